@@ -0,0 +1,2 @@
+#include "mlLib.hpp"
+int fa(){ std::vector<float> v{1,2,3}; return (int)stat::Mean(v); }
@@ -0,0 +1,184 @@
+#ifndef ML_LIB_BENCH_HARNESS_H
+#define ML_LIB_BENCH_HARNESS_H
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <pthread.h>
+#include <sched.h>
+
+namespace bench
+{
+    // Struct to configure a benchmark run
+    struct Config
+    {
+        size_t warmup = 3;                    // Untimed samples before measuring
+        size_t repetitions = 15;              // Timed samples per benchmark
+        double minSampleTime = 0.5e-3;        // Seconds; fast functions are called in a loop until a sample takes this long
+        int cpu = 0;                          // CPU the benchmark thread is pinned to, or -1 to leave it unpinned
+        std::string filter;                   // Only run benchmarks whose name contains this
+        size_t maxVectorSize = 65536;         // Largest size of the vector sweep
+        size_t maxMatrixSize = 128;           // Largest size of the matrix sweep
+        size_t rows = 10000;                  // Rows of the synthetic end-to-end datasets
+        size_t features = 16;                 // Features of the synthetic end-to-end datasets
+        size_t threads = 1;                   // Threads for library functions that take a thread count
+        std::string output = "bench.json";    // JSON output file
+    };
+
+    // Struct to hold the timing of one benchmark, in nanoseconds per call
+    struct Result
+    {
+        std::string name;
+        std::string type;
+        size_t size = 0;
+        size_t callsPerSample = 0;
+        double median = 0.0;
+        double p10 = 0.0;
+        double p90 = 0.0;
+        double p99 = 0.0;
+        double min = 0.0;
+        double mean = 0.0;
+    };
+
+    // Keep the compiler from optimizing away a value that is never otherwise used
+    template <typename T>
+    inline void doNotOptimize(const T &value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    // Pin the calling thread to one CPU
+    inline bool pinThread(int cpu)
+    {
+        if (cpu < 0)
+            return true;
+
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(cpu, &cpuSet);
+        return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+    }
+
+    // Value at fraction q of sorted samples, interpolating between neighbours
+    inline double percentile(const std::vector<double> &sorted, double q)
+    {
+        const double position = q * (sorted.size() - 1);
+        const size_t lower = static_cast<size_t>(position);
+        const size_t upper = std::min(lower + 1, sorted.size() - 1);
+        return sorted[lower] + (position - lower) * (sorted[upper] - sorted[lower]);
+    }
+
+    // Class to time benchmarks and collect their results
+    class Runner
+    {
+    private:
+        Config config;
+        std::vector<Result> results;
+
+    public:
+        explicit Runner(const Config &config) : config(config) {}
+
+        const Config &getConfig() const { return config; }
+        const std::vector<Result> &getResults() const { return results; }
+
+        bool enabled(const std::string &name) const
+        {
+            return config.filter.empty() || name.find(config.filter) != std::string::npos;
+        }
+
+        // Time function(), which runs one call of the benchmarked code
+        template <typename Function>
+        void run(const std::string &name, const std::string &type, size_t size, Function function)
+        {
+            if (!enabled(name))
+                return;
+
+            using Clock = std::chrono::steady_clock;
+
+            // Calibrate the calls per sample so the clock resolution does not dominate
+            size_t callsPerSample = 1;
+            while (true)
+            {
+                const auto start = Clock::now();
+                for (size_t c = 0; c < callsPerSample; ++c)
+                    function();
+                const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+                if (elapsed >= config.minSampleTime || callsPerSample >= (size_t(1) << 30))
+                    break;
+                callsPerSample *= (elapsed > 0.0) ? std::clamp<size_t>(static_cast<size_t>(config.minSampleTime / elapsed * 1.2) + 1, 2, 100) : 100;
+            }
+
+            for (size_t w = 0; w < config.warmup; ++w)
+            {
+                for (size_t c = 0; c < callsPerSample; ++c)
+                    function();
+            }
+
+            std::vector<double> samples(config.repetitions);
+            for (auto &sample : samples)
+            {
+                const auto start = Clock::now();
+                for (size_t c = 0; c < callsPerSample; ++c)
+                    function();
+                sample = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / callsPerSample;
+            }
+            std::sort(samples.begin(), samples.end());
+
+            Result result;
+            result.name = name;
+            result.type = type;
+            result.size = size;
+            result.callsPerSample = callsPerSample;
+            result.median = percentile(samples, 0.5);
+            result.p10 = percentile(samples, 0.1);
+            result.p90 = percentile(samples, 0.9);
+            result.p99 = percentile(samples, 0.99);
+            result.min = samples.front();
+            result.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+            results.push_back(result);
+
+            std::cerr << name << " [" << type << ", " << size << "]: " << result.median << " ns\n";
+        }
+
+        // Write the configuration and every result as JSON
+        bool writeJson(const std::string &filename) const
+        {
+            std::ofstream outFile(filename);
+            if (!outFile.is_open())
+            {
+                std::cerr << "Unable to open file for writing." << std::endl;
+                return false;
+            }
+
+#if defined(__OPTIMIZE__)
+            const bool optimized = true;
+#else
+            const bool optimized = false;
+#endif
+
+            outFile.precision(6);
+            outFile << std::fixed;
+            outFile << "{\n  \"context\": {\"compiler\": \"" << __VERSION__ << "\", \"optimized\": " << (optimized ? "true" : "false")
+                    << ", \"warmup\": " << config.warmup << ", \"repetitions\": " << config.repetitions << ", \"cpu\": " << config.cpu
+                    << ", \"rows\": " << config.rows << ", \"features\": " << config.features << ", \"threads\": " << config.threads << "},\n";
+            outFile << "  \"benchmarks\": [\n";
+            for (size_t i = 0; i < results.size(); ++i)
+            {
+                const Result &r = results[i];
+                outFile << "    {\"name\": \"" << r.name << "\", \"type\": \"" << r.type << "\", \"size\": " << r.size
+                        << ", \"calls_per_sample\": " << r.callsPerSample << ", \"median_ns\": " << r.median << ", \"p10_ns\": " << r.p10
+                        << ", \"p90_ns\": " << r.p90 << ", \"p99_ns\": " << r.p99 << ", \"min_ns\": " << r.min << ", \"mean_ns\": " << r.mean << "}"
+                        << (i + 1 < results.size() ? "," : "") << "\n";
+            }
+            outFile << "  ]\n}\n";
+            return outFile.good();
+        }
+    };
+}
+
+#endif
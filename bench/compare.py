@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""Compare two mlLibBench JSON runs and flag regressions.
+
+Usage: compare.py baseline.json candidate.json [--threshold 0.10] [--all]
+
+A benchmark regresses when its median grew by more than the threshold and
+even its fastest candidate sample is slower than the baseline median, so a
+single noisy sample does not fail the comparison. Exits with status 1 if any
+benchmark regressed.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(filename):
+    with open(filename) as f:
+        run = json.load(f)
+    return run["context"], {(b["name"], b["type"], b["size"]): b for b in run["benchmarks"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two mlLibBench runs")
+    parser.add_argument("baseline")
+    parser.add_argument("candidate")
+    parser.add_argument("--threshold", type=float, default=0.10, help="relative slowdown that counts as a regression")
+    parser.add_argument("--all", action="store_true", help="print every benchmark, not only changes beyond the threshold")
+    args = parser.parse_args()
+
+    baselineContext, baseline = load(args.baseline)
+    candidateContext, candidate = load(args.candidate)
+
+    for key in ("compiler", "optimized", "rows", "features", "threads"):
+        if baselineContext.get(key) != candidateContext.get(key):
+            print(f"warning: runs differ in {key}: {baselineContext.get(key)} vs {candidateContext.get(key)}")
+
+    regressions = 0
+    improvements = 0
+    print(f"{'benchmark':<56} {'type':<12} {'size':>7} {'baseline':>12} {'candidate':>12} {'ratio':>7}")
+    for key in sorted(baseline.keys() & candidate.keys()):
+        old, new = baseline[key], candidate[key]
+        ratio = new["median_ns"] / old["median_ns"] if old["median_ns"] > 0 else 1.0
+
+        status = ""
+        if ratio > 1.0 + args.threshold and new["min_ns"] > old["median_ns"]:
+            status = "REGRESSION"
+            regressions += 1
+        elif ratio < 1.0 / (1.0 + args.threshold) and new["median_ns"] < old["min_ns"]:
+            status = "improved"
+            improvements += 1
+
+        if status or args.all:
+            name, type, size = key
+            print(f"{name:<56} {type:<12} {size:>7} {old['median_ns']:>10.0f}ns {new['median_ns']:>10.0f}ns {ratio:>6.2f}x {status}")
+
+    missing = baseline.keys() - candidate.keys()
+    added = candidate.keys() - baseline.keys()
+    print(f"\n{len(baseline.keys() & candidate.keys())} compared, {regressions} regressed, {improvements} improved, "
+          f"{len(missing)} only in baseline, {len(added)} only in candidate")
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
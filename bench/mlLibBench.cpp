@@ -0,0 +1,548 @@
+#include "../include/mlLib.h"
+#include "benchHarness.h"
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <filesystem>
+
+template <typename T>
+const char *typeName();
+
+template <> const char *typeName<int8_t>() { return "int8"; }
+template <> const char *typeName<int16_t>() { return "int16"; }
+template <> const char *typeName<int32_t>() { return "int32"; }
+template <> const char *typeName<int64_t>() { return "int64"; }
+template <> const char *typeName<uint8_t>() { return "uint8"; }
+template <> const char *typeName<uint16_t>() { return "uint16"; }
+template <> const char *typeName<uint32_t>() { return "uint32"; }
+template <> const char *typeName<uint64_t>() { return "uint64"; }
+template <> const char *typeName<float>() { return "float"; }
+template <> const char *typeName<double>() { return "double"; }
+template <> const char *typeName<long double>() { return "long double"; }
+
+// Small nonzero values, so integer kernels neither overflow nor divide by zero
+template <typename T>
+std::vector<T> randomVector(size_t size, std::mt19937 &rng)
+{
+    std::uniform_int_distribution<int> distribution(1, 3);
+    std::vector<T> values(size);
+    for (auto &value : values)
+    {
+        value = static_cast<T>(distribution(rng));
+    }
+    return values;
+}
+
+template <typename T>
+void benchVectorFunctions(bench::Runner &runner, std::mt19937 &rng)
+{
+    const char *type = typeName<T>();
+    for (size_t size = 16; size <= runner.getConfig().maxVectorSize; size *= 16)
+    {
+        const std::vector<T> a = randomVector<T>(size, rng);
+        const std::vector<T> b = randomVector<T>(size, rng);
+
+        runner.run("vecAlg::vectorAdd", type, size, [&] { bench::doNotOptimize(vecAlg::vectorAdd(a, b)); });
+        runner.run("vecAlg::vectorSubtract", type, size, [&] { bench::doNotOptimize(vecAlg::vectorSubtract(a, b)); });
+        runner.run("vecAlg::Magnitude", type, size, [&] { bench::doNotOptimize(vecAlg::Magnitude(a)); });
+        runner.run("vecAlg::DotProduct", type, size, [&] { bench::doNotOptimize(vecAlg::DotProduct(a, b)); });
+        runner.run("vecAlg::Angle", type, size, [&] { bench::doNotOptimize(vecAlg::Angle(a, b, vecAlg::Angles::Radians)); });
+        runner.run("vecAlg::scalarMultiply", type, size, [&] { bench::doNotOptimize(vecAlg::scalarMultiply(a, 1.5L)); });
+        runner.run("vecAlg::scalarDivide", type, size, [&] { bench::doNotOptimize(vecAlg::scalarDivide(a, 1.5L)); });
+        runner.run("vecAlg::elementwiseMultiply", type, size, [&] { bench::doNotOptimize(vecAlg::elementwiseMultiply(a, b)); });
+        runner.run("vecAlg::elementwiseDivide", type, size, [&] { bench::doNotOptimize(vecAlg::elementwiseDivide(a, b)); });
+
+        runner.run("stat::Norm/Manhattan", type, size, [&] { bench::doNotOptimize(stat::Norm(a, stat::NormType::Manhattan)); });
+        runner.run("stat::Norm/Euclidean", type, size, [&] { bench::doNotOptimize(stat::Norm(a, stat::NormType::Euclidean)); });
+        runner.run("stat::Norm/Infinity", type, size, [&] { bench::doNotOptimize(stat::Norm(a, stat::NormType::Infinity)); });
+        runner.run("stat::Mean", type, size, [&] { bench::doNotOptimize(stat::Mean(a)); });
+        runner.run("stat::Normalize/Min_Max", type, size, [&] { bench::doNotOptimize(stat::Normalize(a, stat::NormalizationType::Min_Max)); });
+        runner.run("stat::Normalize/Z_Score", type, size, [&] { bench::doNotOptimize(stat::Normalize(a, stat::NormalizationType::Z_Score)); });
+        runner.run("stat::Normalize/L2_Euclidean", type, size, [&] { bench::doNotOptimize(stat::Normalize(a, stat::NormalizationType::L2_Euclidean)); });
+    }
+}
+
+template <typename T>
+void benchMatrixFunctions(bench::Runner &runner, std::mt19937 &rng)
+{
+    const char *type = typeName<T>();
+    for (size_t size = 8; size <= runner.getConfig().maxMatrixSize; size *= 4)
+    {
+        std::vector<std::vector<T>> a(size), b(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            a[i] = randomVector<T>(size, rng);
+            b[i] = randomVector<T>(size, rng);
+        }
+
+        runner.run("matAlg::matrixTranspose", type, size, [&] { bench::doNotOptimize(matAlg::matrixTranspose(a)); });
+        runner.run("matAlg::matrixMultiplication", type, size, [&] { bench::doNotOptimize(matAlg::matrixMultiplication(a, b)); });
+    }
+}
+
+template <typename... Types>
+void benchAllTypes(bench::Runner &runner, std::mt19937 &rng)
+{
+    (benchVectorFunctions<Types>(runner, rng), ...);
+    (benchMatrixFunctions<Types>(runner, rng), ...);
+}
+
+void benchProbabilityFunctions(bench::Runner &runner)
+{
+    for (int n : {5, 20, 100})
+    {
+        runner.run("prob::factorial", "double", n, [&] { bench::doNotOptimize(prob::factorial(n)); });
+        runner.run("prob::combinations", "double", n, [&] { bench::doNotOptimize(prob::combinations(n, n / 2)); });
+        runner.run("prob::permutations", "double", n, [&] { bench::doNotOptimize(prob::permutations(n, n / 2)); });
+        runner.run("prob::binomialProbability", "double", n, [&] { bench::doNotOptimize(prob::binomialProbability(n, n / 2, 0.3)); });
+        runner.run("prob::poissonProbability", "double", n, [&] { bench::doNotOptimize(prob::poissonProbability(n, 4.0)); });
+    }
+}
+
+// Synthetic classification data drawn from a logistic model with known coefficients
+template <typename T>
+mlLib::Dataset<T> syntheticClassification(size_t numRows, size_t numFeatures, std::mt19937 &rng)
+{
+    std::normal_distribution<double> feature(0.0, 1.0);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<double> coefficients(numFeatures + 1);
+    for (auto &coefficient : coefficients)
+    {
+        coefficient = feature(rng);
+    }
+
+    std::vector<T> features(numRows * numFeatures), labels(numRows);
+    for (size_t i = 0; i < numRows; ++i)
+    {
+        double logit = coefficients[0];
+        for (size_t j = 0; j < numFeatures; ++j)
+        {
+            features[i * numFeatures + j] = static_cast<T>(feature(rng));
+            logit += coefficients[j + 1] * features[i * numFeatures + j];
+        }
+        labels[i] = (uniform(rng) < 1.0 / (1.0 + std::exp(-logit))) ? 1 : 0;
+    }
+    return mlLib::Dataset<T>(std::move(features), std::move(labels), numFeatures);
+}
+
+void benchLinearRegression(bench::Runner &runner, std::mt19937 &rng)
+{
+    const size_t rows = runner.getConfig().rows;
+    std::normal_distribution<double> noise(0.0, 0.1);
+    std::vector<double> xValues(rows), yValues(rows);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        xValues[i] = static_cast<double>(i) / rows;
+        yValues[i] = 2.0 * xValues[i] + 1.0 + noise(rng);
+    }
+
+    mlLib::LinearRegressionModel model = mlLib::LinearRegressionLeastSquares(xValues, yValues);
+    std::vector<long double> predictions(rows);
+
+    runner.run("LinearRegressionLeastSquares", "double", rows, [&] { bench::doNotOptimize(mlLib::LinearRegressionLeastSquares(xValues, yValues)); });
+    runner.run("LinearRegressionGradientDescent", "double", rows, [&] { bench::doNotOptimize(mlLib::LinearRegressionGradientDescent(xValues, yValues, stat::NormalizationType::Min_Max, 0.01, 100)); });
+    runner.run("LinearRegressionModel::predict", "double", rows, [&] { bench::doNotOptimize(model.predict(xValues)); });
+    runner.run("LinearRegressionModel::predict/span", "double", rows, [&]
+               { model.predict(std::span<const double>(xValues), std::span<long double>(predictions));
+                 bench::doNotOptimize(predictions.data()); });
+}
+
+template <typename T>
+void benchLogisticRegression(bench::Runner &runner, std::mt19937 &rng)
+{
+    const char *type = typeName<T>();
+    const bench::Config &config = runner.getConfig();
+    const size_t rows = config.rows;
+    const int iterations = 20;
+
+    mlLib::Dataset<T> dataset = syntheticClassification<T>(rows, config.features, rng);
+    mlLib::DatasetView<T> view = dataset.view();
+
+    std::vector<std::vector<T>> xValues(rows);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        xValues[i].assign(view.row(i).begin(), view.row(i).end());
+    }
+    const std::vector<T> yValues(dataset.getLabels().begin(), dataset.getLabels().end());
+
+    mlLib::LogisticRegressionModel model = mlLib::LogisticRegression(view, 0.1, 200);
+    std::vector<long double> probabilities(rows);
+    std::vector<int> predictions(rows);
+
+    runner.run("LogisticRegression/vector", type, rows, [&] { bench::doNotOptimize(mlLib::LogisticRegression(xValues, yValues, 0.1, iterations)); });
+    runner.run("LogisticRegression/view", type, rows, [&] { bench::doNotOptimize(mlLib::LogisticRegression(view, 0.1, iterations)); });
+    runner.run("LogisticRegression/adam", type, rows, [&] { bench::doNotOptimize(mlLib::LogisticRegression(mlLib::LogisticRegressionModel(), view, 0.1, iterations, mlLib::OptimizerType::Adam)); });
+    runner.run("LogisticRegressionModel::predict", type, rows, [&] { bench::doNotOptimize(model.predict(xValues)); });
+    runner.run("LogisticRegressionModel::predictProbabilities/span", type, rows, [&]
+               { model.predictProbabilities(dataset.getFeatures(), std::span<long double>(probabilities));
+                 bench::doNotOptimize(probabilities.data()); });
+    runner.run("LogisticRegressionModel::predict/span", type, rows, [&]
+               { model.predict(dataset.getFeatures(), std::span<int>(predictions));
+                 bench::doNotOptimize(predictions.data()); });
+
+    const std::vector<mlLib::LogisticRegressionParams> grid = mlLib::MakeParameterGrid({0.1}, {iterations});
+    runner.run("CrossValidateLogisticRegression", type, rows, [&] { bench::doNotOptimize(mlLib::CrossValidateLogisticRegression(view, grid, 5, false, config.threads)); });
+
+    mlLib::BatchOptions batchOptions;
+    batchOptions.batchSize = 256;
+    batchOptions.numEpochs = 1;
+    runner.run("LogisticRegression/batches", type, rows, [&]
+               { mlLib::BatchIterator<T> batches(view, batchOptions);
+                 bench::doNotOptimize(mlLib::LogisticRegression(batches, 0.1, mlLib::OptimizerType::Adam)); });
+
+    if constexpr (std::is_same_v<T, double>)
+    {
+        mlLib::CompressedDataset compressed(view);
+        runner.run("LogisticRegression/compressed", type, rows, [&] { bench::doNotOptimize(mlLib::LogisticRegression(compressed, 0.1, iterations)); });
+
+        mlLib::QuantizedLogisticRegressionModel quantized = mlLib::QuantizeLogisticRegression(model, xValues);
+        const std::vector<int8_t> quantizedRows = quantized.quantizeInputs(xValues);
+        runner.run("QuantizedLogisticRegressionModel::predictQuantized", "int8", rows, [&] { bench::doNotOptimize(quantized.predictQuantized(quantizedRows)); });
+    }
+}
+
+void benchClustering(bench::Runner &runner, std::mt19937 &rng)
+{
+    const bench::Config &config = runner.getConfig();
+    const size_t rows = config.rows;
+    mlLib::Dataset<double> dataset = syntheticClassification<double>(rows, config.features, rng);
+    mlLib::DatasetView<double> view = dataset.view();
+
+    // A fixed number of passes, so the timings compare the cost per pass of each assignment step
+    mlLib::KMeansOptions options;
+    options.numClusters = 16;
+    options.maxIterations = 10;
+    options.tolerance = 0.0L;
+    options.numThreads = config.threads;
+
+    const std::pair<mlLib::KMeansAlgorithm, const char *> algorithms[] = {{mlLib::Lloyd, "KMeans/Lloyd"}, {mlLib::Hamerly, "KMeans/Hamerly"}, {mlLib::Elkan, "KMeans/Elkan"}};
+    for (const auto &[algorithm, name] : algorithms)
+    {
+        options.algorithm = algorithm;
+        runner.run(name, "double", rows, [&] { bench::doNotOptimize(mlLib::KMeans(view, options)); });
+    }
+
+    options.batchSize = 256;
+    runner.run("MiniBatchKMeans", "double", rows, [&] { bench::doNotOptimize(mlLib::MiniBatchKMeans(view, options)); });
+
+    const mlLib::KMeansModel model = mlLib::KMeans(view, options);
+    runner.run("KMeansModel::predict", "double", rows, [&] { bench::doNotOptimize(model.predict(view, config.threads)); });
+}
+
+void benchNearestNeighbors(bench::Runner &runner, std::mt19937 &rng)
+{
+    const bench::Config &config = runner.getConfig();
+    const size_t rows = config.rows;
+    const size_t numFeatures = 3;
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<double> points(rows * numFeatures), labels(rows);
+    for (auto &value : points)
+    {
+        value = uniform(rng);
+    }
+    for (size_t i = 0; i < rows; ++i)
+    {
+        labels[i] = (points[i * numFeatures] > 0.5) ? 1.0 : 0.0;
+    }
+    const mlLib::DatasetView<double> view(points.data(), labels.data(), rows, numFeatures);
+    const mlLib::DatasetView<double> queries = view.rows(0, std::min<size_t>(rows, 1000));
+
+    const std::pair<mlLib::NeighborIndexType, const char *> types[] = {{mlLib::KDTree, "KDTree"}, {mlLib::BallTree, "BallTree"}};
+    for (const auto &[type, name] : types)
+    {
+        mlLib::NeighborIndexOptions options;
+        options.type = type;
+        const std::string prefix = std::string("NeighborIndex/") + name;
+        runner.run(prefix + "/build", "double", rows, [&] { bench::doNotOptimize(mlLib::NeighborIndex(view, options)); });
+
+        const mlLib::NeighborIndex index(view, options);
+        runner.run(prefix + "/query10", "double", rows, [&] { bench::doNotOptimize(index.query(queries, 10, config.threads)); });
+        runner.run(prefix + "/queryRadius", "double", rows, [&] { bench::doNotOptimize(index.queryRadius(queries, 0.05L, config.threads)); });
+    }
+
+    const mlLib::KNNClassifier classifier(view, 5);
+    runner.run("KNNClassifier::predict", "double", rows, [&] { bench::doNotOptimize(classifier.predict(queries, config.threads)); });
+}
+
+void benchVectorSearch(bench::Runner &runner, std::mt19937 &rng)
+{
+    const bench::Config &config = runner.getConfig();
+    const size_t rows = config.rows;
+    const size_t numFeatures = 128, numQueries = 1000, k = 10;
+
+    // Embedding-like vectors around random topic directions
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+    std::vector<float> topics(64 * numFeatures), vectors((rows + numQueries) * numFeatures);
+    for (auto &value : topics)
+    {
+        value = normal(rng);
+    }
+    for (size_t i = 0; i < rows + numQueries; ++i)
+    {
+        const float *topic = topics.data() + (rng() % 64) * numFeatures;
+        for (size_t j = 0; j < numFeatures; ++j)
+        {
+            vectors[i * numFeatures + j] = topic[j] + 0.8f * normal(rng);
+        }
+    }
+    const mlLib::DatasetView<float> view(vectors.data(), nullptr, rows, numFeatures);
+    const mlLib::DatasetView<float> queries(vectors.data() + rows * numFeatures, nullptr, numQueries, numFeatures);
+
+    mlLib::HNSWOptions options;
+    options.numThreads = config.threads;
+    const mlLib::DatasetView<float> buildView = view.rows(0, std::max<size_t>(1, rows / 10));
+    runner.run("HNSWIndex/build", "float", buildView.size(), [&] { bench::doNotOptimize(mlLib::HNSWIndex(buildView, options)); });
+
+    // Timings are per batch of numQueries queries; recall@10 against the exact scan goes to stderr
+    const mlLib::HNSWIndex index(view, options);
+    const std::vector<std::vector<mlLib::Neighbor>> exact = index.exactQuery(queries, k, config.threads);
+    runner.run("HNSWIndex/exactQuery10", "float", rows, [&] { bench::doNotOptimize(index.exactQuery(queries, k, config.threads)); });
+    for (const size_t efSearch : {16, 64, 256})
+    {
+        const std::string name = "HNSWIndex/query10/ef" + std::to_string(efSearch);
+        if (!runner.enabled(name))
+            continue;
+
+        runner.run(name, "float", rows, [&] { bench::doNotOptimize(index.query(queries, k, efSearch, config.threads)); });
+
+        const std::vector<std::vector<mlLib::Neighbor>> approximate = index.query(queries, k, efSearch, config.threads);
+        size_t found = 0;
+        for (size_t q = 0; q < numQueries; ++q)
+        {
+            for (const mlLib::Neighbor &truth : exact[q])
+            {
+                found += std::any_of(approximate[q].begin(), approximate[q].end(), [&](const mlLib::Neighbor &neighbor)
+                                     { return neighbor.index == truth.index; });
+            }
+        }
+        std::cerr << name << " recall@" << k << ": " << 100.0 * found / (numQueries * k) << "%\n";
+    }
+}
+
+void benchDecomposition(bench::Runner &runner, std::mt19937 &rng)
+{
+    const bench::Config &config = runner.getConfig();
+    const size_t rows = config.rows;
+    const size_t numFeatures = std::max<size_t>(config.features, 64);
+    mlLib::Dataset<double> dataset = syntheticClassification<double>(rows, numFeatures, rng);
+    mlLib::DatasetView<double> view = dataset.view();
+
+    // Each fit makes 2 + powerIterations passes over the rows (one more with centering)
+    mlLib::PCAOptions options;
+    options.numComponents = 10;
+    options.numThreads = config.threads;
+    for (const size_t powerIterations : {0, 2})
+    {
+        options.powerIterations = powerIterations;
+        runner.run("PCA/q" + std::to_string(powerIterations), "double", rows, [&] { bench::doNotOptimize(mlLib::PCA(view, options)); });
+    }
+
+    const mlLib::PCAModel model = mlLib::PCA(view, options);
+    runner.run("PCAModel::transform", "double", rows, [&] { bench::doNotOptimize(model.transform(view, config.threads)); });
+}
+
+void benchGradientBoosting(bench::Runner &runner, std::mt19937 &rng)
+{
+    const bench::Config &config = runner.getConfig();
+    const size_t rows = config.rows;
+    mlLib::Dataset<float> dataset = syntheticClassification<float>(rows, config.features, rng);
+    mlLib::DatasetView<float> view = dataset.view();
+
+    mlLib::GBDTOptions options;
+    options.numTrees = 20;
+    options.numThreads = config.threads;
+    runner.run("GradientBoosting", "float", rows, [&] { bench::doNotOptimize(mlLib::GradientBoosting(view, options)); });
+
+    options.numTrees = 100;
+    const mlLib::GBDTModel model = mlLib::GradientBoosting(view, options);
+    runner.run("GBDTModel::predict", "float", rows, [&] { bench::doNotOptimize(model.predict(view, config.threads)); });
+    runner.run("GBDTModel::predict/row", "float", 1, [&] { bench::doNotOptimize(model.predict(view.row(0))); });
+}
+
+void benchNaiveBayes(bench::Runner &runner, std::mt19937 &rng)
+{
+    const bench::Config &config = runner.getConfig();
+    const size_t rows = config.rows;
+    mlLib::Dataset<float> dataset = syntheticClassification<float>(rows, config.features, rng);
+    mlLib::DatasetView<float> view = dataset.view();
+
+    mlLib::NaiveBayesOptions options;
+    options.numThreads = config.threads;
+    runner.run("NaiveBayes", "float", rows, [&] { bench::doNotOptimize(mlLib::NaiveBayes(view, options)); });
+
+    const mlLib::NaiveBayesModel model = mlLib::NaiveBayes(view, options);
+    runner.run("NaiveBayesModel::predict", "float", rows, [&] { bench::doNotOptimize(model.predict(view, config.threads)); });
+    runner.run("NaiveBayesModel::predictProbabilities", "float", rows, [&] { bench::doNotOptimize(model.predictProbabilities(view, config.threads)); });
+}
+
+void benchPairwiseDistances(bench::Runner &runner, std::mt19937 &rng)
+{
+    const bench::Config &config = runner.getConfig();
+    const size_t rows = std::min<size_t>(config.rows, 2000);
+    mlLib::Dataset<float> dataset = syntheticClassification<float>(rows, config.features, rng);
+    mlLib::DatasetView<float> view = dataset.view();
+
+    const std::pair<mlLib::VectorMetric, const char *> metrics[] = {{mlLib::L2Distance, "L2"}, {mlLib::CosineDistance, "cosine"}, {mlLib::ManhattanDistance, "Manhattan"}};
+    for (const auto &[metric, name] : metrics)
+    {
+        runner.run(std::string("PairwiseDistances/") + name, "float", rows * rows, [&] { bench::doNotOptimize(mlLib::PairwiseDistances(view, view, metric, config.threads)); });
+    }
+    runner.run("PairwiseNearest/k10", "float", rows * rows, [&] { bench::doNotOptimize(mlLib::PairwiseNearest(view, view, 10, mlLib::L2Distance, config.threads)); });
+}
+
+void benchInputOutput(bench::Runner &runner, std::mt19937 &rng)
+{
+    const bench::Config &config = runner.getConfig();
+    const size_t rows = config.rows;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const std::string csvFile = (directory / "mlLibBench.csv").string();
+    const std::string binaryFile = (directory / "mlLibBench.bin").string();
+    const std::string columnarFile = (directory / "mlLibBench.mlcd").string();
+    const std::string textModelFile = (directory / "mlLibBenchModel.txt").string();
+    const std::string binaryModelFile = (directory / "mlLibBenchModel.bin").string();
+
+    mlLib::Dataset<double> dataset = syntheticClassification<double>(rows, config.features, rng);
+    mlLib::DatasetView<double> view = dataset.view();
+
+    std::ofstream csv(csvFile);
+    if (!csv.is_open())
+    {
+        std::cerr << "Unable to open file for writing." << std::endl;
+        return;
+    }
+    csv.precision(17);
+    for (size_t j = 0; j < config.features; ++j)
+    {
+        csv << "x" << j << ",";
+    }
+    csv << "label\n";
+    std::vector<std::vector<double>> xValues(rows);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        xValues[i].assign(view.row(i).begin(), view.row(i).end());
+        for (double value : xValues[i])
+        {
+            csv << value << ",";
+        }
+        csv << view.label(i) << "\n";
+    }
+    csv.close();
+
+    const std::vector<double> yValues(dataset.getLabels().begin(), dataset.getLabels().end());
+    mlLib::saveBinaryDataset(xValues, yValues, binaryFile);
+    mlLib::ConvertCSVToColumnar<double>(csvFile, columnarFile);
+
+    runner.run("LoadCSV", "float", rows, [&] { bench::doNotOptimize(mlLib::LoadCSV<float>(csvFile)); });
+    runner.run("LoadCSV", "double", rows, [&] { bench::doNotOptimize(mlLib::LoadCSV<double>(csvFile)); });
+
+    auto readAllChunks = [&](const std::string &filename, mlLib::DataFormat format)
+    {
+        mlLib::ChunkedDataReader reader(filename, format, config.features, 4096);
+        mlLib::DataChunk chunk;
+        size_t total = 0;
+        while (reader.readChunk(chunk) > 0)
+        {
+            total += chunk.numRows;
+        }
+        bench::doNotOptimize(total);
+    };
+    runner.run("ChunkedDataReader/CSV", "long double", rows, [&] { readAllChunks(csvFile, mlLib::DataFormat::CSV); });
+    runner.run("ChunkedDataReader/Binary", "long double", rows, [&] { readAllChunks(binaryFile, mlLib::DataFormat::Binary); });
+
+    runner.run("ColumnarDataset/open+scan", "double", rows, [&]
+               { mlLib::ColumnarDataset columnar(columnarFile);
+                 double sum = 0.0;
+                 for (const auto &column : columnar.featureColumns<double>())
+                 {
+                     for (double value : column)
+                         sum += value;
+                 }
+                 bench::doNotOptimize(sum); });
+
+    mlLib::LogisticRegressionModel model = mlLib::LogisticRegression(view, 0.1, 50);
+    mlLib::LogisticRegressionModel loaded;
+    runner.run("LogisticRegressionModel::saveToFile", "text", config.features, [&] { model.saveToFile(textModelFile); });
+    runner.run("LogisticRegressionModel::loadFromFile", "text", config.features, [&] { loaded.loadFromFile(textModelFile); });
+    runner.run("LogisticRegressionModel::saveBinary", "binary", config.features, [&] { bench::doNotOptimize(model.saveBinary(binaryModelFile)); });
+    runner.run("LogisticRegressionModel::loadBinary", "binary", config.features, [&] { bench::doNotOptimize(loaded.loadBinary(binaryModelFile)); });
+
+    for (const std::string &file : {csvFile, binaryFile, columnarFile, textModelFile, binaryModelFile})
+    {
+        std::filesystem::remove(file);
+    }
+}
+
+const char *usage = "Usage: mlLibBench [--out file] [--filter substring] [--reps n] [--warmup n] [--rows n] [--features n]\n"
+                    "                  [--max-size n] [--cpu n] [--threads n]\n";
+
+int main(int argc, char *argv[])
+{
+    bench::Config config;
+    for (int i = 1; i < argc; i += 2)
+    {
+        const std::string option = argv[i];
+        if (i + 1 == argc)
+        {
+            std::cerr << "Missing value for option " << option << "\n" << usage;
+            return 1;
+        }
+        const std::string value = argv[i + 1];
+        if (option == "--out")
+            config.output = value;
+        else if (option == "--filter")
+            config.filter = value;
+        else if (option == "--reps")
+            config.repetitions = std::stoul(value);
+        else if (option == "--warmup")
+            config.warmup = std::stoul(value);
+        else if (option == "--rows")
+            config.rows = std::stoul(value);
+        else if (option == "--features")
+            config.features = std::stoul(value);
+        else if (option == "--max-size")
+        {
+            // Caps both sweeps; the matrix sweep keeps its smaller default below the cap
+            config.maxVectorSize = std::stoul(value);
+            config.maxMatrixSize = std::min(config.maxMatrixSize, config.maxVectorSize);
+        }
+        else if (option == "--cpu")
+            config.cpu = std::stoi(value);
+        else if (option == "--threads")
+            config.threads = std::stoul(value);
+        else
+        {
+            std::cerr << "Unknown option " << option << "\n" << usage;
+            return 1;
+        }
+    }
+
+    if (!bench::pinThread(config.cpu))
+    {
+        std::cerr << "Unable to pin to CPU " << config.cpu << ", running unpinned" << std::endl;
+    }
+
+    bench::Runner runner(config);
+    std::mt19937 rng(42);
+
+    benchAllTypes<int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t, float, double, long double>(runner, rng);
+    benchProbabilityFunctions(runner);
+    benchLinearRegression(runner, rng);
+    benchLogisticRegression<float>(runner, rng);
+    benchLogisticRegression<double>(runner, rng);
+    benchClustering(runner, rng);
+    benchNearestNeighbors(runner, rng);
+    benchVectorSearch(runner, rng);
+    benchDecomposition(runner, rng);
+    benchGradientBoosting(runner, rng);
+    benchNaiveBayes(runner, rng);
+    benchPairwiseDistances(runner, rng);
+    benchInputOutput(runner, rng);
+
+    if (!runner.writeJson(config.output))
+    {
+        return 1;
+    }
+    std::cout << runner.getResults().size() << " benchmarks written to " << config.output << std::endl;
+
+    return 0;
+}
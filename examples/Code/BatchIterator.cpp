@@ -0,0 +1,50 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <chrono>
+
+int main()
+{
+    mlLib::Dataset<double> dataset(mlLib::LoadCSV<double>("examples/DataSet/HeartDisease.csv"));
+    if (dataset.getNumRows() == 0)
+    {
+        std::cerr << "Error opening the file!" << std::endl;
+        return 1;
+    }
+
+    // Shuffled, Z-score normalized batches of 256 rows, triple buffered on a producer thread
+    mlLib::BatchOptions options;
+    options.batchSize = 256;
+    options.numBuffers = 3;
+    options.numEpochs = 100;
+    options.normalizeFeatures = true;
+
+    auto start = std::chrono::steady_clock::now();
+    mlLib::BatchIterator<double> batches(dataset.view(), options);
+    mlLib::LogisticRegressionModel model = mlLib::LogisticRegression(batches, 0.01, mlLib::OptimizerType::Adam);
+    auto end = std::chrono::steady_clock::now();
+
+    mlLib::BatchIteratorStats stats = batches.getStats();
+    std::cout << "Trained on " << stats.batches << " batches in " << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n"
+              << "Trainer waited for a batch " << stats.consumerStalls << " times ("
+              << std::chrono::duration<double, std::milli>(stats.consumerWaitTime).count() << " ms in total)\n"
+              << "Producer waited for a free buffer " << stats.producerStalls << " times\n";
+
+    // Score with the same normalization the batches used
+    const std::vector<long double> &offsets = batches.getFeatureOffsets();
+    const std::vector<long double> &scales = batches.getFeatureScales();
+    mlLib::DatasetView<double> all = dataset.view();
+    std::vector<long double> row(all.getNumFeatures());
+    size_t correct = 0;
+    for (size_t i = 0; i < all.size(); ++i)
+    {
+        for (size_t j = 0; j < row.size(); ++j)
+        {
+            row[j] = (all.row(i)[j] - offsets[j]) / scales[j];
+        }
+        const int predictedClass = (model.predictProbability(std::span<const long double>(row)) >= 0.5) ? 1 : 0;
+        correct += (predictedClass == static_cast<int>(all.label(i)));
+    }
+    std::cout << "Training accuracy: " << 100.0 * correct / all.size() << "%\n";
+
+    return 0;
+}
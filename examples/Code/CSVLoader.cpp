@@ -0,0 +1,51 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+int main()
+{
+    mlLib::CSVOptions options;
+    options.layout = mlLib::MatrixLayout::RowMajor;
+
+    auto start = std::chrono::steady_clock::now();
+    mlLib::CSVData<long double> data = mlLib::LoadCSV<long double>("examples/DataSet/HeartDisease.csv", options);
+    auto end = std::chrono::steady_clock::now();
+
+    if (data.numRows == 0)
+    {
+        std::cerr << "Error opening the file!" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Loaded " << data.numRows << " rows x " << data.numFeatures << " features in "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+    std::cout << "Malformed rows: " << data.malformedRows.size() << "\n";
+    for (const auto &row : data.malformedRows)
+    {
+        std::cout << "  line " << row.lineNumber << ": " << row.reason << "\n";
+    }
+
+    // Load only age, sysBP and BMI, stored column by column
+    options.featureColumns = {1, 10, 12};
+    options.layout = mlLib::MatrixLayout::ColumnMajor;
+    mlLib::CSVData<double> subset = mlLib::LoadCSV<double>("examples/DataSet/HeartDisease.csv", options);
+
+    std::cout << "\nFirst rows of the column subset:\n";
+    for (const auto &name : subset.featureNames)
+    {
+        std::cout << std::setw(10) << name;
+    }
+    std::cout << std::setw(12) << "TenYearCHD" << "\n";
+
+    for (size_t i = 0; i < 5; ++i)
+    {
+        for (size_t j = 0; j < subset.numFeatures; ++j)
+        {
+            std::cout << std::setw(10) << subset.at(i, j);
+        }
+        std::cout << std::setw(12) << subset.labels[i] << "\n";
+    }
+
+    return 0;
+}
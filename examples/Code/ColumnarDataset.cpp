@@ -0,0 +1,60 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+int main()
+{
+    // Convert the CSV once; later runs map the columnar file directly
+    if (!mlLib::ConvertCSVToColumnar<double>("examples/DataSet/HeartDisease.csv", "examples/DataSet/HeartDisease.mlcd"))
+    {
+        std::cerr << "Error converting the file!" << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    mlLib::ColumnarDataset dataset("examples/DataSet/HeartDisease.mlcd");
+    auto end = std::chrono::steady_clock::now();
+
+    if (!dataset.isOpen())
+    {
+        std::cerr << "Error opening the file!" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Mapped " << dataset.getNumRows() << " rows x " << dataset.getNumColumns() << " columns in "
+              << std::chrono::duration<double, std::micro>(end - start).count() << " us\n";
+
+    // Project three columns; only their pages are read from disk
+    std::vector<std::span<const double>> features;
+    for (const std::string name : {"age", "sysBP", "BMI"})
+    {
+        size_t column = dataset.findColumn(name);
+        dataset.prefetchColumn(column);
+        features.push_back(dataset.column<double>(column));
+    }
+    std::span<const double> labels = dataset.column<double>(dataset.getLabelColumn());
+
+    std::cout << "\nFirst rows of the projection:\n";
+    std::cout << std::setw(10) << "age" << std::setw(10) << "sysBP" << std::setw(10) << "BMI" << std::setw(12) << "TenYearCHD" << "\n";
+    for (size_t i = 0; i < 5; ++i)
+    {
+        for (const auto &feature : features)
+        {
+            std::cout << std::setw(10) << feature[i];
+        }
+        std::cout << std::setw(12) << labels[i] << "\n";
+    }
+
+    // Train straight from the column views
+    mlLib::LogisticRegressionModel model = mlLib::LogisticRegression(features, labels, 0.01, 100);
+
+    std::cout << "\nCoefficients:";
+    for (long double coefficient : model.getCoefficients())
+    {
+        std::cout << " " << coefficient;
+    }
+    std::cout << "\n";
+
+    return 0;
+}
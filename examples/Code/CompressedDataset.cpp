@@ -0,0 +1,41 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+int main()
+{
+    mlLib::CSVData<double> csv = mlLib::LoadCSV<double>("examples/DataSet/HeartDisease.csv");
+    if (csv.numRows == 0)
+    {
+        std::cerr << "Error opening the file!" << std::endl;
+        return 1;
+    }
+
+    const std::vector<std::string> featureNames = csv.featureNames;
+    mlLib::Dataset<double> dataset(std::move(csv));
+
+    // Flags are bit-packed, small integer codes become one-byte dictionary codes, the rest half precision
+    mlLib::CompressionOptions options;
+    options.continuousEncoding = mlLib::ColumnEncoding::Float16Encoding;
+    mlLib::CompressedDataset compressed(dataset.view(), options);
+
+    const char *encodingNames[] = {"bit-packed", "dictionary", "float16", "bfloat16", "float32"};
+    for (size_t j = 0; j < compressed.getNumFeatures(); ++j)
+    {
+        std::cout << std::setw(16) << featureNames[j] << ": " << encodingNames[compressed.getEncoding(j)] << "\n";
+    }
+
+    const size_t wideBytes = dataset.getNumRows() * (dataset.getNumFeatures() + 1) * sizeof(long double);
+    std::cout << "\nlong double storage: " << wideBytes << " bytes, compressed: " << compressed.getMemoryUsage() << " bytes ("
+              << static_cast<double>(wideBytes) / compressed.getMemoryUsage() << "x smaller)\n";
+
+    auto start = std::chrono::steady_clock::now();
+    mlLib::LogisticRegressionModel model = mlLib::LogisticRegression(compressed, 0.01, 300, mlLib::OptimizerType::Adam);
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "Trained in " << std::chrono::duration<double, std::milli>(end - start).count() << " ms, accuracy "
+              << mlLib::EvaluateClassification(model, dataset.view()).evaluationMetrics.accuracy << "%\n";
+
+    return 0;
+}
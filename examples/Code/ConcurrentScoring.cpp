@@ -0,0 +1,87 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+
+int main()
+{
+    // Read the whole dataset as a single chunk
+    mlLib::ChunkedDataReader reader("examples/DataSet/HeartDisease.csv", mlLib::DataFormat::CSV, 15, 8192);
+    mlLib::DataChunk chunk;
+
+    if (reader.readChunk(chunk) == 0)
+    {
+        std::cerr << "Error opening the file!" << std::endl;
+        return 1;
+    }
+
+    const std::vector<double> xRowMajor(chunk.features.begin(), chunk.features.begin() + chunk.numRows * 15);
+    const std::vector<int> yValues(chunk.labels.begin(), chunk.labels.begin() + chunk.numRows);
+
+    mlLib::LogisticRegressionModel loadedModel;
+    loadedModel.loadFromFile("examples/Models/LogRegModel.txt");
+
+    // One shared, immutable model instance serves every thread without a lock
+    const mlLib::LogisticRegressionModel &model = loadedModel;
+
+    const size_t numThreads = 64;
+    const size_t requestsPerThread = 20000;
+    std::vector<std::vector<double>> latencies(numThreads, std::vector<double>(requestsPerThread));
+    std::vector<std::vector<int>> predictions(numThreads, std::vector<int>(requestsPerThread));
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+        workers.emplace_back([&, t]()
+                             {
+                                 for (size_t r = 0; r < requestsPerThread; ++r)
+                                 {
+                                     const size_t row = (t * requestsPerThread + r) % chunk.numRows;
+                                     const std::span<const double> xRow(&xRowMajor[row * 15], 15);
+
+                                     const auto requestStart = std::chrono::steady_clock::now();
+                                     predictions[t][r] = (model.predictProbability(xRow) >= 0.5) ? 1 : 0;
+                                     const auto requestEnd = std::chrono::steady_clock::now();
+
+                                     latencies[t][r] = std::chrono::duration<double, std::nano>(requestEnd - requestStart).count();
+                                 } });
+    }
+
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::vector<double> allLatencies;
+    allLatencies.reserve(numThreads * requestsPerThread);
+    for (const auto &threadLatencies : latencies)
+    {
+        allLatencies.insert(allLatencies.end(), threadLatencies.begin(), threadLatencies.end());
+    }
+    std::sort(allLatencies.begin(), allLatencies.end());
+
+    auto percentile = [&allLatencies](double p)
+    { return allLatencies[static_cast<size_t>(p * (allLatencies.size() - 1))]; };
+
+    std::cout << "Single-row scoring, " << numThreads << " threads sharing one model:\n";
+    std::cout << std::setw(15) << "Throughput: " << allLatencies.size() / seconds << " rows/s\n";
+    std::cout << std::setw(15) << "p50: " << percentile(0.50) << " ns\n";
+    std::cout << std::setw(15) << "p99: " << percentile(0.99) << " ns\n";
+    std::cout << std::setw(15) << "p99.9: " << percentile(0.999) << " ns\n";
+    std::cout << std::setw(15) << "max: " << allLatencies.back() << " ns\n\n";
+
+    // Batch scoring into caller-owned buffers, evaluated without mutating the model
+    std::vector<int> batchPredictions(chunk.numRows);
+    model.predict(std::span<const double>(xRowMajor), std::span<int>(batchPredictions));
+    mlLib::ClassificationMetrics metrics = mlLib::EvaluateClassification(std::span<const int>(yValues), std::span<const int>(batchPredictions));
+
+    std::cout << "Batch Accuracy: " << metrics.evaluationMetrics.accuracy << "%\n";
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+
+int main()
+{
+    // Read the whole dataset as a single chunk
+    mlLib::ChunkedDataReader reader("examples/DataSet/HeartDisease.csv", mlLib::DataFormat::CSV, 15, 8192);
+    mlLib::DataChunk chunk;
+
+    if (reader.readChunk(chunk) == 0)
+    {
+        std::cerr << "Error opening the file!" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::vector<long double>> xValues(chunk.numRows);
+    std::vector<long double> yValues(chunk.labels.begin(), chunk.labels.begin() + chunk.numRows);
+    for (size_t i = 0; i < chunk.numRows; ++i)
+    {
+        xValues[i].assign(chunk.features.begin() + i * 15, chunk.features.begin() + (i + 1) * 15);
+    }
+
+    std::vector<mlLib::LogisticRegressionParams> parameterGrid = mlLib::MakeParameterGrid({0.0001, 0.0005, 0.001, 0.005}, {50, 200}, {mlLib::OptimizerType::SGD, mlLib::OptimizerType::Adam});
+
+    // 5-fold cross-validation of 16 configurations, dropping the worse half after each round
+    std::vector<mlLib::CrossValidationResult> results = mlLib::CrossValidateLogisticRegression(xValues, yValues, parameterGrid, 5, true);
+
+    std::cout << std::setw(10) << "Optimizer" << std::setw(15) << "Learning Rate" << std::setw(12) << "Iterations"
+              << std::setw(10) << "Trained" << std::setw(16) << "Mean Accuracy" << "\n";
+    for (const auto &result : results)
+    {
+        std::cout << std::setw(10) << (result.params.optimizer == mlLib::OptimizerType::Adam ? "Adam" : "SGD")
+                  << std::setw(15) << result.params.learningRate
+                  << std::setw(12) << result.params.numIterations
+                  << std::setw(10) << result.iterationsTrained
+                  << std::setw(15) << result.meanAccuracy << "%\n";
+    }
+
+    std::cout << "\nBest configuration, per fold:\n";
+    for (size_t k = 0; k < results[0].foldMetrics.size(); ++k)
+    {
+        const mlLib::EvaluationMetrics &metrics = results[0].foldMetrics[k];
+        std::cout << "Fold " << k << ": Accuracy=" << metrics.accuracy << ", Recall=" << metrics.recall
+                  << ", Precision=" << metrics.precision << ", F1 Score=" << metrics.f1Score << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+
+int main()
+{
+    // One copy of the data; every split, shuffle and shard below is a view into it
+    mlLib::Dataset<double> dataset(mlLib::LoadCSV<double>("examples/DataSet/HeartDisease.csv"));
+    if (dataset.getNumRows() == 0)
+    {
+        std::cerr << "Error opening the file!" << std::endl;
+        return 1;
+    }
+
+    mlLib::DatasetView<double> all = dataset.view();
+    auto [train, test] = all.stratifiedSplit(0.2, 7);
+    std::cout << "Train rows: " << train.size() << ", test rows: " << test.size() << "\n";
+
+    mlLib::LogisticRegressionModel model = mlLib::LogisticRegression(mlLib::LogisticRegressionModel(), train, 0.01, 300, mlLib::OptimizerType::Adam);
+    mlLib::ClassificationMetrics metrics = mlLib::EvaluateClassification(model, test);
+    std::cout << "Test accuracy: " << metrics.evaluationMetrics.accuracy << "%\n";
+
+    // Score the test set with one worker per shard
+    std::vector<mlLib::DatasetView<double>> shards = test.shards(4);
+    std::vector<size_t> positives(shards.size());
+    std::vector<std::thread> workers;
+    for (size_t k = 0; k < shards.size(); ++k)
+    {
+        workers.emplace_back([&, k]
+                             {
+                                 std::vector<int> predictions = model.predict(shards[k]);
+                                 positives[k] = std::count(predictions.begin(), predictions.end(), 1); });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    for (size_t k = 0; k < shards.size(); ++k)
+    {
+        std::cout << "Shard " << k << ": " << shards[k].size() << " rows, " << positives[k] << " predicted positive\n";
+    }
+
+    // Cross-validate on a shuffled view of the training part
+    auto results = mlLib::CrossValidateLogisticRegression(train.shuffled(1), mlLib::MakeParameterGrid({0.001, 0.01, 0.1}, {100}, {mlLib::OptimizerType::Adam}), 5);
+    std::cout << "\nBest learning rate: " << results[0].params.learningRate << " (mean accuracy " << results[0].meanAccuracy << "%)\n";
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+int main()
+{
+    // Read the whole dataset as a single chunk
+    mlLib::ChunkedDataReader reader("examples/DataSet/HeartDisease.csv", mlLib::DataFormat::CSV, 15, 8192);
+    mlLib::DataChunk chunk;
+
+    if (reader.readChunk(chunk) == 0)
+    {
+        std::cerr << "Error opening the file!" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::vector<double>> xValues(chunk.numRows);
+    std::vector<double> xRowMajor(chunk.features.begin(), chunk.features.begin() + chunk.numRows * 15);
+    for (size_t i = 0; i < chunk.numRows; ++i)
+    {
+        xValues[i].assign(xRowMajor.begin() + i * 15, xRowMajor.begin() + (i + 1) * 15);
+    }
+
+    mlLib::LogisticRegressionModel model;
+    model.loadFromFile("examples/Models/LogRegModel.txt");
+
+    // The HeartDisease model has 15 features, known at compile time
+    const mlLib::FixedLogisticModel<double, 15> fixedModel(model);
+
+    const int repetitions = 200;
+    std::vector<int> dynamicPredictions;
+    std::vector<int> fixedPredictions;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r)
+    {
+        dynamicPredictions = model.predict(xValues);
+    }
+    auto end = std::chrono::steady_clock::now();
+    const double dynamicNs = std::chrono::duration<double, std::nano>(end - start).count() / (repetitions * chunk.numRows);
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r)
+    {
+        fixedPredictions = fixedModel.predict(xRowMajor);
+    }
+    end = std::chrono::steady_clock::now();
+    const double fixedNs = std::chrono::duration<double, std::nano>(end - start).count() / (repetitions * chunk.numRows);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < chunk.numRows; ++i)
+    {
+        mismatches += (dynamicPredictions[i] != fixedPredictions[i]);
+    }
+
+    std::cout << "Per-row latency over " << chunk.numRows << " rows:\n";
+    std::cout << std::setw(26) << "LogisticRegressionModel: " << dynamicNs << " ns\n";
+    std::cout << std::setw(26) << "FixedLogisticModel<15>: " << fixedNs << " ns\n";
+    std::cout << std::setw(26) << "Speedup: " << dynamicNs / fixedNs << "x\n";
+    std::cout << std::setw(26) << "Mismatched predictions: " << mismatches << "\n";
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <filesystem>
+
+// Rows of the histograms built so far
+uint64_t histogramRows()
+{
+    for (const mlLib::InstrumentationStats &stats : mlLib::Instrumentation::getStats())
+    {
+        if (std::string(stats.name) == "GradientBoosting::histogramRows")
+            return stats.count;
+    }
+    return 0;
+}
+
+int main()
+{
+    // Tabular data with interactions and thresholds that a linear model cannot fit
+    const size_t numRows = 100000, numFeatures = 12;
+    std::mt19937 generator(9);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::uniform_int_distribution<int> category(0, 4);
+
+    std::vector<double> features(numRows * numFeatures), labels(numRows);
+    for (size_t i = 0; i < numRows; ++i)
+    {
+        double *row = features.data() + i * numFeatures;
+        for (size_t j = 0; j < numFeatures; ++j)
+        {
+            row[j] = normal(generator);
+        }
+        row[3] = category(generator);
+        const double score = row[0] * row[1] + ((row[2] > 0.5) ? 1.5 : -0.5) + ((row[3] == 2.0) ? 1.0 : 0.0) - 0.3 * row[4] * row[4] + 0.5 * normal(generator);
+        labels[i] = (score > 0.0) ? 1.0 : 0.0;
+    }
+    mlLib::Dataset<double> dataset(std::move(features), std::move(labels), numFeatures);
+    const auto [train, test] = dataset.view().stratifiedSplit(0.2);
+
+    mlLib::GBDTOptions options;
+    options.numTrees = 200;
+
+    // The callback reports the training loss after every tree
+    mlLib::Instrumentation::enable();
+    auto start = std::chrono::steady_clock::now();
+    mlLib::GBDTModel model = mlLib::GradientBoosting(train, options, [](const mlLib::TrainingProgress &progress)
+                                                     {
+                                                         if (progress.iteration % 50 == 0)
+                                                             std::cout << "Tree " << progress.iteration << ": log loss " << progress.loss << "\n"; });
+    auto end = std::chrono::steady_clock::now();
+    mlLib::Instrumentation::disable();
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Trained " << model.getNumTrees() << " trees on " << train.size() << " rows in " << std::chrono::duration<double>(end - start).count() << " s; "
+              << "histograms covered " << static_cast<double>(histogramRows()) / (train.size() * options.numTrees) << " rows per row and tree\n";
+
+    start = std::chrono::steady_clock::now();
+    const mlLib::ClassificationMetrics metrics = mlLib::EvaluateClassification(model, test);
+    end = std::chrono::steady_clock::now();
+    std::cout << "Gradient boosting: accuracy " << metrics.evaluationMetrics.accuracy << "%, F1 score " << metrics.evaluationMetrics.f1Score << "%, scored "
+              << test.size() << " rows in " << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+    mlLib::LogisticRegressionModel linear = mlLib::LogisticRegression(mlLib::LogisticRegressionModel(), train, 0.05, 200, mlLib::OptimizerType::Adam);
+    std::cout << "Logistic regression: accuracy " << mlLib::EvaluateClassification(linear, test).evaluationMetrics.accuracy << "%\n\n";
+
+    // The saved model scores the same rows
+    const std::string modelFile = (std::filesystem::temp_directory_path() / "GBDTModel.bin").string();
+    model.saveBinary(modelFile);
+    mlLib::GBDTModel loadedModel;
+    loadedModel.loadFromFile(modelFile);
+    loadedModel.printInfo();
+    std::cout << "Probability of class 1 for the first test row: " << loadedModel.predict(test.row(0)) << "\n";
+    std::filesystem::remove(modelFile);
+
+    // Heart disease risk, with smaller trees and a lower learning rate on this small dataset
+    mlLib::Dataset<double> heart(mlLib::LoadCSV<double>("examples/DataSet/HeartDisease.csv"));
+    if (heart.getNumRows() == 0)
+    {
+        std::cerr << "Error opening the file!" << std::endl;
+        return 1;
+    }
+
+    const auto [heartTrain, heartTest] = heart.view().stratifiedSplit(0.2);
+    options.numTrees = 100;
+    options.maxLeaves = 8;
+    options.learningRate = 0.05L;
+    const mlLib::GBDTModel heartModel = mlLib::GradientBoosting(heartTrain, options);
+    const std::vector<long double> probabilities = heartModel.predict(heartTest);
+    std::vector<double> actual(heartTest.size());
+    for (size_t i = 0; i < heartTest.size(); ++i)
+    {
+        actual[i] = heartTest.label(i);
+    }
+    std::cout << "\nHeart disease: accuracy " << mlLib::EvaluateClassification(heartModel, heartTest).evaluationMetrics.accuracy << "%, ROC AUC "
+              << mlLib::EvaluateCurves(probabilities, actual).rocAuc << "\n";
+
+    return 0;
+}
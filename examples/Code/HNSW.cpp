@@ -0,0 +1,98 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <filesystem>
+
+// Fraction of the exact neighbours that the approximate results found
+double recall(const std::vector<std::vector<mlLib::Neighbor>> &approximate, const std::vector<std::vector<mlLib::Neighbor>> &exact)
+{
+    size_t found = 0, total = 0;
+    for (size_t q = 0; q < exact.size(); ++q)
+    {
+        for (const mlLib::Neighbor &truth : exact[q])
+        {
+            for (const mlLib::Neighbor &neighbor : approximate[q])
+            {
+                if (neighbor.index == truth.index)
+                {
+                    ++found;
+                    break;
+                }
+            }
+        }
+        total += exact[q].size();
+    }
+    return 100.0 * found / total;
+}
+
+int main()
+{
+    // Embedding-like vectors: noisy points around a few hundred random topic directions
+    const size_t numVectors = 20000, numQueries = 500, numFeatures = 256, numTopics = 200, k = 10;
+    std::mt19937 generator(5);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+
+    std::vector<float> topics(numTopics * numFeatures);
+    for (auto &value : topics)
+    {
+        value = normal(generator);
+    }
+    auto embeddings = [&](size_t numRows)
+    {
+        std::vector<float> values(numRows * numFeatures);
+        for (size_t i = 0; i < numRows; ++i)
+        {
+            const size_t topic = generator() % numTopics;
+            for (size_t j = 0; j < numFeatures; ++j)
+            {
+                values[i * numFeatures + j] = topics[topic * numFeatures + j] + 0.8f * normal(generator);
+            }
+        }
+        return values;
+    };
+    const std::vector<float> vectors = embeddings(numVectors), queries = embeddings(numQueries);
+    mlLib::DatasetView<float> vectorView(vectors.data(), nullptr, numVectors, numFeatures);
+    mlLib::DatasetView<float> queryView(queries.data(), nullptr, numQueries, numFeatures);
+
+    std::cout << std::fixed << std::setprecision(1);
+    for (const mlLib::VectorMetric metric : {mlLib::CosineDistance, mlLib::L2Distance})
+    {
+        mlLib::HNSWOptions options;
+        options.metric = metric;
+        options.efConstruction = 100;
+
+        auto start = std::chrono::steady_clock::now();
+        mlLib::HNSWIndex index(vectorView, options);
+        auto built = std::chrono::steady_clock::now();
+        const std::vector<std::vector<mlLib::Neighbor>> exact = index.exactQuery(queryView, k);
+        auto scanned = std::chrono::steady_clock::now();
+
+        std::cout << ((metric == mlLib::CosineDistance) ? "Cosine" : "L2") << ": " << numVectors << " vectors of " << numFeatures << " dimensions indexed in "
+                  << std::chrono::duration<double>(built - start).count() << " s, " << index.getMaxLevel() + 1 << " layers\n";
+        std::cout << "  brute force: " << std::setw(8) << numQueries / std::chrono::duration<double>(scanned - built).count() << " queries/s\n";
+
+        // Larger efSearch trades latency for recall
+        for (const size_t efSearch : {10, 20, 40, 80, 160})
+        {
+            auto queryStart = std::chrono::steady_clock::now();
+            const std::vector<std::vector<mlLib::Neighbor>> approximate = index.query(queryView, k, efSearch);
+            auto queryEnd = std::chrono::steady_clock::now();
+            std::cout << "  efSearch " << std::setw(3) << efSearch << ": " << std::setw(8) << numQueries / std::chrono::duration<double>(queryEnd - queryStart).count()
+                      << " queries/s, recall@" << k << " " << recall(approximate, exact) << "%\n";
+        }
+
+        // The saved graph is mapped back in without copying and answers the same queries
+        const std::string filename = (std::filesystem::temp_directory_path() / "HNSWIndex.bin").string();
+        index.save(filename);
+        mlLib::HNSWIndex mapped;
+        if (mapped.open(filename))
+        {
+            std::cout << "  reopened from " << filename << " (" << std::filesystem::file_size(filename) / 1024 << " KiB, mapped), recall@" << k << " "
+                      << recall(mapped.query(queryView, k), exact) << "% at efSearch " << mapped.getOptions().efSearch << "\n";
+        }
+        std::filesystem::remove(filename);
+    }
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include "../../include/mlLib.hpp"
+#include <iostream>
+#include <chrono>
+
+// Half-precision storage type; arithmetic happens in float through the implicit conversions.
+// Conversion truncates the mantissa and flushes subnormals to zero, which is enough for features.
+struct Half
+{
+    uint16_t bits = 0;
+
+    Half() = default;
+    Half(float value)
+    {
+        const uint32_t f = std::bit_cast<uint32_t>(value);
+        const uint16_t sign = static_cast<uint16_t>((f >> 16) & 0x8000);
+        const int exponent = static_cast<int>((f >> 23) & 0xff) - 127 + 15;
+        if (exponent <= 0)
+            bits = sign;
+        else if (exponent >= 31)
+            bits = sign | 0x7c00;
+        else
+            bits = sign | static_cast<uint16_t>(exponent << 10) | static_cast<uint16_t>((f >> 13) & 0x3ff);
+    }
+
+    operator float() const
+    {
+        const uint32_t sign = static_cast<uint32_t>(bits & 0x8000) << 16;
+        const uint32_t exponent = (bits >> 10) & 0x1f;
+        const uint32_t mantissa = bits & 0x3ff;
+        if (exponent == 0)
+            return std::bit_cast<float>(sign);
+        if (exponent == 31)
+            return std::bit_cast<float>(sign | 0x7f800000);
+        return std::bit_cast<float>(sign | ((exponent - 15 + 127) << 23) | (mantissa << 13));
+    }
+};
+
+int main()
+{
+    mlLib::CSVData<float> csv = mlLib::LoadCSV<float>("examples/DataSet/HeartDisease.csv");
+    if (csv.numRows == 0)
+    {
+        std::cerr << "Error opening the file!" << std::endl;
+        return 1;
+    }
+
+    // The same data stored as float and as Half, which the precompiled library has no instantiations for
+    std::vector<Half> halfFeatures(csv.features.begin(), csv.features.end());
+    std::vector<Half> halfLabels(csv.labels.begin(), csv.labels.end());
+    mlLib::Dataset<Half> halfDataset(std::move(halfFeatures), std::move(halfLabels), csv.numFeatures);
+    mlLib::Dataset<float> floatDataset(std::move(csv));
+
+    std::cout << "Feature storage: " << floatDataset.getFeatures().size_bytes() << " bytes as float, "
+              << halfDataset.getFeatures().size_bytes() << " bytes as Half\n";
+
+    // vecAlg and stat templates instantiate for Half like for any built-in type
+    const std::vector<float> firstRow(floatDataset.view().row(0).begin(), floatDataset.view().row(0).end());
+    const std::vector<Half> firstHalfRow(firstRow.begin(), firstRow.end());
+    std::cout << "Magnitude of the first row: " << vecAlg::Magnitude(firstRow) << " (float), " << vecAlg::Magnitude(firstHalfRow) << " (Half)\n";
+    std::cout << "Mean of the first row: " << stat::Mean(firstRow) << " (float), " << stat::Mean(firstHalfRow) << " (Half)\n\n";
+
+    for (const auto &[name, train] : {std::pair{"float", 0}, std::pair{"Half", 1}})
+    {
+        auto start = std::chrono::steady_clock::now();
+        mlLib::LogisticRegressionModel model = (train == 0)
+                                                   ? mlLib::LogisticRegression(mlLib::LogisticRegressionModel(), floatDataset.view(), 0.01, 300, mlLib::OptimizerType::Adam)
+                                                   : mlLib::LogisticRegression(mlLib::LogisticRegressionModel(), halfDataset.view(), 0.01, 300, mlLib::OptimizerType::Adam);
+        auto end = std::chrono::steady_clock::now();
+
+        const long double accuracy = (train == 0) ? mlLib::EvaluateClassification(model, floatDataset.view()).evaluationMetrics.accuracy
+                                                  : mlLib::EvaluateClassification(model, halfDataset.view()).evaluationMetrics.accuracy;
+        std::cout << "Trained on " << name << " in " << std::chrono::duration<double, std::milli>(end - start).count() << " ms, accuracy " << accuracy << "%\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+int main()
+{
+    // Synthetic feature table: rows scattered around numBlobs random centers
+    const size_t numRows = 50000, numFeatures = 8, numBlobs = 10;
+    std::mt19937 generator(7);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    std::vector<double> centers(numBlobs * numFeatures);
+    for (auto &value : centers)
+    {
+        value = 6.0 * normal(generator);
+    }
+
+    std::vector<double> features(numRows * numFeatures);
+    for (size_t i = 0; i < numRows; ++i)
+    {
+        for (size_t j = 0; j < numFeatures; ++j)
+        {
+            features[i * numFeatures + j] = centers[(i % numBlobs) * numFeatures + j] + 3.0 * normal(generator);
+        }
+    }
+    mlLib::Dataset<double> dataset(std::move(features), std::vector<double>(numRows, 0.0), numFeatures);
+
+    // The instrumentation counts the row-to-centroid distances each algorithm computes
+    mlLib::Instrumentation::enable();
+    mlLib::KMeansOptions options;
+    options.numClusters = 2 * numBlobs;
+
+    std::cout << std::fixed << std::setprecision(1);
+    const std::pair<mlLib::KMeansAlgorithm, const char *> algorithms[] = {{mlLib::Lloyd, "Lloyd"}, {mlLib::Hamerly, "Hamerly"}, {mlLib::Elkan, "Elkan"}};
+    for (const auto &[algorithm, name] : algorithms)
+    {
+        mlLib::Instrumentation::reset();
+        options.algorithm = algorithm;
+
+        auto start = std::chrono::steady_clock::now();
+        mlLib::KMeansModel model = mlLib::KMeans(dataset.view(), options);
+        auto end = std::chrono::steady_clock::now();
+
+        uint64_t distances = 0;
+        for (const mlLib::InstrumentationStats &stats : mlLib::Instrumentation::getStats())
+        {
+            if (std::string(stats.name) == "KMeans::distances")
+                distances = stats.count;
+        }
+        std::cout << std::setw(8) << name << ": " << model.getIterations() << " iterations, inertia " << model.getInertia() << ", "
+                  << distances << " distances, " << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+    }
+    mlLib::Instrumentation::disable();
+
+    // Mini-batch k-means only looks at batchSize rows per iteration
+    options.batchSize = 1024;
+    options.maxIterations = 200;
+    auto start = std::chrono::steady_clock::now();
+    mlLib::KMeansModel model = mlLib::MiniBatchKMeans(dataset.view(), options);
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "Mini-batch: " << model.getIterations() << " batches, inertia " << model.getInertia() << ", "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n\n";
+
+    model.saveToFile("examples/Models/KMeansModel.txt");
+
+    mlLib::KMeansModel loadedModel;
+    loadedModel.loadFromFile("examples/Models/KMeansModel.txt");
+    const std::vector<size_t> clusters = loadedModel.predict(dataset.view());
+    std::cout << "The first rows belong to clusters:";
+    for (size_t i = 0; i < 10; ++i)
+    {
+        std::cout << " " << clusters[i];
+    }
+    std::cout << "\n";
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+struct LoadResult
+{
+    std::vector<double> latencies; // Microseconds, sorted
+    double seconds = 0.0;
+};
+
+// Each connection keeps `depth` requests in flight until it has sent numRequests of them
+LoadResult runLoad(const std::string &socketPath, const mlLib::CSVData<float> &data, size_t numConnections, size_t depth, size_t numRequests)
+{
+    std::vector<std::vector<double>> latencies(numConnections);
+    std::vector<std::thread> clients;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t c = 0; c < numConnections; ++c)
+    {
+        clients.emplace_back([&, c]
+                             {
+                                 mlLib::ScoringClient client;
+                                 if (!client.connect(socketPath))
+                                 {
+                                     std::cerr << "Unable to connect to " << socketPath << std::endl;
+                                     return;
+                                 }
+
+                                 std::vector<std::chrono::steady_clock::time_point> sendTimes(numRequests);
+                                 auto sendRequest = [&](uint32_t id)
+                                 {
+                                     const size_t row = (c * numRequests + id) % data.numRows;
+                                     sendTimes[id] = std::chrono::steady_clock::now();
+                                     return client.send(id, std::span<const float>(&data.features[row * data.numFeatures], data.numFeatures));
+                                 };
+
+                                 uint32_t sent = 0;
+                                 for (; sent < std::min(depth, numRequests); ++sent)
+                                     sendRequest(sent);
+
+                                 mlLib::ScoringResponse response;
+                                 for (size_t received = 0; received < numRequests && client.receive(response); ++received)
+                                 {
+                                     latencies[c].push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - sendTimes[response.requestId]).count());
+                                     if (sent < numRequests)
+                                         sendRequest(sent++);
+                                 } });
+    }
+    for (auto &client : clients)
+    {
+        client.join();
+    }
+
+    LoadResult result;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (const auto &connectionLatencies : latencies)
+    {
+        result.latencies.insert(result.latencies.end(), connectionLatencies.begin(), connectionLatencies.end());
+    }
+    std::sort(result.latencies.begin(), result.latencies.end());
+    return result;
+}
+
+void printResult(const std::string &label, const LoadResult &result)
+{
+    if (result.latencies.empty())
+    {
+        std::cout << std::setw(24) << label << ": no responses\n";
+        return;
+    }
+
+    std::cout << std::setw(24) << label << ": " << std::setw(9) << result.latencies.size() / result.seconds << " req/s, p50 "
+              << std::setw(7) << result.latencies[result.latencies.size() / 2] << " us, p99 "
+              << std::setw(7) << result.latencies[result.latencies.size() * 99 / 100] << " us\n";
+}
+
+// Usage: LoadGenerator [socketPath] [numConnections] [depth] [requestsPerConnection]
+// Without a socket path, serves the model in-process once per batching setting and compares them.
+int main(int argc, char *argv[])
+{
+    const size_t numConnections = (argc > 2) ? std::stoul(argv[2]) : 8;
+    const size_t depth = (argc > 3) ? std::stoul(argv[3]) : 8;
+    const size_t numRequests = (argc > 4) ? std::stoul(argv[4]) : 2000;
+
+    mlLib::CSVData<float> data = mlLib::LoadCSV<float>("examples/DataSet/HeartDisease.csv");
+    if (data.numRows == 0)
+    {
+        std::cerr << "Error opening the file!" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << numConnections << " connections x " << depth << " requests in flight, " << numRequests << " requests each\n";
+
+    if (argc > 1)
+    {
+        printResult(argv[1], runLoad(argv[1], data, numConnections, depth, numRequests));
+        return 0;
+    }
+
+    mlLib::ModelRegistry registry;
+    if (!registry.add("default", "examples/Models/LogRegModel.txt"))
+    {
+        std::cerr << "Error loading the model!" << std::endl;
+        return 1;
+    }
+
+    const std::vector<std::pair<size_t, long>> settings = {{1, 0}, {16, 100}, {64, 500}, {256, 2000}};
+    for (const auto &[maxBatchSize, maxDelay] : settings)
+    {
+        mlLib::ScoringServerOptions options;
+        options.socketPath = "/tmp/mllib-loadgen.sock";
+        options.maxBatchSize = maxBatchSize;
+        options.maxDelay = std::chrono::microseconds(maxDelay);
+
+        mlLib::ScoringServer server(registry, options);
+        if (!server.start())
+        {
+            return 1;
+        }
+
+        LoadResult result = runLoad(options.socketPath, data, numConnections, depth, numRequests);
+        server.stop();
+
+        mlLib::ScoringServerStats stats = server.getStats();
+        printResult("batch " + std::to_string(maxBatchSize) + ", delay " + std::to_string(maxDelay) + " us", result);
+        std::cout << std::setw(24) << "" << "  mean batch size " << std::setprecision(1) << static_cast<double>(stats.requests) / stats.batches << std::setprecision(0) << "\n";
+    }
+
+    return 0;
+}
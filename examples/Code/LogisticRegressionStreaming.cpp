@@ -0,0 +1,45 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+
+int main()
+{
+    // Stream the CSV in chunks of 512 rows: 15 feature columns followed by the label column
+    mlLib::ChunkedDataReader reader("examples/DataSet/HeartDisease.csv", mlLib::DataFormat::CSV, 15, 512);
+
+    if (!reader.isOpen())
+    {
+        std::cerr << "Error opening the file!" << std::endl;
+        return 1;
+    }
+
+    mlLib::LogisticRegressionModel model = mlLib::LogisticRegressionStreaming(reader, 0.0005, 1000);
+
+    // Score the data once more, chunk by chunk, so the full dataset is never held in memory
+    reader.reset();
+    mlLib::DataChunk chunk;
+    size_t correctPredictions = 0;
+    size_t totalRows = 0;
+
+    while (reader.readChunk(chunk) > 0)
+    {
+        std::vector<std::vector<long double>> xChunk(chunk.numRows);
+        for (size_t i = 0; i < chunk.numRows; ++i)
+        {
+            xChunk[i].assign(chunk.features.begin() + i * 15, chunk.features.begin() + (i + 1) * 15);
+        }
+
+        std::vector<int> predictedYValues = model.predict(xChunk);
+        for (size_t i = 0; i < chunk.numRows; ++i)
+        {
+            correctPredictions += (predictedYValues[i] == static_cast<int>(chunk.labels[i]));
+        }
+        totalRows += chunk.numRows;
+    }
+
+    std::cout << "Rows = " << totalRows << "\n";
+    std::cout << "Accuracy = " << static_cast<long double>(correctPredictions) / totalRows * 100.0 << "%\n";
+
+    model.printInfo();
+    return 0;
+}
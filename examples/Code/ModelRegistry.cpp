@@ -0,0 +1,108 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <filesystem>
+
+// Score rows with the registry's current model until stop is set, recording the latency of each call
+void scoreUntilStopped(const mlLib::ModelRegistry &registry, const mlLib::CSVData<double> &data, const std::atomic<bool> &stop, std::vector<double> &latencies)
+{
+    size_t row = 0;
+    while (!stop.load(std::memory_order_relaxed))
+    {
+        auto start = std::chrono::steady_clock::now();
+        mlLib::ModelRegistry::ModelPtr model = registry.get("heart");
+        volatile long double probability = model->predictProbability(std::span<const double>(&data.features[row * data.numFeatures], data.numFeatures));
+        (void)probability;
+        auto end = std::chrono::steady_clock::now();
+
+        latencies.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        row = (row + 1) % data.numRows;
+    }
+}
+
+// Run numThreads scoring threads for the given duration, optionally replacing the model file every reloadInterval
+std::vector<double> runScoring(const mlLib::ModelRegistry &registry, const mlLib::CSVData<double> &data, size_t numThreads, std::chrono::milliseconds duration,
+                               const mlLib::LogisticRegressionModel *baseModel, std::chrono::milliseconds reloadInterval)
+{
+    std::atomic<bool> stop(false);
+    std::vector<std::vector<double>> latencies(numThreads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back(scoreUntilStopped, std::cref(registry), std::cref(data), std::cref(stop), std::ref(latencies[t]));
+    }
+
+    auto end = std::chrono::steady_clock::now() + duration;
+    long double scale = 1.0;
+    while (std::chrono::steady_clock::now() < end)
+    {
+        std::this_thread::sleep_for(reloadInterval);
+        if (baseModel != nullptr)
+        {
+            // Publish a new version: write it aside, then rename it over the watched file
+            std::vector<long double> coefficients = baseModel->getCoefficients();
+            scale *= 0.99;
+            for (auto &coefficient : coefficients)
+            {
+                coefficient *= scale;
+            }
+            mlLib::LogisticRegressionModel(coefficients).saveBinary("examples/Models/LiveModel.bin.tmp");
+            std::filesystem::rename("examples/Models/LiveModel.bin.tmp", "examples/Models/LiveModel.bin");
+        }
+    }
+
+    stop = true;
+    std::vector<double> all;
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+        threads[t].join();
+        all.insert(all.end(), latencies[t].begin(), latencies[t].end());
+    }
+    std::sort(all.begin(), all.end());
+    return all;
+}
+
+void printLatencies(const std::string &label, const std::vector<double> &latencies)
+{
+    std::cout << std::setw(16) << label << ": " << latencies.size() << " predictions, p50 " << latencies[latencies.size() / 2]
+              << " ns, p99 " << latencies[latencies.size() * 99 / 100] << " ns, p99.9 " << latencies[latencies.size() * 999 / 1000]
+              << " ns, max " << latencies.back() << " ns\n";
+}
+
+int main()
+{
+    mlLib::CSVData<double> data = mlLib::LoadCSV<double>("examples/DataSet/HeartDisease.csv");
+    if (data.numRows == 0)
+    {
+        std::cerr << "Error opening the file!" << std::endl;
+        return 1;
+    }
+
+    mlLib::LogisticRegressionModel baseModel;
+    baseModel.loadFromFile("examples/Models/LogRegModel.txt");
+    baseModel.saveBinary("examples/Models/LiveModel.bin");
+
+    mlLib::ModelRegistry registry(std::chrono::milliseconds(5));
+    auto validator = [&data](const mlLib::LogisticRegressionModel &model) { return model.getCoefficients().size() == data.numFeatures + 1; };
+    if (!registry.add("heart", "examples/Models/LiveModel.bin", validator))
+    {
+        std::cerr << "Error loading the model!" << std::endl;
+        return 1;
+    }
+    registry.start();
+
+    const size_t numThreads = 4;
+    std::cout << std::fixed << std::setprecision(0);
+    printLatencies("No reloads", runScoring(registry, data, numThreads, std::chrono::milliseconds(1000), nullptr, std::chrono::milliseconds(20)));
+    printLatencies("Reload / 20 ms", runScoring(registry, data, numThreads, std::chrono::milliseconds(1000), &baseModel, std::chrono::milliseconds(20)));
+
+    registry.stop();
+
+    mlLib::ModelRegistryStats stats = registry.getStats("heart");
+    std::cout << "\nVersion " << stats.version << " after " << stats.reloads << " reloads (" << stats.failedReloads << " failed)\n"
+              << "Last load took " << std::chrono::duration<double, std::micro>(stats.lastLoadTime).count() << " us, "
+              << "last swap took " << stats.lastSwapTime.count() << " ns\n";
+
+    return 0;
+}
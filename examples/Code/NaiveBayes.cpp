@@ -0,0 +1,90 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <filesystem>
+
+int main()
+{
+    // Word counts of short documents from four topics; each topic uses its own part of the vocabulary more often
+    const size_t numDocuments = 40000, vocabularySize = 2000, numTopics = 4, wordsPerDocument = 40;
+    std::mt19937 generator(4);
+    std::uniform_int_distribution<size_t> anyWord(0, vocabularySize - 1), topicWord(0, vocabularySize / numTopics - 1);
+    std::bernoulli_distribution fromTopic(0.15);
+
+    std::vector<float> counts(numDocuments * vocabularySize, 0.0f), topics(numDocuments);
+    for (size_t i = 0; i < numDocuments; ++i)
+    {
+        const size_t topic = i % numTopics;
+        topics[i] = static_cast<float>(topic);
+        for (size_t w = 0; w < wordsPerDocument; ++w)
+        {
+            const size_t word = fromTopic(generator) ? topic * (vocabularySize / numTopics) + topicWord(generator) : anyWord(generator);
+            counts[i * vocabularySize + word] += 1.0f;
+        }
+    }
+    mlLib::Dataset<float> documents(std::move(counts), std::move(topics), vocabularySize);
+    const auto [train, test] = documents.view().shuffled(1).split(0.2);
+
+    std::cout << std::fixed << std::setprecision(2);
+    const std::pair<mlLib::NaiveBayesType, const char *> types[] = {{mlLib::MultinomialNaiveBayes, "Multinomial"}, {mlLib::BernoulliNaiveBayes, "Bernoulli"}};
+    for (const auto &[type, name] : types)
+    {
+        mlLib::NaiveBayesOptions options;
+        options.type = type;
+
+        auto start = std::chrono::steady_clock::now();
+        const mlLib::NaiveBayesModel model = mlLib::NaiveBayes(train, options);
+        auto trained = std::chrono::steady_clock::now();
+        const std::vector<int> predictions = model.predict(test);
+        auto end = std::chrono::steady_clock::now();
+
+        size_t correct = 0;
+        for (size_t i = 0; i < test.size(); ++i)
+        {
+            correct += (predictions[i] == static_cast<int>(test.label(i)));
+        }
+        std::cout << std::setw(11) << name << ": trained on " << train.size() << " documents in " << std::chrono::duration<double, std::milli>(trained - start).count()
+                  << " ms, scored " << test.size() << " in " << std::chrono::duration<double, std::milli>(end - trained).count() << " ms, accuracy "
+                  << 100.0 * correct / test.size() << "%\n";
+    }
+
+    // Models trained on separate shards merge into the model of all rows
+    mlLib::NaiveBayesOptions options;
+    options.type = mlLib::MultinomialNaiveBayes;
+    mlLib::NaiveBayesModel merged(options);
+    for (const mlLib::DatasetView<float> &shard : train.shards(4))
+    {
+        merged.merge(mlLib::NaiveBayes(shard, options));
+    }
+    const std::vector<long double> probabilities = merged.predictProbabilities(test.rows(0, 1));
+    std::cout << "Topic probabilities of the first test document from 4 merged shards:";
+    for (const long double probability : probabilities)
+    {
+        std::cout << " " << probability;
+    }
+    std::cout << "\n\n";
+
+    // Gaussian naive Bayes on the heart disease dataset, trained in two batches
+    mlLib::Dataset<double> heart(mlLib::LoadCSV<double>("examples/DataSet/HeartDisease.csv"));
+    if (heart.getNumRows() == 0)
+    {
+        std::cerr << "Error opening the file!" << std::endl;
+        return 1;
+    }
+
+    const auto [heartTrain, heartTest] = heart.view().stratifiedSplit(0.2);
+    mlLib::NaiveBayesModel gaussian;
+    gaussian.partialFit(heartTrain.rows(0, heartTrain.size() / 2));
+    gaussian.partialFit(heartTrain.rows(heartTrain.size() / 2, heartTrain.size()));
+    std::cout << "Gaussian naive Bayes on heart disease: accuracy " << mlLib::EvaluateClassification(gaussian, heartTest).evaluationMetrics.accuracy << "%\n";
+
+    const std::string modelFile = (std::filesystem::temp_directory_path() / "NaiveBayesModel.bin").string();
+    gaussian.saveBinary(modelFile);
+    mlLib::NaiveBayesModel loadedModel;
+    loadedModel.loadFromFile(modelFile);
+    loadedModel.printInfo();
+    std::filesystem::remove(modelFile);
+
+    return 0;
+}
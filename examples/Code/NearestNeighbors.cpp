@@ -0,0 +1,95 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+// Distances computed by the index since the last reset
+uint64_t distanceCount()
+{
+    for (const mlLib::InstrumentationStats &stats : mlLib::Instrumentation::getStats())
+    {
+        if (std::string(stats.name) == "NeighborIndex::distances")
+            return stats.count;
+    }
+    return 0;
+}
+
+int main()
+{
+    // Low-dimensional points, e.g. locations, and a batch of query points
+    const size_t numPoints = 200000, numQueries = 2000, numFeatures = 3, k = 10;
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<double> uniform(0.0, 100.0);
+
+    std::vector<double> points(numPoints * numFeatures), queries(numQueries * numFeatures);
+    for (auto &value : points)
+    {
+        value = uniform(generator);
+    }
+    for (auto &value : queries)
+    {
+        value = uniform(generator);
+    }
+    mlLib::DatasetView<double> pointView(points.data(), nullptr, numPoints, numFeatures);
+    mlLib::DatasetView<double> queryView(queries.data(), nullptr, numQueries, numFeatures);
+
+    mlLib::Instrumentation::enable();
+    std::cout << std::fixed << std::setprecision(1);
+
+    const std::pair<mlLib::NeighborIndexType, const char *> types[] = {{mlLib::KDTree, "KD tree"}, {mlLib::BallTree, "Ball tree"}};
+    for (const auto &[type, name] : types)
+    {
+        mlLib::NeighborIndexOptions options;
+        options.type = type;
+
+        auto start = std::chrono::steady_clock::now();
+        mlLib::NeighborIndex index(pointView, options);
+        auto built = std::chrono::steady_clock::now();
+
+        mlLib::Instrumentation::reset();
+        const std::vector<std::vector<mlLib::Neighbor>> neighbors = index.query(queryView, k);
+        auto end = std::chrono::steady_clock::now();
+
+        std::cout << std::setw(9) << name << ": built " << index.getNumNodes() << " nodes in " << std::chrono::duration<double, std::milli>(built - start).count()
+                  << " ms, " << std::chrono::duration<double, std::micro>(end - built).count() / numQueries << " us and "
+                  << distanceCount() / numQueries << " distances per " << k << "-NN query (brute force: " << numPoints << ")\n";
+
+        mlLib::Instrumentation::reset();
+        const std::vector<std::vector<mlLib::Neighbor>> inRadius = index.queryRadius(queryView, 5.0L);
+        size_t found = 0;
+        for (const auto &result : inRadius)
+        {
+            found += result.size();
+        }
+        std::cout << std::setw(9) << "" << "  " << static_cast<double>(found) / numQueries << " points within radius 5 per query, "
+                  << distanceCount() / numQueries << " distances per query\n";
+    }
+
+    std::cout << "\nNearest point to the first query: row " << mlLib::NeighborIndex(pointView).query(queryView.row(0), 1)[0].index << "\n\n";
+    mlLib::Instrumentation::disable();
+
+    // KNN classification of the heart disease dataset
+    mlLib::Dataset<double> dataset(mlLib::LoadCSV<double>("examples/DataSet/HeartDisease.csv"));
+    if (dataset.getNumRows() == 0)
+    {
+        std::cerr << "Error opening the file!" << std::endl;
+        return 1;
+    }
+
+    const auto [train, test] = dataset.view().stratifiedSplit(0.2);
+    for (const bool weighted : {false, true})
+    {
+        mlLib::KNNClassifier classifier(train, 15, weighted);
+        const std::vector<int> predictions = classifier.predict(test);
+
+        std::vector<double> actual(test.size());
+        for (size_t i = 0; i < test.size(); ++i)
+        {
+            actual[i] = test.label(i);
+        }
+        const mlLib::ClassificationMetrics metrics = mlLib::EvaluateClassification(std::span<const double>(actual), std::span<const int>(predictions));
+        std::cout << "15-NN classifier" << (weighted ? " (distance weighted)" : "") << ": accuracy " << metrics.evaluationMetrics.accuracy << "%\n";
+    }
+
+    return 0;
+}
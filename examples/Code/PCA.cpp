@@ -0,0 +1,77 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <filesystem>
+
+int main()
+{
+    // Wide feature table driven by a few latent factors plus noise; the label depends on the first two factors
+    const size_t numRows = 20000, numFeatures = 300, numFactors = 8;
+    std::mt19937 generator(3);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    std::vector<double> loadings(numFactors * numFeatures);
+    for (auto &value : loadings)
+    {
+        value = normal(generator);
+    }
+
+    std::vector<double> features(numRows * numFeatures), labels(numRows);
+    std::vector<double> factors(numFactors);
+    for (size_t i = 0; i < numRows; ++i)
+    {
+        for (size_t f = 0; f < numFactors; ++f)
+        {
+            factors[f] = normal(generator) * (numFactors - f);
+        }
+        for (size_t j = 0; j < numFeatures; ++j)
+        {
+            double value = 10.0 + 2.0 * normal(generator);
+            for (size_t f = 0; f < numFactors; ++f)
+            {
+                value += factors[f] * loadings[f * numFeatures + j];
+            }
+            features[i * numFeatures + j] = value;
+        }
+        labels[i] = (factors[0] - factors[1] > 0.0) ? 1.0 : 0.0;
+    }
+    mlLib::Dataset<double> dataset(std::move(features), std::move(labels), numFeatures);
+
+    mlLib::PCAOptions options;
+    options.numComponents = 10;
+
+    auto start = std::chrono::steady_clock::now();
+    mlLib::PCAModel model = mlLib::PCA(dataset.view(), options);
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "Fitted " << options.numComponents << " of " << numFeatures << " components on " << numRows << " rows in "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+    std::cout << std::fixed << std::setprecision(2) << "Explained variance ratio:";
+    long double cumulative = 0.0L;
+    for (const long double ratio : model.getExplainedVarianceRatio())
+    {
+        cumulative += ratio;
+        std::cout << " " << 100.0L * ratio << "%";
+    }
+    std::cout << " (" << 100.0L * cumulative << "% in total)\n";
+
+    // Logistic regression on the reduced features
+    start = std::chrono::steady_clock::now();
+    const mlLib::Dataset<double> reduced = model.transform(dataset.view());
+    end = std::chrono::steady_clock::now();
+    std::cout << "Transformed to " << reduced.getNumFeatures() << " features in " << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+    const auto [train, test] = reduced.view().split(0.2);
+    mlLib::LogisticRegressionModel classifier = mlLib::LogisticRegression(mlLib::LogisticRegressionModel(), train, 0.05, 300, mlLib::OptimizerType::Adam);
+    std::cout << "Logistic regression on the components: accuracy " << mlLib::EvaluateClassification(classifier, test).evaluationMetrics.accuracy << "%\n";
+
+    const std::string modelFile = (std::filesystem::temp_directory_path() / "PCAModel.bin").string();
+    model.saveBinary(modelFile);
+    mlLib::PCAModel loadedModel;
+    loadedModel.loadFromFile(modelFile);
+    const std::vector<long double> coordinates = loadedModel.transform(dataset.view().row(0));
+    std::cout << "First row along the first components: " << coordinates[0] << " " << coordinates[1] << "\n";
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <atomic>
+
+int main()
+{
+    // Query and catalogue vectors around a few hundred random directions, like text embeddings
+    const size_t numQueries = 2000, numItems = 20000, numFeatures = 128, numTopics = 300, k = 5;
+    std::mt19937 generator(8);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+
+    std::vector<float> topics(numTopics * numFeatures);
+    for (auto &value : topics)
+    {
+        value = normal(generator);
+    }
+    auto embeddings = [&](size_t numRows)
+    {
+        std::vector<float> values(numRows * numFeatures);
+        for (size_t i = 0; i < numRows; ++i)
+        {
+            const size_t topic = generator() % numTopics;
+            for (size_t j = 0; j < numFeatures; ++j)
+            {
+                values[i * numFeatures + j] = topics[topic * numFeatures + j] + 0.7f * normal(generator);
+            }
+        }
+        return values;
+    };
+    const std::vector<float> queries = embeddings(numQueries), items = embeddings(numItems);
+    mlLib::DatasetView<float> queryView(queries.data(), nullptr, numQueries, numFeatures);
+    mlLib::DatasetView<float> itemView(items.data(), nullptr, numItems, numFeatures);
+
+    std::cout << std::fixed << std::setprecision(3);
+
+    // One angle at a time: one call per pair
+    auto start = std::chrono::steady_clock::now();
+    const size_t numSampled = 20;
+    std::vector<float> query(numFeatures), item(numFeatures);
+    size_t nearestItem = 0;
+    long double smallestAngle = 10.0L;
+    for (size_t q = 0; q < numSampled; ++q)
+    {
+        query.assign(queryView.row(q).begin(), queryView.row(q).end());
+        for (size_t i = 0; i < numItems; ++i)
+        {
+            item.assign(itemView.row(i).begin(), itemView.row(i).end());
+            const long double angle = vecAlg::Angle(query, item, vecAlg::Radians);
+            if (q == 0 && angle < smallestAngle)
+            {
+                smallestAngle = angle;
+                nearestItem = i;
+            }
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    const double pairwiseRate = numSampled * numItems / std::chrono::duration<double>(end - start).count();
+    std::cout << "vecAlg::Angle:     " << std::setw(12) << pairwiseRate / 1e6 << " M pairs/s\n";
+
+    // All pairs at once, kept as the k nearest items of every query
+    for (const mlLib::VectorMetric metric : {mlLib::CosineDistance, mlLib::L2Distance, mlLib::ManhattanDistance})
+    {
+        start = std::chrono::steady_clock::now();
+        const std::vector<std::vector<mlLib::Neighbor>> nearest = mlLib::PairwiseNearest(queryView, itemView, k, metric);
+        end = std::chrono::steady_clock::now();
+
+        const char *name = (metric == mlLib::CosineDistance) ? "cosine" : (metric == mlLib::L2Distance) ? "Euclidean" : "Manhattan";
+        std::cout << "PairwiseNearest, " << std::setw(9) << name << ": " << std::setw(8) << numQueries * numItems / std::chrono::duration<double>(end - start).count() / 1e6
+                  << " M pairs/s, nearest item of query 0: " << nearest[0][0].index << " at " << nearest[0][0].distance << "\n";
+    }
+    std::cout << "Smallest angle of query 0: item " << nearestItem << " at " << smallestAngle << " radians\n";
+
+    // The tiles can be consumed without keeping the matrix, e.g. counting the close pairs
+    std::atomic<size_t> closePairs{0};
+    mlLib::PairwiseDistanceTiles(queryView, itemView, mlLib::CosineDistance, [&](const mlLib::DistanceTile &tile)
+                                 {
+                                     size_t count = 0;
+                                     for (size_t i = tile.rowBegin; i < tile.rowEnd; ++i)
+                                     {
+                                         for (size_t j = tile.columnBegin; j < tile.columnEnd; ++j)
+                                         {
+                                             count += (tile.at(i, j) < 0.25);
+                                         }
+                                     }
+                                     closePairs += count; });
+    std::cout << closePairs << " of " << numQueries * numItems << " pairs have a cosine distance below 0.25\n";
+
+    // A small full matrix
+    const std::vector<double> matrix = mlLib::PairwiseDistances(queryView.rows(0, 3), queryView.rows(0, 3), mlLib::L2Distance);
+    std::cout << "Euclidean distances of the first 3 queries:\n";
+    for (size_t i = 0; i < 3; ++i)
+    {
+        for (size_t j = 0; j < 3; ++j)
+        {
+            std::cout << std::setw(10) << matrix[i * 3 + j];
+        }
+        std::cout << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,45 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+
+int main()
+{
+    // Read the whole dataset as a single chunk
+    mlLib::ChunkedDataReader reader("examples/DataSet/HeartDisease.csv", mlLib::DataFormat::CSV, 15, 8192);
+    mlLib::DataChunk chunk;
+
+    if (reader.readChunk(chunk) == 0)
+    {
+        std::cerr << "Error opening the file!" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::vector<long double>> xValues(chunk.numRows);
+    std::vector<long double> yValues(chunk.labels.begin(), chunk.labels.begin() + chunk.numRows);
+    for (size_t i = 0; i < chunk.numRows; ++i)
+    {
+        xValues[i].assign(chunk.features.begin() + i * 15, chunk.features.begin() + (i + 1) * 15);
+    }
+
+    mlLib::LogisticRegressionModel model;
+    model.loadFromFile("examples/Models/LogRegModel.txt");
+
+    // Calibrate the input ranges on the first 1000 rows
+    std::vector<std::vector<long double>> calibrationXValues(xValues.begin(), xValues.begin() + 1000);
+    mlLib::QuantizedLogisticRegressionModel quantizedModel = mlLib::QuantizeLogisticRegression(model, calibrationXValues);
+
+    mlLib::QuantizationReport report = mlLib::EvaluateQuantization(model, quantizedModel, xValues, yValues);
+
+    std::cout << "Quantization Report:\n";
+    std::cout << std::setw(22) << "Float Accuracy: " << report.floatAccuracy << "%\n";
+    std::cout << std::setw(22) << "Quantized Accuracy: " << report.quantizedAccuracy << "%\n";
+    std::cout << std::setw(22) << "Accuracy Delta: " << report.accuracyDelta << "%\n";
+    std::cout << std::setw(22) << "Agreement: " << report.agreement << "%\n";
+    std::cout << std::setw(22) << "Max Logit Error: " << report.maxLogitError << "\n";
+    std::cout << std::setw(22) << "Mean Logit Error: " << report.meanLogitError << "\n\n";
+
+    quantizedModel.printInfo();
+    quantizedModel.saveToFile("examples/Models/QuantLogRegModel.txt");
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <csignal>
+
+// Usage: ScoringDaemon [modelFile] [socketPath] [maxBatchSize] [maxDelayMicroseconds] [numWorkers]
+int main(int argc, char *argv[])
+{
+    const std::string modelFile = (argc > 1) ? argv[1] : "examples/Models/LogRegModel.txt";
+
+    mlLib::ScoringServerOptions options;
+    if (argc > 2)
+        options.socketPath = argv[2];
+    if (argc > 3)
+        options.maxBatchSize = std::stoul(argv[3]);
+    if (argc > 4)
+        options.maxDelay = std::chrono::microseconds(std::stol(argv[4]));
+    if (argc > 5)
+        options.numWorkers = std::stoul(argv[5]);
+
+    // Block SIGINT and SIGTERM in every thread so main can wait for them below
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    // The model file is watched, so replacing it swaps the served model without a restart
+    mlLib::ModelRegistry registry;
+    if (!registry.add(options.modelName, modelFile))
+    {
+        std::cerr << "Error loading the model!" << std::endl;
+        return 1;
+    }
+    registry.start();
+
+    mlLib::ScoringServer server(registry, options);
+    if (!server.start())
+    {
+        return 1;
+    }
+
+    std::cout << "Serving " << modelFile << " on " << options.socketPath << " (max batch " << options.maxBatchSize
+              << ", max delay " << options.maxDelay.count() << " us, " << options.numWorkers << " workers)" << std::endl;
+
+    int signal;
+    sigwait(&signals, &signal);
+
+    server.stop();
+    registry.stop();
+
+    mlLib::ScoringServerStats stats = server.getStats();
+    std::cout << "Served " << stats.requests << " requests in " << stats.batches << " batches over " << stats.connections << " connections\n";
+
+    return 0;
+}
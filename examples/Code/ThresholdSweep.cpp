@@ -0,0 +1,59 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+
+int main()
+{
+    // Read the whole dataset as a single chunk
+    mlLib::ChunkedDataReader reader("examples/DataSet/HeartDisease.csv", mlLib::DataFormat::CSV, 15, 8192);
+    mlLib::DataChunk chunk;
+
+    if (reader.readChunk(chunk) == 0)
+    {
+        std::cerr << "Error opening the file!" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::vector<long double>> xValues(chunk.numRows);
+    std::vector<long double> yValues(chunk.labels.begin(), chunk.labels.begin() + chunk.numRows);
+    for (size_t i = 0; i < chunk.numRows; ++i)
+    {
+        xValues[i].assign(chunk.features.begin() + i * 15, chunk.features.begin() + (i + 1) * 15);
+    }
+
+    mlLib::LogisticRegressionModel model;
+    model.loadFromFile("examples/Models/LogRegModel.txt");
+
+    // Score once, then evaluate every candidate threshold from the same probabilities
+    std::vector<long double> probabilities = model.predictProbabilities(xValues);
+    mlLib::CurveEvaluation evaluation = mlLib::EvaluateCurves(probabilities, yValues);
+    mlLib::CurveEvaluation approximate = mlLib::EvaluateCurves(probabilities, yValues, mlLib::EvaluationMode::Histogram, 256);
+
+    std::cout << std::setw(15) << "ROC-AUC: " << evaluation.rocAuc << " (histogram " << approximate.rocAuc << ")\n";
+    std::cout << std::setw(15) << "PR-AUC: " << evaluation.prAuc << " (histogram " << approximate.prAuc << ")\n";
+    std::cout << std::setw(15) << "Log-Loss: " << evaluation.logLoss << "\n";
+    std::cout << std::setw(15) << "Thresholds: " << evaluation.thresholds.size() << "\n\n";
+
+    // Pick the operating point with the best F1 score
+    mlLib::ThresholdPoint best = evaluation.thresholds.front();
+    long double bestF1 = 0;
+    for (const auto &point : evaluation.thresholds)
+    {
+        const long double f1Score = mlLib::ComputeEvaluationMetrics(point.confusionMatrix).f1Score;
+        if (f1Score > bestF1)
+        {
+            bestF1 = f1Score;
+            best = point;
+        }
+    }
+
+    mlLib::EvaluationMetrics evaluationMetrics = mlLib::ComputeEvaluationMetrics(best.confusionMatrix);
+
+    std::cout << "Best F1 Threshold: " << best.threshold << "\n";
+    std::cout << std::setw(15) << "Accuracy: " << evaluationMetrics.accuracy << "%\n";
+    std::cout << std::setw(15) << "Recall: " << evaluationMetrics.recall << "%\n";
+    std::cout << std::setw(15) << "Precision: " << evaluationMetrics.precision << "%\n";
+    std::cout << std::setw(15) << "F1 Score: " << evaluationMetrics.f1Score << "\n";
+
+    return 0;
+}
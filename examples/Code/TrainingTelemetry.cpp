@@ -0,0 +1,56 @@
+#include "../../include/mlLib.h"
+#include <iostream>
+#include <iomanip>
+#include <filesystem>
+
+// Usage: TrainingTelemetry [traceFile]
+int main(int argc, char *argv[])
+{
+    const std::string traceFile = (argc > 1) ? argv[1] : (std::filesystem::temp_directory_path() / "TrainingTrace.json").string();
+
+    mlLib::Dataset<double> dataset(mlLib::LoadCSV<double>("examples/DataSet/HeartDisease.csv"));
+    if (dataset.getNumRows() == 0)
+    {
+        std::cerr << "Error opening the file!" << std::endl;
+        return 1;
+    }
+
+    // Time the kernels and keep trace events for the whole run
+    mlLib::Instrumentation::enable(true);
+
+    mlLib::BatchOptions options;
+    options.batchSize = 512;
+    options.numEpochs = 50;
+    options.normalizeFeatures = true;
+    mlLib::BatchIterator<double> batches(dataset.view(), options);
+
+    std::cout << std::fixed << std::setprecision(4);
+    auto report = [](const mlLib::TrainingProgress &progress)
+    {
+        if (progress.iteration % 50 == 0)
+        {
+            std::cout << "batch " << std::setw(4) << progress.iteration << "  loss " << progress.loss << "  |gradient| " << progress.gradientNorm
+                      << "  " << std::setprecision(0) << progress.rowsPerSecond << " rows/s  " << std::setprecision(1)
+                      << progress.elapsed.count() * 1000.0 << " ms" << std::setprecision(4) << "\n";
+        }
+    };
+    mlLib::LogisticRegressionModel model = mlLib::LogisticRegression(batches, 0.01, mlLib::OptimizerType::Adam, report);
+
+    mlLib::Instrumentation::disable();
+
+    std::cout << "\nPer-kernel totals over all threads:\n";
+    for (const mlLib::InstrumentationStats &stats : mlLib::Instrumentation::getStats())
+    {
+        std::cout << std::setw(32) << stats.name << ": " << std::setw(8) << stats.count;
+        if (stats.totalTime.count() > 0)
+            std::cout << " calls, " << std::setprecision(3) << std::chrono::duration<double, std::milli>(stats.totalTime).count() << " ms" << std::setprecision(4);
+        std::cout << "\n";
+    }
+
+    if (mlLib::Instrumentation::writeChromeTrace(traceFile))
+    {
+        std::cout << "\nTrace written to " << traceFile << " (open it in chrome://tracing or ui.perfetto.dev)\n";
+    }
+
+    return 0;
+}
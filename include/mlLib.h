@@ -9,6 +9,34 @@
 #include <numeric>
 #include <algorithm>
 #include <cmath>
+#include <limits>
+#include <array>
+#include <utility>
+#include <span>
+#include <atomic>
+#include <random>
+#include <string>
+#include <future>
+#include <thread>
+#include <charconv>
+#include <bit>
+#include <type_traits>
+#include <memory>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <chrono>
+#include <functional>
+
+// Defining MLLIB_HEADER_ONLY (or including mlLib.hpp instead) compiles the implementation into every
+// translation unit that includes this header, so the templates can be inlined and instantiated for
+// any element type. Without it, code links against the precompiled lib/mlLib.a.
+#if defined(MLLIB_HEADER_ONLY)
+#define MLLIB_INLINE inline
+#else
+#define MLLIB_INLINE
+#endif
 
 namespace prob
 {
@@ -23,6 +51,17 @@ namespace prob
 
     double poissonProbability(int k, double lambda);
 
+    // Log-space versions, finite where the products above underflow; -infinity for an impossible outcome
+    double logBinomialProbability(int n, int k, double p);
+
+    double logPoissonProbability(int k, double lambda);
+
+    // Log of the normal density with the given mean and variance at x
+    double normalLogDensity(double x, double mean, double variance);
+
+    // log(sum(exp(values))) without overflow, by factoring out the largest value
+    double logSumExp(std::span<const double> values);
+
 } // namespace probability
 
 namespace stat
@@ -134,6 +173,50 @@ namespace mlLib
         long double f1Score = 0;
     };
 
+    // Function to derive accuracy, recall, precision and F1 score (in percent) from a confusion matrix
+    EvaluationMetrics ComputeEvaluationMetrics(const ConfusionMatrix &confusionMatrix);
+
+    // Struct to hold the result of a classification evaluation, kept apart from the model so evaluating never mutates it
+    struct ClassificationMetrics
+    {
+        ConfusionMatrix confusionMatrix;
+        EvaluationMetrics evaluationMetrics;
+    };
+
+    // Function to evaluate predicted classes against actual labels without touching any model
+    template <typename T>
+    ClassificationMetrics EvaluateClassification(std::span<const T> actualYValues, std::span<const int> predictedClasses);
+
+    // Enumeration for the threshold sweep strategy of the curve evaluator
+    enum EvaluationMode
+    {
+        Exact,
+        Histogram
+    };
+
+    // Struct to hold the confusion matrix obtained when predicting positive for probability >= threshold
+    struct ThresholdPoint
+    {
+        long double threshold = 0;
+        ConfusionMatrix confusionMatrix;
+    };
+
+    // Struct to store threshold-independent metrics and the full threshold sweep
+    struct CurveEvaluation
+    {
+        long double rocAuc = 0;
+        long double prAuc = 0;
+        long double logLoss = 0;
+        std::vector<ThresholdPoint> thresholds;
+    };
+
+    // Function to compute ROC-AUC, PR-AUC (average precision), log-loss and the confusion matrix at every
+    // candidate threshold in one pass over the probabilities. Exact mode sorts in parallel in O(n log n) and
+    // uses every distinct probability as a threshold; Histogram mode buckets into numBins equal-width bins in O(n).
+    // numThreads = 0 uses all hardware threads.
+    template <typename T>
+    CurveEvaluation EvaluateCurves(const std::vector<long double> &probabilities, const std::vector<T> &actualYValues, EvaluationMode mode = EvaluationMode::Exact, size_t numBins = 1024, size_t numThreads = 0);
+
     inline std::ostream &operator<<(std::ostream &os, const ConfusionMatrix &obj)
     {
         os << obj.truePositive << " "
@@ -167,6 +250,95 @@ namespace mlLib
         return is;
     }
 
+    // Struct to hold the totals of one timer or counter, summed over all threads
+    struct InstrumentationStats
+    {
+        std::string name;
+        uint64_t count = 0;                    // Timed calls, or the summed counter value
+        std::chrono::nanoseconds totalTime{0}; // Zero for counters
+    };
+
+    // Process-wide hot path instrumentation, off by default. While disabled, a timer or counter costs
+    // one relaxed atomic load. While enabled, each thread adds into its own slots and getStats sums
+    // them on demand; a thread that exits folds its totals into a shared aggregate and frees its slots.
+    // With tracing on, every timed scope and recorded value is also kept as a Chrome trace event (up
+    // to about a million per thread) for writeChromeTrace.
+    class Instrumentation
+    {
+    private:
+        static inline std::atomic<bool> enabled{false};
+        static inline std::atomic<bool> tracing{false};
+
+        static void addCount(const char *name, uint64_t value);
+        static void addValue(const char *name, double value);
+
+    public:
+        static void enable(bool withTracing = false);
+        static void disable();
+        static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+        static bool isTracing() { return tracing.load(std::memory_order_relaxed); }
+
+        // Names are compared by content but stored by pointer, so they must outlive the stats (string literals do)
+        static void count(const char *name, uint64_t value = 1)
+        {
+            if (isEnabled())
+                addCount(name, value);
+        }
+
+        // Trace a sampled value such as the training loss as a counter track
+        static void recordValue(const char *name, double value)
+        {
+            if (isTracing())
+                addValue(name, value);
+        }
+
+        static void recordTime(const char *name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+
+        static std::vector<InstrumentationStats> getStats();
+        static void reset();
+
+        // Write the trace events of all threads in the Chrome trace event format (chrome://tracing, Perfetto)
+        static bool writeChromeTrace(const std::string &filename);
+    };
+
+    // Class to time a scope into Instrumentation under a literal name
+    class ScopedTimer
+    {
+    private:
+        const char *name;
+        std::chrono::steady_clock::time_point start;
+        bool active;
+
+    public:
+        explicit ScopedTimer(const char *name) : name(name), active(Instrumentation::isEnabled())
+        {
+            if (active)
+                start = std::chrono::steady_clock::now();
+        }
+
+        ~ScopedTimer()
+        {
+            if (active)
+                Instrumentation::recordTime(name, start, std::chrono::steady_clock::now());
+        }
+
+        ScopedTimer(const ScopedTimer &) = delete;
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+    };
+
+    // Struct to hold the progress of a training run after one iteration, epoch or batch
+    struct TrainingProgress
+    {
+        size_t iteration = 0;                       // Iterations completed, starting at 1
+        long double loss = 0.0;                     // Mean loss over the rows of this iteration
+        long double gradientNorm = 0.0;             // L2 norm of the mean gradient of this iteration
+        double rowsPerSecond = 0.0;                 // Throughput of this iteration
+        std::chrono::duration<double> elapsed{0.0}; // Since training started
+    };
+
+    // Callback the trainers invoke after every iteration; an empty callback costs nothing
+    using TrainingCallback = std::function<void(const TrainingProgress &)>;
+
     // Class for Linear Regression Model
     class LinearRegressionModel
     {
@@ -192,15 +364,24 @@ namespace mlLib
 
         // Predict function
         template <typename T>
-        std::vector<long double> predict(const std::vector<T> &xVector);
+        std::vector<long double> predict(const std::vector<T> &xVector) const;
+
+        // Allocation-free, reentrant predict writing into caller-provided storage of the same size
+        template <typename T>
+        void predict(std::span<const T> xValues, std::span<long double> predictedYValues) const;
 
         // Evaluate function
         template <typename T>
-        long double evaluate(const std::vector<T> &actualYValues, const std::vector<long double> &predictedYValues);
+        long double evaluate(const std::vector<T> &actualYValues, const std::vector<long double> &predictedYValues) const;
 
-        void saveToFile(const std::string &filename);
+        // Text export and import; loadFromFile also accepts binary model files and leaves the model unchanged on a bad file
+        void saveToFile(const std::string &filename) const;
         void loadFromFile(const std::string &filename);
 
+        // Checksummed binary format; loadBinary returns false and leaves the model unchanged on a bad file
+        bool saveBinary(const std::string &filename) const;
+        bool loadBinary(const std::string &filename);
+
         // Serialization function
         friend std::ostream &operator<<(std::ostream &os, const LinearRegressionModel &obj)
         {
@@ -208,12 +389,18 @@ namespace mlLib
             return os;
         }
 
-        // Deserialization function
+        // Deserialization function; a malformed model sets failbit and leaves obj unchanged
         friend std::istream &operator>>(std::istream &is, LinearRegressionModel &obj)
         {
-            int normalizationTypeInt;
-            is >> obj.slope >> obj.intercept >> normalizationTypeInt;
-            obj.normalizationType = static_cast<stat::NormalizationType>(normalizationTypeInt);
+            long double slope = 0.0L, intercept = 0.0L;
+            int normalizationTypeInt = -1;
+            is >> slope >> intercept >> normalizationTypeInt;
+            if (!is || normalizationTypeInt < stat::Min_Max || normalizationTypeInt > stat::L2_Euclidean)
+            {
+                is.setstate(std::ios::failbit);
+                return is;
+            }
+            obj = LinearRegressionModel(slope, intercept, static_cast<stat::NormalizationType>(normalizationTypeInt));
             return is;
         }
 
@@ -226,16 +413,70 @@ namespace mlLib
 
     // Function to create a linear regression model using Gradient Descent method
     template <typename T>
-    LinearRegressionModel LinearRegressionGradientDescent(const std::vector<T> &xValues, const std::vector<T> &yValues, stat::NormalizationType normalizationType = stat::NormalizationType::Min_Max, const long double learningRate = 0.01, const int numIterations = 1000);
+    LinearRegressionModel LinearRegressionGradientDescent(const std::vector<T> &xValues, const std::vector<T> &yValues, stat::NormalizationType normalizationType = stat::NormalizationType::Min_Max, const long double learningRate = 0.01, const int numIterations = 1000, const TrainingCallback &callback = nullptr);
+
+    // Enumeration for the optimizers available to incremental training
+    enum OptimizerType
+    {
+        SGD,
+        Adam
+    };
+
+    // Struct to carry optimizer state across training calls (Adam moments and step count)
+    struct OptimizerState
+    {
+        OptimizerType type = SGD;
+        size_t step = 0;
+        std::vector<long double> firstMoments;
+        std::vector<long double> secondMoments;
+    };
+
+    // Serialization function for OptimizerState
+    inline std::ostream &operator<<(std::ostream &os, const OptimizerState &obj)
+    {
+        os << static_cast<int>(obj.type) << " " << obj.step << " " << obj.firstMoments.size() << " ";
+        for (size_t i = 0; i < obj.firstMoments.size(); ++i)
+        {
+            os << obj.firstMoments[i] << " " << obj.secondMoments[i] << " ";
+        }
+        return os;
+    }
+
+    // Deserialization function for OptimizerState
+    inline std::istream &operator>>(std::istream &is, OptimizerState &obj)
+    {
+        int optimizerTypeInt;
+        size_t momentSize;
+        if (!(is >> optimizerTypeInt >> obj.step >> momentSize))
+            return is;
+
+        obj.type = static_cast<OptimizerType>(optimizerTypeInt);
+        obj.firstMoments.resize(momentSize);
+        obj.secondMoments.resize(momentSize);
+        for (size_t i = 0; i < momentSize; ++i)
+        {
+            is >> obj.firstMoments[i] >> obj.secondMoments[i];
+        }
+        return is;
+    }
+
+    template <typename T>
+    class DatasetView;
+
+    template <typename T>
+    class BatchIterator;
+
+    class CompressedDataset;
 
     // Class for Logistic Regression Model
     class LogisticRegressionModel
     {
     private:
         std::vector<long double> coefficients;
-        stat::NormalizationType normalizationType;
+        stat::NormalizationType normalizationType = stat::NormalizationType::Z_Score;
         ConfusionMatrix confusionMatrix;
         EvaluationMetrics evaluationMetrics;
+        OptimizerState optimizerState;
 
     public:
         // Constructors
@@ -246,26 +487,76 @@ namespace mlLib
         const std::vector<long double> &getCoefficients() const;
         ConfusionMatrix getConfusionMatrix() const;
         EvaluationMetrics getEvaluationMetrics() const;
+        const OptimizerState &getOptimizerState() const;
 
         // Setter functions
         void setCoefficients(const std::vector<long double> &newCoefficients);
         void setConfusionMatrix(const ConfusionMatrix &matrix);
         void setEvaluationMetrics(const EvaluationMetrics &metrics);
+        void setOptimizerState(const OptimizerState &state);
+
+        // Continue training on a batch from the current coefficients and optimizer state.
+        // An untrained model starts from zero coefficients.
+        template <typename T>
+        void partialFit(const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues, const long double learningRate = 0.01, const int numIterations = 1, OptimizerType optimizer = OptimizerType::SGD, const TrainingCallback &callback = nullptr);
+
+        // Continue training on features given as one view per column, e.g. columns of a ColumnarDataset
+        template <typename T>
+        void partialFit(const std::vector<std::span<const T>> &featureColumns, std::span<const T> labels, const long double learningRate = 0.01, const int numIterations = 1, OptimizerType optimizer = OptimizerType::SGD, const TrainingCallback &callback = nullptr);
+
+        // Continue training on the rows of a dataset view
+        template <typename T>
+        void partialFit(const DatasetView<T> &data, const long double learningRate = 0.01, const int numIterations = 1, OptimizerType optimizer = OptimizerType::SGD, const TrainingCallback &callback = nullptr);
+
+        // Continue training with one gradient step per remaining batch of the iterator
+        template <typename T>
+        void partialFit(BatchIterator<T> &batches, const long double learningRate = 0.01, OptimizerType optimizer = OptimizerType::SGD, const TrainingCallback &callback = nullptr);
+
+        // Continue training with full-batch gradient steps on a compressed dataset
+        void partialFit(const CompressedDataset &data, const long double learningRate = 0.01, const int numIterations = 1, OptimizerType optimizer = OptimizerType::SGD, const TrainingCallback &callback = nullptr);
 
         // Predict function
         template <typename T>
-        std::vector<int> predict(const std::vector<std::vector<T>> &xValues, const long double threshold = 0.5);
+        std::vector<int> predict(const std::vector<std::vector<T>> &xValues, const long double threshold = 0.5) const;
+
+        // Predict the probability of the positive class for each row
+        template <typename T>
+        std::vector<long double> predictProbabilities(const std::vector<std::vector<T>> &xValues) const;
+
+        // Allocation-free, reentrant scoring of one row
+        template <typename T>
+        long double predictProbability(std::span<const T> xRow) const;
+
+        // Allocation-free, reentrant batch scoring of rows stored contiguously in row-major order
+        template <typename T>
+        void predictProbabilities(std::span<const T> xRowMajor, std::span<long double> probabilities) const;
+
+        template <typename T>
+        void predict(std::span<const T> xRowMajor, std::span<int> predictions, const long double threshold = 0.5) const;
+
+        // Scoring of the rows of a dataset view
+        template <typename T>
+        std::vector<long double> predictProbabilities(const DatasetView<T> &data) const;
+
+        template <typename T>
+        std::vector<int> predict(const DatasetView<T> &data, const long double threshold = 0.5) const;
 
         // Evaluate function
         template <typename T>
         long double evaluate(const std::vector<T> &actualYValues, const std::vector<int> &predictedClasses);
 
-        // Save the object to a file
+        // Save the object to a file as text
         void saveToFile(const std::string &filename) const;
 
-        // Load the object from a file
+        // Load the object from a text or binary model file
         void loadFromFile(const std::string &filename);
 
+        // Save the object in the checksummed binary format, which loads through a memory mapping
+        bool saveBinary(const std::string &filename) const;
+
+        // Load a binary model file; returns false and leaves the model unchanged if it is invalid
+        bool loadBinary(const std::string &filename);
+
         friend std::ostream &operator<<(std::ostream &os, const LogisticRegressionModel &obj)
         {
             // Serialize coefficients
@@ -284,6 +575,9 @@ namespace mlLib
             // Serialize EvaluationMetrics
             os << obj.evaluationMetrics;
 
+            // Serialize OptimizerState
+            os << obj.optimizerState;
+
             return os;
         }
 
@@ -310,6 +604,20 @@ namespace mlLib
             // Deserialize EvaluationMetrics
             is >> obj.evaluationMetrics;
 
+            // A short read keeps its failbit, so the caller sees a truncated file instead of partial coefficients
+            if (!is)
+                return is;
+
+            // Deserialize OptimizerState; files written before it was stored end here
+            if ((is >> std::ws).eof())
+            {
+                obj.optimizerState = OptimizerState();
+            }
+            else
+            {
+                is >> obj.optimizerState;
+            }
+
             return is;
         }
 
@@ -318,8 +626,2021 @@ namespace mlLib
 
     // Function to create a logistic regression model
     template <typename T>
-    LogisticRegressionModel LogisticRegression(const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues, const long double learningRate = 0.01, const int numIterations = 1000);
+    LogisticRegressionModel LogisticRegression(const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues, const long double learningRate = 0.01, const int numIterations = 1000, const TrainingCallback &callback = nullptr);
 
-} // namespace mlLib
+    // Function to create a logistic regression model from column views without copying them into rows
+    template <typename T>
+    LogisticRegressionModel LogisticRegression(const std::vector<std::span<const T>> &featureColumns, std::span<const T> labels, const long double learningRate = 0.01, const int numIterations = 1000, const TrainingCallback &callback = nullptr);
+
+    // Function to continue training a logistic regression model (warm start) from its coefficients and optimizer state
+    template <typename T>
+    LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues, const long double learningRate = 0.01, const int numIterations = 1000, OptimizerType optimizer = OptimizerType::SGD, const TrainingCallback &callback = nullptr);
+
+    // Struct to describe one hyperparameter configuration for logistic regression
+    struct LogisticRegressionParams
+    {
+        long double learningRate = 0.01;
+        int numIterations = 1000;
+        OptimizerType optimizer = SGD;
+    };
+
+    // Struct to hold the cross-validation result of one configuration
+    struct CrossValidationResult
+    {
+        LogisticRegressionParams params;
+        std::vector<EvaluationMetrics> foldMetrics;
+        long double meanAccuracy = 0;
+        int iterationsTrained = 0; // below params.numIterations when successive halving dropped the configuration early
+    };
+
+    // Function to build every combination of the given hyperparameter values
+    std::vector<LogisticRegressionParams> MakeParameterGrid(const std::vector<long double> &learningRates, const std::vector<int> &iterationCounts, const std::vector<OptimizerType> &optimizers = {OptimizerType::SGD});
+
+    // Function to run k-fold cross-validation of every configuration in the grid. Folds are index ranges of one
+    // shuffled permutation of the shared data, so no rows are copied, and folds x configurations run concurrently.
+    // With successiveHalving, configurations are trained in rounds of doubling iteration budgets and the worse
+    // half is dropped after each round. Results are sorted by mean accuracy, best first.
+    template <typename T>
+    std::vector<CrossValidationResult> CrossValidateLogisticRegression(const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds = 5, bool successiveHalving = false, size_t numThreads = 0, unsigned int seed = 42);
+
+    // Class for Logistic Regression scoring with the feature count N fixed at compile time.
+    // Coefficients live in a std::array and the N-wide dot product is unrolled into a balanced tree
+    // of additions, so scoring a row has no loop bound, size check or serial chain of adds at run time.
+    template <typename T, size_t N>
+    class FixedLogisticModel
+    {
+    private:
+        T intercept;
+        std::array<T, N> weights;
+
+        // Sum of weights[j] * xRow[j] for j in [Begin, Begin + Count), added as a balanced tree so the
+        // products are summed in independent halves rather than one serial chain
+        template <size_t Begin, size_t Count>
+        T dotProduct(const T *xRow) const
+        {
+            if constexpr (Count == 0)
+                return 0;
+            else if constexpr (Count == 1)
+                return weights[Begin] * xRow[Begin];
+            else
+                return dotProduct<Begin, Count / 2>(xRow) + dotProduct<Begin + Count / 2, Count - Count / 2>(xRow);
+        }
+
+    public:
+        // Constructors
+        FixedLogisticModel() : intercept(0), weights{} {}
+
+        explicit FixedLogisticModel(const LogisticRegressionModel &model)
+        {
+            const std::vector<long double> &coefficients = model.getCoefficients();
+            assert(coefficients.size() == N + 1 && "Model feature count does not match N.");
+
+            intercept = static_cast<T>(coefficients[0]);
+            for (size_t j = 0; j < N; ++j)
+            {
+                weights[j] = static_cast<T>(coefficients[j + 1]);
+            }
+        }
+
+        // Getter functions
+        static constexpr size_t getNumFeatures() { return N; }
+        T getIntercept() const { return intercept; }
+        const std::array<T, N> &getWeights() const { return weights; }
+
+        // Logit of one row of N values
+        T logit(const T *xRow) const
+        {
+            if constexpr (N <= 64)
+            {
+                return intercept + dotProduct<0, N>(xRow);
+            }
+            else
+            {
+                T sums[4] = {};
+                size_t j = 0;
+                for (; j + 4 <= N; j += 4)
+                {
+                    for (size_t u = 0; u < 4; ++u)
+                    {
+                        sums[u] += weights[j + u] * xRow[j + u];
+                    }
+                }
+                for (; j < N; ++j)
+                {
+                    sums[0] += weights[j] * xRow[j];
+                }
+                return intercept + ((sums[0] + sums[1]) + (sums[2] + sums[3]));
+            }
+        }
+
+        T logit(const std::array<T, N> &xRow) const { return logit(xRow.data()); }
+
+        // Probability of the positive class for one row
+        T predictProbability(const T *xRow) const
+        {
+            return static_cast<T>(1) / (static_cast<T>(1) + std::exp(-logit(xRow)));
+        }
+
+        // Predicted class for one row
+        int predict(const T *xRow, const T threshold = 0.5) const
+        {
+            return (predictProbability(xRow) >= threshold) ? 1 : 0;
+        }
+
+        int predict(const std::array<T, N> &xRow, const T threshold = 0.5) const { return predict(xRow.data(), threshold); }
+
+        // Predict function for rows stored contiguously in row-major order
+        std::vector<int> predict(const std::vector<T> &xRowMajor, const T threshold = 0.5) const
+        {
+            assert(xRowMajor.size() % N == 0 && "Input feature size mismatch.");
+
+            const size_t numRows = xRowMajor.size() / N;
+            std::vector<int> predictions(numRows);
+            for (size_t i = 0; i < numRows; ++i)
+            {
+                predictions[i] = predict(&xRowMajor[i * N], threshold);
+            }
+            return predictions;
+        }
+    };
+
+    // Enumeration for on-disk dataset formats accepted by the chunked reader
+    enum DataFormat
+    {
+        CSV,
+        Binary
+    };
+
+    // Struct to hold one chunk of rows with features stored contiguously in row-major order
+    struct DataChunk
+    {
+        std::vector<long double> features;
+        std::vector<long double> labels;
+        size_t numRows = 0;
+    };
+
+    // Class to read a dataset from disk in fixed-size chunks.
+    // CSV rows hold numFeatures values followed by the label; Binary files hold
+    // records of (numFeatures + 1) little-endian doubles in the same order.
+    class ChunkedDataReader
+    {
+    private:
+        std::string filename;
+        DataFormat format;
+        size_t numFeatures;
+        size_t chunkRows;
+        bool hasHeader;
+        std::ifstream inFile;
+        std::string line;
+        size_t lineNumber = 0; // Last CSV line read, counting the header
+        std::vector<double> recordBuffer;
+
+    public:
+        // Constructor
+        ChunkedDataReader(const std::string &filename, DataFormat format, size_t numFeatures, size_t chunkRows = 65536, bool hasHeader = true);
+
+        // Getter functions
+        size_t getNumFeatures() const;
+        size_t getChunkRows() const;
+        bool isOpen() const;
+
+        // Rewind to the first data row
+        void reset();
+
+        // Read up to chunkRows rows into the chunk, reusing its storage. Returns the number of rows read.
+        size_t readChunk(DataChunk &chunk);
+    };
+
+    // Class to map a file read-only into memory; the mapping is released when the object is destroyed
+    class MappedFile
+    {
+    private:
+        const char *mappedData = nullptr;
+        size_t mappedSize = 0;
+        bool opened = false;
+
+    public:
+        // Constructors
+        MappedFile();
+        explicit MappedFile(const std::string &filename);
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+        MappedFile(MappedFile &&other) noexcept;
+        MappedFile &operator=(MappedFile &&other) noexcept;
+        ~MappedFile();
+
+        // Map a file, replacing any current mapping. Returns false if the file cannot be opened or mapped.
+        bool open(const std::string &filename);
+        void close();
+
+        // Getter functions
+        bool isOpen() const;
+        const char *data() const;
+        size_t size() const;
+    };
+
+    // Enumeration for the memory layout of a loaded feature matrix
+    enum MatrixLayout
+    {
+        RowMajor,
+        ColumnMajor
+    };
+
+    // Struct to configure CSV loading
+    struct CSVOptions
+    {
+        bool hasHeader = true;
+        char delimiter = ',';
+        bool hasLabel = true;
+        int labelColumn = -1;               // -1 selects the last column
+        std::vector<size_t> featureColumns; // empty selects every column except the label
+        MatrixLayout layout = RowMajor;
+        size_t numThreads = 0; // 0 uses all hardware threads
+    };
+
+    // Struct to report a row that could not be parsed
+    struct MalformedRow
+    {
+        size_t lineNumber = 0; // 1-based line number in the file
+        std::string reason;
+    };
+
+    // Struct to hold a loaded CSV dataset with features stored contiguously in the requested layout
+    template <typename T>
+    struct CSVData
+    {
+        std::vector<std::string> featureNames;
+        std::vector<T> features;
+        std::vector<T> labels;
+        size_t numRows = 0;
+        size_t numFeatures = 0;
+        MatrixLayout layout = RowMajor;
+        std::vector<MalformedRow> malformedRows;
+
+        // Feature value at (row, feature) regardless of layout
+        T at(size_t row, size_t feature) const
+        {
+            return (layout == RowMajor) ? features[row * numFeatures + feature] : features[feature * numRows + row];
+        }
+    };
+
+    // Function to load a numeric CSV file. The file is memory-mapped, split at line boundaries into one
+    // chunk per thread, and each chunk is parsed with std::from_chars straight into the output buffers.
+    // Malformed rows are skipped and reported. Instantiated for float, double and long double.
+    template <typename T>
+    CSVData<T> LoadCSV(const std::string &filename, const CSVOptions &options = CSVOptions());
+
+    // Class to refer to rows of a dataset without copying them: either a contiguous range of rows or a
+    // range of a shared index permutation. Views are cheap to copy and do not own the data, so the
+    // Dataset (or buffers) they were made from must outlive them.
+    template <typename T>
+    class DatasetView
+    {
+    private:
+        const T *features = nullptr;
+        const T *labels = nullptr;
+        size_t numFeatures = 0;
+        std::shared_ptr<const std::vector<size_t>> indices; // Underlying row of each position, or null for offset + i
+        size_t offset = 0;
+        size_t count = 0;
+
+        DatasetView(const DatasetView &base, std::shared_ptr<const std::vector<size_t>> indices, size_t offset, size_t count);
+
+    public:
+        // Constructors, the second views numRows rows stored contiguously in row-major order
+        DatasetView();
+        DatasetView(const T *features, const T *labels, size_t numRows, size_t numFeatures);
+
+        // Getter functions
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        size_t getNumFeatures() const { return numFeatures; }
+
+        // Row of the underlying data at position i of the view
+        size_t rowIndex(size_t i) const { return indices ? (*indices)[offset + i] : offset + i; }
+
+        std::span<const T> row(size_t i) const { return std::span<const T>(features + rowIndex(i) * numFeatures, numFeatures); }
+        T label(size_t i) const { return labels[rowIndex(i)]; }
+        bool hasLabels() const { return labels != nullptr; }
+
+        // Positions [begin, end) of this view
+        DatasetView rows(size_t begin, size_t end) const;
+
+        // The given positions of this view, in the given order
+        DatasetView select(std::vector<size_t> positions) const;
+
+        // This view in a random order
+        DatasetView shuffled(unsigned int seed = 42) const;
+
+        // Split into numShards contiguous views of near-equal size for parallel workers
+        std::vector<DatasetView> shards(size_t numShards) const;
+
+        // Train/test split; the stratified version keeps the label proportions of this view in both parts
+        std::pair<DatasetView, DatasetView> split(long double testFraction) const;
+        std::pair<DatasetView, DatasetView> stratifiedSplit(long double testFraction, unsigned int seed = 42) const;
+
+        // Train/test views of fold foldIndex of numFolds contiguous folds (shuffle first for random folds)
+        std::pair<DatasetView, DatasetView> fold(size_t numFolds, size_t foldIndex) const;
+    };
+
+    // Class to own a dataset as one contiguous row-major feature buffer plus its labels. Shuffles,
+    // splits, folds and shards are DatasetView objects over this single copy.
+    template <typename T>
+    class Dataset
+    {
+    private:
+        std::vector<T> features;
+        std::vector<T> labels;
+        size_t numFeatures = 0;
+
+    public:
+        // Constructors
+        Dataset();
+        Dataset(const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues);
+        Dataset(std::vector<T> rowMajorFeatures, std::vector<T> labels, size_t numFeatures);
+
+        // Take over the buffers of loaded CSV data, converting column-major data to row-major
+        explicit Dataset(CSVData<T> &&data);
+
+        // Getter functions
+        size_t getNumRows() const { return labels.size(); }
+        size_t getNumFeatures() const { return numFeatures; }
+        std::span<const T> getFeatures() const { return features; }
+        std::span<const T> getLabels() const { return labels; }
+
+        // View of every row
+        DatasetView<T> view() const { return DatasetView<T>(features.data(), labels.data(), labels.size(), numFeatures); }
+    };
+
+    // Function to create a logistic regression model from the rows of a dataset view
+    template <typename T>
+    LogisticRegressionModel LogisticRegression(const DatasetView<T> &data, const long double learningRate = 0.01, const int numIterations = 1000, const TrainingCallback &callback = nullptr);
+
+    // Function to continue training a copy of initialModel on the rows of a dataset view
+    template <typename T>
+    LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const DatasetView<T> &data, const long double learningRate = 0.01, const int numIterations = 1000, OptimizerType optimizer = OptimizerType::SGD, const TrainingCallback &callback = nullptr);
+
+    // Function to evaluate a model on the rows of a dataset view
+    template <typename T>
+    ClassificationMetrics EvaluateClassification(const LogisticRegressionModel &model, const DatasetView<T> &data, const long double threshold = 0.5);
+
+    // Function to cross-validate over the rows of a dataset view
+    template <typename T>
+    std::vector<CrossValidationResult> CrossValidateLogisticRegression(const DatasetView<T> &data, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds = 5, bool successiveHalving = false, size_t numThreads = 0, unsigned int seed = 42);
+
+    // Class for a bounded lock-free queue with exactly one producer thread and one consumer thread
+    template <typename T>
+    class SPSCQueue
+    {
+    private:
+        std::vector<T> slots;
+        alignas(64) std::atomic<size_t> head{0}; // Next slot to pop, written only by the consumer
+        alignas(64) std::atomic<size_t> tail{0}; // Next slot to push, written only by the producer
+
+    public:
+        explicit SPSCQueue(size_t capacity) : slots(capacity + 1) {}
+
+        SPSCQueue(const SPSCQueue &) = delete;
+        SPSCQueue &operator=(const SPSCQueue &) = delete;
+
+        // Returns false if the queue is full
+        bool tryPush(const T &value)
+        {
+            const size_t currentTail = tail.load(std::memory_order_relaxed);
+            const size_t nextTail = (currentTail + 1 == slots.size()) ? 0 : currentTail + 1;
+            if (nextTail == head.load(std::memory_order_acquire))
+                return false;
+
+            slots[currentTail] = value;
+            tail.store(nextTail, std::memory_order_release);
+            return true;
+        }
+
+        // Returns false if the queue is empty
+        bool tryPop(T &value)
+        {
+            const size_t currentHead = head.load(std::memory_order_relaxed);
+            if (currentHead == tail.load(std::memory_order_acquire))
+                return false;
+
+            value = slots[currentHead];
+            head.store((currentHead + 1 == slots.size()) ? 0 : currentHead + 1, std::memory_order_release);
+            return true;
+        }
+    };
+
+    // Struct for one mini-batch, converted to long double and normalized, in row-major order
+    struct Batch
+    {
+        std::vector<long double> features;
+        std::vector<long double> labels;
+        size_t numRows = 0;
+        size_t numFeatures = 0;
+        size_t epoch = 0;
+    };
+
+    // Struct to configure a BatchIterator
+    struct BatchOptions
+    {
+        size_t batchSize = 256;
+        size_t numBuffers = 3; // 2 for double buffering, 3 for triple buffering
+        size_t numEpochs = 1;
+        bool shuffle = true; // Reshuffled every epoch
+        unsigned int seed = 42;
+        bool normalizeFeatures = false;
+        bool normalizeLabels = false;
+        stat::NormalizationType normalizationType = stat::NormalizationType::Z_Score;
+    };
+
+    // Struct to report how often either side of a BatchIterator had to wait for the other
+    struct BatchIteratorStats
+    {
+        size_t batches = 0;
+        size_t consumerStalls = 0;
+        std::chrono::nanoseconds consumerWaitTime{0};
+        size_t producerStalls = 0;
+    };
+
+    // Class to produce mini-batches of a dataset view on a background thread. Batches are gathered
+    // (in shuffled order if requested) and normalized into a fixed set of pre-allocated buffers that
+    // circulate between the producer and the consumer through two SPSC queues, so a trainer only
+    // waits if the producer falls behind. Normalization parameters are computed once over the view.
+    template <typename T>
+    class BatchIterator
+    {
+    private:
+        DatasetView<T> data;
+        BatchOptions options;
+        std::vector<Batch> buffers;
+        SPSCQueue<size_t> readyBuffers;
+        SPSCQueue<size_t> freeBuffers;
+        std::vector<long double> featureOffsets, featureScales;
+        long double labelOffset = 0.0L, labelScale = 1.0L;
+
+        std::thread producer;
+        std::atomic<bool> stopRequested{false};
+        std::atomic<size_t> producerStalls{0};
+        BatchIteratorStats stats;
+        size_t currentBuffer;
+        bool finished = false;
+
+        void produce();
+
+    public:
+        // Constructor, starts the producer thread
+        BatchIterator(const DatasetView<T> &data, const BatchOptions &options = BatchOptions());
+        ~BatchIterator();
+
+        BatchIterator(const BatchIterator &) = delete;
+        BatchIterator &operator=(const BatchIterator &) = delete;
+
+        // Next batch, or nullptr after the last epoch. The batch stays valid until the next call.
+        const Batch *next();
+
+        // Getter functions
+        size_t getNumFeatures() const { return data.getNumFeatures(); }
+        const BatchOptions &getOptions() const { return options; }
+        const std::vector<long double> &getFeatureOffsets() const { return featureOffsets; }
+        const std::vector<long double> &getFeatureScales() const { return featureScales; }
+        long double getLabelOffset() const { return labelOffset; }
+        long double getLabelScale() const { return labelScale; }
+        BatchIteratorStats getStats() const;
+    };
+
+    // Function to train a logistic regression model with one gradient step per mini-batch
+    template <typename T>
+    LogisticRegressionModel LogisticRegression(BatchIterator<T> &batches, const long double learningRate = 0.01, OptimizerType optimizer = OptimizerType::SGD, const TrainingCallback &callback = nullptr);
+
+    // Function to train a linear regression model on a single-feature dataset with one gradient step per mini-batch
+    template <typename T>
+    LinearRegressionModel LinearRegressionGradientDescent(BatchIterator<T> &batches, const long double learningRate = 0.01, const TrainingCallback &callback = nullptr);
+
+    // Enumeration for the storage encoding of a column of a CompressedDataset
+    enum ColumnEncoding : uint8_t
+    {
+        BitPackedEncoding,  // 0/1 values, one bit per row
+        DictionaryEncoding, // Up to 256 distinct values, one byte code per row
+        Float16Encoding,    // IEEE half precision, 2 bytes per row, lossy
+        BFloat16Encoding,   // bfloat16, 2 bytes per row, lossy
+        Float32Encoding     // 4 bytes per row
+    };
+
+    // Struct to configure how CompressedDataset encodes columns
+    struct CompressionOptions
+    {
+        bool detectBinary = true;                           // Bit-pack columns holding only 0 and 1
+        bool detectDictionary = true;                       // Dictionary-encode columns with at most 256 distinct values
+        ColumnEncoding continuousEncoding = Float32Encoding; // Encoding of all other columns
+    };
+
+    // Class to hold a dataset column by column in compact encodings. The training kernels decode
+    // blocks of a column straight into registers (AVX2 when available) while computing logits and
+    // gradients, so the full-width values are never materialized.
+    class CompressedDataset
+    {
+    public:
+        struct Column
+        {
+            ColumnEncoding encoding = Float32Encoding;
+            std::vector<uint8_t> data;
+            std::vector<float> dictionary;
+        };
+
+    private:
+        std::vector<Column> columns;
+        Column labelColumn;
+        size_t numRows = 0;
+
+    public:
+        // Constructors
+        CompressedDataset();
+
+        template <typename T>
+        explicit CompressedDataset(const DatasetView<T> &data, const CompressionOptions &options = CompressionOptions());
+
+        // Getter functions
+        size_t getNumRows() const;
+        size_t getNumFeatures() const;
+        ColumnEncoding getEncoding(size_t feature) const;
+
+        // Bytes used by the encoded features and labels
+        size_t getMemoryUsage() const;
+
+        // Decoded single values
+        float value(size_t row, size_t feature) const;
+        float label(size_t row) const;
+
+        // logits[i - begin] = coefficients[0] + sum_j coefficients[j + 1] * x[i][j] for rows [begin, end)
+        void computeLogits(std::span<const float> coefficients, size_t begin, size_t end, std::span<float> logits) const;
+
+        // gradient[0] += sum_i errors[i - begin] and gradient[j + 1] += sum_i errors[i - begin] * x[i][j] for rows [begin, end)
+        void accumulateGradient(std::span<const float> errors, size_t begin, size_t end, std::span<long double> gradient) const;
+    };
+
+    // Function to create a logistic regression model by full-batch gradient descent on a compressed dataset
+    LogisticRegressionModel LogisticRegression(const CompressedDataset &data, const long double learningRate = 0.01, const int numIterations = 1000, OptimizerType optimizer = OptimizerType::SGD, const TrainingCallback &callback = nullptr);
+
+    // Enumeration for the element type of a column in a columnar dataset file
+    enum ColumnType : uint32_t
+    {
+        Int8,
+        Int16,
+        Int32,
+        Int64,
+        UInt8,
+        UInt16,
+        UInt32,
+        UInt64,
+        Float32,
+        Float64
+    };
+
+    // Function to get the ColumnType that stores elements of type T
+    template <typename T>
+    constexpr ColumnType columnTypeOf()
+    {
+        if constexpr (std::is_same_v<T, int8_t>)
+            return Int8;
+        else if constexpr (std::is_same_v<T, int16_t>)
+            return Int16;
+        else if constexpr (std::is_same_v<T, int32_t>)
+            return Int32;
+        else if constexpr (std::is_same_v<T, int64_t>)
+            return Int64;
+        else if constexpr (std::is_same_v<T, uint8_t>)
+            return UInt8;
+        else if constexpr (std::is_same_v<T, uint16_t>)
+            return UInt16;
+        else if constexpr (std::is_same_v<T, uint32_t>)
+            return UInt32;
+        else if constexpr (std::is_same_v<T, uint64_t>)
+            return UInt64;
+        else if constexpr (std::is_same_v<T, float>)
+            return Float32;
+        else
+        {
+            static_assert(std::is_same_v<T, double>, "Unsupported column element type");
+            return Float64;
+        }
+    }
+
+    // On-disk layout of a columnar dataset file (little-endian, version 1):
+    //   ColumnarFileHeader (64 bytes), then numColumns ColumnDescriptor entries (64 bytes each),
+    //   then every column as a contiguous typed array starting on a 64-byte boundary.
+    struct ColumnarFileHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint64_t numRows;
+        uint32_t numColumns;
+        uint32_t labelColumn; // UINT32_MAX when there is no label
+        uint8_t reserved[40];
+    };
+
+    struct ColumnDescriptor
+    {
+        char name[40];
+        ColumnType type;
+        uint32_t reserved;
+        uint64_t offset;
+        uint64_t byteSize;
+    };
+
+    static_assert(sizeof(ColumnarFileHeader) == 64 && sizeof(ColumnDescriptor) == 64, "Columnar file structs must be 64 bytes");
+
+    // Class to access a columnar dataset file through a read-only memory mapping. Columns are returned
+    // as views into the mapping, so only the pages of the columns actually read are ever loaded.
+    class ColumnarDataset
+    {
+    private:
+        MappedFile file;
+        const ColumnarFileHeader *header = nullptr;
+        const ColumnDescriptor *descriptors = nullptr;
+
+    public:
+        static constexpr uint32_t formatVersion = 1;
+        static constexpr uint32_t noLabel = UINT32_MAX;
+
+        // Constructors
+        ColumnarDataset();
+        explicit ColumnarDataset(const std::string &filename);
+
+        // Map and validate a file. Returns false if it cannot be opened or is not a valid columnar dataset.
+        bool open(const std::string &filename);
+        bool isOpen() const;
+
+        // Getter functions
+        size_t getNumRows() const;
+        size_t getNumColumns() const;
+        bool hasLabel() const;
+        size_t getLabelColumn() const;
+        std::string getColumnName(size_t column) const;
+        ColumnType getColumnType(size_t column) const;
+
+        // Index of the named column, or getNumColumns() if there is none
+        size_t findColumn(const std::string &name) const;
+
+        // Ask the kernel to read a column ahead of use
+        void prefetchColumn(size_t column) const;
+
+        // Zero-copy view of a column; T must match the column's type
+        template <typename T>
+        std::span<const T> column(size_t column) const
+        {
+            assert(isOpen() && "Dataset is not open");
+            assert(column < header->numColumns && "Column index out of range");
+            assert(descriptors[column].type == columnTypeOf<T>() && "Column type mismatch");
+
+            return std::span<const T>(reinterpret_cast<const T *>(file.data() + descriptors[column].offset), header->numRows);
+        }
+
+        // Views of every non-label column, in file order
+        template <typename T>
+        std::vector<std::span<const T>> featureColumns() const
+        {
+            std::vector<std::span<const T>> columns;
+            for (size_t c = 0; c < getNumColumns(); ++c)
+            {
+                if (!hasLabel() || c != getLabelColumn())
+                    columns.push_back(column<T>(c));
+            }
+            return columns;
+        }
+    };
+
+    // Function to write loaded CSV data as a columnar dataset file (T is float or double)
+    template <typename T>
+    bool SaveColumnarDataset(const CSVData<T> &data, const std::string &filename);
+
+    // Function to convert a CSV file to a columnar dataset file with every column stored as T (float or double)
+    template <typename T>
+    bool ConvertCSVToColumnar(const std::string &csvFilename, const std::string &columnarFilename, const CSVOptions &options = CSVOptions());
+
+    // Function to write a dataset in the Binary record format read by ChunkedDataReader
+    template <typename T>
+    void saveBinaryDataset(const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues, const std::string &filename);
+
+    // Function to create a logistic regression model by streaming the training data from disk.
+    // Memory use is bounded by two chunks: the next chunk is read on a background thread while the current one is processed.
+    LogisticRegressionModel LogisticRegressionStreaming(ChunkedDataReader &reader, const long double learningRate = 0.01, const int numEpochs = 1000, const TrainingCallback &callback = nullptr);
+
+    // Struct to report how closely a quantized model tracks its floating point source
+    struct QuantizationReport
+    {
+        long double floatAccuracy = 0;
+        long double quantizedAccuracy = 0;
+        long double accuracyDelta = 0;
+        long double agreement = 0;
+        long double maxLogitError = 0;
+        long double meanLogitError = 0;
+    };
+
+    // Class for int8 quantized Logistic Regression inference.
+    // Inputs are quantized per feature as x = scale * (q - zeroPoint); the weights hold
+    // coefficient * inputScale quantized symmetrically, so a row is scored with a single
+    // int8 dot product accumulated in int32 and one dequantizing multiply.
+    class QuantizedLogisticRegressionModel
+    {
+    private:
+        std::vector<int8_t> weights;
+        std::vector<long double> inputScales;
+        std::vector<int32_t> inputZeroPoints;
+        long double weightScale = 1;
+        long double bias = 0;
+        int64_t zeroPointOffset = 0;
+
+        void updateZeroPointOffset();
+
+    public:
+        // Constructors
+        QuantizedLogisticRegressionModel();
+        QuantizedLogisticRegressionModel(const std::vector<int8_t> &weights, const std::vector<long double> &inputScales, const std::vector<int32_t> &inputZeroPoints, long double weightScale, long double bias);
+
+        // Getter functions
+        size_t getNumFeatures() const;
+        const std::vector<int8_t> &getWeights() const;
+        const std::vector<long double> &getInputScales() const;
+        const std::vector<int32_t> &getInputZeroPoints() const;
+        long double getWeightScale() const;
+        long double getBias() const;
+
+        // Quantize rows into a contiguous row-major int8 buffer
+        template <typename T>
+        std::vector<int8_t> quantizeInputs(const std::vector<std::vector<T>> &xValues) const;
+
+        // Dequantized logit of one quantized row of getNumFeatures() values
+        long double logit(const int8_t *quantizedRow) const;
+
+        // Predict from rows already produced by quantizeInputs
+        std::vector<int> predictQuantized(const std::vector<int8_t> &quantizedRows, const long double threshold = 0.5) const;
+
+        // Predict function
+        template <typename T>
+        std::vector<int> predict(const std::vector<std::vector<T>> &xValues, const long double threshold = 0.5) const;
+
+        // Save the object to a file
+        void saveToFile(const std::string &filename) const;
+
+        // Load the object from a file
+        void loadFromFile(const std::string &filename);
+
+        friend std::ostream &operator<<(std::ostream &os, const QuantizedLogisticRegressionModel &obj)
+        {
+            os << obj.weights.size() << " ";
+            for (size_t j = 0; j < obj.weights.size(); ++j)
+            {
+                os << static_cast<int>(obj.weights[j]) << " " << obj.inputScales[j] << " " << obj.inputZeroPoints[j] << " ";
+            }
+            os << obj.weightScale << " " << obj.bias << " ";
+            return os;
+        }
+
+        friend std::istream &operator>>(std::istream &is, QuantizedLogisticRegressionModel &obj)
+        {
+            size_t numFeatures;
+            is >> numFeatures;
+            obj.weights.resize(numFeatures);
+            obj.inputScales.resize(numFeatures);
+            obj.inputZeroPoints.resize(numFeatures);
+            for (size_t j = 0; j < numFeatures; ++j)
+            {
+                int weight;
+                is >> weight >> obj.inputScales[j] >> obj.inputZeroPoints[j];
+                obj.weights[j] = static_cast<int8_t>(weight);
+            }
+            is >> obj.weightScale >> obj.bias;
+            obj.updateZeroPointOffset();
+            return is;
+        }
+
+        void printInfo() const;
+    };
+
+    // Function to export a logistic regression model to int8, calibrating input scales and zero points on a sample batch
+    template <typename T>
+    QuantizedLogisticRegressionModel QuantizeLogisticRegression(const LogisticRegressionModel &model, const std::vector<std::vector<T>> &calibrationXValues);
+
+    // Function to measure the accuracy delta and logit error of a quantized model against its source model
+    template <typename T>
+    QuantizationReport EvaluateQuantization(const LogisticRegressionModel &model, const QuantizedLogisticRegressionModel &quantizedModel, const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues, const long double threshold = 0.5);
+
+    // Struct to report the reload history of a model in a ModelRegistry
+    struct ModelRegistryStats
+    {
+        uint64_t version = 0;
+        size_t reloads = 0;
+        size_t failedReloads = 0;
+        std::chrono::nanoseconds lastLoadTime{0};
+        std::chrono::nanoseconds lastSwapTime{0};
+    };
+
+    // Class to serve logistic regression models that are reloaded from their files while in use.
+    // The registered models are published as one immutable snapshot, read-copy-update style: get()
+    // takes no lock, it marks itself active in a reader stripe, loads the snapshot pointer and copies
+    // the model's shared pointer out. A reload, add or remove copies the snapshot, swaps the pointer,
+    // then frees the old snapshot once every reader that could have seen it has left. A caller keeps
+    // the version it fetched for as long as it holds the pointer. Files should be replaced by rename
+    // so a reload never sees a partially written file; a file that fails to load or validate is
+    // skipped until it changes again.
+    class ModelRegistry
+    {
+    public:
+        using ModelPtr = std::shared_ptr<const LogisticRegressionModel>;
+        using Validator = std::function<bool(const LogisticRegressionModel &)>;
+
+        // Constructor, the watcher thread checks the files every pollInterval once started
+        explicit ModelRegistry(std::chrono::milliseconds pollInterval = std::chrono::milliseconds(1000));
+        ~ModelRegistry();
+
+        ModelRegistry(const ModelRegistry &) = delete;
+        ModelRegistry &operator=(const ModelRegistry &) = delete;
+
+        // Register a model file under a name and load it; returns false if the file cannot be loaded or fails validation
+        bool add(const std::string &name, const std::string &filename, Validator validator = Validator());
+
+        // Unregister a model; callers still holding it keep their pointer
+        void remove(const std::string &name);
+
+        // Current version of a model, or nullptr if the name is not registered. Never blocks.
+        ModelPtr get(const std::string &name) const;
+
+        // Reload a model now; returns false and keeps the current version if the file fails to load or validate
+        bool reload(const std::string &name);
+
+        // Reload statistics of a model
+        ModelRegistryStats getStats(const std::string &name) const;
+
+        // Start and stop the background thread that reloads models whose files have changed
+        void start();
+        void stop();
+
+    private:
+        struct Entry
+        {
+            std::string name;
+            std::string filename;
+            Validator validator;
+            std::mutex reloadMutex;
+            int64_t fileTime = 0;
+            uintmax_t fileSize = 0;
+            ModelRegistryStats stats;
+        };
+
+        // Immutable once published
+        struct Snapshot
+        {
+            std::map<std::string, ModelPtr> models;
+        };
+
+        // Readers inside get(), counted by the parity of the epoch they entered in. Readers are spread
+        // over padded stripes by thread so they do not contend for one cache line.
+        struct alignas(64) ReaderStripe
+        {
+            std::atomic<uint64_t> active[2] = {0, 0};
+        };
+
+        static constexpr size_t numReaderStripes = 64;
+
+        ModelPtr loadEntry(Entry &entry, bool onlyIfChanged);
+        bool reloadEntry(Entry &entry, bool onlyIfChanged);
+        void install(Entry &entry, ModelPtr model);
+        std::chrono::nanoseconds publish(const std::string &name, ModelPtr model);
+        void waitForReaders();
+        void watch();
+
+        std::atomic<const Snapshot *> snapshot;
+        mutable std::array<ReaderStripe, numReaderStripes> readers;
+        std::atomic<uint64_t> epoch{0};
+
+        // Guards entries and serializes publishing; never taken by get()
+        mutable std::mutex entriesMutex;
+        std::map<std::string, std::shared_ptr<Entry>> entries;
+
+        std::chrono::milliseconds pollInterval;
+        std::thread watcher;
+        std::mutex watcherMutex;
+        std::condition_variable watcherCondition;
+        bool stopRequested = false;
+    };
+
+    // Wire format of a scoring request on a ScoringServer socket (little-endian), followed by numFeatures float values
+    struct ScoringRequestHeader
+    {
+        static constexpr uint32_t magicNumber = 0x514C4D53; // "SMLQ"
+
+        uint32_t magic = magicNumber;
+        uint32_t requestId = 0;
+        uint32_t numFeatures = 0;
+    };
+
+    // Enumeration for the status of a scoring response
+    enum ScoringStatus : uint32_t
+    {
+        ScoringOk,
+        ScoringFeatureMismatch,
+        ScoringNoModel
+    };
+
+    // Wire format of a scoring response; responses on a connection may arrive out of request order
+    struct ScoringResponse
+    {
+        uint32_t requestId = 0;
+        ScoringStatus status = ScoringOk;
+        double probability = 0.0;
+    };
+
+    static_assert(sizeof(ScoringRequestHeader) == 12 && sizeof(ScoringResponse) == 16, "Scoring protocol structs must be packed");
+
+    // Struct to configure a ScoringServer
+    struct ScoringServerOptions
+    {
+        std::string socketPath = "/tmp/mllib-scoring.sock";
+        std::string modelName = "default"; // Name of the model in the registry
+        size_t maxBatchSize = 64;           // A batch is scored as soon as it has this many requests...
+        std::chrono::microseconds maxDelay{500}; // ...or when its oldest request has waited this long
+        size_t numWorkers = 2;
+        uint32_t maxFeatures = 4096; // Requests with more features are rejected by closing the connection
+    };
+
+    // Struct to report what a ScoringServer has done so far
+    struct ScoringServerStats
+    {
+        size_t connections = 0;
+        size_t requests = 0;
+        size_t batches = 0;
+    };
+
+    // Class to serve logistic regression scores over a Unix domain socket. A reader thread per connection
+    // queues requests, a batcher groups requests from all connections into micro-batches by the
+    // maxBatchSize/maxDelay policy, and a pool of workers scores each batch with one batched call on the
+    // registry's current model and writes the responses back to their connections.
+    class ScoringServer
+    {
+    public:
+        ScoringServer(const ModelRegistry &registry, const ScoringServerOptions &options = ScoringServerOptions());
+        ~ScoringServer();
+
+        ScoringServer(const ScoringServer &) = delete;
+        ScoringServer &operator=(const ScoringServer &) = delete;
+
+        // Bind the socket and start serving; returns false if the socket cannot be created
+        bool start();
+
+        // Stop serving, close every connection and remove the socket file
+        void stop();
+
+        ScoringServerStats getStats() const;
+
+    private:
+        struct Connection;
+
+        struct PendingRequest
+        {
+            std::shared_ptr<Connection> connection;
+            uint32_t requestId = 0;
+            std::vector<float> features;
+            std::chrono::steady_clock::time_point arrival;
+        };
+
+        void acceptConnections();
+        void readRequests(std::shared_ptr<Connection> connection);
+        void formBatches();
+        void scoreBatches();
+
+        const ModelRegistry &registry;
+        ScoringServerOptions options;
+        int listenSocket = -1;
+        std::atomic<bool> running{false};
+
+        std::thread acceptor;
+        std::thread batcher;
+        std::vector<std::thread> workers;
+
+        std::mutex connectionsMutex;
+        std::vector<std::shared_ptr<Connection>> connections;
+
+        std::mutex pendingMutex;
+        std::condition_variable pendingCondition;
+        std::vector<PendingRequest> pending;
+
+        std::mutex batchesMutex;
+        std::condition_variable batchesCondition;
+        std::vector<std::vector<PendingRequest>> readyBatches;
+
+        std::atomic<size_t> numConnections{0}, numRequests{0}, numBatches{0};
+    };
+
+    // Class to talk to a ScoringServer over its socket. Requests can be pipelined: send several, then receive
+    // their responses, matching them by requestId.
+    class ScoringClient
+    {
+    private:
+        int socketDescriptor = -1;
+
+    public:
+        ScoringClient();
+        ~ScoringClient();
+
+        ScoringClient(const ScoringClient &) = delete;
+        ScoringClient &operator=(const ScoringClient &) = delete;
+
+        bool connect(const std::string &socketPath);
+        void close();
+        bool isConnected() const;
+
+        bool send(uint32_t requestId, std::span<const float> features);
+        bool receive(ScoringResponse &response);
+
+        // Send one request and wait for its response
+        bool score(std::span<const float> features, ScoringResponse &response);
+    };
+
+    // Enumeration for the assignment step of k-means. All three give the same clustering: Hamerly keeps an
+    // upper and one lower distance bound per row, Elkan one lower bound per row and cluster, and both use
+    // the triangle inequality to skip distance computations that cannot change a row's cluster.
+    enum KMeansAlgorithm
+    {
+        Lloyd,
+        Hamerly,
+        Elkan
+    };
+
+    // Struct to configure k-means training
+    struct KMeansOptions
+    {
+        size_t numClusters = 8;
+        KMeansAlgorithm algorithm = Hamerly;
+        size_t maxIterations = 300;    // Full passes, or mini-batches for MiniBatchKMeans
+        long double tolerance = 1e-4L; // Stop once the summed squared centroid movement is below tolerance times the mean feature variance
+        size_t batchSize = 1024;       // Rows per mini-batch of MiniBatchKMeans
+        size_t numThreads = 0;         // 0 uses all hardware threads
+        unsigned int seed = 42;
+    };
+
+    // Class for k-means clustering model
+    class KMeansModel
+    {
+    private:
+        std::vector<long double> centroids; // numClusters rows of numFeatures values, row-major
+        size_t numFeatures = 0;
+        std::vector<long double> clusterCounts; // Rows each centroid has absorbed in mini-batch updates
+        long double inertia = 0;                // Sum of squared distances of the training rows to their centroids
+        size_t iterations = 0;
+
+    public:
+        // Constructors
+        KMeansModel();
+        KMeansModel(const std::vector<long double> &centroids, size_t numFeatures);
+
+        // Getter functions
+        size_t getNumClusters() const;
+        size_t getNumFeatures() const;
+        const std::vector<long double> &getCentroids() const;
+        std::span<const long double> getCentroid(size_t cluster) const;
+        const std::vector<long double> &getClusterCounts() const;
+        long double getInertia() const;
+        size_t getIterations() const;
+
+        // Setter functions
+        void setCentroids(const std::vector<long double> &newCentroids, size_t newNumFeatures);
+        void setClusterCounts(const std::vector<long double> &newClusterCounts);
+        void setInertia(long double newInertia);
+        void setIterations(size_t newIterations);
+
+        // Mini-batch update with the rows of a dataset view. An untrained model is first seeded by k-means++
+        // with options.numClusters centroids drawn from these rows.
+        template <typename T>
+        void partialFit(const DatasetView<T> &data, const KMeansOptions &options = KMeansOptions());
+
+        // Index of the nearest centroid of one row
+        template <typename T>
+        size_t predict(std::span<const T> xRow) const;
+
+        // Index of the nearest centroid of every row
+        template <typename T>
+        std::vector<size_t> predict(const std::vector<std::vector<T>> &xValues, size_t numThreads = 0) const;
+
+        template <typename T>
+        std::vector<size_t> predict(const DatasetView<T> &data, size_t numThreads = 0) const;
+
+        // Sum of squared distances of the rows to their nearest centroid
+        template <typename T>
+        long double evaluate(const DatasetView<T> &data, size_t numThreads = 0) const;
+
+        // Text export and import; loadFromFile also accepts binary model files and leaves the model unchanged on a bad file
+        void saveToFile(const std::string &filename) const;
+        void loadFromFile(const std::string &filename);
+
+        // Checksummed binary format; loadBinary returns false and leaves the model unchanged on a bad file
+        bool saveBinary(const std::string &filename) const;
+        bool loadBinary(const std::string &filename);
+
+        // Serialization function
+        friend std::ostream &operator<<(std::ostream &os, const KMeansModel &obj)
+        {
+            os << obj.getNumClusters() << " " << obj.numFeatures << " ";
+            for (const auto &value : obj.centroids)
+            {
+                os << value << " ";
+            }
+            for (const auto &count : obj.clusterCounts)
+            {
+                os << count << " ";
+            }
+            os << obj.inertia << " " << obj.iterations << " ";
+            return os;
+        }
+
+        // Deserialization function; a malformed model sets failbit and leaves obj unchanged
+        friend std::istream &operator>>(std::istream &is, KMeansModel &obj)
+        {
+            // Values are appended one at a time, so a corrupt count fails the stream instead of allocating
+            KMeansModel model;
+            size_t numClusters = 0;
+            is >> numClusters >> model.numFeatures;
+            for (size_t c = 0; is && c < numClusters; ++c)
+            {
+                for (size_t j = 0; is && j < model.numFeatures; ++j)
+                {
+                    long double value;
+                    if (is >> value)
+                        model.centroids.push_back(value);
+                }
+            }
+            for (size_t c = 0; is && c < numClusters; ++c)
+            {
+                long double count;
+                if (is >> count)
+                    model.clusterCounts.push_back(count);
+            }
+            is >> model.inertia >> model.iterations;
+
+            // An untrained model has neither clusters nor features; cluster counts are never negative
+            const bool consistent = (numClusters == 0) == (model.numFeatures == 0) &&
+                                    std::all_of(model.clusterCounts.begin(), model.clusterCounts.end(), [](long double count) { return count >= 0.0L; });
+            if (!is || !consistent)
+            {
+                is.setstate(std::ios::failbit);
+                return is;
+            }
+            obj = std::move(model);
+            return is;
+        }
+
+        void printInfo() const;
+    };
+
+    // Function to cluster the rows of a dataset view by k-means. Centroids are seeded by greedy k-means++
+    // and refined by full passes; distances of blocks of rows to all centroids are computed as one matrix
+    // product, and rows are assigned by numThreads threads. The callback reports the mean squared
+    // distance as the loss and the norm of the centroid movement as the gradient norm.
+    template <typename T>
+    KMeansModel KMeans(const DatasetView<T> &data, const KMeansOptions &options = KMeansOptions(), const TrainingCallback &callback = nullptr);
+
+    template <typename T>
+    KMeansModel KMeans(const std::vector<std::vector<T>> &xValues, const KMeansOptions &options = KMeansOptions(), const TrainingCallback &callback = nullptr);
+
+    // Function to cluster the rows of a dataset view by mini-batch k-means: every iteration moves the
+    // centroids toward the rows of one batch of options.batchSize rows, taken from a fresh shuffle each epoch
+    template <typename T>
+    KMeansModel MiniBatchKMeans(const DatasetView<T> &data, const KMeansOptions &options = KMeansOptions(), const TrainingCallback &callback = nullptr);
+
+    // Enumeration for the tree structure of a NeighborIndex
+    enum NeighborIndexType
+    {
+        KDTree,  // Axis-aligned median splits with a bounding box per node; best on few dimensions
+        BallTree // Median splits with a bounding sphere per node; degrades more gracefully as dimensions grow
+    };
+
+    // Struct to configure a NeighborIndex
+    struct NeighborIndexOptions
+    {
+        NeighborIndexType type = KDTree;
+        stat::NormType metric = stat::NormType::Euclidean; // Manhattan, Euclidean or Infinity distance
+        size_t leafSize = 32;                              // Maximum points per leaf bucket
+    };
+
+    // Struct to hold one result of a neighbour query
+    struct Neighbor
+    {
+        size_t index = 0; // Position of the point in the view the index was built from
+        long double distance = 0;
+    };
+
+    // Class to find the nearest neighbours of queries among a fixed set of points. The tree nodes live in
+    // one array in depth-first order, and the points are copied to double precision in tree order so every
+    // leaf bucket is one contiguous block. A query skips every subtree whose bounding box (KD tree) or
+    // sphere (ball tree) is farther away than the neighbours found so far.
+    class NeighborIndex
+    {
+    private:
+        struct Node
+        {
+            size_t begin = 0; // Points [begin, end) in tree order
+            size_t end = 0;
+            size_t right = 0;    // Index of the right child, 0 for a leaf; the left child follows its parent
+            double radius = 0.0; // Ball tree only
+        };
+
+        NeighborIndexOptions options;
+        size_t numFeatures = 0;
+        std::vector<Node> nodes;
+        std::vector<double> bounds;    // Per node: the minima then the maxima of each feature (KD tree), or the centre (ball tree)
+        std::vector<double> points;    // numFeatures values per point, in tree order
+        std::vector<size_t> positions; // Position in the source view of each point in tree order
+
+        size_t buildNode(const std::vector<double> &source, std::vector<size_t> &order, size_t begin, size_t end);
+
+        template <stat::NormType Metric>
+        double nodeBound(const double *query, size_t node) const;
+
+        template <stat::NormType Metric>
+        void searchNearest(const double *query, size_t node, size_t k, std::vector<Neighbor> &heap, uint64_t &numDistances) const;
+
+        template <stat::NormType Metric>
+        void searchRadius(const double *query, size_t node, double reducedRadius, std::vector<Neighbor> &result, uint64_t &numDistances) const;
+
+        std::vector<Neighbor> nearest(const double *query, size_t k) const;
+        std::vector<Neighbor> withinRadius(const double *query, long double radius) const;
+
+    public:
+        // Constructors, the second builds the index over the rows of a view
+        NeighborIndex();
+
+        template <typename T>
+        NeighborIndex(const DatasetView<T> &data, const NeighborIndexOptions &options = NeighborIndexOptions());
+
+        // Getter functions
+        size_t size() const { return positions.size(); }
+        size_t getNumFeatures() const { return numFeatures; }
+        size_t getNumNodes() const { return nodes.size(); }
+        const NeighborIndexOptions &getOptions() const { return options; }
+
+        // The k nearest points of a query, nearest first
+        template <typename T>
+        std::vector<Neighbor> query(std::span<const T> point, size_t k) const;
+
+        // Every point within radius of a query, nearest first
+        template <typename T>
+        std::vector<Neighbor> queryRadius(std::span<const T> point, long double radius) const;
+
+        // Batched queries, one result per row of the view, run on numThreads threads
+        template <typename T>
+        std::vector<std::vector<Neighbor>> query(const DatasetView<T> &queries, size_t k, size_t numThreads = 0) const;
+
+        template <typename T>
+        std::vector<std::vector<Neighbor>> queryRadius(const DatasetView<T> &queries, long double radius, size_t numThreads = 0) const;
+    };
+
+    // Class for k-nearest-neighbour classification: a row gets the most common label among its numNeighbors
+    // nearest training rows, with votes weighted by inverse distance if distanceWeighted is set. Ties go to
+    // the class of the nearer neighbour.
+    class KNNClassifier
+    {
+    private:
+        NeighborIndex index;
+        std::vector<int> labels;
+        size_t numNeighbors = 5;
+        bool distanceWeighted = false;
+
+        int vote(const std::vector<Neighbor> &neighbors) const;
+
+    public:
+        // Constructors, the second indexes the rows and labels of a view
+        KNNClassifier();
+
+        template <typename T>
+        KNNClassifier(const DatasetView<T> &data, size_t numNeighbors = 5, bool distanceWeighted = false, const NeighborIndexOptions &options = NeighborIndexOptions());
+
+        // Getter functions
+        const NeighborIndex &getIndex() const { return index; }
+        size_t getNumNeighbors() const { return numNeighbors; }
+        bool isDistanceWeighted() const { return distanceWeighted; }
+
+        // Predict function
+        template <typename T>
+        int predict(std::span<const T> xRow) const;
+
+        template <typename T>
+        std::vector<int> predict(const DatasetView<T> &data, size_t numThreads = 0) const;
+    };
+
+    // Class for k-nearest-neighbour regression: a row gets the mean label of its numNeighbors nearest
+    // training rows, weighted by inverse distance if distanceWeighted is set
+    class KNNRegressor
+    {
+    private:
+        NeighborIndex index;
+        std::vector<long double> targets;
+        size_t numNeighbors = 5;
+        bool distanceWeighted = false;
+
+        long double average(const std::vector<Neighbor> &neighbors) const;
+
+    public:
+        // Constructors, the second indexes the rows and labels of a view
+        KNNRegressor();
+
+        template <typename T>
+        KNNRegressor(const DatasetView<T> &data, size_t numNeighbors = 5, bool distanceWeighted = false, const NeighborIndexOptions &options = NeighborIndexOptions());
+
+        // Getter functions
+        const NeighborIndex &getIndex() const { return index; }
+        size_t getNumNeighbors() const { return numNeighbors; }
+        bool isDistanceWeighted() const { return distanceWeighted; }
+
+        // Predict function
+        template <typename T>
+        long double predict(std::span<const T> xRow) const;
+
+        template <typename T>
+        std::vector<long double> predict(const DatasetView<T> &data, size_t numThreads = 0) const;
+    };
+
+    // Enumeration for the distance between vectors used by an HNSWIndex and by PairwiseDistances
+    enum VectorMetric
+    {
+        L2Distance,       // Euclidean distance
+        CosineDistance,   // One minus the cosine similarity; vectors are normalized to unit length when added
+        ManhattanDistance // Sum of the absolute differences
+    };
+
+    // Struct to configure an HNSWIndex
+    struct HNSWOptions
+    {
+        VectorMetric metric = L2Distance;
+        size_t M = 16;               // Links per node on the upper layers; the bottom layer keeps 2 * M
+        size_t efConstruction = 200; // Candidates considered when linking a new node; larger builds a better graph, slower
+        size_t efSearch = 64;        // Default candidates kept by a query; larger raises recall and latency
+        size_t numThreads = 0;       // Threads inserting the rows of addBatch, 0 uses all hardware threads
+        unsigned int seed = 42;      // Seed of the random node layers
+    };
+
+    // Class for approximate nearest-neighbour search over high-dimensional float vectors with a hierarchical
+    // navigable small world graph. Each node lives on layers 0..level with a geometrically distributed
+    // level; a query descends greedily through the sparse upper layers and then runs a best-first search
+    // of efSearch candidates on layer 0. Vectors and links are stored in flat arrays, so a saved index is
+    // opened by mapping the file without copying it. Nodes are inserted concurrently by addBatch under
+    // striped per-node locks; queries may run concurrently with each other but not with insertion.
+    class HNSWIndex
+    {
+    private:
+        // Per-thread marks of the nodes a search has reached; bumping the epoch clears them all
+        struct VisitedSet
+        {
+            std::vector<uint32_t> marks;
+            uint32_t epoch = 0;
+
+            void reset(size_t numNodes);
+            bool insert(uint32_t node);
+        };
+
+        using Candidate = std::pair<float, uint32_t>; // Distance to the query and node
+
+        static constexpr size_t numLockStripes = 4096;
+
+        HNSWOptions options;
+        size_t numFeatures = 0;
+        size_t numNodes = 0;
+        int maxLevel = -1; // Top layer of the graph, -1 while empty
+        uint32_t entryPoint = 0;
+        std::mt19937 levelGenerator;
+
+        // Storage of an index built in memory
+        std::vector<float> vectors;         // numFeatures values per node
+        std::vector<uint32_t> baseLinks;    // Per node: the layer 0 link count, then 2 * M slots
+        std::vector<uint8_t> levels;        // Top layer of each node
+        std::vector<uint64_t> upperOffsets; // Start of each node's upper-layer links in upperLinks, numNodes + 1 entries
+        std::vector<uint32_t> upperLinks;   // Per node and layer above 0: the link count, then M slots
+
+        // Read pointers into the storage above, or into the mapping of an opened file
+        MappedFile file;
+        const float *vectorData = nullptr;
+        const uint32_t *baseLinkData = nullptr;
+        const uint8_t *levelData = nullptr;
+        const uint64_t *upperOffsetData = nullptr;
+        const uint32_t *upperLinkData = nullptr;
+
+        std::unique_ptr<std::mutex[]> nodeLocks; // Guard link lists during insertion, one stripe per id modulo numLockStripes
+        std::unique_ptr<std::mutex> entryLock;   // Guards the entry point and maxLevel during insertion
+        VisitedSet addVisited;                   // Reused by add
+
+        void bindStorage();
+        void detach();
+        size_t reserve(size_t count);
+
+        template <typename T>
+        void storeVector(std::span<const T> point, float *destination) const;
+
+        float distance(const float *a, const float *b) const;
+        size_t maxLinks(size_t level) const { return (level == 0) ? 2 * options.M : options.M; }
+        const float *vectorAt(uint32_t node) const { return vectorData + static_cast<size_t>(node) * numFeatures; }
+        const uint32_t *linksAt(uint32_t node, size_t level) const;
+        uint32_t *mutableLinksAt(uint32_t node, size_t level);
+        std::mutex &nodeLock(uint32_t node) const { return nodeLocks[node % numLockStripes]; }
+
+        template <bool Locked>
+        std::span<const uint32_t> readLinks(uint32_t node, size_t level, std::vector<uint32_t> &buffer) const;
+
+        template <bool Locked>
+        uint32_t greedyClosest(const float *query, uint32_t entry, int topLevel, int bottomLevel, uint64_t &numDistances) const;
+
+        template <bool Locked>
+        std::vector<Candidate> searchLayer(const float *query, uint32_t entry, size_t ef, size_t level, VisitedSet &visited, uint64_t &numDistances) const;
+
+        void selectNeighbors(std::vector<Candidate> &candidates, size_t maxCount, uint64_t &numDistances) const;
+        void linkBack(uint32_t node, uint32_t newNode, float newDistance, size_t level, uint64_t &numDistances);
+        void insert(uint32_t node, VisitedSet &visited);
+        std::vector<Neighbor> search(const float *query, size_t k, size_t ef, VisitedSet &visited) const;
+        std::vector<Neighbor> toNeighbors(std::vector<Candidate> &candidates, size_t k) const;
+
+    public:
+        // Constructors, the third inserts the rows of a view
+        HNSWIndex();
+        explicit HNSWIndex(size_t numFeatures, const HNSWOptions &options = HNSWOptions());
+
+        template <typename T>
+        explicit HNSWIndex(const DatasetView<T> &data, const HNSWOptions &options = HNSWOptions());
+
+        HNSWIndex(HNSWIndex &&other) noexcept = default;
+        HNSWIndex &operator=(HNSWIndex &&other) noexcept = default;
+
+        // Getter functions
+        size_t size() const { return numNodes; }
+        size_t getNumFeatures() const { return numFeatures; }
+        const HNSWOptions &getOptions() const { return options; }
+        int getMaxLevel() const { return maxLevel; }
+        bool isMapped() const { return file.isOpen(); }
+
+        // Setter function for the default candidate list size of queries
+        void setEfSearch(size_t efSearch);
+
+        // Insert one vector and return its id, the number of vectors inserted before it
+        template <typename T>
+        size_t add(std::span<const T> point);
+
+        // Insert the rows of a view on options.numThreads threads; row i gets id size() + i
+        template <typename T>
+        void addBatch(const DatasetView<T> &data);
+
+        // The approximate k nearest vectors of a query, nearest first. efSearch 0 uses options.efSearch;
+        // values below k are raised to k.
+        template <typename T>
+        std::vector<Neighbor> query(std::span<const T> point, size_t k, size_t efSearch = 0) const;
+
+        // Batched queries, one result per row of the view, run on numThreads threads
+        template <typename T>
+        std::vector<std::vector<Neighbor>> query(const DatasetView<T> &queries, size_t k, size_t efSearch = 0, size_t numThreads = 0) const;
+
+        // The exact k nearest vectors by a scan over all vectors, the reference for measuring recall
+        template <typename T>
+        std::vector<Neighbor> exactQuery(std::span<const T> point, size_t k) const;
+
+        template <typename T>
+        std::vector<std::vector<Neighbor>> exactQuery(const DatasetView<T> &queries, size_t k, size_t numThreads = 0) const;
+
+        // Write the graph and vectors to a binary file
+        bool save(const std::string &filename) const;
+
+        // Map a saved index read-only. Queries read vectors and links straight from the mapping; the
+        // first insertion copies them into memory. Returns false and leaves the index unchanged on a bad file.
+        bool open(const std::string &filename);
+    };
+
+    // Struct to hold one tile of a pairwise distance matrix: the distances of rows [rowBegin, rowEnd) of x
+    // to rows [columnBegin, columnEnd) of y, row-major with stride columnEnd - columnBegin
+    struct DistanceTile
+    {
+        size_t rowBegin = 0, rowEnd = 0;
+        size_t columnBegin = 0, columnEnd = 0;
+        const double *distances = nullptr;
+
+        double at(size_t row, size_t column) const { return distances[(row - rowBegin) * (columnEnd - columnBegin) + column - columnBegin]; }
+    };
+
+    using DistanceTileCallback = std::function<void(const DistanceTile &)>;
+
+    // Function to compute the distance of every row of x to every row of y, tile by tile, without forming
+    // the whole matrix. Euclidean and cosine distances come from the products of the rows, |x|^2 + |y|^2 - 2 x.y,
+    // computed as matrix products of blocks of x with packed blocks of y; Manhattan distances use the same
+    // tiles. Bands of x rows run on numThreads threads, and the callback receives the tiles of a band from
+    // one thread, in column order, so per-row state of the band needs no locking. Euclidean distances of
+    // nearly equal rows lose relative precision to cancellation; cosine distances to a zero row are 1.
+    template <typename T>
+    void PairwiseDistanceTiles(const DatasetView<T> &x, const DatasetView<T> &y, VectorMetric metric, const DistanceTileCallback &callback, size_t numThreads = 0);
+
+    // Function to compute the full distance matrix, x.size() rows of y.size() values in row-major order
+    template <typename T>
+    std::vector<double> PairwiseDistances(const DatasetView<T> &x, const DatasetView<T> &y, VectorMetric metric = L2Distance, size_t numThreads = 0);
+
+    // Function to find the k rows of y nearest to each row of x, nearest first, from the tiles
+    template <typename T>
+    std::vector<std::vector<Neighbor>> PairwiseNearest(const DatasetView<T> &x, const DatasetView<T> &y, size_t k, VectorMetric metric = L2Distance, size_t numThreads = 0);
+
+    // Struct to configure PCA and truncated SVD
+    struct PCAOptions
+    {
+        size_t numComponents = 2;
+        size_t oversampling = 10;    // Extra random directions searched beyond numComponents, for accuracy
+        size_t powerIterations = 2;  // Extra passes that sharpen the subspace when the spectrum decays slowly
+        bool center = true;          // Subtract the feature means (PCA); false gives a truncated SVD of the raw rows
+        size_t numThreads = 0;       // 0 uses all hardware threads
+        unsigned int seed = 42;
+    };
+
+    // Class for a principal component analysis (or truncated SVD) model: the feature means and the
+    // principal axes, i.e. the top right singular vectors of the centered data, one row per component
+    class PCAModel
+    {
+    private:
+        std::vector<long double> mean;       // Zero when the data was not centered
+        std::vector<long double> components; // numComponents rows of numFeatures values, row-major, unit length
+        size_t numFeatures = 0;
+        std::vector<long double> explainedVariance; // Variance of the data along each component
+        std::vector<long double> singularValues;
+        long double totalVariance = 0; // Summed variance of all features, the denominator of the explained variance ratio
+
+    public:
+        // Constructors
+        PCAModel();
+        PCAModel(const std::vector<long double> &components, size_t numFeatures);
+
+        // Getter functions
+        size_t getNumComponents() const;
+        size_t getNumFeatures() const;
+        const std::vector<long double> &getMean() const;
+        const std::vector<long double> &getComponents() const;
+        std::span<const long double> getComponent(size_t component) const;
+        const std::vector<long double> &getExplainedVariance() const;
+        std::vector<long double> getExplainedVarianceRatio() const;
+        const std::vector<long double> &getSingularValues() const;
+        long double getTotalVariance() const;
+
+        // Setter functions
+        void setComponents(const std::vector<long double> &newComponents, size_t newNumFeatures);
+        void setMean(const std::vector<long double> &newMean);
+        void setExplainedVariance(const std::vector<long double> &newExplainedVariance, long double newTotalVariance);
+        void setSingularValues(const std::vector<long double> &newSingularValues);
+
+        // Coordinates of one row along the components
+        template <typename T>
+        std::vector<long double> transform(std::span<const T> xRow) const;
+
+        // Coordinates of every row as a double dataset with numComponents features, computed on numThreads
+        // threads in blocks of rows by matrix products. Labels are carried over, or zero if the view has none.
+        template <typename T>
+        Dataset<double> transform(const DatasetView<T> &data, size_t numThreads = 0) const;
+
+        // Row reconstructed from its coordinates
+        std::vector<long double> inverseTransform(std::span<const long double> coordinates) const;
+
+        // Text export and import; loadFromFile also accepts binary model files and leaves the model unchanged on a bad file
+        void saveToFile(const std::string &filename) const;
+        void loadFromFile(const std::string &filename);
+
+        // Checksummed binary format; loadBinary returns false and leaves the model unchanged on a bad file
+        bool saveBinary(const std::string &filename) const;
+        bool loadBinary(const std::string &filename);
+
+        // Serialization function
+        friend std::ostream &operator<<(std::ostream &os, const PCAModel &obj)
+        {
+            os << obj.getNumComponents() << " " << obj.numFeatures << " ";
+            for (const auto &value : obj.mean)
+            {
+                os << value << " ";
+            }
+            for (const auto &value : obj.components)
+            {
+                os << value << " ";
+            }
+            for (size_t c = 0; c < obj.getNumComponents(); ++c)
+            {
+                os << obj.explainedVariance[c] << " " << obj.singularValues[c] << " ";
+            }
+            os << obj.totalVariance << " ";
+            return os;
+        }
+
+        // Deserialization function; a malformed model sets failbit and leaves obj unchanged
+        friend std::istream &operator>>(std::istream &is, PCAModel &obj)
+        {
+            // Values are appended one at a time, so a corrupt count fails the stream instead of allocating
+            PCAModel model;
+            size_t numComponents = 0;
+            is >> numComponents >> model.numFeatures;
+            for (size_t j = 0; is && j < model.numFeatures; ++j)
+            {
+                long double value;
+                if (is >> value)
+                    model.mean.push_back(value);
+            }
+            for (size_t c = 0; is && c < numComponents; ++c)
+            {
+                for (size_t j = 0; is && j < model.numFeatures; ++j)
+                {
+                    long double value;
+                    if (is >> value)
+                        model.components.push_back(value);
+                }
+            }
+            for (size_t c = 0; is && c < numComponents; ++c)
+            {
+                long double variance, singularValue;
+                if (is >> variance >> singularValue)
+                {
+                    model.explainedVariance.push_back(variance);
+                    model.singularValues.push_back(singularValue);
+                }
+            }
+            is >> model.totalVariance;
+
+            // An unfitted model has neither components nor features
+            if (!is || (numComponents == 0) != (model.numFeatures == 0))
+            {
+                is.setstate(std::ios::failbit);
+                return is;
+            }
+            obj = std::move(model);
+            return is;
+        }
+
+        void printInfo() const;
+    };
+
+    // Function to fit PCA by randomized subspace iteration (Halko, Martinsson and Tropp). A random subspace
+    // of numComponents + oversampling directions is multiplied by X^T X, one pass over the rows per
+    // product, and re-orthonormalized by Householder QR, 1 + powerIterations times; a last pass projects
+    // the data onto the subspace, and the eigenvectors of that small projected covariance give the
+    // components. Every pass streams blocks of rows through matrix products on numThreads threads, so
+    // neither the covariance matrix nor a row-sized intermediate is ever formed.
+    template <typename T>
+    PCAModel PCA(const DatasetView<T> &data, const PCAOptions &options = PCAOptions());
+
+    template <typename T>
+    PCAModel PCA(const std::vector<std::vector<T>> &xValues, const PCAOptions &options = PCAOptions());
+
+    // Function to fit PCA on a dataset too large for memory; the file is read powerIterations + 3 times
+    PCAModel PCA(ChunkedDataReader &reader, const PCAOptions &options = PCAOptions());
+
+    // Enumeration for the loss minimized by gradient boosting
+    enum BoostingLoss
+    {
+        SquaredError, // Regression; the model predicts the label
+        LogLoss       // Binary classification with 0/1 labels; the model predicts the probability of class 1
+    };
+
+    // Struct to configure gradient-boosted decision trees
+    struct GBDTOptions
+    {
+        BoostingLoss loss = LogLoss;
+        size_t numTrees = 100;
+        long double learningRate = 0.1L; // Shrinkage applied to every leaf value
+        size_t maxLeaves = 31;           // Leaves per tree; trees grow by splitting the leaf with the largest gain
+        size_t maxDepth = 0;             // 0 for no depth limit
+        size_t maxBins = 255;            // Histogram bins per feature, at most 256 so a bin fits in one byte
+        size_t minSamplesLeaf = 20;
+        long double l2Regularization = 1.0L; // Added to the hessian sum of each leaf
+        long double minSplitGain = 0.0L;
+        size_t numThreads = 0; // 0 uses all hardware threads
+    };
+
+    // Node of a flattened decision tree. A split node sends rows with x[feature] <= value to node left and
+    // the others to node left + 1; a leaf has left == 0 and outputs value.
+    struct GBDTNode
+    {
+        uint32_t feature = 0;
+        uint32_t left = 0;
+        double value = 0.0;
+    };
+
+    // Class for a gradient-boosted decision tree model. The nodes of all trees are stored in one array, each
+    // tree as a contiguous range with sibling nodes next to each other, so scoring walks compact memory.
+    class GBDTModel
+    {
+    private:
+        BoostingLoss loss = LogLoss;
+        long double baseScore = 0; // Raw score before the first tree: the label mean, or its log-odds
+        size_t numFeatures = 0;
+        std::vector<GBDTNode> nodes;
+        std::vector<uint32_t> treeOffsets;         // First node of each tree
+        std::vector<long double> featureImportance; // Loss reduction summed over the splits on each feature
+
+        template <typename T>
+        double rawScore(const T *xRow) const;
+
+        // True if the feature importances, tree offsets and trees are consistent, so scoring stays in bounds
+        bool isValid() const;
+
+    public:
+        // Constructors
+        GBDTModel();
+        GBDTModel(BoostingLoss loss, long double baseScore, size_t numFeatures);
+
+        // Getter functions
+        BoostingLoss getLoss() const;
+        long double getBaseScore() const;
+        size_t getNumFeatures() const;
+        size_t getNumTrees() const;
+        const std::vector<GBDTNode> &getNodes() const;
+        const std::vector<uint32_t> &getTreeOffsets() const;
+        const std::vector<long double> &getFeatureImportance() const;
+
+        // Append a tree whose child indices are relative to its first node; returns false if it is malformed
+        bool addTree(const std::vector<GBDTNode> &treeNodes);
+        void setFeatureImportance(const std::vector<long double> &newFeatureImportance);
+
+        // Raw score of one row: the base score plus the leaf values of every tree
+        template <typename T>
+        long double predictRaw(std::span<const T> xRow) const;
+
+        // Predicted value (SquaredError) or probability of class 1 (LogLoss) of one row
+        template <typename T>
+        long double predict(std::span<const T> xRow) const;
+
+        // Predictions for every row, computed on numThreads threads. Blocks of rows go through one tree at a
+        // time, so each tree stays in cache while the block is scored.
+        template <typename T>
+        std::vector<long double> predict(const DatasetView<T> &data, size_t numThreads = 0) const;
+
+        // Classes of the rows, 1 if the probability is at least the threshold (LogLoss models)
+        template <typename T>
+        std::vector<int> predictClasses(const DatasetView<T> &data, const long double threshold = 0.5, size_t numThreads = 0) const;
+
+        // Text export and import; loadFromFile also accepts binary model files and leaves the model unchanged on a bad file
+        void saveToFile(const std::string &filename) const;
+        void loadFromFile(const std::string &filename);
+
+        // Checksummed binary format; loadBinary returns false and leaves the model unchanged on a bad file
+        bool saveBinary(const std::string &filename) const;
+        bool loadBinary(const std::string &filename);
+
+        // Serialization function
+        friend std::ostream &operator<<(std::ostream &os, const GBDTModel &obj)
+        {
+            os << static_cast<int>(obj.loss) << " " << obj.baseScore << " " << obj.numFeatures << " ";
+            for (const auto &value : obj.featureImportance)
+            {
+                os << value << " ";
+            }
+            os << obj.getNumTrees() << " " << obj.nodes.size() << " ";
+            for (const auto &offset : obj.treeOffsets)
+            {
+                os << offset << " ";
+            }
+            for (const auto &node : obj.nodes)
+            {
+                os << node.feature << " " << node.left << " " << node.value << " ";
+            }
+            return os;
+        }
+
+        // Deserialization function; a malformed model sets failbit and leaves obj unchanged
+        friend std::istream &operator>>(std::istream &is, GBDTModel &obj)
+        {
+            // Values are appended one at a time, so a corrupt count fails the stream instead of allocating
+            GBDTModel model;
+            int lossInt = -1;
+            is >> lossInt >> model.baseScore >> model.numFeatures;
+            for (size_t j = 0; is && j < model.numFeatures; ++j)
+            {
+                long double value;
+                if (is >> value)
+                    model.featureImportance.push_back(value);
+            }
+            size_t numTrees = 0, numNodes = 0;
+            is >> numTrees >> numNodes;
+            for (size_t t = 0; is && t < numTrees; ++t)
+            {
+                uint32_t offset;
+                if (is >> offset)
+                    model.treeOffsets.push_back(offset);
+            }
+            for (size_t n = 0; is && n < numNodes; ++n)
+            {
+                GBDTNode node;
+                if (is >> node.feature >> node.left >> node.value)
+                    model.nodes.push_back(node);
+            }
+
+            if (!is || lossInt < SquaredError || lossInt > LogLoss)
+            {
+                is.setstate(std::ios::failbit);
+                return is;
+            }
+            model.loss = static_cast<BoostingLoss>(lossInt);
+            if (!model.isValid())
+            {
+                is.setstate(std::ios::failbit);
+                return is;
+            }
+            obj = std::move(model);
+            return is;
+        }
+
+        void printInfo() const;
+    };
+
+    // Function to train gradient-boosted decision trees on the rows of a dataset view. Features are first
+    // bucketed into at most maxBins quantile bins and stored as one byte per value. Each tree then grows
+    // leaf-wise from per-leaf histograms of gradient and hessian sums: a split builds the histogram of the
+    // smaller child over its rows, on numThreads threads over row blocks, and derives the larger child's by
+    // subtracting it from the parent's. The callback reports the training loss after every tree.
+    template <typename T>
+    GBDTModel GradientBoosting(const DatasetView<T> &data, const GBDTOptions &options = GBDTOptions(), const TrainingCallback &callback = nullptr);
+
+    template <typename T>
+    GBDTModel GradientBoosting(const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues, const GBDTOptions &options = GBDTOptions(), const TrainingCallback &callback = nullptr);
+
+    // Function to evaluate the classes a LogLoss model predicts for the rows of a view against their labels
+    template <typename T>
+    ClassificationMetrics EvaluateClassification(const GBDTModel &model, const DatasetView<T> &data, const long double threshold = 0.5);
+
+    // Enumeration for the feature model of a naive Bayes classifier
+    enum NaiveBayesType
+    {
+        GaussianNaiveBayes,    // Continuous features, normal within each class
+        MultinomialNaiveBayes, // Non-negative counts, e.g. word or event counts
+        BernoulliNaiveBayes    // Presence or absence of each feature
+    };
+
+    // Struct to configure naive Bayes training
+    struct NaiveBayesOptions
+    {
+        NaiveBayesType type = GaussianNaiveBayes;
+        long double alpha = 1.0L;              // Additive smoothing of the Multinomial and Bernoulli counts
+        long double varianceSmoothing = 1e-9L; // Gaussian: fraction of the largest feature variance added to every variance
+        long double binarizeThreshold = 0.0L;  // Bernoulli: a feature is present if its value is above the threshold
+        size_t numThreads = 0;                 // 0 uses all hardware threads
+    };
+
+    // Class for a naive Bayes classifier. The model keeps the sufficient statistics of every class (row count,
+    // feature sums, and for Gaussian models the squared deviations from the class means), so batches can be
+    // added with partialFit and models trained on separate shards combined with merge. Scoring parameters
+    // are derived from the statistics, and the log joint probabilities of a block of rows are one matrix
+    // product with them.
+    class NaiveBayesModel
+    {
+    private:
+        NaiveBayesOptions options;
+        size_t numFeatures = 0;
+        std::vector<int> classes;                    // Sorted class labels
+        std::vector<long double> classCounts;        // Rows of each class
+        std::vector<long double> featureSums;        // numClasses rows of numFeatures values: sums of the values, or for Bernoulli, counts of present features
+        std::vector<long double> squaredDeviations;  // Gaussian: sums of squared deviations from the class means, same layout
+
+        // Scoring parameters: log joint = features' * weights + biases, where the scoring features are the
+        // values (Multinomial), their presence (Bernoulli) or the shifted values and their squares (Gaussian)
+        std::vector<double> weights; // numScoringFeatures rows of numClasses values
+        std::vector<double> biases;
+        std::vector<double> shift; // Gaussian: the overall feature means, subtracted before scoring
+
+        void updateParameters();
+
+        // True if the classes are sorted and seen at least once and the statistics have the sizes the type needs
+        bool isValid() const;
+
+        template <typename T>
+        void scoringFeatures(std::span<const T> xRow, double *out) const;
+
+        template <typename T, typename Visit>
+        void scoreRows(const DatasetView<T> &data, size_t numThreads, Visit visit) const;
+
+    public:
+        // Constructors
+        NaiveBayesModel();
+        explicit NaiveBayesModel(const NaiveBayesOptions &options);
+
+        // Getter functions
+        NaiveBayesType getType() const;
+        const NaiveBayesOptions &getOptions() const;
+        size_t getNumFeatures() const;
+        size_t getNumClasses() const;
+        const std::vector<int> &getClasses() const;
+        const std::vector<long double> &getClassCounts() const;
+        const std::vector<long double> &getFeatureSums() const;
+        const std::vector<long double> &getSquaredDeviations() const;
+
+        // Add the rows of a view to the statistics in one pass, on options.numThreads threads. Labels are
+        // rounded to int class labels; classes not seen before are added.
+        template <typename T>
+        void partialFit(const DatasetView<T> &data);
+
+        // Add the statistics of a model of the same type and number of features, e.g. one trained on another shard
+        void merge(const NaiveBayesModel &other);
+
+        // Log posterior probability of each class for one row, in the order of getClasses()
+        template <typename T>
+        std::vector<long double> predictLogProbabilities(std::span<const T> xRow) const;
+
+        // Most probable class of one row
+        template <typename T>
+        int predict(std::span<const T> xRow) const;
+
+        // Posterior probabilities of every row, numClasses values per row in row-major order
+        template <typename T>
+        std::vector<long double> predictProbabilities(const DatasetView<T> &data, size_t numThreads = 0) const;
+
+        // Most probable class of every row
+        template <typename T>
+        std::vector<int> predict(const DatasetView<T> &data, size_t numThreads = 0) const;
+
+        // Text export and import; loadFromFile also accepts binary model files and leaves the model unchanged on a bad file
+        void saveToFile(const std::string &filename) const;
+        void loadFromFile(const std::string &filename);
+
+        // Checksummed binary format; loadBinary returns false and leaves the model unchanged on a bad file
+        bool saveBinary(const std::string &filename) const;
+        bool loadBinary(const std::string &filename);
+
+        // Serialization function
+        friend std::ostream &operator<<(std::ostream &os, const NaiveBayesModel &obj)
+        {
+            os << static_cast<int>(obj.options.type) << " " << obj.options.alpha << " " << obj.options.varianceSmoothing << " "
+               << obj.options.binarizeThreshold << " " << obj.numFeatures << " " << obj.classes.size() << " ";
+            for (size_t c = 0; c < obj.classes.size(); ++c)
+            {
+                os << obj.classes[c] << " " << obj.classCounts[c] << " ";
+            }
+            for (const auto &value : obj.featureSums)
+            {
+                os << value << " ";
+            }
+            for (const auto &value : obj.squaredDeviations)
+            {
+                os << value << " ";
+            }
+            return os;
+        }
+
+        // Deserialization function; a malformed model sets failbit and leaves obj unchanged
+        friend std::istream &operator>>(std::istream &is, NaiveBayesModel &obj)
+        {
+            // Values are appended one at a time, so a corrupt count fails the stream instead of allocating
+            NaiveBayesModel model;
+            int typeInt = -1;
+            size_t numClasses = 0;
+            is >> typeInt >> model.options.alpha >> model.options.varianceSmoothing >> model.options.binarizeThreshold >> model.numFeatures >> numClasses;
+            for (size_t c = 0; is && c < numClasses; ++c)
+            {
+                int label;
+                long double count;
+                if (is >> label >> count)
+                {
+                    model.classes.push_back(label);
+                    model.classCounts.push_back(count);
+                }
+            }
+            const size_t numStatistics = (typeInt == GaussianNaiveBayes) ? 2 : 1;
+            for (size_t k = 0; k < numStatistics; ++k)
+            {
+                std::vector<long double> &values = (k == 0) ? model.featureSums : model.squaredDeviations;
+                for (size_t c = 0; is && c < numClasses; ++c)
+                {
+                    for (size_t j = 0; is && j < model.numFeatures; ++j)
+                    {
+                        long double value;
+                        if (is >> value)
+                            values.push_back(value);
+                    }
+                }
+            }
+
+            if (!is || typeInt < GaussianNaiveBayes || typeInt > BernoulliNaiveBayes)
+            {
+                is.setstate(std::ios::failbit);
+                return is;
+            }
+            model.options.type = static_cast<NaiveBayesType>(typeInt);
+            if (!model.isValid())
+            {
+                is.setstate(std::ios::failbit);
+                return is;
+            }
+            model.options.numThreads = obj.options.numThreads;
+            model.updateParameters();
+            obj = std::move(model);
+            return is;
+        }
+
+        void printInfo() const;
+    };
+
+    // Function to train a naive Bayes classifier on the rows of a dataset view in one pass
+    template <typename T>
+    NaiveBayesModel NaiveBayes(const DatasetView<T> &data, const NaiveBayesOptions &options = NaiveBayesOptions());
+
+    template <typename T>
+    NaiveBayesModel NaiveBayes(const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues, const NaiveBayesOptions &options = NaiveBayesOptions());
+
+    // Function to evaluate the classes a naive Bayes model predicts for the rows of a view against 0/1 labels
+    template <typename T>
+    ClassificationMetrics EvaluateClassification(const NaiveBayesModel &model, const DatasetView<T> &data);
+
+} // namespace mlLib
+
+#if defined(MLLIB_HEADER_ONLY)
+#include "../src/mlLib.cpp"
+#endif
 
 #endif // ML_LIB_H
\ No newline at end of file
@@ -0,0 +1,12 @@
+#ifndef ML_LIB_HPP
+#define ML_LIB_HPP
+
+// Header-only mlLib: include this instead of mlLib.h (in every translation unit that uses the
+// library) and do not link lib/mlLib.a
+#ifndef MLLIB_HEADER_ONLY
+#define MLLIB_HEADER_ONLY
+#endif
+
+#include "mlLib.h"
+
+#endif // ML_LIB_HPP
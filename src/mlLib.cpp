@@ -1,9 +1,28 @@
 #include "../include/mlLib.h"
 
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <numbers>
+#include <queue>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// On x86 the SIMD kernels are compiled for AVX2 on their own and chosen at run time, so a build
+// without -mavx2 still uses them on CPUs that support them
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MLLIB_AVX2_KERNELS
+#define MLLIB_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+#endif
+
 namespace prob
 {
 
-    double factorial(int n)
+    MLLIB_INLINE double factorial(int n)
     {
         if (n == 0 || n == 1)
             return 1;
@@ -17,34 +36,79 @@ namespace prob
         return result;
     }
 
-    double combinations(int n, int k)
+    MLLIB_INLINE double combinations(int n, int k)
     {
         if (k > n)
             return 0;
         return prob::factorial(n) / (prob::factorial(k) * prob::factorial(n - k));
     }
 
-    double permutations(int n, int k)
+    MLLIB_INLINE double permutations(int n, int k)
     {
         if (k > n)
             return 0;
         return prob::factorial(n) / prob::factorial(n - k);
     }
 
-    double binomialProbability(int n, int k, double p)
+    MLLIB_INLINE double binomialProbability(int n, int k, double p)
     {
         if (k > n || p < 0 || p > 1)
             return 0.0;
         return prob::combinations(n, k) * std::pow(p, k) * std::pow(1 - p, n - k);
     }
 
-    double poissonProbability(int k, double lambda)
+    MLLIB_INLINE double poissonProbability(int k, double lambda)
     {
         if (lambda < 0)
             return 0.0;
         return (std::exp(-lambda) * std::pow(lambda, k)) / prob::factorial(k);
     }
 
+    MLLIB_INLINE double logBinomialProbability(int n, int k, double p)
+    {
+        if (k < 0 || k > n || p < 0 || p > 1)
+            return -std::numeric_limits<double>::infinity();
+
+        double result = std::lgamma(n + 1.0) - std::lgamma(k + 1.0) - std::lgamma(n - k + 1.0);
+        if (k > 0)
+            result += k * std::log(p);
+        if (n - k > 0)
+            result += (n - k) * std::log1p(-p);
+        return result;
+    }
+
+    MLLIB_INLINE double logPoissonProbability(int k, double lambda)
+    {
+        if (k < 0 || lambda < 0)
+            return -std::numeric_limits<double>::infinity();
+        if (k == 0)
+            return -lambda;
+        return k * std::log(lambda) - lambda - std::lgamma(k + 1.0);
+    }
+
+    MLLIB_INLINE double normalLogDensity(double x, double mean, double variance)
+    {
+        const double deviation = x - mean;
+        return -0.5 * (std::log(2.0 * std::numbers::pi * variance) + deviation * deviation / variance);
+    }
+
+    MLLIB_INLINE double logSumExp(std::span<const double> values)
+    {
+        if (values.empty())
+            return -std::numeric_limits<double>::infinity();
+
+        const double largest = *std::max_element(values.begin(), values.end());
+        if (!std::isfinite(largest))
+            return largest;
+
+        double sum = 0.0;
+        for (const double value : values)
+        {
+            sum += std::exp(value - largest);
+        }
+        return largest + std::log(sum);
+    }
+
 } // namespace probability
 
 namespace stat
@@ -88,6 +152,7 @@ namespace stat
         return result;
     }
 
+#if !defined(MLLIB_HEADER_ONLY)
     template long double Norm(const std::vector<int8_t> &vectorA, NormType normType);
     template long double Norm(const std::vector<int16_t> &vectorA, NormType normType);
     template long double Norm(const std::vector<int32_t> &vectorA, NormType normType);
@@ -101,15 +166,17 @@ namespace stat
     template long double Norm(const std::vector<float> &vectorA, NormType normType);
     template long double Norm(const std::vector<double> &vectorA, NormType normType);
     template long double Norm(const std::vector<long double> &vectorA, NormType normType);
+#endif
 
     template <typename T>
     long double Mean(const std::vector<T> &vectorA)
     {
         assert(("Vector is empty" && !vectorA.empty()));
 
-        return static_cast<long double>(std::accumulate(vectorA.begin(), vectorA.end(), 0)) / vectorA.size();
+        return std::accumulate(vectorA.begin(), vectorA.end(), 0.0L) / vectorA.size();
     }
 
+#if !defined(MLLIB_HEADER_ONLY)
     template long double Mean(const std::vector<int8_t> &vectorA);
     template long double Mean(const std::vector<int16_t> &vectorA);
     template long double Mean(const std::vector<int32_t> &vectorA);
@@ -123,6 +190,7 @@ namespace stat
     template long double Mean(const std::vector<float> &vectorA);
     template long double Mean(const std::vector<double> &vectorA);
     template long double Mean(const std::vector<long double> &vectorA);
+#endif
 
     template <typename T>
     long double standardDeviation(const std::vector<T> &vectorA)
@@ -142,6 +210,7 @@ namespace stat
         return std::sqrt(sumSquaredDiffs / static_cast<long double>(vecLen - 1));
     }
 
+#if !defined(MLLIB_HEADER_ONLY)
     template long double standardDeviation(const std::vector<int8_t> &vectorA);
     template long double standardDeviation(const std::vector<int16_t> &vectorA);
     template long double standardDeviation(const std::vector<int32_t> &vectorA);
@@ -155,6 +224,7 @@ namespace stat
     template long double standardDeviation(const std::vector<float> &vectorA);
     template long double standardDeviation(const std::vector<double> &vectorA);
     template long double standardDeviation(const std::vector<long double> &vectorA);
+#endif
 
     template <typename T>
     std::vector<long double> Normalize(const std::vector<T> &vectorA, NormalizationType type)
@@ -212,6 +282,7 @@ namespace stat
         return normalizedVector;
     }
 
+#if !defined(MLLIB_HEADER_ONLY)
     template std::vector<long double> Normalize(const std::vector<int8_t> &vectorA, NormalizationType type);
     template std::vector<long double> Normalize(const std::vector<int16_t> &vectorA, NormalizationType type);
     template std::vector<long double> Normalize(const std::vector<int32_t> &vectorA, NormalizationType type);
@@ -225,6 +296,7 @@ namespace stat
     template std::vector<long double> Normalize(const std::vector<float> &vectorA, NormalizationType type);
     template std::vector<long double> Normalize(const std::vector<double> &vectorA, NormalizationType type);
     template std::vector<long double> Normalize(const std::vector<long double> &vectorA, NormalizationType type);
+#endif
 
 } // namespace Statistics
 
@@ -248,6 +320,7 @@ namespace vecAlg
         return result;
     }
 
+#if !defined(MLLIB_HEADER_ONLY)
     template std::vector<int8_t> vectorAdd(const std::vector<int8_t> &vectorA, const std::vector<int8_t> &vectorB);
     template std::vector<int16_t> vectorAdd(const std::vector<int16_t> &vectorA, const std::vector<int16_t> &vectorB);
     template std::vector<int32_t> vectorAdd(const std::vector<int32_t> &vectorA, const std::vector<int32_t> &vectorB);
@@ -261,6 +334,7 @@ namespace vecAlg
     template std::vector<float> vectorAdd(const std::vector<float> &vectorA, const std::vector<float> &vectorB);
     template std::vector<double> vectorAdd(const std::vector<double> &vectorA, const std::vector<double> &vectorB);
     template std::vector<long double> vectorAdd(const std::vector<long double> &vectorA, const std::vector<long double> &vectorB);
+#endif
 
     template <typename T>
     std::vector<T> vectorSubtract(const std::vector<T> &vectorA, const std::vector<T> &vectorB)
@@ -280,6 +354,7 @@ namespace vecAlg
         return result;
     }
 
+#if !defined(MLLIB_HEADER_ONLY)
     template std::vector<int8_t> vectorSubtract(const std::vector<int8_t> &vectorA, const std::vector<int8_t> &vectorB);
     template std::vector<int16_t> vectorSubtract(const std::vector<int16_t> &vectorA, const std::vector<int16_t> &vectorB);
     template std::vector<int32_t> vectorSubtract(const std::vector<int32_t> &vectorA, const std::vector<int32_t> &vectorB);
@@ -293,6 +368,7 @@ namespace vecAlg
     template std::vector<float> vectorSubtract(const std::vector<float> &vectorA, const std::vector<float> &vectorB);
     template std::vector<double> vectorSubtract(const std::vector<double> &vectorA, const std::vector<double> &vectorB);
     template std::vector<long double> vectorSubtract(const std::vector<long double> &vectorA, const std::vector<long double> &vectorB);
+#endif
 
     template <typename T>
     long double Magnitude(const std::vector<T> &vectorA)
@@ -310,6 +386,7 @@ namespace vecAlg
         return std::sqrt(result);
     }
 
+#if !defined(MLLIB_HEADER_ONLY)
     template long double Magnitude(const std::vector<int8_t> &vectorA);
     template long double Magnitude(const std::vector<int16_t> &vectorA);
     template long double Magnitude(const std::vector<int32_t> &vectorA);
@@ -323,6 +400,7 @@ namespace vecAlg
     template long double Magnitude(const std::vector<float> &vectorA);
     template long double Magnitude(const std::vector<double> &vectorA);
     template long double Magnitude(const std::vector<long double> &vectorA);
+#endif
 
     template <typename T>
     size_t DotProduct(const std::vector<T> &vectorA, const std::vector<T> &vectorB)
@@ -342,6 +420,7 @@ namespace vecAlg
         return result;
     }
 
+#if !defined(MLLIB_HEADER_ONLY)
     template size_t DotProduct(const std::vector<int8_t> &vectorA, const std::vector<int8_t> &vectorB);
     template size_t DotProduct(const std::vector<int16_t> &vectorA, const std::vector<int16_t> &vectorB);
     template size_t DotProduct(const std::vector<int32_t> &vectorA, const std::vector<int32_t> &vectorB);
@@ -355,6 +434,7 @@ namespace vecAlg
     template size_t DotProduct(const std::vector<float> &vectorA, const std::vector<float> &vectorB);
     template size_t DotProduct(const std::vector<double> &vectorA, const std::vector<double> &vectorB);
     template size_t DotProduct(const std::vector<long double> &vectorA, const std::vector<long double> &vectorB);
+#endif
 
     template <typename T>
     long double Angle(const std::vector<T> &vectorA, const std::vector<T> &vectorB, Angles angleUnit)
@@ -363,11 +443,17 @@ namespace vecAlg
                ("Vector 2 is empty" && !vectorB.empty()) &&
                ("Vector dimensions do not match" && vectorA.size() == vectorB.size()));
 
-        const long double dotProd = DotProduct(vectorA, vectorB);
-        const long double magnitudeA = Magnitude(vectorA);
-        const long double magnitudeB = Magnitude(vectorB);
+        // Dot product and both squared magnitudes in one pass; PairwiseDistances compares many vectors at once
+        long double dotProd = 0.0L, squaredA = 0.0L, squaredB = 0.0L;
+        for (size_t i = 0; i < vectorA.size(); i++)
+        {
+            const long double a = vectorA[i], b = vectorB[i];
+            dotProd += a * b;
+            squaredA += a * a;
+            squaredB += b * b;
+        }
 
-        long double cos_theta = dotProd / (magnitudeA * magnitudeB);
+        long double cos_theta = dotProd / std::sqrt(squaredA * squaredB);
 
         cos_theta = std::max(-1.0L, std::min(1.0L, cos_theta));
         long double theta = std::acos(cos_theta);
@@ -380,6 +466,7 @@ namespace vecAlg
         return theta;
     }
 
+#if !defined(MLLIB_HEADER_ONLY)
     template long double vecAlg::Angle(const std::vector<int8_t> &vectorA, const std::vector<int8_t> &vectorB, Angles angleUnit);
     template long double vecAlg::Angle(const std::vector<int16_t> &vectorA, const std::vector<int16_t> &vectorB, Angles angleUnit);
     template long double vecAlg::Angle(const std::vector<int32_t> &vectorA, const std::vector<int32_t> &vectorB, Angles angleUnit);
@@ -393,6 +480,7 @@ namespace vecAlg
     template long double vecAlg::Angle(const std::vector<float> &vectorA, const std::vector<float> &vectorB, Angles angleUnit);
     template long double vecAlg::Angle(const std::vector<double> &vectorA, const std::vector<double> &vectorB, Angles angleUnit);
     template long double vecAlg::Angle(const std::vector<long double> &vectorA, const std::vector<long double> &vectorB, Angles angleUnit);
+#endif
 
     template <typename T>
     std::vector<long double> scalarMultiply(const std::vector<T> &vectorA, long double scalar)
@@ -413,6 +501,7 @@ namespace vecAlg
 
         return result;
     }
+#if !defined(MLLIB_HEADER_ONLY)
     template std::vector<long double> vecAlg::scalarMultiply(const std::vector<int8_t> &vectorA, long double scalar);
     template std::vector<long double> vecAlg::scalarMultiply(const std::vector<int16_t> &vectorA, long double scalar);
     template std::vector<long double> vecAlg::scalarMultiply(const std::vector<int32_t> &vectorA, long double scalar);
@@ -426,6 +515,7 @@ namespace vecAlg
     template std::vector<long double> vecAlg::scalarMultiply(const std::vector<float> &vectorA, long double scalar);
     template std::vector<long double> vecAlg::scalarMultiply(const std::vector<double> &vectorA, long double scalar);
     template std::vector<long double> vecAlg::scalarMultiply(const std::vector<long double> &vectorA, long double scalar);
+#endif
 
     template <typename T>
     std::vector<long double> scalarDivide(const std::vector<T> &vectorA, long double scalar)
@@ -444,6 +534,7 @@ namespace vecAlg
         return result;
     }
 
+#if !defined(MLLIB_HEADER_ONLY)
     template std::vector<long double> vecAlg::scalarDivide(const std::vector<int8_t> &vectorA, long double scalar);
     template std::vector<long double> vecAlg::scalarDivide(const std::vector<int16_t> &vectorA, long double scalar);
     template std::vector<long double> vecAlg::scalarDivide(const std::vector<int32_t> &vectorA, long double scalar);
@@ -457,6 +548,7 @@ namespace vecAlg
     template std::vector<long double> vecAlg::scalarDivide(const std::vector<float> &vectorA, long double scalar);
     template std::vector<long double> vecAlg::scalarDivide(const std::vector<double> &vectorA, long double scalar);
     template std::vector<long double> vecAlg::scalarDivide(const std::vector<long double> &vectorA, long double scalar);
+#endif
 
     template <typename T>
     std::vector<long double> elementwiseMultiply(const std::vector<T> &vectorA, const std::vector<T> &vectorB)
@@ -476,6 +568,7 @@ namespace vecAlg
         return result;
     }
 
+#if !defined(MLLIB_HEADER_ONLY)
     template std::vector<long double> vecAlg::elementwiseMultiply(const std::vector<int8_t> &vectorA, const std::vector<int8_t> &vectorB);
     template std::vector<long double> vecAlg::elementwiseMultiply(const std::vector<int16_t> &vectorA, const std::vector<int16_t> &vectorB);
     template std::vector<long double> vecAlg::elementwiseMultiply(const std::vector<int32_t> &vectorA, const std::vector<int32_t> &vectorB);
@@ -489,6 +582,7 @@ namespace vecAlg
     template std::vector<long double> vecAlg::elementwiseMultiply(const std::vector<float> &vectorA, const std::vector<float> &vectorB);
     template std::vector<long double> vecAlg::elementwiseMultiply(const std::vector<double> &vectorA, const std::vector<double> &vectorB);
     template std::vector<long double> vecAlg::elementwiseMultiply(const std::vector<long double> &vectorA, const std::vector<long double> &vectorB);
+#endif
 
     template <typename T>
     std::vector<long double> elementwiseDivide(const std::vector<T> &vectorA, const std::vector<T> &vectorB)
@@ -511,6 +605,7 @@ namespace vecAlg
         return result;
     }
 
+#if !defined(MLLIB_HEADER_ONLY)
     template std::vector<long double> vecAlg::elementwiseDivide(const std::vector<int8_t> &vectorA, const std::vector<int8_t> &vectorB);
     template std::vector<long double> vecAlg::elementwiseDivide(const std::vector<int16_t> &vectorA, const std::vector<int16_t> &vectorB);
     template std::vector<long double> vecAlg::elementwiseDivide(const std::vector<int32_t> &vectorA, const std::vector<int32_t> &vectorB);
@@ -524,6 +619,7 @@ namespace vecAlg
     template std::vector<long double> vecAlg::elementwiseDivide(const std::vector<float> &vectorA, const std::vector<float> &vectorB);
     template std::vector<long double> vecAlg::elementwiseDivide(const std::vector<double> &vectorA, const std::vector<double> &vectorB);
     template std::vector<long double> vecAlg::elementwiseDivide(const std::vector<long double> &vectorA, const std::vector<long double> &vectorB);
+#endif
 
 } // namespace vecAlg
 
@@ -548,6 +644,7 @@ namespace matAlg
         return transposeMatrix;
     }
 
+#if !defined(MLLIB_HEADER_ONLY)
     template std::vector<std::vector<int8_t>> matrixTranspose(const std::vector<std::vector<int8_t>> &matrixA);
     template std::vector<std::vector<int16_t>> matrixTranspose(const std::vector<std::vector<int16_t>> &matrixA);
     template std::vector<std::vector<int32_t>> matrixTranspose(const std::vector<std::vector<int32_t>> &matrixA);
@@ -561,6 +658,7 @@ namespace matAlg
     template std::vector<std::vector<float>> matrixTranspose(const std::vector<std::vector<float>> &matrixA);
     template std::vector<std::vector<double>> matrixTranspose(const std::vector<std::vector<double>> &matrixA);
     template std::vector<std::vector<long double>> matrixTranspose(const std::vector<std::vector<long double>> &matrixA);
+#endif
 
     template <typename T>
     std::vector<std::vector<T>> matrixMultiplication(const std::vector<std::vector<T>> &matrixA, const std::vector<std::vector<T>> &matrixB)
@@ -594,6 +692,7 @@ namespace matAlg
     }
 
     // Template instantiation for various types
+#if !defined(MLLIB_HEADER_ONLY)
     template std::vector<std::vector<int8_t>> matrixMultiplication(const std::vector<std::vector<int8_t>> &matrixA, const std::vector<std::vector<int8_t>> &matrixB);
     template std::vector<std::vector<int16_t>> matrixMultiplication(const std::vector<std::vector<int16_t>> &matrixA, const std::vector<std::vector<int16_t>> &matrixB);
     template std::vector<std::vector<int32_t>> matrixMultiplication(const std::vector<std::vector<int32_t>> &matrixA, const std::vector<std::vector<int32_t>> &matrixB);
@@ -607,341 +706,9278 @@ namespace matAlg
     template std::vector<std::vector<float>> matrixMultiplication(const std::vector<std::vector<float>> &matrixA, const std::vector<std::vector<float>> &matrixB);
     template std::vector<std::vector<double>> matrixMultiplication(const std::vector<std::vector<double>> &matrixA, const std::vector<std::vector<double>> &matrixB);
     template std::vector<std::vector<long double>> matrixMultiplication(const std::vector<std::vector<long double>> &matrixA, const std::vector<std::vector<long double>> &matrixB);
+#endif
 
 } // namespace matAlg
 
 namespace mlLib
 {
-    LinearRegressionModel::LinearRegressionModel(){};
-
-    LinearRegressionModel::LinearRegressionModel(long double slope, long double intercept, stat::NormalizationType normalizationType)
-        : slope(slope), intercept(intercept), normalizationType(normalizationType) {}
-
-    // Getter function implementations
-    long double LinearRegressionModel::getSlope() const { return slope; }
-    long double LinearRegressionModel::getIntercept() const { return intercept; }
-    stat::NormalizationType LinearRegressionModel::getNormalizationType() const { return normalizationType; }
+    // Internal helpers, in a named namespace so that the header-only build shares one copy of them
+    // (and of the instrumentation state) between translation units
+    namespace detail
+    {
+        // Resolve a requested thread count, where 0 means all hardware threads
+        MLLIB_INLINE size_t resolveThreadCount(size_t numThreads)
+        {
+            if (numThreads == 0)
+                numThreads = std::thread::hardware_concurrency();
+            return std::max<size_t>(1, numThreads);
+        }
 
-    // Setter function implementations
-    void LinearRegressionModel::setSlope(long double newSlope) { slope = newSlope; }
-    void LinearRegressionModel::setIntercept(long double newIntercept) { intercept = newIntercept; }
-    void LinearRegressionModel::setNormalizationType(stat::NormalizationType newNormalizationType) { normalizationType = newNormalizationType; }
+        // Split [0, numItems) into one contiguous block per thread and run function(begin, end, threadIndex) on each
+        template <typename Function>
+        void parallelFor(size_t numItems, size_t numThreads, Function function)
+        {
+            numThreads = std::max<size_t>(1, std::min(numThreads, numItems));
+            const size_t blockSize = (numItems + numThreads - 1) / numThreads;
 
-    template <typename T>
-    std::vector<long double> LinearRegressionModel::predict(const std::vector<T> &xValues)
-    {
-        assert(("xValues is empty" && !xValues.empty()) && "Input values must not be empty");
+            std::vector<std::thread> workers;
+            for (size_t t = 1; t < numThreads; ++t)
+            {
+                const size_t begin = std::min(numItems, t * blockSize);
+                const size_t end = std::min(numItems, begin + blockSize);
+                workers.emplace_back(function, begin, end, t);
+            }
 
-        size_t size = xValues.size();
+            function(0, std::min(numItems, blockSize), 0);
 
-        std::vector<long double> normalizedXValues = stat::Normalize(xValues, normalizationType);
-        std::vector<long double> predictedYValues(size);
+            for (auto &worker : workers)
+            {
+                worker.join();
+            }
+        }
 
-        for (size_t i = 0; i < size; ++i)
+        // Run function(job) for every job in [0, numJobs), handing jobs out one at a time to numThreads workers
+        template <typename Function>
+        void parallelForDynamic(size_t numJobs, size_t numThreads, Function function)
         {
-            predictedYValues[i] = slope * normalizedXValues[i] + intercept;
+            std::atomic<size_t> nextJob{0};
+            parallelFor(numThreads, numThreads, [&](size_t, size_t, size_t)
+                        {
+                            for (size_t job = nextJob++; job < numJobs; job = nextJob++)
+                            {
+                                function(job);
+                            } });
         }
 
-        return predictedYValues;
-    }
+        // Compute the offset and scale such that a normalized value is (x - offset) / scale, matching stat::Normalize
+        template <typename T>
+        void normalizationParameters(std::span<const T> values, stat::NormalizationType type, long double &offset, long double &scale)
+        {
+            offset = 0.0L;
+            scale = 1.0L;
 
-    template std::vector<long double> LinearRegressionModel::predict(const std::vector<int8_t> &xValues);
-    template std::vector<long double> LinearRegressionModel::predict(const std::vector<int16_t> &xValues);
-    template std::vector<long double> LinearRegressionModel::predict(const std::vector<int32_t> &xValues);
-    template std::vector<long double> LinearRegressionModel::predict(const std::vector<int64_t> &xValues);
+            switch (type)
+            {
+            case stat::Min_Max:
+            {
+                const auto [minIter, maxIter] = std::minmax_element(values.begin(), values.end());
+                offset = static_cast<long double>(*minIter);
+                scale = static_cast<long double>(*maxIter) - offset;
+            }
+            break;
 
-    template std::vector<long double> LinearRegressionModel::predict(const std::vector<uint8_t> &xValues);
-    template std::vector<long double> LinearRegressionModel::predict(const std::vector<uint16_t> &xValues);
-    template std::vector<long double> LinearRegressionModel::predict(const std::vector<uint32_t> &xValues);
-    template std::vector<long double> LinearRegressionModel::predict(const std::vector<uint64_t> &xValues);
+            case stat::Z_Score:
+            {
+                assert(values.size() >= 2 && "Vector has insufficient elements for standard deviation");
 
-    template std::vector<long double> LinearRegressionModel::predict(const std::vector<float> &xValues);
-    template std::vector<long double> LinearRegressionModel::predict(const std::vector<double> &xValues);
-    template std::vector<long double> LinearRegressionModel::predict(const std::vector<long double> &xValues);
+                long double sum = 0.0L;
+                for (const auto &value : values)
+                {
+                    sum += static_cast<long double>(value);
+                }
+                offset = sum / values.size();
 
-    template <typename T>
-    long double LinearRegressionModel::evaluate(const std::vector<T> &actualYValues, const std::vector<long double> &predictedYValues)
-    {
-        assert(("Actual Y values are empty" && !actualYValues.empty()) &&
-               ("Predicted Y values are empty" && !predictedYValues.empty()) &&
-               (actualYValues.size() == predictedYValues.size() && "Input values must have the same size"));
+                long double sumSquaredDiffs = 0.0L;
+                for (const auto &value : values)
+                {
+                    const long double diff = static_cast<long double>(value) - offset;
+                    sumSquaredDiffs += diff * diff;
+                }
+                scale = std::sqrt(sumSquaredDiffs / static_cast<long double>(values.size() - 1));
+            }
+            break;
 
-        size_t size = actualYValues.size();
-        long double mse = 0.0L;
+            case stat::L2_Euclidean:
+            {
+                long double sumSquares = 0.0L;
+                for (const auto &value : values)
+                {
+                    sumSquares += static_cast<long double>(value) * static_cast<long double>(value);
+                }
+                scale = std::sqrt(sumSquares);
+            }
+            break;
 
-        // Normalize actualYValues based on the model's normalization type
-        std::vector<long double> normalizedActualYValues = stat::Normalize(actualYValues, normalizationType);
+            default:
+                assert(false && "Unsupported norm type");
+            }
+        }
 
-        for (size_t i = 0; i < size; ++i)
+        // Reset the Adam moments unless they continue a run with the same optimizer and model shape
+        MLLIB_INLINE void prepareAdamState(OptimizerState &optimizerState, size_t numCoefficients)
         {
-            mse += std::pow(normalizedActualYValues[i] - predictedYValues[i], 2);
+            if (optimizerState.type != Adam || optimizerState.firstMoments.size() != numCoefficients)
+            {
+                optimizerState = OptimizerState();
+                optimizerState.type = Adam;
+                optimizerState.firstMoments.assign(numCoefficients, 0.0L);
+                optimizerState.secondMoments.assign(numCoefficients, 0.0L);
+            }
         }
 
-        mse /= static_cast<long double>(size);
-        return mse;
-    }
-
-    template long double LinearRegressionModel::evaluate(const std::vector<int8_t> &actualYValues, const std::vector<long double> &predictedYValues);
-    template long double LinearRegressionModel::evaluate(const std::vector<int16_t> &actualYValues, const std::vector<long double> &predictedYValues);
-    template long double LinearRegressionModel::evaluate(const std::vector<int32_t> &actualYValues, const std::vector<long double> &predictedYValues);
-    template long double LinearRegressionModel::evaluate(const std::vector<int64_t> &actualYValues, const std::vector<long double> &predictedYValues);
+        // One Adam update from the gradient summed over numRows rows
+        MLLIB_INLINE void adamStep(std::vector<long double> &coefficients, OptimizerState &optimizerState, const std::vector<long double> &gradient, size_t numRows, const long double learningRate)
+        {
+            const long double beta1 = 0.9L;
+            const long double beta2 = 0.999L;
+            const long double epsilon = 1e-8L;
 
-    template long double LinearRegressionModel::evaluate(const std::vector<uint8_t> &actualYValues, const std::vector<long double> &predictedYValues);
-    template long double LinearRegressionModel::evaluate(const std::vector<uint16_t> &actualYValues, const std::vector<long double> &predictedYValues);
-    template long double LinearRegressionModel::evaluate(const std::vector<uint32_t> &actualYValues, const std::vector<long double> &predictedYValues);
-    template long double LinearRegressionModel::evaluate(const std::vector<uint64_t> &actualYValues, const std::vector<long double> &predictedYValues);
+            ++optimizerState.step;
+            const long double correction1 = 1.0L - std::pow(beta1, static_cast<long double>(optimizerState.step));
+            const long double correction2 = 1.0L - std::pow(beta2, static_cast<long double>(optimizerState.step));
 
-    template long double LinearRegressionModel::evaluate(const std::vector<float> &actualYValues, const std::vector<long double> &predictedYValues);
-    template long double LinearRegressionModel::evaluate(const std::vector<double> &actualYValues, const std::vector<long double> &predictedYValues);
-    template long double LinearRegressionModel::evaluate(const std::vector<long double> &actualYValues, const std::vector<long double> &predictedYValues);
+            for (size_t j = 0; j < coefficients.size(); ++j)
+            {
+                const long double g = gradient[j] / numRows;
+                long double &m = optimizerState.firstMoments[j];
+                long double &v = optimizerState.secondMoments[j];
 
-    void LinearRegressionModel::saveToFile(const std::string &filename)
-    {
-        std::ofstream outFile(filename);
-        if (outFile.is_open())
-        {
-            outFile << *this;
-            outFile.close();
-        }
-        else
-        {
-            std::cerr << "Unable to open file for writing." << std::endl;
+                m = beta1 * m + (1.0L - beta1) * g;
+                v = beta2 * v + (1.0L - beta2) * g * g;
+                coefficients[j] -= learningRate * (m / correction1) / (std::sqrt(v / correction2) + epsilon);
+            }
         }
-    }
 
-    void LinearRegressionModel::loadFromFile(const std::string &filename)
-    {
-        std::ifstream inFile(filename);
-        if (inFile.is_open())
-        {
-            inFile >> *this;
-            inFile.close();
-        }
-        else
+        // Cross-entropy of one prediction, with the probability clamped away from 0 and 1
+        MLLIB_INLINE long double logisticLoss(long double probability, long double label)
         {
-            std::cerr << "Unable to open file for reading." << std::endl;
+            const long double p = std::clamp(probability, 1e-15L, 1.0L - 1e-15L);
+            return -(label * std::log(p) + (1.0L - label) * std::log(1.0L - p));
         }
-    }
 
-    template <typename T>
-    LinearRegressionModel LinearRegressionLeastSquares(const std::vector<T> &xValues, const std::vector<T> &yValues, stat::NormalizationType normalizationType)
-    {
-        assert(("xValues is empty" && !xValues.empty()) &&
-               ("yValues is empty" && !yValues.empty()) &&
-               (xValues.size() == yValues.size() && "Input vectors must have the same size"));
+        // Turns per-iteration loss and gradient sums into TrainingProgress reports for the callback,
+        // and into trace counters while tracing. Trainers only compute the sums while active().
+        class TrainingMonitor
+        {
+        private:
+            const TrainingCallback &callback;
+            std::chrono::steady_clock::time_point start;
+            std::chrono::steady_clock::time_point last;
+            size_t iteration = 0;
 
-        std::vector<long double> normalizedXValues = stat::Normalize(xValues, normalizationType);
-        std::vector<long double> normalizedYValues = stat::Normalize(yValues, normalizationType);
+        public:
+            explicit TrainingMonitor(const TrainingCallback &callback)
+                : callback(callback), start(std::chrono::steady_clock::now()), last(start) {}
 
-        size_t size = normalizedXValues.size();
+            bool active() const { return callback || Instrumentation::isTracing(); }
 
-        long double sumX = std::accumulate(normalizedXValues.begin(), normalizedXValues.end(), 0.0L);
-        long double sumY = std::accumulate(normalizedYValues.begin(), normalizedYValues.end(), 0.0L);
-        long double sumXY = vecAlg::DotProduct(normalizedXValues, normalizedYValues);
-        long double sumXSquare = vecAlg::DotProduct(normalizedXValues, normalizedXValues);
+            void report(long double totalLoss, std::span<const long double> gradientSums, size_t numRows)
+            {
+                long double squaredNorm = 0.0L;
+                for (const long double g : gradientSums)
+                {
+                    squaredNorm += (g / numRows) * (g / numRows);
+                }
 
-        long double slope = (size * sumXY - sumX * sumY) / (size * sumXSquare - std::pow(sumX, 2));
-        long double intercept = (sumY - slope * sumX) / size;
+                reportMean(totalLoss / numRows, std::sqrt(squaredNorm), numRows);
+            }
 
-        return LinearRegressionModel(slope, intercept, normalizationType);
-    }
+            // Report a loss already averaged over the rows and the norm of the step taken
+            void reportMean(long double meanLoss, long double gradientNorm, size_t numRows)
+            {
+                const auto now = std::chrono::steady_clock::now();
+
+                TrainingProgress progress;
+                progress.iteration = ++iteration;
+                progress.loss = meanLoss;
+                progress.gradientNorm = gradientNorm;
+                progress.elapsed = now - start;
+                const double seconds = std::chrono::duration<double>(now - last).count();
+                progress.rowsPerSecond = (seconds > 0.0) ? numRows / seconds : 0.0;
+                last = now;
+
+                Instrumentation::recordValue("loss", static_cast<double>(progress.loss));
+                Instrumentation::recordValue("gradientNorm", static_cast<double>(progress.gradientNorm));
+                if (callback)
+                    callback(progress);
+            }
+        };
 
-    void LinearRegressionModel::printInfo() const
-    {
-        std::cout << "Linear Regression Model:\n"
-                  << "Slope: " << slope << "\n"
-                  << "Intercept: " << intercept << "\n"
-                  << "Normalization Type: " << normalizationType << "\n";
-    }
+        // Run numIterations of logistic regression training over rows supplied by accessors, so the trainers
+        // can work on a shared dataset through an index view as well as on their own vectors
+        template <typename RowFunction, typename LabelFunction>
+        void fitLogisticRows(std::vector<long double> &coefficients, OptimizerState &optimizerState, size_t numRows, RowFunction row, LabelFunction label, const long double learningRate, const int numIterations, OptimizerType optimizer, TrainingMonitor *monitor = nullptr)
+        {
+            const size_t numFeatures = coefficients.size() - 1;
+            const bool tracking = monitor && monitor->active();
 
-    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<int8_t> &xValues, const std::vector<int8_t> &yValues, stat::NormalizationType normalizationType);
-    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<int16_t> &xValues, const std::vector<int16_t> &yValues, stat::NormalizationType normalizationType);
-    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<int32_t> &xValues, const std::vector<int32_t> &yValues, stat::NormalizationType normalizationType);
-    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<int64_t> &xValues, const std::vector<int64_t> &yValues, stat::NormalizationType normalizationType);
+            switch (optimizer)
+            {
+            case SGD:
+            {
+                optimizerState.type = SGD;
 
-    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<uint8_t> &xValues, const std::vector<uint8_t> &yValues, stat::NormalizationType normalizationType);
-    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<uint16_t> &xValues, const std::vector<uint16_t> &yValues, stat::NormalizationType normalizationType);
-    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<uint32_t> &xValues, const std::vector<uint32_t> &yValues, stat::NormalizationType normalizationType);
-    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<uint64_t> &xValues, const std::vector<uint64_t> &yValues, stat::NormalizationType normalizationType);
+                // Per-row updates need no gradient buffer; it is only summed for progress reports
+                std::vector<long double> gradient(tracking ? coefficients.size() : 0);
 
-    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<float> &xValues, const std::vector<float> &yValues, stat::NormalizationType normalizationType);
-    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<double> &xValues, const std::vector<double> &yValues, stat::NormalizationType normalizationType);
-    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<long double> &xValues, const std::vector<long double> &yValues, stat::NormalizationType normalizationType);
+                for (int iter = 0; iter < numIterations; ++iter)
+                {
+                    ScopedTimer timer("LogisticRegression::iteration");
+                    long double interceptGradient = 0.0;
+                    long double totalLoss = 0.0L;
+                    std::fill(gradient.begin(), gradient.end(), 0.0L);
+
+                    for (size_t i = 0; i < numRows; ++i)
+                    {
+                        const auto &xVector = row(i);
+
+                        long double logit = coefficients[0];
+                        for (size_t j = 0; j < numFeatures; ++j)
+                        {
+                            logit += coefficients[j + 1] * xVector[j];
+                        }
+
+                        const long double prediction = 1.0 / (1.0 + std::exp(-logit));
+                        const long double error = prediction - label(i);
+
+                        if (tracking)
+                        {
+                            totalLoss += logisticLoss(prediction, label(i));
+                            for (size_t j = 0; j < numFeatures; ++j)
+                            {
+                                gradient[j + 1] += error * xVector[j];
+                            }
+                        }
+
+                        interceptGradient += error;
+                        for (size_t j = 0; j < numFeatures; ++j)
+                        {
+                            coefficients[j + 1] -= learningRate * error * xVector[j];
+                        }
+                    }
+
+                    if (tracking)
+                    {
+                        gradient[0] = interceptGradient;
+                        monitor->report(totalLoss, gradient, numRows);
+                    }
+
+                    interceptGradient /= numRows;
+                    coefficients[0] -= learningRate * interceptGradient;
+                    ++optimizerState.step;
+                    Instrumentation::count("LogisticRegression::rows", numRows);
+                }
+            }
+            break;
 
-    template <typename T>
-    LinearRegressionModel LinearRegressionGradientDescent(const std::vector<T> &xValues, const std::vector<T> &yValues, stat::NormalizationType normalizationType, long double learningRate, int numIterations)
-    {
-        assert(("xValues is empty" && !xValues.empty()) &&
-               ("yValues is empty" && !yValues.empty()) &&
-               (xValues.size() == yValues.size() && "Input vectors must have the same size"));
+            case Adam:
+            {
+                prepareAdamState(optimizerState, coefficients.size());
 
-        std::vector<long double> normalizedXValues = stat::Normalize(xValues, normalizationType);
-        std::vector<long double> normalizedYValues = stat::Normalize(yValues, normalizationType);
+                std::vector<long double> gradient(coefficients.size());
 
-        size_t size = normalizedXValues.size();
+                for (int iter = 0; iter < numIterations; ++iter)
+                {
+                    ScopedTimer timer("LogisticRegression::iteration");
+                    long double totalLoss = 0.0L;
+                    std::fill(gradient.begin(), gradient.end(), 0.0L);
+
+                    for (size_t i = 0; i < numRows; ++i)
+                    {
+                        const auto &xVector = row(i);
+
+                        long double logit = coefficients[0];
+                        for (size_t j = 0; j < numFeatures; ++j)
+                        {
+                            logit += coefficients[j + 1] * xVector[j];
+                        }
+
+                        const long double prediction = 1.0 / (1.0 + std::exp(-logit));
+                        const long double error = prediction - label(i);
+                        if (tracking)
+                            totalLoss += logisticLoss(prediction, label(i));
+
+                        gradient[0] += error;
+                        for (size_t j = 0; j < numFeatures; ++j)
+                        {
+                            gradient[j + 1] += error * xVector[j];
+                        }
+                    }
+
+                    if (tracking)
+                        monitor->report(totalLoss, gradient, numRows);
+
+                    adamStep(coefficients, optimizerState, gradient, numRows, learningRate);
+                    Instrumentation::count("LogisticRegression::rows", numRows);
+                }
+            }
+            break;
 
-        // Initialize parameters
-        long double slope = 0.0L;
-        long double intercept = 0.0L;
+            default:
+                assert(false && "Unsupported optimizer type");
+            }
+        }
 
-        // Gradient Descent
-        for (int iteration = 0; iteration < numIterations; ++iteration)
+#if defined(MLLIB_AVX2_KERNELS)
+        // Whether the CPU runs the AVX2 kernels (AVX2, FMA and F16C), checked once
+        MLLIB_INLINE bool cpuHasAvx2()
         {
-            long double sumErrors = 0.0L;
-            long double sumXErrors = 0.0L;
+#if defined(__AVX2__) && defined(__FMA__) && defined(__F16C__)
+            return true;
+#else
+            static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c");
+            return supported;
+#endif
+        }
 
-            for (size_t i = 0; i < size; ++i)
+        // int8 dot product of the first vecLen - vecLen % 16 values
+        MLLIB_INLINE MLLIB_TARGET_AVX2 int32_t dotProductInt8Avx2(const int8_t *vectorA, const int8_t *vectorB, size_t vecLen)
+        {
+            __m256i accumulator = _mm256_setzero_si256();
+            for (size_t i = 0; i + 16 <= vecLen; i += 16)
             {
-                long double error = slope * normalizedXValues[i] + intercept - normalizedYValues[i];
-                sumErrors += error;
-                sumXErrors += error * normalizedXValues[i];
+                const __m256i a = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(vectorA + i)));
+                const __m256i b = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(vectorB + i)));
+                accumulator = _mm256_add_epi32(accumulator, _mm256_madd_epi16(a, b));
             }
 
-            // Update parameters
-            slope -= learningRate * (1.0L / size) * sumXErrors;
-            intercept -= learningRate * (1.0L / size) * sumErrors;
+            __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(accumulator), _mm256_extracti128_si256(accumulator, 1));
+            sum = _mm_hadd_epi32(sum, sum);
+            sum = _mm_hadd_epi32(sum, sum);
+            return _mm_cvtsi128_si32(sum);
         }
+#endif
 
-        return LinearRegressionModel(slope, intercept, normalizationType);
-    }
-
-    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<int8_t> &xValues, const std::vector<int8_t> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations);
-    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<int16_t> &xValues, const std::vector<int16_t> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations);
-    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<int32_t> &xValues, const std::vector<int32_t> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations);
-    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<int64_t> &xValues, const std::vector<int64_t> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations);
-
-    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<uint8_t> &xValues, const std::vector<uint8_t> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations);
-    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<uint16_t> &xValues, const std::vector<uint16_t> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations);
-    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<uint32_t> &xValues, const std::vector<uint32_t> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations);
-    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<uint64_t> &xValues, const std::vector<uint64_t> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations);
+        // int8 dot product with int32 accumulation
+        MLLIB_INLINE int32_t dotProductInt8(const int8_t *vectorA, const int8_t *vectorB, size_t vecLen)
+        {
+            int32_t result = 0;
+            size_t i = 0;
 
-    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<float> &xValues, const std::vector<float> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations);
-    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<double> &xValues, const std::vector<double> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations);
-    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<long double> &xValues, const std::vector<long double> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations);
+#if defined(MLLIB_AVX2_KERNELS)
+            if (cpuHasAvx2())
+            {
+                result = dotProductInt8Avx2(vectorA, vectorB, vecLen);
+                i = vecLen - vecLen % 16;
+            }
+#endif
 
-    LogisticRegressionModel::LogisticRegressionModel() {}
-    LogisticRegressionModel::LogisticRegressionModel(const std::vector<long double> &coefficients) : coefficients(coefficients), normalizationType(stat::NormalizationType::Z_Score) {}
+            for (; i < vecLen; ++i)
+            {
+                result += static_cast<int32_t>(vectorA[i]) * static_cast<int32_t>(vectorB[i]);
+            }
 
-    // Getter function
-    const std::vector<long double> &LogisticRegressionModel::getCoefficients() const { return coefficients; }
+            return result;
+        }
 
-    ConfusionMatrix LogisticRegressionModel::getConfusionMatrix() const { return confusionMatrix; }
+        MLLIB_INLINE int8_t saturateInt8(long double value)
+        {
+            return static_cast<int8_t>(std::max(-128.0L, std::min(127.0L, std::round(value))));
+        }
 
-    // Getter and Setter for Evaluation Metrics
-    EvaluationMetrics LogisticRegressionModel::getEvaluationMetrics() const { return evaluationMetrics; }
+        // CRC-32 (IEEE 802.3 polynomial, as in zlib), computed eight bytes at a time with slicing tables
+        MLLIB_INLINE uint32_t crc32(const char *data, size_t size)
+        {
+            static const auto tables = []
+            {
+                std::array<std::array<uint32_t, 256>, 8> result{};
+                for (uint32_t i = 0; i < 256; ++i)
+                {
+                    uint32_t crc = i;
+                    for (int bit = 0; bit < 8; ++bit)
+                        crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+                    result[0][i] = crc;
+                }
+                for (uint32_t i = 0; i < 256; ++i)
+                {
+                    for (size_t t = 1; t < 8; ++t)
+                        result[t][i] = (result[t - 1][i] >> 8) ^ result[0][result[t - 1][i] & 0xFF];
+                }
+                return result;
+            }();
 
-    // Setter function
-    void LogisticRegressionModel::setCoefficients(const std::vector<long double> &newCoefficients) { coefficients = newCoefficients; }
+            const auto *bytes = reinterpret_cast<const uint8_t *>(data);
+            uint32_t crc = 0xFFFFFFFFu;
+            for (; size >= 8; size -= 8, bytes += 8)
+            {
+                uint32_t low, high;
+                std::memcpy(&low, bytes, 4);
+                std::memcpy(&high, bytes + 4, 4);
+                low ^= crc;
+                crc = tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF] ^ tables[5][(low >> 16) & 0xFF] ^ tables[4][low >> 24] ^
+                      tables[3][high & 0xFF] ^ tables[2][(high >> 8) & 0xFF] ^ tables[1][(high >> 16) & 0xFF] ^ tables[0][high >> 24];
+            }
+            for (; size > 0; --size, ++bytes)
+            {
+                crc = (crc >> 8) ^ tables[0][(crc ^ *bytes) & 0xFF];
+            }
+            return ~crc;
+        }
 
-    void LogisticRegressionModel::setConfusionMatrix(const ConfusionMatrix &matrix) { confusionMatrix = matrix; }
+        // Binary model file layout (little-endian): a 64-byte ModelFileHeader followed by a payload of
+        // payloadSize bytes whose CRC-32 is stored in the header. The payload starts with numCoefficients
+        // long double values; model-specific fields follow.
+        enum ModelFileType : uint32_t
+        {
+            LinearModelFile = 1,
+            LogisticModelFile = 2,
+            KMeansModelFile = 3,
+            PCAModelFile = 4,
+            GBDTModelFile = 5,
+            NaiveBayesModelFile = 6
+        };
+
+        struct ModelFileHeader
+        {
+            char magic[4];
+            uint32_t version;
+            uint32_t modelType;
+            uint32_t scalarSize;   // sizeof(long double) of the writer
+            uint32_t scalarDigits; // mantissa digits of the writer's long double
+            uint32_t normalizationType;
+            uint64_t numCoefficients;
+            uint64_t payloadSize;
+            uint32_t checksum;
+            uint8_t reserved[20];
+        };
+
+        static_assert(sizeof(ModelFileHeader) == 64, "Model file header must be 64 bytes");
+        static_assert(std::endian::native == std::endian::little, "Binary model files are stored little-endian");
+
+        constexpr uint32_t modelFileVersion = 1;
+
+        // Bytes of a long double that hold its value; x87 extended precision fills 10 bytes of a 16-byte slot
+        constexpr size_t longDoubleValueBytes = (std::numeric_limits<long double>::digits == 64) ? 10 : sizeof(long double);
+
+        // Append raw values to a binary model payload
+        class PayloadWriter
+        {
+        public:
+            std::string buffer;
 
-    void LogisticRegressionModel::setEvaluationMetrics(const EvaluationMetrics &metrics) { evaluationMetrics = metrics; }
+            template <typename V>
+            void write(const V &value)
+            {
+                buffer.append(reinterpret_cast<const char *>(&value), sizeof(V));
+            }
 
-    template <typename T>
-    std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<T>> &xValues, const long double threshold)
-    {
-        assert(!coefficients.empty() && "Model coefficients are not initialized.");
+            // long doubles keep their full slot size, with the padding bytes zeroed rather than copied
+            // from whatever was on the stack, so a model always serializes to the same bytes
+            void write(const long double &value)
+            {
+                char bytes[sizeof(long double)] = {};
+                std::memcpy(bytes, &value, longDoubleValueBytes);
+                buffer.append(bytes, sizeof(bytes));
+            }
 
-        std::vector<int> predictions;
-        predictions.reserve(xValues.size());
+            void write(const std::vector<long double> &values)
+            {
+                buffer.reserve(buffer.size() + values.size() * sizeof(long double));
+                for (const long double value : values)
+                    write(value);
+            }
+        };
 
-        for (size_t i = 0; i < xValues.size(); ++i)
+        // Read raw values from a checked binary model payload; every read fails once the payload is exhausted
+        class PayloadReader
         {
-            const auto &xVector = xValues[i];
-            assert(xVector.size() == coefficients.size() - 1 && "Input feature size mismatch.");
+        private:
+            const char *position;
+            const char *end;
 
-            long double logit = coefficients[0];
-            for (size_t j = 0; j < xVector.size(); ++j)
+        public:
+            PayloadReader(const char *data, size_t size) : position(data), end(data + size) {}
+
+            template <typename V>
+            bool read(V &value)
             {
-                logit += coefficients[j + 1] * xVector[j];
+                if (static_cast<size_t>(end - position) < sizeof(V))
+                    return false;
+                std::memcpy(&value, position, sizeof(V));
+                position += sizeof(V);
+                return true;
             }
 
-            const long double probability = 1.0 / (1.0 + std::exp(-logit));
-            const int predictedClass = (probability >= threshold) ? 1 : 0;
-            predictions.push_back(predictedClass);
-        }
+            bool read(std::vector<long double> &values, uint64_t count)
+            {
+                if (static_cast<size_t>(end - position) / sizeof(long double) < count)
+                    return false;
+                values.resize(count);
+                if (count > 0)
+                    std::memcpy(values.data(), position, count * sizeof(long double));
+                position += count * sizeof(long double);
+                return true;
+            }
 
-        return predictions;
-    }
+            bool atEnd() const { return position == end; }
+        };
 
-    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<int8_t>> &xValues, long double threshold);
-    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<int16_t>> &xValues, long double threshold);
-    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<int32_t>> &xValues, long double threshold);
-    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<int64_t>> &xValues, long double threshold);
+        MLLIB_INLINE bool writeModelFile(const std::string &filename, ModelFileType modelType, stat::NormalizationType normalizationType, uint64_t numCoefficients, const std::string &payload)
+        {
+            std::ofstream outFile(filename, std::ios::binary);
+            if (!outFile.is_open())
+            {
+                std::cerr << "Unable to open file for writing." << std::endl;
+                return false;
+            }
 
-    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<uint8_t>> &xValues, long double threshold);
-    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<uint16_t>> &xValues, long double threshold);
-    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<uint32_t>> &xValues, long double threshold);
-    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<uint64_t>> &xValues, long double threshold);
+            ModelFileHeader header = {};
+            std::memcpy(header.magic, "MLBM", 4);
+            header.version = modelFileVersion;
+            header.modelType = modelType;
+            header.scalarSize = sizeof(long double);
+            header.scalarDigits = std::numeric_limits<long double>::digits;
+            header.normalizationType = static_cast<uint32_t>(normalizationType);
+            header.numCoefficients = numCoefficients;
+            header.payloadSize = payload.size();
+            header.checksum = crc32(payload.data(), payload.size());
+
+            outFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            outFile.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+            return outFile.good();
+        }
 
-    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<float>> &xValues, long double threshold);
-    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<double>> &xValues, long double threshold);
-    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<long double>> &xValues, long double threshold);
+        // Map a binary model file and validate its header and checksum. On success the returned header
+        // points into file and the payload follows it.
+        MLLIB_INLINE const ModelFileHeader *readModelFile(MappedFile &file, const std::string &filename, ModelFileType modelType)
+        {
+            if (!file.open(filename))
+            {
+                std::cerr << "Unable to open file for reading." << std::endl;
+                return nullptr;
+            }
 
-    template <typename T>
-    long double LogisticRegressionModel::evaluate(const std::vector<T> &actualYValues, const std::vector<int> &predictedClasses)
-    {
-        assert(("Input vectors must have the same size" && actualYValues.size() == predictedClasses.size()));
+            auto invalid = [](const char *reason) -> const ModelFileHeader *
+            {
+                std::cerr << "Invalid model file: " << reason << std::endl;
+                return nullptr;
+            };
+
+            if (file.size() < sizeof(ModelFileHeader))
+                return invalid("file is truncated");
+
+            const auto *header = reinterpret_cast<const ModelFileHeader *>(file.data());
+            if (std::memcmp(header->magic, "MLBM", 4) != 0)
+                return invalid("bad magic number");
+            if (header->version != modelFileVersion)
+                return invalid("unsupported format version");
+            if (header->modelType != modelType)
+                return invalid("wrong model type");
+            if (header->scalarSize != sizeof(long double) || header->scalarDigits != static_cast<uint32_t>(std::numeric_limits<long double>::digits))
+                return invalid("long double format differs from this platform");
+            if (header->payloadSize != file.size() - sizeof(ModelFileHeader))
+                return invalid("file is truncated");
+            if (crc32(file.data() + sizeof(ModelFileHeader), header->payloadSize) != header->checksum)
+                return invalid("checksum mismatch");
+
+            return header;
+        }
 
-        size_t dataSize = actualYValues.size();
-        ConfusionMatrix newConfusionMatrix = {0, 0, 0, 0}; // Initialize to zeros
+        // True if the file starts with the binary model magic number
+        MLLIB_INLINE bool isBinaryModelFile(const std::string &filename)
+        {
+            std::ifstream inFile(filename, std::ios::binary);
+            char magic[4] = {};
+            return inFile.read(magic, 4) && std::memcmp(magic, "MLBM", 4) == 0;
+        }
 
-        for (size_t i = 0; i < dataSize; ++i)
+        // IEEE half precision to single precision
+        MLLIB_INLINE float halfToFloat(uint16_t half)
         {
-            int predictedClass = predictedClasses[i];
+            const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+            const uint32_t exponent = (half >> 10) & 0x1F;
+            const uint32_t mantissa = half & 0x3FF;
+
+            if (exponent == 0)
+            {
+                const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+                return sign ? -magnitude : magnitude;
+            }
+
+            const uint32_t bits = sign | ((exponent == 31) ? (0x7F800000 | (mantissa << 13)) : (((exponent + 112) << 23) | (mantissa << 13)));
+            return std::bit_cast<float>(bits);
+        }
+
+        // Single precision to IEEE half precision, rounding to nearest even
+        MLLIB_INLINE uint16_t floatToHalf(float value)
+        {
+            uint32_t bits = std::bit_cast<uint32_t>(value);
+            const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+            bits &= 0x7FFFFFFF;
+
+            if (bits > 0x7F800000)
+                return sign | 0x7E00; // NaN
+            if (bits >= 0x477FF000)
+                return sign | 0x7C00; // Rounds to infinity
+            if (bits < 0x38800000)
+                return sign | static_cast<uint16_t>(std::nearbyint(std::bit_cast<float>(bits) * 16777216.0f)); // Subnormal
+
+            const uint32_t rounded = bits + 0xFFF + ((bits >> 13) & 1);
+            return sign | static_cast<uint16_t>((rounded - 0x38000000) >> 13);
+        }
+
+        // Single precision to bfloat16, rounding to nearest even
+        MLLIB_INLINE uint16_t floatToBFloat16(float value)
+        {
+            const uint32_t bits = std::bit_cast<uint32_t>(value);
+            if ((bits & 0x7FFFFFFF) > 0x7F800000)
+                return static_cast<uint16_t>((bits >> 16) | 0x40); // Quiet NaN
+            return static_cast<uint16_t>((bits + 0x7FFF + ((bits >> 16) & 1)) >> 16);
+        }
+
+        // Decoded value of row i of a compressed column
+        template <ColumnEncoding Encoding>
+        float decodeValue(const CompressedDataset::Column &column, size_t i)
+        {
+            if constexpr (Encoding == BitPackedEncoding)
+                return static_cast<float>((column.data[i >> 3] >> (i & 7)) & 1);
+            else if constexpr (Encoding == DictionaryEncoding)
+                return column.dictionary[column.data[i]];
+            else if constexpr (Encoding == Float16Encoding || Encoding == BFloat16Encoding)
+            {
+                uint16_t bits;
+                std::memcpy(&bits, column.data.data() + 2 * i, 2);
+                return (Encoding == Float16Encoding) ? halfToFloat(bits) : std::bit_cast<float>(static_cast<uint32_t>(bits) << 16);
+            }
+            else
+            {
+                float result;
+                std::memcpy(&result, column.data.data() + 4 * i, 4);
+                return result;
+            }
+        }
+
+#if defined(MLLIB_AVX2_KERNELS)
+        // Decoded values of rows [i, i + 8) of a compressed column; i must be a multiple of 8
+        template <ColumnEncoding Encoding>
+        MLLIB_TARGET_AVX2 __m256 decodeBlock8(const CompressedDataset::Column &column, size_t i)
+        {
+            if constexpr (Encoding == BitPackedEncoding)
+            {
+                const __m256i bitMasks = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+                const __m256i bits = _mm256_and_si256(_mm256_set1_epi32(column.data[i >> 3]), bitMasks);
+                return _mm256_and_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(bits, bitMasks)), _mm256_set1_ps(1.0f));
+            }
+            else if constexpr (Encoding == DictionaryEncoding)
+            {
+                const __m256i codes = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(column.data.data() + i)));
+                return _mm256_i32gather_ps(column.dictionary.data(), codes, 4);
+            }
+            else if constexpr (Encoding == Float16Encoding)
+            {
+                return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(column.data.data() + 2 * i)));
+            }
+            else if constexpr (Encoding == BFloat16Encoding)
+            {
+                const __m256i halves = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(column.data.data() + 2 * i)));
+                return _mm256_castsi256_ps(_mm256_slli_epi32(halves, 16));
+            }
+            else
+            {
+                return _mm256_loadu_ps(reinterpret_cast<const float *>(column.data.data() + 4 * i));
+            }
+        }
+
+        MLLIB_INLINE MLLIB_TARGET_AVX2 float horizontalSum(__m256 values)
+        {
+            __m128 sum = _mm_add_ps(_mm256_castps256_ps128(values), _mm256_extractf128_ps(values, 1));
+            sum = _mm_hadd_ps(sum, sum);
+            sum = _mm_hadd_ps(sum, sum);
+            return _mm_cvtss_f32(sum);
+        }
+
+        // addScaledColumn over whole blocks of 8 rows from i, a multiple of 8; returns the first row not done
+        template <ColumnEncoding Encoding>
+        MLLIB_TARGET_AVX2 size_t addScaledBlocks(const CompressedDataset::Column &column, size_t begin, size_t i, size_t end, float weight, float *output)
+        {
+            const __m256 weights = _mm256_set1_ps(weight);
+            for (; i + 8 <= end; i += 8)
+            {
+                float *destination = output + (i - begin);
+                _mm256_storeu_ps(destination, _mm256_fmadd_ps(weights, decodeBlock8<Encoding>(column, i), _mm256_loadu_ps(destination)));
+            }
+            return i;
+        }
+
+        // dotColumn over whole blocks of 8 rows from i, a multiple of 8; returns the first row not done
+        template <ColumnEncoding Encoding>
+        MLLIB_TARGET_AVX2 size_t dotBlocks(const CompressedDataset::Column &column, size_t begin, size_t i, size_t end, const float *weights, float &result)
+        {
+            __m256 accumulator = _mm256_setzero_ps();
+            for (; i + 8 <= end; i += 8)
+            {
+                accumulator = _mm256_fmadd_ps(_mm256_loadu_ps(weights + (i - begin)), decodeBlock8<Encoding>(column, i), accumulator);
+            }
+            result += horizontalSum(accumulator);
+            return i;
+        }
+#endif
+
+        // output[i - begin] += weight * x[i] for rows [begin, end) of a compressed column
+        template <ColumnEncoding Encoding>
+        void addScaledColumn(const CompressedDataset::Column &column, size_t begin, size_t end, float weight, float *output)
+        {
+            size_t i = begin;
+
+#if defined(MLLIB_AVX2_KERNELS)
+            if (cpuHasAvx2())
+            {
+                for (; i < end && i % 8 != 0; ++i)
+                    output[i - begin] += weight * decodeValue<Encoding>(column, i);
+                i = addScaledBlocks<Encoding>(column, begin, i, end, weight, output);
+            }
+#endif
+
+            for (; i < end; ++i)
+                output[i - begin] += weight * decodeValue<Encoding>(column, i);
+        }
+
+        // sum of weights[i - begin] * x[i] for rows [begin, end) of a compressed column
+        template <ColumnEncoding Encoding>
+        float dotColumn(const CompressedDataset::Column &column, size_t begin, size_t end, const float *weights)
+        {
+            float result = 0.0f;
+            size_t i = begin;
+
+#if defined(MLLIB_AVX2_KERNELS)
+            if (cpuHasAvx2())
+            {
+                for (; i < end && i % 8 != 0; ++i)
+                    result += weights[i - begin] * decodeValue<Encoding>(column, i);
+                i = dotBlocks<Encoding>(column, begin, i, end, weights, result);
+            }
+#endif
+
+            for (; i < end; ++i)
+                result += weights[i - begin] * decodeValue<Encoding>(column, i);
+
+            return result;
+        }
+
+        // Call function with the encoding of a column as a compile-time constant
+        template <typename Function>
+        auto dispatchEncoding(ColumnEncoding encoding, Function function)
+        {
+            switch (encoding)
+            {
+            case BitPackedEncoding:
+                return function(std::integral_constant<ColumnEncoding, BitPackedEncoding>());
+            case DictionaryEncoding:
+                return function(std::integral_constant<ColumnEncoding, DictionaryEncoding>());
+            case Float16Encoding:
+                return function(std::integral_constant<ColumnEncoding, Float16Encoding>());
+            case BFloat16Encoding:
+                return function(std::integral_constant<ColumnEncoding, BFloat16Encoding>());
+            default:
+                return function(std::integral_constant<ColumnEncoding, Float32Encoding>());
+            }
+        }
+
+        // Encode a column of values, choosing the most compact encoding the options allow
+        MLLIB_INLINE CompressedDataset::Column encodeColumn(const std::vector<float> &values, const CompressionOptions &options)
+        {
+            CompressedDataset::Column column;
+
+            std::vector<float> distinct(values);
+            std::sort(distinct.begin(), distinct.end());
+            distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+
+            const bool binary = std::all_of(distinct.begin(), distinct.end(), [](float v) { return v == 0.0f || v == 1.0f; });
+            if (options.detectBinary && binary)
+            {
+                column.encoding = BitPackedEncoding;
+                column.data.assign((values.size() + 7) / 8, 0);
+                for (size_t i = 0; i < values.size(); ++i)
+                {
+                    if (values[i] == 1.0f)
+                        column.data[i >> 3] |= static_cast<uint8_t>(1u << (i & 7));
+                }
+            }
+            else if (options.detectDictionary && distinct.size() <= 256)
+            {
+                column.encoding = DictionaryEncoding;
+                column.dictionary = distinct;
+                column.data.resize(values.size());
+                for (size_t i = 0; i < values.size(); ++i)
+                {
+                    column.data[i] = static_cast<uint8_t>(std::lower_bound(distinct.begin(), distinct.end(), values[i]) - distinct.begin());
+                }
+            }
+            else if (options.continuousEncoding == Float16Encoding || options.continuousEncoding == BFloat16Encoding)
+            {
+                column.encoding = options.continuousEncoding;
+                column.data.resize(2 * values.size());
+                for (size_t i = 0; i < values.size(); ++i)
+                {
+                    const uint16_t bits = (column.encoding == Float16Encoding) ? floatToHalf(values[i]) : floatToBFloat16(values[i]);
+                    std::memcpy(column.data.data() + 2 * i, &bits, 2);
+                }
+            }
+            else
+            {
+                column.encoding = Float32Encoding;
+                column.data.resize(4 * values.size());
+                std::memcpy(column.data.data(), values.data(), 4 * values.size());
+            }
+
+            return column;
+        }
+
+        // Read exactly size bytes from a socket; false on end of stream or error
+        MLLIB_INLINE bool readFully(int socketDescriptor, void *buffer, size_t size)
+        {
+            char *position = static_cast<char *>(buffer);
+            while (size > 0)
+            {
+                const ssize_t received = ::recv(socketDescriptor, position, size, 0);
+                if (received < 0 && errno == EINTR)
+                    continue;
+                if (received <= 0)
+                    return false;
+                position += received;
+                size -= static_cast<size_t>(received);
+            }
+            return true;
+        }
+
+        // Write exactly size bytes to a socket without raising SIGPIPE if the peer has gone
+        MLLIB_INLINE bool writeFully(int socketDescriptor, const void *buffer, size_t size)
+        {
+            const char *position = static_cast<const char *>(buffer);
+            while (size > 0)
+            {
+                const ssize_t sent = ::send(socketDescriptor, position, size, MSG_NOSIGNAL);
+                if (sent < 0 && errno == EINTR)
+                    continue;
+                if (sent <= 0)
+                    return false;
+                position += sent;
+                size -= static_cast<size_t>(sent);
+            }
+            return true;
+        }
+
+        // Fill a Unix domain socket address; false if the path does not fit
+        MLLIB_INLINE bool makeSocketAddress(const std::string &socketPath, sockaddr_un &address)
+        {
+            address = sockaddr_un();
+            address.sun_family = AF_UNIX;
+            if (socketPath.size() >= sizeof(address.sun_path))
+                return false;
+            std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+            return true;
+        }
+
+        // Cross-validation over dataSize rows given by row(i) and label(i), shared by the vector and view overloads
+        template <typename RowFunction, typename LabelFunction>
+        std::vector<CrossValidationResult> crossValidateRows(size_t dataSize, size_t numFeatures, RowFunction row, LabelFunction label, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed)
+        {
+            assert(!parameterGrid.empty() && "Parameter grid is empty");
+            assert(numFolds >= 2 && numFolds <= dataSize && "Invalid number of folds");
+
+            const size_t numConfigs = parameterGrid.size();
+            numThreads = resolveThreadCount(numThreads);
+
+            // One shuffled permutation shared by every fold: fold k tests on order[foldBegin[k], foldBegin[k + 1])
+            std::vector<size_t> order(dataSize);
+            std::iota(order.begin(), order.end(), 0);
+            std::mt19937 generator(seed);
+            std::shuffle(order.begin(), order.end(), generator);
+
+            std::vector<size_t> foldBegin(numFolds + 1);
+            for (size_t k = 0; k <= numFolds; ++k)
+            {
+                foldBegin[k] = k * dataSize / numFolds;
+            }
+
+            // Training state per (configuration, fold), continued across successive halving rounds
+            std::vector<std::vector<long double>> coefficients(numConfigs * numFolds, std::vector<long double>(numFeatures + 1, 0.0L));
+            std::vector<OptimizerState> optimizerStates(numConfigs * numFolds);
+
+            std::vector<CrossValidationResult> results(numConfigs);
+            for (size_t c = 0; c < numConfigs; ++c)
+            {
+                results[c].params = parameterGrid[c];
+                results[c].foldMetrics.resize(numFolds);
+            }
+
+            size_t numRounds = 1;
+            if (successiveHalving)
+            {
+                while ((static_cast<size_t>(1) << (numRounds - 1)) < numConfigs)
+                    ++numRounds;
+            }
+
+            std::vector<size_t> survivors(numConfigs);
+            std::iota(survivors.begin(), survivors.end(), 0);
+            std::vector<size_t> lastRound(numConfigs, 0);
+
+            for (size_t round = 0; round < numRounds; ++round)
+            {
+                // Budgets double each round and reach the full iteration count in the last round
+                const long double budgetFraction = std::pow(2.0L, static_cast<long double>(round) - static_cast<long double>(numRounds - 1));
+
+                parallelForDynamic(survivors.size() * numFolds, numThreads, [&](size_t job)
+                                   {
+                                       const size_t config = survivors[job / numFolds];
+                                       const size_t fold = job % numFolds;
+                                       const size_t state = config * numFolds + fold;
+                                       const LogisticRegressionParams &params = parameterGrid[config];
+
+                                       const int targetIterations = std::max(1, static_cast<int>(std::ceil(budgetFraction * params.numIterations)));
+                                       const int previousIterations = static_cast<int>(optimizerStates[state].step);
+
+                                       const size_t testBegin = foldBegin[fold];
+                                       const size_t testSize = foldBegin[fold + 1] - testBegin;
+
+                                       // Training rows are the permutation with the test range skipped
+                                       fitLogisticRows(
+                                           coefficients[state], optimizerStates[state], dataSize - testSize,
+                                           [&](size_t i) { return row(order[i < testBegin ? i : i + testSize]); },
+                                           [&](size_t i) { return label(order[i < testBegin ? i : i + testSize]); },
+                                           params.learningRate, targetIterations - previousIterations, params.optimizer);
+
+                                       ConfusionMatrix confusionMatrix;
+                                       for (size_t i = testBegin; i < testBegin + testSize; ++i)
+                                       {
+                                           const auto &xVector = row(order[i]);
+                                           long double logit = coefficients[state][0];
+                                           for (size_t j = 0; j < numFeatures; ++j)
+                                           {
+                                               logit += coefficients[state][j + 1] * xVector[j];
+                                           }
+
+                                           const int predictedClass = (logit >= 0.0L) ? 1 : 0;
+                                           const int actualValue = static_cast<int>(label(order[i]));
+
+                                           if (predictedClass == 1 && actualValue == 1)
+                                               confusionMatrix.truePositive++;
+                                           else if (predictedClass == 0 && actualValue == 0)
+                                               confusionMatrix.trueNegative++;
+                                           else if (predictedClass == 1 && actualValue == 0)
+                                               confusionMatrix.falsePositive++;
+                                           else if (predictedClass == 0 && actualValue == 1)
+                                               confusionMatrix.falseNegative++;
+                                       }
+
+                                       results[config].foldMetrics[fold] = ComputeEvaluationMetrics(confusionMatrix); });
+
+                for (const size_t config : survivors)
+                {
+                    long double sumAccuracy = 0.0L;
+                    for (const auto &metrics : results[config].foldMetrics)
+                    {
+                        sumAccuracy += metrics.accuracy;
+                    }
+                    results[config].meanAccuracy = sumAccuracy / numFolds;
+                    results[config].iterationsTrained = static_cast<int>(optimizerStates[config * numFolds].step);
+                    lastRound[config] = round;
+                }
+
+                // Keep the better half for the next round
+                if (round + 1 < numRounds)
+                {
+                    std::stable_sort(survivors.begin(), survivors.end(), [&results](size_t a, size_t b)
+                                     { return results[a].meanAccuracy > results[b].meanAccuracy; });
+                    survivors.resize((survivors.size() + 1) / 2);
+                }
+            }
+
+            // Configurations that survived more rounds rank first, then by accuracy
+            std::vector<size_t> ranking(numConfigs);
+            std::iota(ranking.begin(), ranking.end(), 0);
+            std::stable_sort(ranking.begin(), ranking.end(), [&results, &lastRound](size_t a, size_t b)
+                             {
+                                 if (lastRound[a] != lastRound[b])
+                                     return lastRound[a] > lastRound[b];
+                                 return results[a].meanAccuracy > results[b].meanAccuracy; });
+
+            std::vector<CrossValidationResult> rankedResults;
+            rankedResults.reserve(numConfigs);
+            for (const size_t config : ranking)
+            {
+                rankedResults.push_back(std::move(results[config]));
+            }
+
+            return rankedResults;
+        }
+
+        // One timer or counter of a thread; only the owning thread adds to it, getStats reads it
+        struct InstrumentationSlot
+        {
+            std::atomic<const char *> name{nullptr};
+            std::atomic<uint64_t> count{0};
+            std::atomic<uint64_t> nanoseconds{0};
+        };
+
+        // Chrome trace event: a complete duration ('X') or a counter sample ('C')
+        struct TraceEvent
+        {
+            const char *name;
+            char phase;
+            int64_t timestamp; // Nanoseconds since tracing was enabled
+            int64_t duration;
+            double value;
+        };
+
+        // Instrumentation state of one live thread
+        struct InstrumentationThread
+        {
+            size_t threadId = 0;
+            std::array<InstrumentationSlot, 128> slots;
+            std::atomic<size_t> numSlots{0};
+            std::mutex eventMutex;
+            std::vector<TraceEvent> events;
+            size_t droppedEvents = 0;
+        };
+
+        // Trace events left by a thread that has exited
+        struct RetiredTrace
+        {
+            size_t threadId;
+            std::vector<TraceEvent> events;
+        };
+
+        const size_t maxTraceEventsPerThread = size_t(1) << 20;
+
+        // Live threads are listed in instrumentationThreads. A thread that exits folds its totals into
+        // retiredStats and hands its trace events over to retiredTraces, so short-lived threads do not
+        // leave their records behind.
+        MLLIB_INLINE std::mutex instrumentationMutex;
+        MLLIB_INLINE std::vector<std::shared_ptr<InstrumentationThread>> instrumentationThreads;
+        MLLIB_INLINE std::map<std::string, InstrumentationStats> retiredStats;
+        MLLIB_INLINE std::vector<RetiredTrace> retiredTraces;
+        MLLIB_INLINE size_t retiredDroppedEvents = 0;
+        MLLIB_INLINE size_t nextInstrumentationThreadId = 1;
+        MLLIB_INLINE std::atomic<int64_t> traceEpoch{0};
+
+        MLLIB_INLINE int64_t steadyNanoseconds(std::chrono::steady_clock::time_point time)
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+        }
+
+        // Registers the calling thread's record on first use and retires it when the thread exits
+        struct InstrumentationThreadOwner
+        {
+            std::shared_ptr<InstrumentationThread> record = std::make_shared<InstrumentationThread>();
+
+            InstrumentationThreadOwner()
+            {
+                std::lock_guard<std::mutex> lock(instrumentationMutex);
+                record->threadId = nextInstrumentationThreadId++;
+                instrumentationThreads.push_back(record);
+            }
+
+            ~InstrumentationThreadOwner()
+            {
+                std::lock_guard<std::mutex> lock(instrumentationMutex);
+                const size_t numSlots = record->numSlots.load(std::memory_order_acquire);
+                for (size_t s = 0; s < numSlots; ++s)
+                {
+                    const InstrumentationSlot &slot = record->slots[s];
+                    InstrumentationStats &stats = retiredStats[slot.name.load(std::memory_order_relaxed)];
+                    stats.count += slot.count.load(std::memory_order_relaxed);
+                    stats.totalTime += std::chrono::nanoseconds(slot.nanoseconds.load(std::memory_order_relaxed));
+                }
+
+                std::lock_guard<std::mutex> eventLock(record->eventMutex);
+                if (!record->events.empty())
+                    retiredTraces.push_back({record->threadId, std::move(record->events)});
+                retiredDroppedEvents += record->droppedEvents;
+
+                std::erase(instrumentationThreads, record);
+            }
+        };
+
+        MLLIB_INLINE InstrumentationThread &currentInstrumentationThread()
+        {
+            thread_local InstrumentationThreadOwner owner;
+            return *owner.record;
+        }
+
+        // Slot of name in the calling thread, or nullptr once all slots are taken
+        MLLIB_INLINE InstrumentationSlot *findSlot(const char *name)
+        {
+            InstrumentationThread &thread = currentInstrumentationThread();
+            const size_t numSlots = thread.numSlots.load(std::memory_order_relaxed);
+            for (size_t s = 0; s < numSlots; ++s)
+            {
+                const char *slotName = thread.slots[s].name.load(std::memory_order_relaxed);
+                if (slotName == name || std::strcmp(slotName, name) == 0)
+                    return &thread.slots[s];
+            }
+
+            if (numSlots == thread.slots.size())
+                return nullptr;
+
+            thread.slots[numSlots].name.store(name, std::memory_order_relaxed);
+            thread.numSlots.store(numSlots + 1, std::memory_order_release);
+            return &thread.slots[numSlots];
+        }
+
+        MLLIB_INLINE void addTraceEvent(const TraceEvent &event)
+        {
+            InstrumentationThread &thread = currentInstrumentationThread();
+            std::lock_guard<std::mutex> lock(thread.eventMutex);
+            if (thread.events.size() < maxTraceEventsPerThread)
+                thread.events.push_back(event);
+            else
+                ++thread.droppedEvents;
+        }
+
+        MLLIB_INLINE void writeJsonString(std::ostream &os, const char *text)
+        {
+            os << '"';
+            for (; *text; ++text)
+            {
+                if (*text == '"' || *text == '\\')
+                    os << '\\';
+                os << *text;
+            }
+            os << '"';
+        }
+
+        // Centroids of a k-means run in double precision, with the transposed copy and the squared norms the
+        // blocked distance kernel needs
+        struct CentroidTable
+        {
+            size_t numClusters = 0;
+            size_t numFeatures = 0;
+            std::vector<double> centroids;  // numClusters x numFeatures, row-major
+            std::vector<double> transposed; // numFeatures x numClusters, row-major
+            std::vector<double> norms;
+
+            CentroidTable(size_t numClusters, size_t numFeatures)
+                : numClusters(numClusters), numFeatures(numFeatures), centroids(numClusters * numFeatures), transposed(numClusters * numFeatures), norms(numClusters) {}
+
+            const double *centroid(size_t cluster) const { return centroids.data() + cluster * numFeatures; }
+            double *centroid(size_t cluster) { return centroids.data() + cluster * numFeatures; }
+
+            // Refresh the transposed copy and the norms after the centroids changed
+            void update()
+            {
+                for (size_t c = 0; c < numClusters; ++c)
+                {
+                    double norm = 0.0;
+                    for (size_t j = 0; j < numFeatures; ++j)
+                    {
+                        const double value = centroids[c * numFeatures + j];
+                        transposed[j * numClusters + c] = value;
+                        norm += value * value;
+                    }
+                    norms[c] = norm;
+                }
+            }
+        };
+
+        // Squared Euclidean distance of a row to a centroid, accumulated directly for full precision
+        template <typename T>
+        double squaredDistance(std::span<const T> row, const double *centroid)
+        {
+            double sum = 0.0;
+            for (size_t j = 0; j < row.size(); ++j)
+            {
+                const double difference = static_cast<double>(row[j]) - centroid[j];
+                sum += difference * difference;
+            }
+            return sum;
+        }
+
+        // distances[r * numClusters + c] = |row r - centroid c|^2 for a block of rows stored contiguously,
+        // expanded as |x|^2 - 2 x.c + |c|^2 so the cross terms are one product of the row block with the
+        // transposed centroids, accumulated one feature at a time over contiguous centroid values
+        MLLIB_INLINE void blockSquaredDistances(const double *rows, const double *rowNorms, size_t numRows, const CentroidTable &table, double *distances)
+        {
+            const size_t numClusters = table.numClusters;
+            for (size_t r = 0; r < numRows; ++r)
+            {
+                const double *row = rows + r * table.numFeatures;
+                double *out = distances + r * numClusters;
+                std::fill(out, out + numClusters, 0.0);
+                for (size_t j = 0; j < table.numFeatures; ++j)
+                {
+                    const double value = row[j];
+                    const double *column = table.transposed.data() + j * numClusters;
+                    for (size_t c = 0; c < numClusters; ++c)
+                    {
+                        out[c] += value * column[c];
+                    }
+                }
+                for (size_t c = 0; c < numClusters; ++c)
+                {
+                    out[c] = std::max(0.0, rowNorms[r] - 2.0 * out[c] + table.norms[c]);
+                }
+            }
+        }
+
+        // Call visit(position, distances) for every row in [begin, end) of a view with its squared distances to
+        // all centroids, converting rows to double in blocks that stay in cache while the kernel runs
+        template <typename T, typename Visit>
+        void forEachRowDistances(const DatasetView<T> &data, size_t begin, size_t end, const CentroidTable &table, Visit visit)
+        {
+            const size_t blockRows = 64;
+            const size_t numFeatures = table.numFeatures;
+            std::vector<double> rows(blockRows * numFeatures), rowNorms(blockRows), distances(blockRows * table.numClusters);
+
+            for (size_t blockBegin = begin; blockBegin < end; blockBegin += blockRows)
+            {
+                const size_t numRows = std::min(blockRows, end - blockBegin);
+                for (size_t r = 0; r < numRows; ++r)
+                {
+                    const std::span<const T> row = data.row(blockBegin + r);
+                    double norm = 0.0;
+                    for (size_t j = 0; j < numFeatures; ++j)
+                    {
+                        const double value = static_cast<double>(row[j]);
+                        rows[r * numFeatures + j] = value;
+                        norm += value * value;
+                    }
+                    rowNorms[r] = norm;
+                }
+
+                blockSquaredDistances(rows.data(), rowNorms.data(), numRows, table, distances.data());
+                Instrumentation::count("KMeans::distances", numRows * table.numClusters);
+
+                for (size_t r = 0; r < numRows; ++r)
+                {
+                    visit(blockBegin + r, distances.data() + r * table.numClusters);
+                }
+            }
+        }
+
+        // Greedy k-means++ seeding: each new centroid is the best of 2 + log(k) candidates drawn with probability
+        // proportional to the squared distance to the nearest centroid so far. The distance updates run in parallel.
+        template <typename T>
+        CentroidTable seedKMeansPlusPlus(const DatasetView<T> &data, size_t numClusters, size_t numThreads, std::mt19937 &generator)
+        {
+            const size_t numRows = data.size();
+            const size_t numFeatures = data.getNumFeatures();
+            const size_t numTrials = 2 + static_cast<size_t>(std::log(static_cast<double>(numClusters)));
+            CentroidTable table(numClusters, numFeatures);
+
+            auto setCentroid = [&](size_t cluster, size_t position)
+            {
+                const std::span<const T> row = data.row(position);
+                std::transform(row.begin(), row.end(), table.centroid(cluster), [](T value)
+                               { return static_cast<double>(value); });
+            };
+
+            setCentroid(0, std::uniform_int_distribution<size_t>(0, numRows - 1)(generator));
+            std::vector<double> minDistances(numRows);
+            parallelFor(numRows, numThreads, [&](size_t begin, size_t end, size_t)
+                        {
+                            for (size_t i = begin; i < end; ++i)
+                            {
+                                minDistances[i] = squaredDistance(data.row(i), table.centroid(0));
+                            } });
+
+            std::vector<double> cumulative(numRows);
+            std::vector<size_t> candidates(numTrials);
+            std::vector<double> candidateDistances(numTrials * numRows);
+            std::vector<double> potentials(numTrials);
+
+            for (size_t cluster = 1; cluster < numClusters; ++cluster)
+            {
+                std::partial_sum(minDistances.begin(), minDistances.end(), cumulative.begin());
+                std::uniform_real_distribution<double> uniform(0.0, cumulative.back());
+                for (size_t t = 0; t < numTrials; ++t)
+                {
+                    // All rows coincide with a centroid already once the total is zero; any row will do then
+                    const size_t position = std::upper_bound(cumulative.begin(), cumulative.end(), uniform(generator)) - cumulative.begin();
+                    candidates[t] = std::min(position, numRows - 1);
+                }
+
+                // Distances of every row to every candidate, and the potential each candidate would leave
+                std::vector<std::vector<double>> threadPotentials(numThreads, std::vector<double>(numTrials, 0.0));
+                parallelFor(numRows, numThreads, [&](size_t begin, size_t end, size_t threadIndex)
+                            {
+                                std::vector<double> candidate(numFeatures);
+                                for (size_t t = 0; t < numTrials; ++t)
+                                {
+                                    const std::span<const T> candidateRow = data.row(candidates[t]);
+                                    std::transform(candidateRow.begin(), candidateRow.end(), candidate.begin(), [](T value)
+                                                   { return static_cast<double>(value); });
+                                    double potential = 0.0;
+                                    for (size_t i = begin; i < end; ++i)
+                                    {
+                                        const double distance = std::min(minDistances[i], squaredDistance(data.row(i), candidate.data()));
+                                        candidateDistances[t * numRows + i] = distance;
+                                        potential += distance;
+                                    }
+                                    threadPotentials[threadIndex][t] = potential;
+                                } });
+
+                std::fill(potentials.begin(), potentials.end(), 0.0);
+                for (const auto &threadPotential : threadPotentials)
+                {
+                    for (size_t t = 0; t < numTrials; ++t)
+                    {
+                        potentials[t] += threadPotential[t];
+                    }
+                }
+
+                const size_t best = std::min_element(potentials.begin(), potentials.end()) - potentials.begin();
+                setCentroid(cluster, candidates[best]);
+                std::copy(candidateDistances.begin() + best * numRows, candidateDistances.begin() + (best + 1) * numRows, minDistances.begin());
+            }
+
+            table.update();
+            return table;
+        }
+
+        // Mean over the features of the variance of each feature, the scale k-means tolerances are relative to
+        template <typename T>
+        double meanFeatureVariance(const DatasetView<T> &data)
+        {
+            const size_t numFeatures = data.getNumFeatures();
+            std::vector<double> sums(numFeatures, 0.0), squaredSums(numFeatures, 0.0);
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                const std::span<const T> row = data.row(i);
+                for (size_t j = 0; j < numFeatures; ++j)
+                {
+                    const double value = static_cast<double>(row[j]);
+                    sums[j] += value;
+                    squaredSums[j] += value * value;
+                }
+            }
+
+            double variance = 0.0;
+            for (size_t j = 0; j < numFeatures; ++j)
+            {
+                const double mean = sums[j] / data.size();
+                variance += std::max(0.0, squaredSums[j] / data.size() - mean * mean);
+            }
+            return variance / std::max<size_t>(1, numFeatures);
+        }
+
+        // Per-thread sums of the rows assigned to each cluster, reduced into new centroids after a pass
+        struct ClusterSums
+        {
+            std::vector<double> sums;
+            std::vector<size_t> counts;
+            double inertia = 0.0;
+            size_t changed = 0;
+
+            ClusterSums(size_t numClusters, size_t numFeatures) : sums(numClusters * numFeatures, 0.0), counts(numClusters, 0) {}
+
+            template <typename T>
+            void add(std::span<const T> row, size_t cluster)
+            {
+                double *sum = sums.data() + cluster * row.size();
+                for (size_t j = 0; j < row.size(); ++j)
+                {
+                    sum[j] += static_cast<double>(row[j]);
+                }
+                ++counts[cluster];
+            }
+        };
+
+        // Sum the per-thread results into the first one
+        MLLIB_INLINE ClusterSums &reduceClusterSums(std::vector<ClusterSums> &threadSums)
+        {
+            ClusterSums &total = threadSums[0];
+            for (size_t t = 1; t < threadSums.size(); ++t)
+            {
+                for (size_t v = 0; v < total.sums.size(); ++v)
+                {
+                    total.sums[v] += threadSums[t].sums[v];
+                }
+                for (size_t c = 0; c < total.counts.size(); ++c)
+                {
+                    total.counts[c] += threadSums[t].counts[c];
+                }
+                total.inertia += threadSums[t].inertia;
+                total.changed += threadSums[t].changed;
+            }
+            return total;
+        }
+
+        // Move every non-empty cluster's centroid to the mean of its rows; an empty cluster keeps its centroid.
+        // Returns the distance each centroid moved.
+        MLLIB_INLINE std::vector<double> moveCentroids(CentroidTable &table, const ClusterSums &total)
+        {
+            std::vector<double> movement(table.numClusters, 0.0);
+            for (size_t c = 0; c < table.numClusters; ++c)
+            {
+                if (total.counts[c] == 0)
+                    continue;
+
+                double *centroid = table.centroid(c);
+                double squaredMove = 0.0;
+                for (size_t j = 0; j < table.numFeatures; ++j)
+                {
+                    const double mean = total.sums[c * table.numFeatures + j] / total.counts[c];
+                    squaredMove += (mean - centroid[j]) * (mean - centroid[j]);
+                    centroid[j] = mean;
+                }
+                movement[c] = std::sqrt(squaredMove);
+            }
+            table.update();
+            return movement;
+        }
+
+        // Euclidean distances between all pairs of centroids
+        MLLIB_INLINE std::vector<double> centroidDistances(const CentroidTable &table)
+        {
+            std::vector<double> distances(table.numClusters * table.numClusters, 0.0);
+            for (size_t a = 0; a < table.numClusters; ++a)
+            {
+                for (size_t b = a + 1; b < table.numClusters; ++b)
+                {
+                    const double distance = std::sqrt(squaredDistance(std::span<const double>(table.centroid(a), table.numFeatures), table.centroid(b)));
+                    distances[a * table.numClusters + b] = distance;
+                    distances[b * table.numClusters + a] = distance;
+                }
+            }
+            return distances;
+        }
+
+        // One mini-batch k-means update (Sculley, 2010): each centroid moves toward the mean of its rows in the
+        // batch with a learning rate of its batch rows over all rows it has absorbed. Returns the summed squared
+        // movement; batchInertia receives the squared distances of the batch rows before the update.
+        template <typename T>
+        double miniBatchStep(const DatasetView<T> &batch, CentroidTable &table, std::vector<long double> &clusterCounts, size_t numThreads, double &batchInertia)
+        {
+            std::vector<ClusterSums> threadSums(std::max<size_t>(1, std::min(numThreads, batch.size())), ClusterSums(table.numClusters, table.numFeatures));
+            parallelFor(batch.size(), numThreads, [&](size_t begin, size_t end, size_t threadIndex)
+                        {
+                            ClusterSums &local = threadSums[threadIndex];
+                            forEachRowDistances(batch, begin, end, table, [&](size_t position, const double *distances)
+                                                {
+                                                    const size_t cluster = std::min_element(distances, distances + table.numClusters) - distances;
+                                                    local.inertia += distances[cluster];
+                                                    local.add(batch.row(position), cluster);
+                                                }); });
+
+            const ClusterSums &total = reduceClusterSums(threadSums);
+            batchInertia = total.inertia;
+
+            double squaredMovement = 0.0;
+            for (size_t c = 0; c < table.numClusters; ++c)
+            {
+                if (total.counts[c] == 0)
+                    continue;
+
+                clusterCounts[c] += total.counts[c];
+                const double rate = total.counts[c] / static_cast<double>(clusterCounts[c]);
+                double *centroid = table.centroid(c);
+                for (size_t j = 0; j < table.numFeatures; ++j)
+                {
+                    const double step = rate * (total.sums[c * table.numFeatures + j] / total.counts[c] - centroid[j]);
+                    centroid[j] += step;
+                    squaredMovement += step * step;
+                }
+            }
+            table.update();
+            return squaredMovement;
+        }
+
+        // Neighbour searches compare reduced distances, which order points like the metric does but are
+        // cheaper: the squared distance for Euclidean, the distance itself for Manhattan and Infinity
+        template <stat::NormType Metric>
+        double accumulateReduced(double reduced, double difference)
+        {
+            if constexpr (Metric == stat::NormType::Manhattan)
+                return reduced + std::abs(difference);
+            else if constexpr (Metric == stat::NormType::Euclidean)
+                return reduced + difference * difference;
+            else
+                return std::max(reduced, std::abs(difference));
+        }
+
+        template <stat::NormType Metric>
+        double reducedDistance(const double *pointA, const double *pointB, size_t numFeatures)
+        {
+            double reduced = 0.0;
+            for (size_t j = 0; j < numFeatures; ++j)
+            {
+                reduced = accumulateReduced<Metric>(reduced, pointA[j] - pointB[j]);
+            }
+            return reduced;
+        }
+
+        template <stat::NormType Metric>
+        double toReduced(double distance)
+        {
+            return (Metric == stat::NormType::Euclidean) ? distance * distance : distance;
+        }
+
+        template <stat::NormType Metric>
+        double fromReduced(double reduced)
+        {
+            return (Metric == stat::NormType::Euclidean) ? std::sqrt(reduced) : reduced;
+        }
+
+        // Run function.template operator()<Metric>() for the metric selected at run time
+        template <typename Function>
+        auto dispatchMetric(stat::NormType metric, Function function)
+        {
+            switch (metric)
+            {
+            case stat::NormType::Manhattan:
+                return function.template operator()<stat::NormType::Manhattan>();
+            case stat::NormType::Infinity:
+                return function.template operator()<stat::NormType::Infinity>();
+            default:
+                return function.template operator()<stat::NormType::Euclidean>();
+            }
+        }
+
+#if defined(MLLIB_AVX2_KERNELS)
+        // Squared Euclidean distance of the first vecLen - vecLen % 8 values
+        MLLIB_INLINE MLLIB_TARGET_AVX2 float squaredDistanceAvx2(const float *vectorA, const float *vectorB, size_t vecLen)
+        {
+            size_t i = 0;
+            __m256 sums[4] = {_mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps()};
+            for (; i + 32 <= vecLen; i += 32)
+            {
+                for (size_t u = 0; u < 4; ++u)
+                {
+                    const __m256 difference = _mm256_sub_ps(_mm256_loadu_ps(vectorA + i + 8 * u), _mm256_loadu_ps(vectorB + i + 8 * u));
+                    sums[u] = _mm256_fmadd_ps(difference, difference, sums[u]);
+                }
+            }
+            for (; i + 8 <= vecLen; i += 8)
+            {
+                const __m256 difference = _mm256_sub_ps(_mm256_loadu_ps(vectorA + i), _mm256_loadu_ps(vectorB + i));
+                sums[0] = _mm256_fmadd_ps(difference, difference, sums[0]);
+            }
+            return horizontalSum(_mm256_add_ps(_mm256_add_ps(sums[0], sums[1]), _mm256_add_ps(sums[2], sums[3])));
+        }
+
+        // Dot product of the first vecLen - vecLen % 8 values
+        MLLIB_INLINE MLLIB_TARGET_AVX2 float dotProductAvx2(const float *vectorA, const float *vectorB, size_t vecLen)
+        {
+            size_t i = 0;
+            __m256 sums[4] = {_mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps()};
+            for (; i + 32 <= vecLen; i += 32)
+            {
+                for (size_t u = 0; u < 4; ++u)
+                {
+                    sums[u] = _mm256_fmadd_ps(_mm256_loadu_ps(vectorA + i + 8 * u), _mm256_loadu_ps(vectorB + i + 8 * u), sums[u]);
+                }
+            }
+            for (; i + 8 <= vecLen; i += 8)
+            {
+                sums[0] = _mm256_fmadd_ps(_mm256_loadu_ps(vectorA + i), _mm256_loadu_ps(vectorB + i), sums[0]);
+            }
+            return horizontalSum(_mm256_add_ps(_mm256_add_ps(sums[0], sums[1]), _mm256_add_ps(sums[2], sums[3])));
+        }
+#endif
+
+        // Squared Euclidean distance of two float vectors
+        MLLIB_INLINE float squaredDistanceFloat(const float *vectorA, const float *vectorB, size_t vecLen)
+        {
+            float result = 0.0f;
+            size_t i = 0;
+
+#if defined(MLLIB_AVX2_KERNELS)
+            if (cpuHasAvx2())
+            {
+                result = squaredDistanceAvx2(vectorA, vectorB, vecLen);
+                i = vecLen - vecLen % 8;
+            }
+#endif
+
+            float sums[4] = {};
+            for (; i + 4 <= vecLen; i += 4)
+            {
+                for (size_t u = 0; u < 4; ++u)
+                {
+                    const float difference = vectorA[i + u] - vectorB[i + u];
+                    sums[u] += difference * difference;
+                }
+            }
+            result += (sums[0] + sums[1]) + (sums[2] + sums[3]);
+
+            for (; i < vecLen; ++i)
+            {
+                const float difference = vectorA[i] - vectorB[i];
+                result += difference * difference;
+            }
+            return result;
+        }
+
+        // Dot product of two float vectors
+        MLLIB_INLINE float dotProductFloat(const float *vectorA, const float *vectorB, size_t vecLen)
+        {
+            float result = 0.0f;
+            size_t i = 0;
+
+#if defined(MLLIB_AVX2_KERNELS)
+            if (cpuHasAvx2())
+            {
+                result = dotProductAvx2(vectorA, vectorB, vecLen);
+                i = vecLen - vecLen % 8;
+            }
+#endif
+
+            float sums[4] = {};
+            for (; i + 4 <= vecLen; i += 4)
+            {
+                for (size_t u = 0; u < 4; ++u)
+                {
+                    sums[u] += vectorA[i + u] * vectorB[i + u];
+                }
+            }
+            result += (sums[0] + sums[1]) + (sums[2] + sums[3]);
+
+            for (; i < vecLen; ++i)
+            {
+                result += vectorA[i] * vectorB[i];
+            }
+            return result;
+        }
+
+#if defined(MLLIB_AVX2_KERNELS)
+        // Manhattan distance of the first vecLen - vecLen % 8 values
+        MLLIB_INLINE MLLIB_TARGET_AVX2 float manhattanDistanceAvx2(const float *vectorA, const float *vectorB, size_t vecLen)
+        {
+            size_t i = 0;
+            const __m256 signMask = _mm256_set1_ps(-0.0f);
+            __m256 sums[4] = {_mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps()};
+            for (; i + 32 <= vecLen; i += 32)
+            {
+                for (size_t u = 0; u < 4; ++u)
+                {
+                    const __m256 difference = _mm256_sub_ps(_mm256_loadu_ps(vectorA + i + 8 * u), _mm256_loadu_ps(vectorB + i + 8 * u));
+                    sums[u] = _mm256_add_ps(sums[u], _mm256_andnot_ps(signMask, difference));
+                }
+            }
+            for (; i + 8 <= vecLen; i += 8)
+            {
+                const __m256 difference = _mm256_sub_ps(_mm256_loadu_ps(vectorA + i), _mm256_loadu_ps(vectorB + i));
+                sums[0] = _mm256_add_ps(sums[0], _mm256_andnot_ps(signMask, difference));
+            }
+            return horizontalSum(_mm256_add_ps(_mm256_add_ps(sums[0], sums[1]), _mm256_add_ps(sums[2], sums[3])));
+        }
+#endif
+
+        // Manhattan distance of two float vectors
+        MLLIB_INLINE float manhattanDistanceFloat(const float *vectorA, const float *vectorB, size_t vecLen)
+        {
+            float result = 0.0f;
+            size_t i = 0;
+
+#if defined(MLLIB_AVX2_KERNELS)
+            if (cpuHasAvx2())
+            {
+                result = manhattanDistanceAvx2(vectorA, vectorB, vecLen);
+                i = vecLen - vecLen % 8;
+            }
+#endif
+
+            float sums[4] = {};
+            for (; i + 4 <= vecLen; i += 4)
+            {
+                for (size_t u = 0; u < 4; ++u)
+                {
+                    sums[u] += std::fabs(vectorA[i + u] - vectorB[i + u]);
+                }
+            }
+            result += (sums[0] + sums[1]) + (sums[2] + sums[3]);
+
+            for (; i < vecLen; ++i)
+            {
+                result += std::fabs(vectorA[i] - vectorB[i]);
+            }
+            return result;
+        }
+
+        // HNSW index file layout (little-endian): a 64-byte HNSWFileHeader, then the vectors, layer 0 links,
+        // node levels, upper-layer offsets and upper-layer links of the index, each starting on a 64-byte
+        // boundary so the mapped arrays are aligned
+        struct HNSWFileHeader
+        {
+            char magic[4];
+            uint32_t version;
+            uint32_t metric;
+            int32_t maxLevel;
+            uint32_t entryPoint;
+            uint32_t M;
+            uint32_t efConstruction;
+            uint32_t efSearch;
+            uint64_t numNodes;
+            uint64_t numFeatures;
+            uint64_t numUpperLinks;
+            uint8_t reserved[8];
+        };
+
+        static_assert(sizeof(HNSWFileHeader) == 64, "HNSW file header must be 64 bytes");
+
+        constexpr uint32_t hnswFileVersion = 1;
+
+        // Byte offsets of the five sections of an HNSW index file, followed by the file size
+        MLLIB_INLINE std::array<uint64_t, 6> hnswSectionOffsets(const HNSWFileHeader &header)
+        {
+            const uint64_t sectionSizes[5] = {header.numNodes * header.numFeatures * sizeof(float),
+                                              header.numNodes * (1 + 2 * static_cast<uint64_t>(header.M)) * sizeof(uint32_t),
+                                              header.numNodes * sizeof(uint8_t),
+                                              (header.numNodes + 1) * sizeof(uint64_t),
+                                              header.numUpperLinks * sizeof(uint32_t)};
+
+            std::array<uint64_t, 6> offsets;
+            offsets[0] = sizeof(HNSWFileHeader);
+            for (size_t s = 0; s < 5; ++s)
+            {
+                offsets[s + 1] = (offsets[s] + sectionSizes[s] + 63) / 64 * 64;
+            }
+            return offsets;
+        }
+    }
+
+    MLLIB_INLINE void Instrumentation::enable(bool withTracing)
+    {
+        if (withTracing && !isTracing())
+            detail::traceEpoch.store(detail::steadyNanoseconds(std::chrono::steady_clock::now()), std::memory_order_relaxed);
+
+        tracing.store(withTracing, std::memory_order_relaxed);
+        enabled.store(true, std::memory_order_relaxed);
+    }
+
+    MLLIB_INLINE void Instrumentation::disable()
+    {
+        enabled.store(false, std::memory_order_relaxed);
+        tracing.store(false, std::memory_order_relaxed);
+    }
+
+    MLLIB_INLINE void Instrumentation::addCount(const char *name, uint64_t value)
+    {
+        if (detail::InstrumentationSlot *slot = detail::findSlot(name))
+            slot->count.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    MLLIB_INLINE void Instrumentation::addValue(const char *name, double value)
+    {
+        const int64_t timestamp = detail::steadyNanoseconds(std::chrono::steady_clock::now()) - detail::traceEpoch.load(std::memory_order_relaxed);
+        detail::addTraceEvent({name, 'C', timestamp, 0, value});
+    }
+
+    MLLIB_INLINE void Instrumentation::recordTime(const char *name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+    {
+        const int64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        if (detail::InstrumentationSlot *slot = detail::findSlot(name))
+        {
+            slot->count.fetch_add(1, std::memory_order_relaxed);
+            slot->nanoseconds.fetch_add(duration, std::memory_order_relaxed);
+        }
+
+        if (isTracing())
+            detail::addTraceEvent({name, 'X', detail::steadyNanoseconds(start) - detail::traceEpoch.load(std::memory_order_relaxed), duration, 0.0});
+    }
+
+    MLLIB_INLINE std::vector<InstrumentationStats> Instrumentation::getStats()
+    {
+        std::lock_guard<std::mutex> lock(detail::instrumentationMutex);
+        std::map<std::string, InstrumentationStats> totals = detail::retiredStats;
+        for (const auto &thread : detail::instrumentationThreads)
+        {
+            const size_t numSlots = thread->numSlots.load(std::memory_order_acquire);
+            for (size_t s = 0; s < numSlots; ++s)
+            {
+                const detail::InstrumentationSlot &slot = thread->slots[s];
+                InstrumentationStats &stats = totals[slot.name.load(std::memory_order_relaxed)];
+                stats.count += slot.count.load(std::memory_order_relaxed);
+                stats.totalTime += std::chrono::nanoseconds(slot.nanoseconds.load(std::memory_order_relaxed));
+            }
+        }
+
+        std::vector<InstrumentationStats> result;
+        result.reserve(totals.size());
+        for (auto &[name, stats] : totals)
+        {
+            stats.name = name;
+            result.push_back(std::move(stats));
+        }
+        return result;
+    }
+
+    MLLIB_INLINE void Instrumentation::reset()
+    {
+        std::lock_guard<std::mutex> lock(detail::instrumentationMutex);
+        for (const auto &thread : detail::instrumentationThreads)
+        {
+            const size_t numSlots = thread->numSlots.load(std::memory_order_acquire);
+            for (size_t s = 0; s < numSlots; ++s)
+            {
+                thread->slots[s].count.store(0, std::memory_order_relaxed);
+                thread->slots[s].nanoseconds.store(0, std::memory_order_relaxed);
+            }
+
+            std::lock_guard<std::mutex> eventLock(thread->eventMutex);
+            thread->events.clear();
+            thread->droppedEvents = 0;
+        }
+
+        detail::retiredStats.clear();
+        detail::retiredTraces.clear();
+        detail::retiredDroppedEvents = 0;
+    }
+
+    MLLIB_INLINE bool Instrumentation::writeChromeTrace(const std::string &filename)
+    {
+        std::ofstream outFile(filename);
+        if (!outFile.is_open())
+        {
+            std::cerr << "Unable to open file for writing." << std::endl;
+            return false;
+        }
+
+        // Timestamps and durations are in microseconds
+        outFile << std::fixed;
+        outFile.precision(3);
+        outFile << "{\"traceEvents\":[";
+
+        bool first = true;
+        auto writeEvents = [&outFile, &first](size_t threadId, const std::vector<detail::TraceEvent> &events)
+        {
+            for (const detail::TraceEvent &event : events)
+            {
+                outFile << (first ? "\n" : ",\n") << "{\"name\":";
+                detail::writeJsonString(outFile, event.name);
+                outFile << ",\"ph\":\"" << event.phase << "\",\"ts\":" << event.timestamp / 1000.0 << ",\"pid\":1,\"tid\":" << threadId;
+                if (event.phase == 'X')
+                    outFile << ",\"dur\":" << event.duration / 1000.0 << "}";
+                else
+                {
+                    outFile.precision(9);
+                    outFile << ",\"args\":{\"value\":" << event.value << "}}";
+                    outFile.precision(3);
+                }
+                first = false;
+            }
+        };
+
+        std::lock_guard<std::mutex> lock(detail::instrumentationMutex);
+        size_t droppedEvents = detail::retiredDroppedEvents;
+        for (const detail::RetiredTrace &trace : detail::retiredTraces)
+        {
+            writeEvents(trace.threadId, trace.events);
+        }
+        for (const auto &thread : detail::instrumentationThreads)
+        {
+            std::lock_guard<std::mutex> eventLock(thread->eventMutex);
+            droppedEvents += thread->droppedEvents;
+            writeEvents(thread->threadId, thread->events);
+        }
+
+        outFile << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":" << droppedEvents << "}}\n";
+        return outFile.good();
+    }
+
+    MLLIB_INLINE LinearRegressionModel::LinearRegressionModel(){};
+
+    MLLIB_INLINE LinearRegressionModel::LinearRegressionModel(long double slope, long double intercept, stat::NormalizationType normalizationType)
+        : slope(slope), intercept(intercept), normalizationType(normalizationType) {}
+
+    // Getter function implementations
+    MLLIB_INLINE long double LinearRegressionModel::getSlope() const { return slope; }
+    MLLIB_INLINE long double LinearRegressionModel::getIntercept() const { return intercept; }
+    MLLIB_INLINE stat::NormalizationType LinearRegressionModel::getNormalizationType() const { return normalizationType; }
+
+    // Setter function implementations
+    MLLIB_INLINE void LinearRegressionModel::setSlope(long double newSlope) { slope = newSlope; }
+    MLLIB_INLINE void LinearRegressionModel::setIntercept(long double newIntercept) { intercept = newIntercept; }
+    MLLIB_INLINE void LinearRegressionModel::setNormalizationType(stat::NormalizationType newNormalizationType) { normalizationType = newNormalizationType; }
+
+    template <typename T>
+    std::vector<long double> LinearRegressionModel::predict(const std::vector<T> &xValues) const
+    {
+        assert(("xValues is empty" && !xValues.empty()) && "Input values must not be empty");
+
+        size_t size = xValues.size();
+
+        std::vector<long double> normalizedXValues = stat::Normalize(xValues, normalizationType);
+        std::vector<long double> predictedYValues(size);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            predictedYValues[i] = slope * normalizedXValues[i] + intercept;
+        }
+
+        return predictedYValues;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template std::vector<long double> LinearRegressionModel::predict(const std::vector<int8_t> &xValues) const;
+    template std::vector<long double> LinearRegressionModel::predict(const std::vector<int16_t> &xValues) const;
+    template std::vector<long double> LinearRegressionModel::predict(const std::vector<int32_t> &xValues) const;
+    template std::vector<long double> LinearRegressionModel::predict(const std::vector<int64_t> &xValues) const;
+
+    template std::vector<long double> LinearRegressionModel::predict(const std::vector<uint8_t> &xValues) const;
+    template std::vector<long double> LinearRegressionModel::predict(const std::vector<uint16_t> &xValues) const;
+    template std::vector<long double> LinearRegressionModel::predict(const std::vector<uint32_t> &xValues) const;
+    template std::vector<long double> LinearRegressionModel::predict(const std::vector<uint64_t> &xValues) const;
+
+    template std::vector<long double> LinearRegressionModel::predict(const std::vector<float> &xValues) const;
+    template std::vector<long double> LinearRegressionModel::predict(const std::vector<double> &xValues) const;
+    template std::vector<long double> LinearRegressionModel::predict(const std::vector<long double> &xValues) const;
+#endif
+
+    template <typename T>
+    void LinearRegressionModel::predict(std::span<const T> xValues, std::span<long double> predictedYValues) const
+    {
+        assert(("xValues is empty" && !xValues.empty()) && "Input values must not be empty");
+        assert(xValues.size() == predictedYValues.size() && "Output size must match input size");
+
+        long double offset;
+        long double scale;
+        detail::normalizationParameters(xValues, normalizationType, offset, scale);
+
+        for (size_t i = 0; i < xValues.size(); ++i)
+        {
+            predictedYValues[i] = slope * ((static_cast<long double>(xValues[i]) - offset) / scale) + intercept;
+        }
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template void LinearRegressionModel::predict(std::span<const int8_t> xValues, std::span<long double> predictedYValues) const;
+    template void LinearRegressionModel::predict(std::span<const int16_t> xValues, std::span<long double> predictedYValues) const;
+    template void LinearRegressionModel::predict(std::span<const int32_t> xValues, std::span<long double> predictedYValues) const;
+    template void LinearRegressionModel::predict(std::span<const int64_t> xValues, std::span<long double> predictedYValues) const;
+
+    template void LinearRegressionModel::predict(std::span<const uint8_t> xValues, std::span<long double> predictedYValues) const;
+    template void LinearRegressionModel::predict(std::span<const uint16_t> xValues, std::span<long double> predictedYValues) const;
+    template void LinearRegressionModel::predict(std::span<const uint32_t> xValues, std::span<long double> predictedYValues) const;
+    template void LinearRegressionModel::predict(std::span<const uint64_t> xValues, std::span<long double> predictedYValues) const;
+
+    template void LinearRegressionModel::predict(std::span<const float> xValues, std::span<long double> predictedYValues) const;
+    template void LinearRegressionModel::predict(std::span<const double> xValues, std::span<long double> predictedYValues) const;
+    template void LinearRegressionModel::predict(std::span<const long double> xValues, std::span<long double> predictedYValues) const;
+#endif
+
+    template <typename T>
+    long double LinearRegressionModel::evaluate(const std::vector<T> &actualYValues, const std::vector<long double> &predictedYValues) const
+    {
+        assert(("Actual Y values are empty" && !actualYValues.empty()) &&
+               ("Predicted Y values are empty" && !predictedYValues.empty()) &&
+               (actualYValues.size() == predictedYValues.size() && "Input values must have the same size"));
+
+        size_t size = actualYValues.size();
+        long double mse = 0.0L;
+
+        // Normalize actualYValues based on the model's normalization type
+        std::vector<long double> normalizedActualYValues = stat::Normalize(actualYValues, normalizationType);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            mse += std::pow(normalizedActualYValues[i] - predictedYValues[i], 2);
+        }
+
+        mse /= static_cast<long double>(size);
+        return mse;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template long double LinearRegressionModel::evaluate(const std::vector<int8_t> &actualYValues, const std::vector<long double> &predictedYValues) const;
+    template long double LinearRegressionModel::evaluate(const std::vector<int16_t> &actualYValues, const std::vector<long double> &predictedYValues) const;
+    template long double LinearRegressionModel::evaluate(const std::vector<int32_t> &actualYValues, const std::vector<long double> &predictedYValues) const;
+    template long double LinearRegressionModel::evaluate(const std::vector<int64_t> &actualYValues, const std::vector<long double> &predictedYValues) const;
+
+    template long double LinearRegressionModel::evaluate(const std::vector<uint8_t> &actualYValues, const std::vector<long double> &predictedYValues) const;
+    template long double LinearRegressionModel::evaluate(const std::vector<uint16_t> &actualYValues, const std::vector<long double> &predictedYValues) const;
+    template long double LinearRegressionModel::evaluate(const std::vector<uint32_t> &actualYValues, const std::vector<long double> &predictedYValues) const;
+    template long double LinearRegressionModel::evaluate(const std::vector<uint64_t> &actualYValues, const std::vector<long double> &predictedYValues) const;
+
+    template long double LinearRegressionModel::evaluate(const std::vector<float> &actualYValues, const std::vector<long double> &predictedYValues) const;
+    template long double LinearRegressionModel::evaluate(const std::vector<double> &actualYValues, const std::vector<long double> &predictedYValues) const;
+    template long double LinearRegressionModel::evaluate(const std::vector<long double> &actualYValues, const std::vector<long double> &predictedYValues) const;
+#endif
+
+    MLLIB_INLINE void LinearRegressionModel::saveToFile(const std::string &filename) const
+    {
+        std::ofstream outFile(filename);
+        if (outFile.is_open())
+        {
+            outFile.precision(std::numeric_limits<long double>::max_digits10);
+            outFile << *this;
+            outFile.close();
+        }
+        else
+        {
+            std::cerr << "Unable to open file for writing." << std::endl;
+        }
+    }
+
+    MLLIB_INLINE void LinearRegressionModel::loadFromFile(const std::string &filename)
+    {
+        if (detail::isBinaryModelFile(filename))
+        {
+            loadBinary(filename);
+            return;
+        }
+
+        std::ifstream inFile(filename);
+        if (inFile.is_open())
+        {
+            // Read into a temporary so a truncated or malformed file leaves this model unchanged
+            LinearRegressionModel model;
+            if (inFile >> model)
+                *this = model;
+            else
+                std::cerr << "Invalid model file: truncated or malformed text model" << std::endl;
+            inFile.close();
+        }
+        else
+        {
+            std::cerr << "Unable to open file for reading." << std::endl;
+        }
+    }
+
+    MLLIB_INLINE bool LinearRegressionModel::saveBinary(const std::string &filename) const
+    {
+        detail::PayloadWriter payload;
+        payload.write(slope);
+        payload.write(intercept);
+        return detail::writeModelFile(filename, detail::LinearModelFile, normalizationType, 2, payload.buffer);
+    }
+
+    MLLIB_INLINE bool LinearRegressionModel::loadBinary(const std::string &filename)
+    {
+        MappedFile file;
+        const detail::ModelFileHeader *header = detail::readModelFile(file, filename, detail::LinearModelFile);
+        if (header == nullptr)
+            return false;
+
+        detail::PayloadReader payload(file.data() + sizeof(detail::ModelFileHeader), header->payloadSize);
+        long double newSlope, newIntercept;
+        if (header->numCoefficients != 2 || header->normalizationType > stat::L2_Euclidean || !payload.read(newSlope) || !payload.read(newIntercept) ||
+            !payload.atEnd())
+        {
+            std::cerr << "Invalid model file: malformed payload" << std::endl;
+            return false;
+        }
+
+        slope = newSlope;
+        intercept = newIntercept;
+        normalizationType = static_cast<stat::NormalizationType>(header->normalizationType);
+        return true;
+    }
+
+    template <typename T>
+    LinearRegressionModel LinearRegressionLeastSquares(const std::vector<T> &xValues, const std::vector<T> &yValues, stat::NormalizationType normalizationType)
+    {
+        assert(("xValues is empty" && !xValues.empty()) &&
+               ("yValues is empty" && !yValues.empty()) &&
+               (xValues.size() == yValues.size() && "Input vectors must have the same size"));
+
+        std::vector<long double> normalizedXValues = stat::Normalize(xValues, normalizationType);
+        std::vector<long double> normalizedYValues = stat::Normalize(yValues, normalizationType);
+
+        size_t size = normalizedXValues.size();
+
+        long double sumX = std::accumulate(normalizedXValues.begin(), normalizedXValues.end(), 0.0L);
+        long double sumY = std::accumulate(normalizedYValues.begin(), normalizedYValues.end(), 0.0L);
+        long double sumXY = vecAlg::DotProduct(normalizedXValues, normalizedYValues);
+        long double sumXSquare = vecAlg::DotProduct(normalizedXValues, normalizedXValues);
+
+        long double slope = (size * sumXY - sumX * sumY) / (size * sumXSquare - std::pow(sumX, 2));
+        long double intercept = (sumY - slope * sumX) / size;
+
+        return LinearRegressionModel(slope, intercept, normalizationType);
+    }
+
+    MLLIB_INLINE void LinearRegressionModel::printInfo() const
+    {
+        std::cout << "Linear Regression Model:\n"
+                  << "Slope: " << slope << "\n"
+                  << "Intercept: " << intercept << "\n"
+                  << "Normalization Type: " << normalizationType << "\n";
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<int8_t> &xValues, const std::vector<int8_t> &yValues, stat::NormalizationType normalizationType);
+    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<int16_t> &xValues, const std::vector<int16_t> &yValues, stat::NormalizationType normalizationType);
+    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<int32_t> &xValues, const std::vector<int32_t> &yValues, stat::NormalizationType normalizationType);
+    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<int64_t> &xValues, const std::vector<int64_t> &yValues, stat::NormalizationType normalizationType);
+
+    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<uint8_t> &xValues, const std::vector<uint8_t> &yValues, stat::NormalizationType normalizationType);
+    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<uint16_t> &xValues, const std::vector<uint16_t> &yValues, stat::NormalizationType normalizationType);
+    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<uint32_t> &xValues, const std::vector<uint32_t> &yValues, stat::NormalizationType normalizationType);
+    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<uint64_t> &xValues, const std::vector<uint64_t> &yValues, stat::NormalizationType normalizationType);
+
+    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<float> &xValues, const std::vector<float> &yValues, stat::NormalizationType normalizationType);
+    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<double> &xValues, const std::vector<double> &yValues, stat::NormalizationType normalizationType);
+    template LinearRegressionModel LinearRegressionLeastSquares(const std::vector<long double> &xValues, const std::vector<long double> &yValues, stat::NormalizationType normalizationType);
+#endif
+
+    template <typename T>
+    LinearRegressionModel LinearRegressionGradientDescent(const std::vector<T> &xValues, const std::vector<T> &yValues, stat::NormalizationType normalizationType, long double learningRate, int numIterations, const TrainingCallback &callback)
+    {
+        assert(("xValues is empty" && !xValues.empty()) &&
+               ("yValues is empty" && !yValues.empty()) &&
+               (xValues.size() == yValues.size() && "Input vectors must have the same size"));
+
+        std::vector<long double> normalizedXValues = stat::Normalize(xValues, normalizationType);
+        std::vector<long double> normalizedYValues = stat::Normalize(yValues, normalizationType);
+
+        size_t size = normalizedXValues.size();
+
+        // Initialize parameters
+        long double slope = 0.0L;
+        long double intercept = 0.0L;
+
+        // Gradient Descent; the reported loss is the mean squared error
+        detail::TrainingMonitor monitor(callback);
+        const bool tracking = monitor.active();
+        for (int iteration = 0; iteration < numIterations; ++iteration)
+        {
+            ScopedTimer timer("LinearRegression::iteration");
+            long double sumErrors = 0.0L;
+            long double sumXErrors = 0.0L;
+            long double sumSquaredErrors = 0.0L;
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                long double error = slope * normalizedXValues[i] + intercept - normalizedYValues[i];
+                sumErrors += error;
+                sumXErrors += error * normalizedXValues[i];
+                sumSquaredErrors += error * error;
+            }
+
+            if (tracking)
+            {
+                const long double gradientSums[2] = {sumXErrors, sumErrors};
+                monitor.report(sumSquaredErrors, gradientSums, size);
+            }
+
+            // Update parameters
+            slope -= learningRate * (1.0L / size) * sumXErrors;
+            intercept -= learningRate * (1.0L / size) * sumErrors;
+        }
+
+        return LinearRegressionModel(slope, intercept, normalizationType);
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<int8_t> &xValues, const std::vector<int8_t> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<int16_t> &xValues, const std::vector<int16_t> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<int32_t> &xValues, const std::vector<int32_t> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<int64_t> &xValues, const std::vector<int64_t> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+
+    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<uint8_t> &xValues, const std::vector<uint8_t> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<uint16_t> &xValues, const std::vector<uint16_t> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<uint32_t> &xValues, const std::vector<uint32_t> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<uint64_t> &xValues, const std::vector<uint64_t> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+
+    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<float> &xValues, const std::vector<float> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<double> &xValues, const std::vector<double> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LinearRegressionModel LinearRegressionGradientDescent(const std::vector<long double> &xValues, const std::vector<long double> &yValues, stat::NormalizationType normalizationType, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+#endif
+
+    MLLIB_INLINE EvaluationMetrics ComputeEvaluationMetrics(const ConfusionMatrix &confusionMatrix)
+    {
+        const size_t dataSize = confusionMatrix.truePositive + confusionMatrix.trueNegative + confusionMatrix.falsePositive + confusionMatrix.falseNegative;
+
+        long double accuracy = static_cast<long double>(confusionMatrix.truePositive + confusionMatrix.trueNegative) / dataSize * 100.0;
+        long double recall = static_cast<long double>(confusionMatrix.truePositive) / (confusionMatrix.truePositive + confusionMatrix.falseNegative) * 100.0;
+        long double precision = static_cast<long double>(confusionMatrix.truePositive) / (confusionMatrix.truePositive + confusionMatrix.falsePositive) * 100.0;
+        long double f1Score = 2 * precision * recall / (precision + recall);
+
+        return {accuracy, recall, precision, f1Score};
+    }
+
+    MLLIB_INLINE LogisticRegressionModel::LogisticRegressionModel() {}
+    MLLIB_INLINE LogisticRegressionModel::LogisticRegressionModel(const std::vector<long double> &coefficients) : coefficients(coefficients), normalizationType(stat::NormalizationType::Z_Score) {}
+
+    // Getter function
+    MLLIB_INLINE const std::vector<long double> &LogisticRegressionModel::getCoefficients() const { return coefficients; }
+
+    MLLIB_INLINE ConfusionMatrix LogisticRegressionModel::getConfusionMatrix() const { return confusionMatrix; }
+
+    // Getter and Setter for Evaluation Metrics
+    MLLIB_INLINE EvaluationMetrics LogisticRegressionModel::getEvaluationMetrics() const { return evaluationMetrics; }
+
+    // Setter function
+    MLLIB_INLINE void LogisticRegressionModel::setCoefficients(const std::vector<long double> &newCoefficients) { coefficients = newCoefficients; }
+
+    MLLIB_INLINE void LogisticRegressionModel::setConfusionMatrix(const ConfusionMatrix &matrix) { confusionMatrix = matrix; }
+
+    MLLIB_INLINE void LogisticRegressionModel::setEvaluationMetrics(const EvaluationMetrics &metrics) { evaluationMetrics = metrics; }
+
+    MLLIB_INLINE const OptimizerState &LogisticRegressionModel::getOptimizerState() const { return optimizerState; }
+
+    MLLIB_INLINE void LogisticRegressionModel::setOptimizerState(const OptimizerState &state) { optimizerState = state; }
+
+    template <typename T>
+    void LogisticRegressionModel::partialFit(const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback)
+    {
+        assert(!xValues.empty() && "xValues is empty");
+        assert(!yValues.empty() && "yValues is empty");
+        assert(xValues.size() == yValues.size() && "Input vectors must have the same size");
+
+        const size_t numFeatures = xValues[0].size();
+
+        if (coefficients.empty())
+        {
+            coefficients.assign(numFeatures + 1, 0.0);
+            normalizationType = stat::NormalizationType::Z_Score;
+        }
+        assert(coefficients.size() == numFeatures + 1 && "Input feature size mismatch.");
+
+        detail::TrainingMonitor monitor(callback);
+        detail::fitLogisticRows(
+            coefficients, optimizerState, xValues.size(),
+            [&xValues](size_t i) -> const std::vector<T> & { return xValues[i]; },
+            [&yValues](size_t i) { return yValues[i]; },
+            learningRate, numIterations, optimizer, &monitor);
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template void LogisticRegressionModel::partialFit(const std::vector<std::vector<int8_t>> &xValues, const std::vector<int8_t> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const std::vector<std::vector<int16_t>> &xValues, const std::vector<int16_t> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const std::vector<std::vector<int32_t>> &xValues, const std::vector<int32_t> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const std::vector<std::vector<int64_t>> &xValues, const std::vector<int64_t> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+
+    template void LogisticRegressionModel::partialFit(const std::vector<std::vector<uint8_t>> &xValues, const std::vector<uint8_t> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const std::vector<std::vector<uint16_t>> &xValues, const std::vector<uint16_t> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const std::vector<std::vector<uint32_t>> &xValues, const std::vector<uint32_t> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const std::vector<std::vector<uint64_t>> &xValues, const std::vector<uint64_t> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+
+    template void LogisticRegressionModel::partialFit(const std::vector<std::vector<float>> &xValues, const std::vector<float> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const std::vector<std::vector<double>> &xValues, const std::vector<double> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const std::vector<std::vector<long double>> &xValues, const std::vector<long double> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+#endif
+
+    template <typename T>
+    void LogisticRegressionModel::partialFit(const std::vector<std::span<const T>> &featureColumns, std::span<const T> labels, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback)
+    {
+        assert(!featureColumns.empty() && "featureColumns is empty");
+        assert(!labels.empty() && "labels is empty");
+
+        const size_t numFeatures = featureColumns.size();
+        for (const auto &featureColumn : featureColumns)
+        {
+            assert(featureColumn.size() == labels.size() && "Input columns must have the same size");
+        }
+
+        if (coefficients.empty())
+        {
+            coefficients.assign(numFeatures + 1, 0.0);
+            normalizationType = stat::NormalizationType::Z_Score;
+        }
+        assert(coefficients.size() == numFeatures + 1 && "Input feature size mismatch.");
+
+        // Row i is read across the column views
+        struct ColumnRow
+        {
+            const std::vector<std::span<const T>> &columns;
+            size_t row;
+            T operator[](size_t j) const { return columns[j][row]; }
+        };
+
+        detail::TrainingMonitor monitor(callback);
+        detail::fitLogisticRows(
+            coefficients, optimizerState, labels.size(),
+            [&featureColumns](size_t i) { return ColumnRow{featureColumns, i}; },
+            [&labels](size_t i) { return labels[i]; },
+            learningRate, numIterations, optimizer, &monitor);
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template void LogisticRegressionModel::partialFit(const std::vector<std::span<const int8_t>> &featureColumns, std::span<const int8_t> labels, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const std::vector<std::span<const int16_t>> &featureColumns, std::span<const int16_t> labels, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const std::vector<std::span<const int32_t>> &featureColumns, std::span<const int32_t> labels, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const std::vector<std::span<const int64_t>> &featureColumns, std::span<const int64_t> labels, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+
+    template void LogisticRegressionModel::partialFit(const std::vector<std::span<const uint8_t>> &featureColumns, std::span<const uint8_t> labels, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const std::vector<std::span<const uint16_t>> &featureColumns, std::span<const uint16_t> labels, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const std::vector<std::span<const uint32_t>> &featureColumns, std::span<const uint32_t> labels, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const std::vector<std::span<const uint64_t>> &featureColumns, std::span<const uint64_t> labels, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+
+    template void LogisticRegressionModel::partialFit(const std::vector<std::span<const float>> &featureColumns, std::span<const float> labels, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const std::vector<std::span<const double>> &featureColumns, std::span<const double> labels, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const std::vector<std::span<const long double>> &featureColumns, std::span<const long double> labels, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+#endif
+
+    template <typename T>
+    std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<T>> &xValues, const long double threshold) const
+    {
+        assert(!coefficients.empty() && "Model coefficients are not initialized.");
+
+        std::vector<int> predictions;
+        predictions.reserve(xValues.size());
+
+        for (size_t i = 0; i < xValues.size(); ++i)
+        {
+            const auto &xVector = xValues[i];
+            assert(xVector.size() == coefficients.size() - 1 && "Input feature size mismatch.");
+
+            long double logit = coefficients[0];
+            for (size_t j = 0; j < xVector.size(); ++j)
+            {
+                logit += coefficients[j + 1] * xVector[j];
+            }
+
+            const long double probability = 1.0 / (1.0 + std::exp(-logit));
+            const int predictedClass = (probability >= threshold) ? 1 : 0;
+            predictions.push_back(predictedClass);
+        }
+
+        return predictions;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<int8_t>> &xValues, long double threshold) const;
+    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<int16_t>> &xValues, long double threshold) const;
+    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<int32_t>> &xValues, long double threshold) const;
+    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<int64_t>> &xValues, long double threshold) const;
+
+    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<uint8_t>> &xValues, long double threshold) const;
+    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<uint16_t>> &xValues, long double threshold) const;
+    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<uint32_t>> &xValues, long double threshold) const;
+    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<uint64_t>> &xValues, long double threshold) const;
+
+    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<float>> &xValues, long double threshold) const;
+    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<double>> &xValues, long double threshold) const;
+    template std::vector<int> LogisticRegressionModel::predict(const std::vector<std::vector<long double>> &xValues, long double threshold) const;
+#endif
+
+    template <typename T>
+    std::vector<long double> LogisticRegressionModel::predictProbabilities(const std::vector<std::vector<T>> &xValues) const
+    {
+        assert(!coefficients.empty() && "Model coefficients are not initialized.");
+
+        std::vector<long double> probabilities(xValues.size());
+
+        for (size_t i = 0; i < xValues.size(); ++i)
+        {
+            const auto &xVector = xValues[i];
+            assert(xVector.size() == coefficients.size() - 1 && "Input feature size mismatch.");
+
+            long double logit = coefficients[0];
+            for (size_t j = 0; j < xVector.size(); ++j)
+            {
+                logit += coefficients[j + 1] * xVector[j];
+            }
+
+            probabilities[i] = 1.0 / (1.0 + std::exp(-logit));
+        }
+
+        return probabilities;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const std::vector<std::vector<int8_t>> &xValues) const;
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const std::vector<std::vector<int16_t>> &xValues) const;
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const std::vector<std::vector<int32_t>> &xValues) const;
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const std::vector<std::vector<int64_t>> &xValues) const;
+
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const std::vector<std::vector<uint8_t>> &xValues) const;
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const std::vector<std::vector<uint16_t>> &xValues) const;
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const std::vector<std::vector<uint32_t>> &xValues) const;
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const std::vector<std::vector<uint64_t>> &xValues) const;
+
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const std::vector<std::vector<float>> &xValues) const;
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const std::vector<std::vector<double>> &xValues) const;
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const std::vector<std::vector<long double>> &xValues) const;
+#endif
+
+    template <typename T>
+    long double LogisticRegressionModel::predictProbability(std::span<const T> xRow) const
+    {
+        assert(xRow.size() + 1 == coefficients.size() && "Input feature size mismatch.");
+
+        long double logit = coefficients[0];
+        for (size_t j = 0; j < xRow.size(); ++j)
+        {
+            logit += coefficients[j + 1] * xRow[j];
+        }
+
+        return 1.0 / (1.0 + std::exp(-logit));
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template long double LogisticRegressionModel::predictProbability(std::span<const int8_t> xRow) const;
+    template long double LogisticRegressionModel::predictProbability(std::span<const int16_t> xRow) const;
+    template long double LogisticRegressionModel::predictProbability(std::span<const int32_t> xRow) const;
+    template long double LogisticRegressionModel::predictProbability(std::span<const int64_t> xRow) const;
+
+    template long double LogisticRegressionModel::predictProbability(std::span<const uint8_t> xRow) const;
+    template long double LogisticRegressionModel::predictProbability(std::span<const uint16_t> xRow) const;
+    template long double LogisticRegressionModel::predictProbability(std::span<const uint32_t> xRow) const;
+    template long double LogisticRegressionModel::predictProbability(std::span<const uint64_t> xRow) const;
+
+    template long double LogisticRegressionModel::predictProbability(std::span<const float> xRow) const;
+    template long double LogisticRegressionModel::predictProbability(std::span<const double> xRow) const;
+    template long double LogisticRegressionModel::predictProbability(std::span<const long double> xRow) const;
+#endif
+
+    template <typename T>
+    void LogisticRegressionModel::predictProbabilities(std::span<const T> xRowMajor, std::span<long double> probabilities) const
+    {
+        assert(!coefficients.empty() && "Model coefficients are not initialized.");
+
+        const size_t numFeatures = coefficients.size() - 1;
+        assert(xRowMajor.size() == probabilities.size() * numFeatures && "Input feature size mismatch.");
+
+        ScopedTimer timer("LogisticRegressionModel::predictProbabilities");
+        for (size_t i = 0; i < probabilities.size(); ++i)
+        {
+            probabilities[i] = predictProbability(xRowMajor.subspan(i * numFeatures, numFeatures));
+        }
+        Instrumentation::count("LogisticRegressionModel::rowsScored", probabilities.size());
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template void LogisticRegressionModel::predictProbabilities(std::span<const int8_t> xRowMajor, std::span<long double> probabilities) const;
+    template void LogisticRegressionModel::predictProbabilities(std::span<const int16_t> xRowMajor, std::span<long double> probabilities) const;
+    template void LogisticRegressionModel::predictProbabilities(std::span<const int32_t> xRowMajor, std::span<long double> probabilities) const;
+    template void LogisticRegressionModel::predictProbabilities(std::span<const int64_t> xRowMajor, std::span<long double> probabilities) const;
+
+    template void LogisticRegressionModel::predictProbabilities(std::span<const uint8_t> xRowMajor, std::span<long double> probabilities) const;
+    template void LogisticRegressionModel::predictProbabilities(std::span<const uint16_t> xRowMajor, std::span<long double> probabilities) const;
+    template void LogisticRegressionModel::predictProbabilities(std::span<const uint32_t> xRowMajor, std::span<long double> probabilities) const;
+    template void LogisticRegressionModel::predictProbabilities(std::span<const uint64_t> xRowMajor, std::span<long double> probabilities) const;
+
+    template void LogisticRegressionModel::predictProbabilities(std::span<const float> xRowMajor, std::span<long double> probabilities) const;
+    template void LogisticRegressionModel::predictProbabilities(std::span<const double> xRowMajor, std::span<long double> probabilities) const;
+    template void LogisticRegressionModel::predictProbabilities(std::span<const long double> xRowMajor, std::span<long double> probabilities) const;
+#endif
+
+    template <typename T>
+    void LogisticRegressionModel::predict(std::span<const T> xRowMajor, std::span<int> predictions, const long double threshold) const
+    {
+        assert(!coefficients.empty() && "Model coefficients are not initialized.");
+
+        const size_t numFeatures = coefficients.size() - 1;
+        assert(xRowMajor.size() == predictions.size() * numFeatures && "Input feature size mismatch.");
+
+        for (size_t i = 0; i < predictions.size(); ++i)
+        {
+            predictions[i] = (predictProbability(xRowMajor.subspan(i * numFeatures, numFeatures)) >= threshold) ? 1 : 0;
+        }
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template void LogisticRegressionModel::predict(std::span<const int8_t> xRowMajor, std::span<int> predictions, const long double threshold) const;
+    template void LogisticRegressionModel::predict(std::span<const int16_t> xRowMajor, std::span<int> predictions, const long double threshold) const;
+    template void LogisticRegressionModel::predict(std::span<const int32_t> xRowMajor, std::span<int> predictions, const long double threshold) const;
+    template void LogisticRegressionModel::predict(std::span<const int64_t> xRowMajor, std::span<int> predictions, const long double threshold) const;
+
+    template void LogisticRegressionModel::predict(std::span<const uint8_t> xRowMajor, std::span<int> predictions, const long double threshold) const;
+    template void LogisticRegressionModel::predict(std::span<const uint16_t> xRowMajor, std::span<int> predictions, const long double threshold) const;
+    template void LogisticRegressionModel::predict(std::span<const uint32_t> xRowMajor, std::span<int> predictions, const long double threshold) const;
+    template void LogisticRegressionModel::predict(std::span<const uint64_t> xRowMajor, std::span<int> predictions, const long double threshold) const;
+
+    template void LogisticRegressionModel::predict(std::span<const float> xRowMajor, std::span<int> predictions, const long double threshold) const;
+    template void LogisticRegressionModel::predict(std::span<const double> xRowMajor, std::span<int> predictions, const long double threshold) const;
+    template void LogisticRegressionModel::predict(std::span<const long double> xRowMajor, std::span<int> predictions, const long double threshold) const;
+#endif
+
+    template <typename T>
+    ClassificationMetrics EvaluateClassification(std::span<const T> actualYValues, std::span<const int> predictedClasses)
+    {
+        assert(("Input vectors must have the same size" && actualYValues.size() == predictedClasses.size()));
+
+        size_t dataSize = actualYValues.size();
+        ClassificationMetrics metrics;
+        ConfusionMatrix &newConfusionMatrix = metrics.confusionMatrix;
+
+        for (size_t i = 0; i < dataSize; ++i)
+        {
+            int predictedClass = predictedClasses[i];
             int actualValue = actualYValues[i];
 
-            if (predictedClass == 1 && actualValue == 1)
+            if (predictedClass == 1 && actualValue == 1)
+            {
+                newConfusionMatrix.truePositive++;
+            }
+            else if (predictedClass == 0 && actualValue == 0)
+            {
+                newConfusionMatrix.trueNegative++;
+            }
+            else if (predictedClass == 1 && actualValue == 0)
+            {
+                newConfusionMatrix.falsePositive++;
+            }
+            else if (predictedClass == 0 && actualValue == 1)
+            {
+                newConfusionMatrix.falseNegative++;
+            }
+        }
+
+        metrics.evaluationMetrics = ComputeEvaluationMetrics(newConfusionMatrix);
+        return metrics;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template ClassificationMetrics EvaluateClassification(std::span<const int8_t> actualYValues, std::span<const int> predictedClasses);
+    template ClassificationMetrics EvaluateClassification(std::span<const int16_t> actualYValues, std::span<const int> predictedClasses);
+    template ClassificationMetrics EvaluateClassification(std::span<const int32_t> actualYValues, std::span<const int> predictedClasses);
+    template ClassificationMetrics EvaluateClassification(std::span<const int64_t> actualYValues, std::span<const int> predictedClasses);
+
+    template ClassificationMetrics EvaluateClassification(std::span<const uint8_t> actualYValues, std::span<const int> predictedClasses);
+    template ClassificationMetrics EvaluateClassification(std::span<const uint16_t> actualYValues, std::span<const int> predictedClasses);
+    template ClassificationMetrics EvaluateClassification(std::span<const uint32_t> actualYValues, std::span<const int> predictedClasses);
+    template ClassificationMetrics EvaluateClassification(std::span<const uint64_t> actualYValues, std::span<const int> predictedClasses);
+
+    template ClassificationMetrics EvaluateClassification(std::span<const float> actualYValues, std::span<const int> predictedClasses);
+    template ClassificationMetrics EvaluateClassification(std::span<const double> actualYValues, std::span<const int> predictedClasses);
+    template ClassificationMetrics EvaluateClassification(std::span<const long double> actualYValues, std::span<const int> predictedClasses);
+#endif
+
+    template <typename T>
+    long double LogisticRegressionModel::evaluate(const std::vector<T> &actualYValues, const std::vector<int> &predictedClasses)
+    {
+        const ClassificationMetrics metrics = EvaluateClassification(std::span<const T>(actualYValues), std::span<const int>(predictedClasses));
+
+        setConfusionMatrix(metrics.confusionMatrix);
+
+        // Set the evaluation metrics
+        setEvaluationMetrics(metrics.evaluationMetrics);
+
+        size_t correctPredictions = metrics.confusionMatrix.truePositive + metrics.confusionMatrix.trueNegative;
+        return static_cast<long double>(correctPredictions) / actualYValues.size() * 100.0;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template long double mlLib::LogisticRegressionModel::evaluate<int8_t>(const std::vector<int8_t> &actualYValues, const std::vector<int> &predictedClasses);
+    template long double mlLib::LogisticRegressionModel::evaluate<int16_t>(const std::vector<int16_t> &actualYValues, const std::vector<int> &predictedClasses);
+    template long double mlLib::LogisticRegressionModel::evaluate<int32_t>(const std::vector<int32_t> &actualYValues, const std::vector<int> &predictedClasses);
+    template long double mlLib::LogisticRegressionModel::evaluate<int64_t>(const std::vector<int64_t> &actualYValues, const std::vector<int> &predictedClasses);
+
+    template long double mlLib::LogisticRegressionModel::evaluate<uint8_t>(const std::vector<uint8_t> &actualYValues, const std::vector<int> &predictedClasses);
+    template long double mlLib::LogisticRegressionModel::evaluate<uint16_t>(const std::vector<uint16_t> &actualYValues, const std::vector<int> &predictedClasses);
+    template long double mlLib::LogisticRegressionModel::evaluate<uint32_t>(const std::vector<uint32_t> &actualYValues, const std::vector<int> &predictedClasses);
+    template long double mlLib::LogisticRegressionModel::evaluate<uint64_t>(const std::vector<uint64_t> &actualYValues, const std::vector<int> &predictedClasses);
+
+    template long double mlLib::LogisticRegressionModel::evaluate<float>(const std::vector<float> &actualYValues, const std::vector<int> &predictedClasses);
+    template long double mlLib::LogisticRegressionModel::evaluate<double>(const std::vector<double> &actualYValues, const std::vector<int> &predictedClasses);
+    template long double mlLib::LogisticRegressionModel::evaluate<long double>(const std::vector<long double> &actualYValues, const std::vector<int> &predictedClasses);
+#endif
+
+    MLLIB_INLINE void LogisticRegressionModel::saveToFile(const std::string &filename) const
+    {
+        std::ofstream outFile(filename);
+        if (outFile.is_open())
+        {
+            outFile.precision(std::numeric_limits<long double>::max_digits10);
+            outFile << *this;
+            outFile.close();
+        }
+        else
+        {
+            std::cerr << "Unable to open file for writing." << std::endl;
+        }
+    }
+
+    // Definition of the member function loadFromFile
+    MLLIB_INLINE void LogisticRegressionModel::loadFromFile(const std::string &filename)
+    {
+        if (detail::isBinaryModelFile(filename))
+        {
+            loadBinary(filename);
+            return;
+        }
+
+        std::ifstream inFile(filename);
+        if (inFile.is_open())
+        {
+            // Read into a temporary so a truncated or malformed file leaves this model unchanged
+            LogisticRegressionModel model;
+            if (inFile >> model)
+                *this = std::move(model);
+            else
+                std::cerr << "Invalid model file: truncated or malformed text model" << std::endl;
+            inFile.close();
+        }
+        else
+        {
+            std::cerr << "Unable to open file for reading." << std::endl;
+        }
+    }
+
+    MLLIB_INLINE bool LogisticRegressionModel::saveBinary(const std::string &filename) const
+    {
+        detail::PayloadWriter payload;
+        payload.write(coefficients);
+
+        payload.write(static_cast<uint64_t>(confusionMatrix.truePositive));
+        payload.write(static_cast<uint64_t>(confusionMatrix.trueNegative));
+        payload.write(static_cast<uint64_t>(confusionMatrix.falsePositive));
+        payload.write(static_cast<uint64_t>(confusionMatrix.falseNegative));
+
+        payload.write(evaluationMetrics.accuracy);
+        payload.write(evaluationMetrics.recall);
+        payload.write(evaluationMetrics.precision);
+        payload.write(evaluationMetrics.f1Score);
+
+        payload.write(static_cast<uint32_t>(optimizerState.type));
+        payload.write(static_cast<uint64_t>(optimizerState.step));
+        payload.write(static_cast<uint64_t>(optimizerState.firstMoments.size()));
+        payload.write(optimizerState.firstMoments);
+        payload.write(optimizerState.secondMoments);
+
+        return detail::writeModelFile(filename, detail::LogisticModelFile, normalizationType, coefficients.size(), payload.buffer);
+    }
+
+    MLLIB_INLINE bool LogisticRegressionModel::loadBinary(const std::string &filename)
+    {
+        MappedFile file;
+        const detail::ModelFileHeader *header = detail::readModelFile(file, filename, detail::LogisticModelFile);
+        if (header == nullptr)
+            return false;
+
+        // Decode into a temporary so a malformed payload leaves this model untouched
+        LogisticRegressionModel model;
+        detail::PayloadReader payload(file.data() + sizeof(detail::ModelFileHeader), header->payloadSize);
+        uint64_t truePositive, trueNegative, falsePositive, falseNegative, step, momentSize;
+        uint32_t optimizerType;
+
+        bool valid = payload.read(model.coefficients, header->numCoefficients) &&
+                     payload.read(truePositive) && payload.read(trueNegative) && payload.read(falsePositive) && payload.read(falseNegative) &&
+                     payload.read(model.evaluationMetrics.accuracy) && payload.read(model.evaluationMetrics.recall) &&
+                     payload.read(model.evaluationMetrics.precision) && payload.read(model.evaluationMetrics.f1Score) &&
+                     payload.read(optimizerType) && payload.read(step) && payload.read(momentSize) &&
+                     payload.read(model.optimizerState.firstMoments, momentSize) && payload.read(model.optimizerState.secondMoments, momentSize) &&
+                     payload.atEnd();
+        if (!valid)
+        {
+            std::cerr << "Invalid model file: malformed payload" << std::endl;
+            return false;
+        }
+
+        model.normalizationType = static_cast<stat::NormalizationType>(header->normalizationType);
+        model.confusionMatrix = {truePositive, trueNegative, falsePositive, falseNegative};
+        model.optimizerState.type = static_cast<OptimizerType>(optimizerType);
+        model.optimizerState.step = step;
+
+        *this = std::move(model);
+        return true;
+    }
+
+    MLLIB_INLINE void LogisticRegressionModel::printInfo() const
+    {
+        std::cout << "Logistic Regression Model:\n"
+                  << "Coefficients: ";
+        for (const auto &coeff : coefficients)
+        {
+            std::cout << coeff << " ";
+        }
+        std::cout << "\nNormalization Type: " << normalizationType << "\n"
+                  << "Confusion Matrix: TP=" << confusionMatrix.truePositive
+                  << ", TN=" << confusionMatrix.trueNegative
+                  << ", FP=" << confusionMatrix.falsePositive
+                  << ", FN=" << confusionMatrix.falseNegative << "\n"
+                  << "Evaluation Metrics: Accuracy=" << evaluationMetrics.accuracy
+                  << ", Recall=" << evaluationMetrics.recall
+                  << ", Precision=" << evaluationMetrics.precision
+                  << ", F1 Score=" << evaluationMetrics.f1Score << "\n";
+    }
+
+    template <typename T>
+    LogisticRegressionModel LogisticRegression(const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues, const long double learningRate, const int numIterations, const TrainingCallback &callback)
+    {
+        LogisticRegressionModel model;
+        model.partialFit(xValues, yValues, learningRate, numIterations, SGD, callback);
+        return model;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<int8_t>> &xValues, const std::vector<int8_t> &yValues, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<int16_t>> &xValues, const std::vector<int16_t> &yValues, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<int32_t>> &xValues, const std::vector<int32_t> &yValues, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<int64_t>> &xValues, const std::vector<int64_t> &yValues, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+
+    // Explicit instantiations for Logistic Regression with uint types
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<uint8_t>> &xValues, const std::vector<uint8_t> &yValues, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<uint16_t>> &xValues, const std::vector<uint16_t> &yValues, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<uint32_t>> &xValues, const std::vector<uint32_t> &yValues, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<uint64_t>> &xValues, const std::vector<uint64_t> &yValues, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+
+    // Explicit instantiations for Logistic Regression with float types
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<float>> &xValues, const std::vector<float> &yValues, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<double>> &xValues, const std::vector<double> &yValues, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<long double>> &xValues, const std::vector<long double> &yValues, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+#endif
+
+    template <typename T>
+    LogisticRegressionModel LogisticRegression(const std::vector<std::span<const T>> &featureColumns, std::span<const T> labels, const long double learningRate, const int numIterations, const TrainingCallback &callback)
+    {
+        LogisticRegressionModel model;
+        model.partialFit(featureColumns, labels, learningRate, numIterations, SGD, callback);
+        return model;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::span<const int8_t>> &featureColumns, std::span<const int8_t> labels, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::span<const int16_t>> &featureColumns, std::span<const int16_t> labels, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::span<const int32_t>> &featureColumns, std::span<const int32_t> labels, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::span<const int64_t>> &featureColumns, std::span<const int64_t> labels, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::span<const uint8_t>> &featureColumns, std::span<const uint8_t> labels, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::span<const uint16_t>> &featureColumns, std::span<const uint16_t> labels, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::span<const uint32_t>> &featureColumns, std::span<const uint32_t> labels, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::span<const uint64_t>> &featureColumns, std::span<const uint64_t> labels, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::span<const float>> &featureColumns, std::span<const float> labels, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::span<const double>> &featureColumns, std::span<const double> labels, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const std::vector<std::span<const long double>> &featureColumns, std::span<const long double> labels, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+#endif
+
+    template <typename T>
+    LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback)
+    {
+        LogisticRegressionModel model = initialModel;
+        model.partialFit(xValues, yValues, learningRate, numIterations, optimizer, callback);
+        return model;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const std::vector<std::vector<int8_t>> &xValues, const std::vector<int8_t> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const std::vector<std::vector<int16_t>> &xValues, const std::vector<int16_t> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const std::vector<std::vector<int32_t>> &xValues, const std::vector<int32_t> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const std::vector<std::vector<int64_t>> &xValues, const std::vector<int64_t> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const std::vector<std::vector<uint8_t>> &xValues, const std::vector<uint8_t> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const std::vector<std::vector<uint16_t>> &xValues, const std::vector<uint16_t> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const std::vector<std::vector<uint32_t>> &xValues, const std::vector<uint32_t> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const std::vector<std::vector<uint64_t>> &xValues, const std::vector<uint64_t> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const std::vector<std::vector<float>> &xValues, const std::vector<float> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const std::vector<std::vector<double>> &xValues, const std::vector<double> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const std::vector<std::vector<long double>> &xValues, const std::vector<long double> &yValues, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+#endif
+
+    MLLIB_INLINE ChunkedDataReader::ChunkedDataReader(const std::string &filename, DataFormat format, size_t numFeatures, size_t chunkRows, bool hasHeader)
+        : filename(filename), format(format), numFeatures(numFeatures), chunkRows(chunkRows), hasHeader(hasHeader)
+    {
+        assert(("Number of features must be positive" && numFeatures > 0));
+        assert(("Chunk size must be positive" && chunkRows > 0));
+
+        if (format == Binary)
+        {
+            inFile.open(filename, std::ios::binary);
+            recordBuffer.resize(chunkRows * (numFeatures + 1));
+        }
+        else
+        {
+            inFile.open(filename);
+        }
+
+        if (!inFile.is_open())
+        {
+            std::cerr << "Unable to open file for reading." << std::endl;
+            return;
+        }
+
+        reset();
+    }
+
+    MLLIB_INLINE size_t ChunkedDataReader::getNumFeatures() const { return numFeatures; }
+    MLLIB_INLINE size_t ChunkedDataReader::getChunkRows() const { return chunkRows; }
+    MLLIB_INLINE bool ChunkedDataReader::isOpen() const { return inFile.is_open(); }
+
+    MLLIB_INLINE void ChunkedDataReader::reset()
+    {
+        inFile.clear();
+        inFile.seekg(0, std::ios::beg);
+        lineNumber = 0;
+
+        if (format == CSV && hasHeader)
+        {
+            std::getline(inFile, line); // Skip header line
+            ++lineNumber;
+        }
+    }
+
+    MLLIB_INLINE size_t ChunkedDataReader::readChunk(DataChunk &chunk)
+    {
+        ScopedTimer timer("ChunkedDataReader::readChunk");
+        const size_t recordLen = numFeatures + 1;
+
+        // Storage is sized once and reused, so a chunk never grows past chunkRows rows
+        chunk.features.resize(chunkRows * numFeatures);
+        chunk.labels.resize(chunkRows);
+        chunk.numRows = 0;
+
+        if (!inFile.is_open())
+            return 0;
+
+        switch (format)
+        {
+        case CSV:
+            while (chunk.numRows < chunkRows && std::getline(inFile, line))
+            {
+                ++lineNumber;
+                const char *first = line.data();
+                const char *last = line.data() + line.size();
+                if (last > first && last[-1] == '\r')
+                    --last;
+                if (first == last)
+                    continue; // blank line
+
+                // Malformed lines are reported and skipped, as LoadCSV does
+                const size_t numFields = static_cast<size_t>(std::count(first, last, ',')) + 1;
+                if (numFields != recordLen)
+                {
+                    std::cerr << "Skipping line " << lineNumber << ": expected " << recordLen << " columns, found " << numFields << std::endl;
+                    continue;
+                }
+
+                long double *row = &chunk.features[chunk.numRows * numFeatures];
+                bool valid = true;
+
+                for (size_t column = 0; column < recordLen; ++column)
+                {
+                    const char *fieldEnd = std::find(first, last, ',');
+                    const char *a = first;
+                    const char *b = fieldEnd;
+                    while (a < b && (*a == ' ' || *a == '\t'))
+                        ++a;
+                    while (b > a && (b[-1] == ' ' || b[-1] == '\t'))
+                        --b;
+                    first = fieldEnd + 1;
+
+                    long double value;
+                    const auto [parsedEnd, error] = std::from_chars(a, b, value);
+                    if (error != std::errc() || parsedEnd != b)
+                    {
+                        std::cerr << "Skipping line " << lineNumber << ": invalid number in column " << column << std::endl;
+                        valid = false;
+                        break;
+                    }
+
+                    if (column < numFeatures)
+                        row[column] = value;
+                    else
+                        chunk.labels[chunk.numRows] = value;
+                }
+
+                if (valid)
+                    ++chunk.numRows;
+            }
+            break;
+
+        case Binary:
+        {
+            inFile.read(reinterpret_cast<char *>(recordBuffer.data()), recordBuffer.size() * sizeof(double));
+            chunk.numRows = static_cast<size_t>(inFile.gcount()) / (recordLen * sizeof(double));
+
+            for (size_t i = 0; i < chunk.numRows; ++i)
+            {
+                const double *record = &recordBuffer[i * recordLen];
+                for (size_t j = 0; j < numFeatures; ++j)
+                {
+                    chunk.features[i * numFeatures + j] = record[j];
+                }
+                chunk.labels[i] = record[numFeatures];
+            }
+        }
+        break;
+
+        default:
+            assert(false && "Unsupported data format");
+        }
+
+        return chunk.numRows;
+    }
+
+    MLLIB_INLINE MappedFile::MappedFile() {}
+
+    MLLIB_INLINE MappedFile::MappedFile(const std::string &filename) { open(filename); }
+
+    MLLIB_INLINE MappedFile::MappedFile(MappedFile &&other) noexcept
+        : mappedData(other.mappedData), mappedSize(other.mappedSize), opened(other.opened)
+    {
+        other.mappedData = nullptr;
+        other.mappedSize = 0;
+        other.opened = false;
+    }
+
+    MLLIB_INLINE MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            std::swap(mappedData, other.mappedData);
+            std::swap(mappedSize, other.mappedSize);
+            std::swap(opened, other.opened);
+        }
+        return *this;
+    }
+
+    MLLIB_INLINE MappedFile::~MappedFile() { close(); }
+
+    MLLIB_INLINE bool MappedFile::open(const std::string &filename)
+    {
+        close();
+
+        std::error_code error;
+        const auto fileSize = std::filesystem::file_size(filename, error);
+        if (error)
+            return false;
+
+        std::FILE *file = std::fopen(filename.c_str(), "rb");
+        if (file == nullptr)
+            return false;
+
+        // An empty file is valid but cannot be mapped
+        if (fileSize > 0)
+        {
+            void *mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+            if (mapping == MAP_FAILED)
+            {
+                std::fclose(file);
+                return false;
+            }
+
+            mappedData = static_cast<const char *>(mapping);
+            mappedSize = fileSize;
+        }
+
+        // The mapping stays valid after the descriptor is closed
+        std::fclose(file);
+        opened = true;
+        return true;
+    }
+
+    MLLIB_INLINE void MappedFile::close()
+    {
+        if (mappedData != nullptr)
+        {
+            munmap(const_cast<char *>(mappedData), mappedSize);
+        }
+
+        mappedData = nullptr;
+        mappedSize = 0;
+        opened = false;
+    }
+
+    MLLIB_INLINE bool MappedFile::isOpen() const { return opened; }
+    MLLIB_INLINE const char *MappedFile::data() const { return mappedData; }
+    MLLIB_INLINE size_t MappedFile::size() const { return mappedSize; }
+
+    template <typename T>
+    CSVData<T> LoadCSV(const std::string &filename, const CSVOptions &options)
+    {
+        ScopedTimer timer("LoadCSV");
+        CSVData<T> result;
+        result.layout = options.layout;
+
+        MappedFile file(filename);
+        if (!file.isOpen())
+        {
+            std::cerr << "Unable to open file for reading." << std::endl;
+            return result;
+        }
+
+        const char *const begin = file.data();
+        const char *const end = begin + file.size();
+        if (begin == nullptr)
+            return result;
+
+        madvise(const_cast<char *>(begin), file.size(), MADV_SEQUENTIAL);
+
+        auto lineEnd = [end](const char *position)
+        {
+            const void *newline = std::memchr(position, '\n', end - position);
+            return newline ? static_cast<const char *>(newline) : end;
+        };
+
+        // Split a line into fields, trimming spaces and a trailing carriage return
+        auto splitFields = [&options](const char *first, const char *last, std::vector<std::pair<const char *, const char *>> &fields)
+        {
+            fields.clear();
+            if (last > first && last[-1] == '\r')
+                --last;
+
+            while (true)
+            {
+                const char *fieldEnd = static_cast<const char *>(std::memchr(first, options.delimiter, last - first));
+                if (fieldEnd == nullptr)
+                    fieldEnd = last;
+
+                const char *a = first;
+                const char *b = fieldEnd;
+                while (a < b && (*a == ' ' || *a == '\t'))
+                    ++a;
+                while (b > a && (b[-1] == ' ' || b[-1] == '\t'))
+                    --b;
+                fields.emplace_back(a, b);
+
+                if (fieldEnd == last)
+                    break;
+                first = fieldEnd + 1;
+            }
+        };
+
+        // The header (or the first row) fixes the number of columns
+        std::vector<std::pair<const char *, const char *>> fields;
+        const char *bodyBegin = begin;
+        const char *firstLineEnd = lineEnd(begin);
+        splitFields(begin, firstLineEnd, fields);
+        const size_t numColumns = fields.size();
+
+        std::vector<std::string> columnNames(numColumns);
+        for (size_t c = 0; c < numColumns; ++c)
+        {
+            columnNames[c] = options.hasHeader ? std::string(fields[c].first, fields[c].second) : "column" + std::to_string(c);
+        }
+
+        if (options.hasHeader)
+        {
+            bodyBegin = (firstLineEnd < end) ? firstLineEnd + 1 : end;
+        }
+
+        // Map each column to its feature slot, the label (-2) or nothing (-1)
+        const int labelColumn = options.hasLabel ? (options.labelColumn < 0 ? static_cast<int>(numColumns) - 1 : options.labelColumn) : -1;
+        assert(("Label column out of range" && labelColumn < static_cast<int>(numColumns)));
+
+        std::vector<int> columnSlot(numColumns, -1);
+        if (options.featureColumns.empty())
+        {
+            for (size_t c = 0; c < numColumns; ++c)
+            {
+                if (static_cast<int>(c) != labelColumn)
+                    columnSlot[c] = static_cast<int>(result.numFeatures++);
+            }
+        }
+        else
+        {
+            for (const size_t c : options.featureColumns)
+            {
+                assert(("Feature column out of range" && c < numColumns));
+                columnSlot[c] = static_cast<int>(result.numFeatures++);
+            }
+        }
+        if (labelColumn >= 0)
+            columnSlot[labelColumn] = -2;
+
+        for (size_t c = 0; c < numColumns; ++c)
+        {
+            if (columnSlot[c] >= 0)
+                result.featureNames.push_back(columnNames[c]);
+        }
+
+        // Split the body into one chunk per thread, each starting at the beginning of a line
+        const size_t numThreads = detail::resolveThreadCount(options.numThreads);
+        std::vector<const char *> chunkBegin(numThreads + 1, end);
+        chunkBegin[0] = bodyBegin;
+        for (size_t t = 1; t < numThreads; ++t)
+        {
+            const char *position = bodyBegin + (end - bodyBegin) * t / numThreads;
+            position = std::max(position, chunkBegin[t - 1]);
+            if (position != bodyBegin && position != end)
+            {
+                const char *newline = lineEnd(position - 1);
+                position = (newline == end) ? end : newline + 1;
+            }
+            chunkBegin[t] = position;
+        }
+
+        // Pass 1: count lines per chunk so every chunk writes its rows directly into its own slot range
+        std::vector<size_t> chunkLines(numThreads, 0);
+        detail::parallelFor(numThreads, numThreads, [&](size_t first, size_t last, size_t)
+                            {
+                                for (size_t t = first; t < last; ++t)
+                                {
+                                    for (const char *position = chunkBegin[t]; position < chunkBegin[t + 1]; position = lineEnd(position) + 1)
+                                    {
+                                        chunkLines[t]++;
+                                    }
+                                } });
+
+        std::vector<size_t> lineOffset(numThreads + 1, 0);
+        for (size_t t = 0; t < numThreads; ++t)
+        {
+            lineOffset[t + 1] = lineOffset[t] + chunkLines[t];
+        }
+        const size_t capacity = lineOffset[numThreads];
+        const size_t firstLineNumber = options.hasHeader ? 2 : 1;
+
+        result.features.resize(capacity * result.numFeatures);
+        result.labels.resize(labelColumn >= 0 ? capacity : 0);
+
+        auto featureIndex = [&result, capacity](size_t row, size_t feature)
+        {
+            return (result.layout == RowMajor) ? row * result.numFeatures + feature : feature * capacity + row;
+        };
+
+        // Pass 2: parse each chunk; valid rows are packed at the start of the chunk's slot range
+        std::vector<size_t> chunkRows(numThreads, 0);
+        std::vector<std::vector<MalformedRow>> chunkMalformed(numThreads);
+        detail::parallelFor(numThreads, numThreads, [&](size_t first, size_t last, size_t)
+                            {
+                                std::vector<std::pair<const char *, const char *>> lineFields;
+
+                                for (size_t t = first; t < last; ++t)
+                                {
+                                    size_t lineIndex = lineOffset[t];
+
+                                    for (const char *position = chunkBegin[t]; position < chunkBegin[t + 1]; ++lineIndex)
+                                    {
+                                        const char *currentEnd = lineEnd(position);
+                                        const char *lineStart = position;
+                                        position = currentEnd + 1;
+
+                                        if (currentEnd == lineStart || (currentEnd - lineStart == 1 && *lineStart == '\r'))
+                                            continue; // blank line
+
+                                        splitFields(lineStart, currentEnd, lineFields);
+                                        if (lineFields.size() != numColumns)
+                                        {
+                                            chunkMalformed[t].push_back({firstLineNumber + lineIndex, "expected " + std::to_string(numColumns) + " columns, found " + std::to_string(lineFields.size())});
+                                            continue;
+                                        }
+
+                                        const size_t row = lineOffset[t] + chunkRows[t];
+                                        bool valid = true;
+
+                                        for (size_t c = 0; c < numColumns && valid; ++c)
+                                        {
+                                            if (columnSlot[c] == -1)
+                                                continue;
+
+                                            T value;
+                                            const auto [parsedEnd, error] = std::from_chars(lineFields[c].first, lineFields[c].second, value);
+                                            if (error != std::errc() || parsedEnd != lineFields[c].second)
+                                            {
+                                                chunkMalformed[t].push_back({firstLineNumber + lineIndex, "invalid number in column " + columnNames[c]});
+                                                valid = false;
+                                                break;
+                                            }
+
+                                            if (columnSlot[c] == -2)
+                                                result.labels[row] = value;
+                                            else
+                                                result.features[featureIndex(row, columnSlot[c])] = value;
+                                        }
+
+                                        if (valid)
+                                            chunkRows[t]++;
+                                    }
+                                } });
+
+        // Close the gaps left by skipped lines; nothing moves when every line was a valid row
+        for (size_t t = 0; t < numThreads; ++t)
+        {
+            const size_t source = lineOffset[t];
+            const size_t target = result.numRows;
+
+            if (source != target)
+            {
+                for (size_t i = 0; i < chunkRows[t]; ++i)
+                {
+                    if (result.layout == RowMajor)
+                    {
+                        std::copy_n(&result.features[(source + i) * result.numFeatures], result.numFeatures, &result.features[(target + i) * result.numFeatures]);
+                    }
+                    else
+                    {
+                        for (size_t j = 0; j < result.numFeatures; ++j)
+                        {
+                            result.features[featureIndex(target + i, j)] = result.features[featureIndex(source + i, j)];
+                        }
+                    }
+
+                    if (labelColumn >= 0)
+                        result.labels[target + i] = result.labels[source + i];
+                }
+            }
+
+            result.numRows += chunkRows[t];
+            result.malformedRows.insert(result.malformedRows.end(), chunkMalformed[t].begin(), chunkMalformed[t].end());
+        }
+
+        // Column-major storage is strided by the line count; repack it to the final row count
+        if (result.layout == ColumnMajor && result.numRows != capacity)
+        {
+            std::vector<T> packed(result.numRows * result.numFeatures);
+            for (size_t j = 0; j < result.numFeatures; ++j)
+            {
+                std::copy_n(&result.features[j * capacity], result.numRows, &packed[j * result.numRows]);
+            }
+            result.features.swap(packed);
+        }
+        else
+        {
+            result.features.resize(result.numRows * result.numFeatures);
+        }
+        if (labelColumn >= 0)
+            result.labels.resize(result.numRows);
+
+        return result;
+    }
+
+    // Only floating point element types: integer parsing would reject values such as "46.0"
+#if !defined(MLLIB_HEADER_ONLY)
+    template CSVData<float> LoadCSV(const std::string &filename, const CSVOptions &options);
+    template CSVData<double> LoadCSV(const std::string &filename, const CSVOptions &options);
+    template CSVData<long double> LoadCSV(const std::string &filename, const CSVOptions &options);
+#endif
+
+    template <typename T>
+    DatasetView<T>::DatasetView() {}
+
+    template <typename T>
+    DatasetView<T>::DatasetView(const T *features, const T *labels, size_t numRows, size_t numFeatures)
+        : features(features), labels(labels), numFeatures(numFeatures), count(numRows) {}
+
+    template <typename T>
+    DatasetView<T>::DatasetView(const DatasetView &base, std::shared_ptr<const std::vector<size_t>> indices, size_t offset, size_t count)
+        : features(base.features), labels(base.labels), numFeatures(base.numFeatures), indices(std::move(indices)), offset(offset), count(count) {}
+
+    template <typename T>
+    DatasetView<T> DatasetView<T>::rows(size_t begin, size_t end) const
+    {
+        assert(begin <= end && end <= count && "Row range out of bounds");
+        return DatasetView(*this, indices, offset + begin, end - begin);
+    }
+
+    template <typename T>
+    DatasetView<T> DatasetView<T>::select(std::vector<size_t> positions) const
+    {
+        // Resolve positions to underlying rows so views never chain through more than one permutation
+        for (auto &position : positions)
+        {
+            assert(position < count && "Position out of bounds");
+            position = rowIndex(position);
+        }
+
+        const size_t numSelected = positions.size();
+        return DatasetView(*this, std::make_shared<const std::vector<size_t>>(std::move(positions)), 0, numSelected);
+    }
+
+    template <typename T>
+    DatasetView<T> DatasetView<T>::shuffled(unsigned int seed) const
+    {
+        std::vector<size_t> positions(count);
+        std::iota(positions.begin(), positions.end(), 0);
+        std::mt19937 generator(seed);
+        std::shuffle(positions.begin(), positions.end(), generator);
+        return select(std::move(positions));
+    }
+
+    template <typename T>
+    std::vector<DatasetView<T>> DatasetView<T>::shards(size_t numShards) const
+    {
+        assert(numShards > 0 && "Number of shards must be positive");
+
+        std::vector<DatasetView> result;
+        result.reserve(numShards);
+        for (size_t k = 0; k < numShards; ++k)
+        {
+            result.push_back(rows(k * count / numShards, (k + 1) * count / numShards));
+        }
+        return result;
+    }
+
+    template <typename T>
+    std::pair<DatasetView<T>, DatasetView<T>> DatasetView<T>::split(long double testFraction) const
+    {
+        assert(testFraction >= 0.0L && testFraction <= 1.0L && "Test fraction must be in [0, 1]");
+
+        const size_t trainSize = count - static_cast<size_t>(std::llround(testFraction * count));
+        return {rows(0, trainSize), rows(trainSize, count)};
+    }
+
+    template <typename T>
+    std::pair<DatasetView<T>, DatasetView<T>> DatasetView<T>::stratifiedSplit(long double testFraction, unsigned int seed) const
+    {
+        assert(testFraction >= 0.0L && testFraction <= 1.0L && "Test fraction must be in [0, 1]");
+
+        std::map<T, std::vector<size_t>> classes;
+        for (size_t i = 0; i < count; ++i)
+        {
+            classes[label(i)].push_back(i);
+        }
+
+        // One index buffer holds the training positions followed by the test positions
+        std::vector<size_t> train, test;
+        train.reserve(count);
+        std::mt19937 generator(seed);
+        for (auto &[value, positions] : classes)
+        {
+            std::shuffle(positions.begin(), positions.end(), generator);
+            const size_t classTestSize = static_cast<size_t>(std::llround(testFraction * positions.size()));
+            test.insert(test.end(), positions.begin(), positions.begin() + classTestSize);
+            train.insert(train.end(), positions.begin() + classTestSize, positions.end());
+        }
+
+        // Interleave the classes within each part
+        std::shuffle(train.begin(), train.end(), generator);
+        std::shuffle(test.begin(), test.end(), generator);
+
+        const size_t trainSize = train.size();
+        train.insert(train.end(), test.begin(), test.end());
+        const DatasetView combined = select(std::move(train));
+        return {combined.rows(0, trainSize), combined.rows(trainSize, count)};
+    }
+
+    template <typename T>
+    std::pair<DatasetView<T>, DatasetView<T>> DatasetView<T>::fold(size_t numFolds, size_t foldIndex) const
+    {
+        assert(numFolds >= 2 && numFolds <= count && "Invalid number of folds");
+        assert(foldIndex < numFolds && "Fold index out of range");
+
+        const size_t testBegin = foldIndex * count / numFolds;
+        const size_t testEnd = (foldIndex + 1) * count / numFolds;
+
+        // The training part is the view with the test range cut out
+        std::vector<size_t> trainRows;
+        trainRows.reserve(count - (testEnd - testBegin));
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (i < testBegin || i >= testEnd)
+                trainRows.push_back(rowIndex(i));
+        }
+
+        const size_t trainSize = trainRows.size();
+        return {DatasetView(*this, std::make_shared<const std::vector<size_t>>(std::move(trainRows)), 0, trainSize), rows(testBegin, testEnd)};
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template class DatasetView<int8_t>;
+    template class DatasetView<int16_t>;
+    template class DatasetView<int32_t>;
+    template class DatasetView<int64_t>;
+
+    template class DatasetView<uint8_t>;
+    template class DatasetView<uint16_t>;
+    template class DatasetView<uint32_t>;
+    template class DatasetView<uint64_t>;
+
+    template class DatasetView<float>;
+    template class DatasetView<double>;
+    template class DatasetView<long double>;
+#endif
+
+    template <typename T>
+    Dataset<T>::Dataset() {}
+
+    template <typename T>
+    Dataset<T>::Dataset(const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues)
+        : labels(yValues), numFeatures(xValues.empty() ? 0 : xValues[0].size())
+    {
+        assert(xValues.size() == yValues.size() && "Input vectors must have the same size");
+
+        features.reserve(xValues.size() * numFeatures);
+        for (const auto &xVector : xValues)
+        {
+            assert(xVector.size() == numFeatures && "All rows must have the same number of features");
+            features.insert(features.end(), xVector.begin(), xVector.end());
+        }
+    }
+
+    template <typename T>
+    Dataset<T>::Dataset(std::vector<T> rowMajorFeatures, std::vector<T> labels, size_t numFeatures)
+        : features(std::move(rowMajorFeatures)), labels(std::move(labels)), numFeatures(numFeatures)
+    {
+        assert(features.size() == this->labels.size() * numFeatures && "Feature buffer size mismatch");
+    }
+
+    template <typename T>
+    Dataset<T>::Dataset(CSVData<T> &&data)
+        : labels(std::move(data.labels)), numFeatures(data.numFeatures)
+    {
+        if (labels.size() != data.numRows)
+            labels.assign(data.numRows, T());
+
+        if (data.layout == RowMajor)
+        {
+            features = std::move(data.features);
+        }
+        else
+        {
+            features.resize(data.features.size());
+            for (size_t i = 0; i < data.numRows; ++i)
+            {
+                for (size_t j = 0; j < numFeatures; ++j)
+                {
+                    features[i * numFeatures + j] = data.features[j * data.numRows + i];
+                }
+            }
+            std::vector<T>().swap(data.features);
+        }
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template class Dataset<int8_t>;
+    template class Dataset<int16_t>;
+    template class Dataset<int32_t>;
+    template class Dataset<int64_t>;
+
+    template class Dataset<uint8_t>;
+    template class Dataset<uint16_t>;
+    template class Dataset<uint32_t>;
+    template class Dataset<uint64_t>;
+
+    template class Dataset<float>;
+    template class Dataset<double>;
+    template class Dataset<long double>;
+#endif
+
+    template <typename T>
+    void LogisticRegressionModel::partialFit(const DatasetView<T> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback)
+    {
+        assert(!data.empty() && "Dataset view is empty");
+
+        if (coefficients.empty())
+        {
+            coefficients.assign(data.getNumFeatures() + 1, 0.0);
+            normalizationType = stat::NormalizationType::Z_Score;
+        }
+        assert(coefficients.size() == data.getNumFeatures() + 1 && "Input feature size mismatch.");
+
+        detail::TrainingMonitor monitor(callback);
+        detail::fitLogisticRows(
+            coefficients, optimizerState, data.size(),
+            [&data](size_t i) { return data.row(i); },
+            [&data](size_t i) { return data.label(i); },
+            learningRate, numIterations, optimizer, &monitor);
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template void LogisticRegressionModel::partialFit(const DatasetView<int8_t> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const DatasetView<int16_t> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const DatasetView<int32_t> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const DatasetView<int64_t> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+
+    template void LogisticRegressionModel::partialFit(const DatasetView<uint8_t> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const DatasetView<uint16_t> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const DatasetView<uint32_t> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const DatasetView<uint64_t> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+
+    template void LogisticRegressionModel::partialFit(const DatasetView<float> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const DatasetView<double> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(const DatasetView<long double> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+#endif
+
+    template <typename T>
+    std::vector<long double> LogisticRegressionModel::predictProbabilities(const DatasetView<T> &data) const
+    {
+        std::vector<long double> probabilities(data.size());
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            probabilities[i] = predictProbability(data.row(i));
+        }
+        return probabilities;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const DatasetView<int8_t> &data) const;
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const DatasetView<int16_t> &data) const;
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const DatasetView<int32_t> &data) const;
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const DatasetView<int64_t> &data) const;
+
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const DatasetView<uint8_t> &data) const;
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const DatasetView<uint16_t> &data) const;
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const DatasetView<uint32_t> &data) const;
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const DatasetView<uint64_t> &data) const;
+
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const DatasetView<float> &data) const;
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const DatasetView<double> &data) const;
+    template std::vector<long double> LogisticRegressionModel::predictProbabilities(const DatasetView<long double> &data) const;
+#endif
+
+    template <typename T>
+    std::vector<int> LogisticRegressionModel::predict(const DatasetView<T> &data, const long double threshold) const
+    {
+        std::vector<int> predictions(data.size());
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            predictions[i] = (predictProbability(data.row(i)) >= threshold) ? 1 : 0;
+        }
+        return predictions;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template std::vector<int> LogisticRegressionModel::predict(const DatasetView<int8_t> &data, const long double threshold) const;
+    template std::vector<int> LogisticRegressionModel::predict(const DatasetView<int16_t> &data, const long double threshold) const;
+    template std::vector<int> LogisticRegressionModel::predict(const DatasetView<int32_t> &data, const long double threshold) const;
+    template std::vector<int> LogisticRegressionModel::predict(const DatasetView<int64_t> &data, const long double threshold) const;
+
+    template std::vector<int> LogisticRegressionModel::predict(const DatasetView<uint8_t> &data, const long double threshold) const;
+    template std::vector<int> LogisticRegressionModel::predict(const DatasetView<uint16_t> &data, const long double threshold) const;
+    template std::vector<int> LogisticRegressionModel::predict(const DatasetView<uint32_t> &data, const long double threshold) const;
+    template std::vector<int> LogisticRegressionModel::predict(const DatasetView<uint64_t> &data, const long double threshold) const;
+
+    template std::vector<int> LogisticRegressionModel::predict(const DatasetView<float> &data, const long double threshold) const;
+    template std::vector<int> LogisticRegressionModel::predict(const DatasetView<double> &data, const long double threshold) const;
+    template std::vector<int> LogisticRegressionModel::predict(const DatasetView<long double> &data, const long double threshold) const;
+#endif
+
+    template <typename T>
+    LogisticRegressionModel LogisticRegression(const DatasetView<T> &data, const long double learningRate, const int numIterations, const TrainingCallback &callback)
+    {
+        LogisticRegressionModel model;
+        model.partialFit(data, learningRate, numIterations, SGD, callback);
+        return model;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template LogisticRegressionModel LogisticRegression(const DatasetView<int8_t> &data, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const DatasetView<int16_t> &data, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const DatasetView<int32_t> &data, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const DatasetView<int64_t> &data, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+
+    template LogisticRegressionModel LogisticRegression(const DatasetView<uint8_t> &data, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const DatasetView<uint16_t> &data, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const DatasetView<uint32_t> &data, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const DatasetView<uint64_t> &data, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+
+    template LogisticRegressionModel LogisticRegression(const DatasetView<float> &data, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const DatasetView<double> &data, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const DatasetView<long double> &data, const long double learningRate, const int numIterations, const TrainingCallback &callback);
+#endif
+
+    template <typename T>
+    LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const DatasetView<T> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback)
+    {
+        LogisticRegressionModel model = initialModel;
+        model.partialFit(data, learningRate, numIterations, optimizer, callback);
+        return model;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const DatasetView<int8_t> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const DatasetView<int16_t> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const DatasetView<int32_t> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const DatasetView<int64_t> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const DatasetView<uint8_t> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const DatasetView<uint16_t> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const DatasetView<uint32_t> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const DatasetView<uint64_t> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const DatasetView<float> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const DatasetView<double> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(const LogisticRegressionModel &initialModel, const DatasetView<long double> &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback);
+#endif
+
+    template <typename T>
+    ClassificationMetrics EvaluateClassification(const LogisticRegressionModel &model, const DatasetView<T> &data, const long double threshold)
+    {
+        ClassificationMetrics metrics;
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            const int predictedClass = (model.predictProbability(data.row(i)) >= threshold) ? 1 : 0;
+            const int actualValue = static_cast<int>(data.label(i));
+
+            if (predictedClass == 1 && actualValue == 1)
+                metrics.confusionMatrix.truePositive++;
+            else if (predictedClass == 0 && actualValue == 0)
+                metrics.confusionMatrix.trueNegative++;
+            else if (predictedClass == 1 && actualValue == 0)
+                metrics.confusionMatrix.falsePositive++;
+            else if (predictedClass == 0 && actualValue == 1)
+                metrics.confusionMatrix.falseNegative++;
+        }
+
+        metrics.evaluationMetrics = ComputeEvaluationMetrics(metrics.confusionMatrix);
+        return metrics;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template ClassificationMetrics EvaluateClassification(const LogisticRegressionModel &model, const DatasetView<int8_t> &data, const long double threshold);
+    template ClassificationMetrics EvaluateClassification(const LogisticRegressionModel &model, const DatasetView<int16_t> &data, const long double threshold);
+    template ClassificationMetrics EvaluateClassification(const LogisticRegressionModel &model, const DatasetView<int32_t> &data, const long double threshold);
+    template ClassificationMetrics EvaluateClassification(const LogisticRegressionModel &model, const DatasetView<int64_t> &data, const long double threshold);
+
+    template ClassificationMetrics EvaluateClassification(const LogisticRegressionModel &model, const DatasetView<uint8_t> &data, const long double threshold);
+    template ClassificationMetrics EvaluateClassification(const LogisticRegressionModel &model, const DatasetView<uint16_t> &data, const long double threshold);
+    template ClassificationMetrics EvaluateClassification(const LogisticRegressionModel &model, const DatasetView<uint32_t> &data, const long double threshold);
+    template ClassificationMetrics EvaluateClassification(const LogisticRegressionModel &model, const DatasetView<uint64_t> &data, const long double threshold);
+
+    template ClassificationMetrics EvaluateClassification(const LogisticRegressionModel &model, const DatasetView<float> &data, const long double threshold);
+    template ClassificationMetrics EvaluateClassification(const LogisticRegressionModel &model, const DatasetView<double> &data, const long double threshold);
+    template ClassificationMetrics EvaluateClassification(const LogisticRegressionModel &model, const DatasetView<long double> &data, const long double threshold);
+#endif
+
+    namespace detail
+    {
+        // Bytes per value of a column type
+        MLLIB_INLINE uint64_t columnTypeSize(ColumnType type)
+        {
+            static constexpr uint64_t sizes[] = {1, 2, 4, 8, 1, 2, 4, 8, 4, 8};
+            return sizes[type];
+        }
+    } // namespace detail
+
+    MLLIB_INLINE ColumnarDataset::ColumnarDataset() {}
+
+    MLLIB_INLINE ColumnarDataset::ColumnarDataset(const std::string &filename) { open(filename); }
+
+    MLLIB_INLINE bool ColumnarDataset::open(const std::string &filename)
+    {
+        static_assert(std::endian::native == std::endian::little, "Columnar datasets are stored little-endian");
+
+        header = nullptr;
+        descriptors = nullptr;
+
+        if (!file.open(filename))
+        {
+            std::cerr << "Unable to open file for reading." << std::endl;
+            return false;
+        }
+
+        auto invalid = [this](const char *reason)
+        {
+            std::cerr << "Invalid columnar dataset: " << reason << std::endl;
+            file.close();
+            return false;
+        };
+
+        if (file.size() < sizeof(ColumnarFileHeader))
+            return invalid("file is truncated");
+
+        const auto *fileHeader = reinterpret_cast<const ColumnarFileHeader *>(file.data());
+        if (std::memcmp(fileHeader->magic, "MLCD", 4) != 0)
+            return invalid("bad magic number");
+        if (fileHeader->version != formatVersion)
+            return invalid("unsupported format version");
+        if (file.size() < sizeof(ColumnarFileHeader) + fileHeader->numColumns * sizeof(ColumnDescriptor))
+            return invalid("file is truncated");
+        if (fileHeader->labelColumn != noLabel && fileHeader->labelColumn >= fileHeader->numColumns)
+            return invalid("label column out of range");
+
+        const auto *fileDescriptors = reinterpret_cast<const ColumnDescriptor *>(file.data() + sizeof(ColumnarFileHeader));
+        for (uint32_t c = 0; c < fileHeader->numColumns; ++c)
+        {
+            const ColumnDescriptor &descriptor = fileDescriptors[c];
+            if (descriptor.type > Float64)
+                return invalid("unknown column type");
+            if (descriptor.offset % 64 != 0)
+                return invalid("column is not 64-byte aligned");
+            if (descriptor.offset > file.size() || descriptor.byteSize > file.size() - descriptor.offset)
+                return invalid("file is truncated");
+
+            // column() returns numRows values, so the column must hold them; the division avoids overflowing numRows * size
+            if (descriptor.byteSize / detail::columnTypeSize(descriptor.type) < fileHeader->numRows)
+                return invalid("column is shorter than the row count");
+        }
+
+        header = fileHeader;
+        descriptors = fileDescriptors;
+        return true;
+    }
+
+    MLLIB_INLINE bool ColumnarDataset::isOpen() const { return header != nullptr; }
+    MLLIB_INLINE size_t ColumnarDataset::getNumRows() const { return header->numRows; }
+    MLLIB_INLINE size_t ColumnarDataset::getNumColumns() const { return header->numColumns; }
+    MLLIB_INLINE bool ColumnarDataset::hasLabel() const { return header->labelColumn != noLabel; }
+    MLLIB_INLINE size_t ColumnarDataset::getLabelColumn() const { return header->labelColumn; }
+
+    MLLIB_INLINE std::string ColumnarDataset::getColumnName(size_t column) const
+    {
+        assert(column < header->numColumns && "Column index out of range");
+        return std::string(descriptors[column].name, strnlen(descriptors[column].name, sizeof(descriptors[column].name)));
+    }
+
+    MLLIB_INLINE ColumnType ColumnarDataset::getColumnType(size_t column) const
+    {
+        assert(column < header->numColumns && "Column index out of range");
+        return descriptors[column].type;
+    }
+
+    MLLIB_INLINE size_t ColumnarDataset::findColumn(const std::string &name) const
+    {
+        for (size_t c = 0; c < getNumColumns(); ++c)
+        {
+            if (getColumnName(c) == name)
+                return c;
+        }
+        return getNumColumns();
+    }
+
+    MLLIB_INLINE void ColumnarDataset::prefetchColumn(size_t column) const
+    {
+        assert(column < header->numColumns && "Column index out of range");
+
+        // madvise needs a page-aligned start; columns are only 64-byte aligned
+        static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t begin = descriptors[column].offset / pageSize * pageSize;
+        madvise(const_cast<char *>(file.data()) + begin, descriptors[column].offset + descriptors[column].byteSize - begin, MADV_WILLNEED);
+    }
+
+    template <typename T>
+    bool SaveColumnarDataset(const CSVData<T> &data, const std::string &filename)
+    {
+        std::ofstream outFile(filename, std::ios::binary);
+        if (!outFile.is_open())
+        {
+            std::cerr << "Unable to open file for writing." << std::endl;
+            return false;
+        }
+
+        const bool hasLabel = data.labels.size() == data.numRows && !data.labels.empty();
+        const uint32_t numColumns = static_cast<uint32_t>(data.numFeatures + (hasLabel ? 1 : 0));
+        const uint64_t columnBytes = data.numRows * sizeof(T);
+        const uint64_t alignedColumnBytes = (columnBytes + 63) / 64 * 64;
+
+        ColumnarFileHeader header = {};
+        std::memcpy(header.magic, "MLCD", 4);
+        header.version = ColumnarDataset::formatVersion;
+        header.numRows = data.numRows;
+        header.numColumns = numColumns;
+        header.labelColumn = hasLabel ? static_cast<uint32_t>(data.numFeatures) : ColumnarDataset::noLabel;
+        outFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        // Features first, then the label as the last column
+        uint64_t offset = sizeof(ColumnarFileHeader) + numColumns * sizeof(ColumnDescriptor);
+        offset = (offset + 63) / 64 * 64;
+        for (uint32_t c = 0; c < numColumns; ++c)
+        {
+            ColumnDescriptor descriptor = {};
+            const std::string name = (c < data.numFeatures) ? data.featureNames[c] : "label";
+            std::memcpy(descriptor.name, name.data(), std::min(name.size(), sizeof(descriptor.name) - 1));
+            descriptor.type = columnTypeOf<T>();
+            descriptor.offset = offset;
+            descriptor.byteSize = columnBytes;
+            outFile.write(reinterpret_cast<const char *>(&descriptor), sizeof(descriptor));
+            offset += alignedColumnBytes;
+        }
+
+        const char padding[64] = {};
+        outFile.write(padding, static_cast<std::streamsize>((64 - outFile.tellp() % 64) % 64));
+
+        std::vector<T> columnBuffer(data.numRows);
+        for (uint32_t c = 0; c < numColumns; ++c)
+        {
+            const T *columnData = nullptr;
+            if (c == data.numFeatures)
+            {
+                columnData = data.labels.data();
+            }
+            else if (data.layout == ColumnMajor)
+            {
+                columnData = &data.features[c * data.numRows];
+            }
+            else
+            {
+                for (size_t i = 0; i < data.numRows; ++i)
+                {
+                    columnBuffer[i] = data.features[i * data.numFeatures + c];
+                }
+                columnData = columnBuffer.data();
+            }
+
+            outFile.write(reinterpret_cast<const char *>(columnData), static_cast<std::streamsize>(columnBytes));
+            outFile.write(padding, static_cast<std::streamsize>(alignedColumnBytes - columnBytes));
+        }
+
+        return outFile.good();
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template bool SaveColumnarDataset(const CSVData<float> &data, const std::string &filename);
+    template bool SaveColumnarDataset(const CSVData<double> &data, const std::string &filename);
+#endif
+
+    template <typename T>
+    bool ConvertCSVToColumnar(const std::string &csvFilename, const std::string &columnarFilename, const CSVOptions &options)
+    {
+        CSVOptions columnOptions = options;
+        columnOptions.layout = ColumnMajor;
+
+        const CSVData<T> data = LoadCSV<T>(csvFilename, columnOptions);
+        for (const auto &row : data.malformedRows)
+        {
+            std::cerr << "Skipping line " << row.lineNumber << ": " << row.reason << std::endl;
+        }
+
+        return SaveColumnarDataset(data, columnarFilename);
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template bool ConvertCSVToColumnar<float>(const std::string &csvFilename, const std::string &columnarFilename, const CSVOptions &options);
+    template bool ConvertCSVToColumnar<double>(const std::string &csvFilename, const std::string &columnarFilename, const CSVOptions &options);
+#endif
+
+    template <typename T>
+    void saveBinaryDataset(const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues, const std::string &filename)
+    {
+        assert(!xValues.empty() && "xValues is empty");
+        assert(xValues.size() == yValues.size() && "Input vectors must have the same size");
+
+        std::ofstream outFile(filename, std::ios::binary);
+        if (!outFile.is_open())
+        {
+            std::cerr << "Unable to open file for writing." << std::endl;
+            return;
+        }
+
+        const size_t numFeatures = xValues[0].size();
+        std::vector<double> record(numFeatures + 1);
+
+        for (size_t i = 0; i < xValues.size(); ++i)
+        {
+            assert(xValues[i].size() == numFeatures && "Input feature size mismatch.");
+
+            for (size_t j = 0; j < numFeatures; ++j)
+            {
+                record[j] = static_cast<double>(xValues[i][j]);
+            }
+            record[numFeatures] = static_cast<double>(yValues[i]);
+
+            outFile.write(reinterpret_cast<const char *>(record.data()), record.size() * sizeof(double));
+        }
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template void saveBinaryDataset(const std::vector<std::vector<int8_t>> &xValues, const std::vector<int8_t> &yValues, const std::string &filename);
+    template void saveBinaryDataset(const std::vector<std::vector<int16_t>> &xValues, const std::vector<int16_t> &yValues, const std::string &filename);
+    template void saveBinaryDataset(const std::vector<std::vector<int32_t>> &xValues, const std::vector<int32_t> &yValues, const std::string &filename);
+    template void saveBinaryDataset(const std::vector<std::vector<int64_t>> &xValues, const std::vector<int64_t> &yValues, const std::string &filename);
+
+    template void saveBinaryDataset(const std::vector<std::vector<uint8_t>> &xValues, const std::vector<uint8_t> &yValues, const std::string &filename);
+    template void saveBinaryDataset(const std::vector<std::vector<uint16_t>> &xValues, const std::vector<uint16_t> &yValues, const std::string &filename);
+    template void saveBinaryDataset(const std::vector<std::vector<uint32_t>> &xValues, const std::vector<uint32_t> &yValues, const std::string &filename);
+    template void saveBinaryDataset(const std::vector<std::vector<uint64_t>> &xValues, const std::vector<uint64_t> &yValues, const std::string &filename);
+
+    template void saveBinaryDataset(const std::vector<std::vector<float>> &xValues, const std::vector<float> &yValues, const std::string &filename);
+    template void saveBinaryDataset(const std::vector<std::vector<double>> &xValues, const std::vector<double> &yValues, const std::string &filename);
+    template void saveBinaryDataset(const std::vector<std::vector<long double>> &xValues, const std::vector<long double> &yValues, const std::string &filename);
+#endif
+
+    MLLIB_INLINE LogisticRegressionModel LogisticRegressionStreaming(ChunkedDataReader &reader, const long double learningRate, const int numEpochs, const TrainingCallback &callback)
+    {
+        assert(reader.isOpen() && "Data source is not open");
+
+        const size_t numFeatures = reader.getNumFeatures();
+        std::vector<long double> coefficients(numFeatures + 1, 0.0);
+
+        // Double buffer: one chunk is trained on while the other is filled by the prefetch thread
+        DataChunk buffers[2];
+
+        // One progress report per epoch
+        detail::TrainingMonitor monitor(callback);
+        const bool tracking = monitor.active();
+        std::vector<long double> gradient(tracking ? coefficients.size() : 0);
+
+        for (int epoch = 0; epoch < numEpochs; ++epoch)
+        {
+            ScopedTimer timer("LogisticRegressionStreaming::epoch");
+            reader.reset();
+
+            long double interceptGradient = 0.0;
+            long double totalLoss = 0.0L;
+            size_t totalRows = 0;
+            int current = 0;
+            std::fill(gradient.begin(), gradient.end(), 0.0L);
+
+            std::future<size_t> pending = std::async(std::launch::async, [&reader, &buffers]()
+                                                     { return reader.readChunk(buffers[0]); });
+
+            while (pending.get() > 0)
+            {
+                const DataChunk &chunk = buffers[current];
+                const int next = 1 - current;
+
+                pending = std::async(std::launch::async, [&reader, &buffers, next]()
+                                     { return reader.readChunk(buffers[next]); });
+
+                for (size_t i = 0; i < chunk.numRows; ++i)
+                {
+                    const long double *xVector = &chunk.features[i * numFeatures];
+
+                    long double logit = coefficients[0];
+                    for (size_t j = 0; j < numFeatures; ++j)
+                    {
+                        logit += coefficients[j + 1] * xVector[j];
+                    }
+
+                    const long double prediction = 1.0 / (1.0 + std::exp(-logit));
+                    const long double error = prediction - chunk.labels[i];
+
+                    if (tracking)
+                    {
+                        totalLoss += detail::logisticLoss(prediction, chunk.labels[i]);
+                        for (size_t j = 0; j < numFeatures; ++j)
+                        {
+                            gradient[j + 1] += error * xVector[j];
+                        }
+                    }
+
+                    interceptGradient += error;
+                    for (size_t j = 0; j < numFeatures; ++j)
+                    {
+                        coefficients[j + 1] -= learningRate * error * xVector[j];
+                    }
+                }
+
+                totalRows += chunk.numRows;
+                current = next;
+            }
+
+            assert(totalRows > 0 && "Data source is empty");
+
+            if (tracking)
+            {
+                gradient[0] = interceptGradient;
+                monitor.report(totalLoss, gradient, totalRows);
+            }
+
+            interceptGradient /= totalRows;
+            coefficients[0] -= learningRate * interceptGradient;
+        }
+
+        return LogisticRegressionModel(coefficients);
+    }
+
+
+    MLLIB_INLINE QuantizedLogisticRegressionModel::QuantizedLogisticRegressionModel() {}
+
+    MLLIB_INLINE QuantizedLogisticRegressionModel::QuantizedLogisticRegressionModel(const std::vector<int8_t> &weights, const std::vector<long double> &inputScales, const std::vector<int32_t> &inputZeroPoints, long double weightScale, long double bias)
+        : weights(weights), inputScales(inputScales), inputZeroPoints(inputZeroPoints), weightScale(weightScale), bias(bias)
+    {
+        assert(("Quantization parameter sizes do not match" && weights.size() == inputScales.size() && weights.size() == inputZeroPoints.size()));
+        updateZeroPointOffset();
+    }
+
+    MLLIB_INLINE void QuantizedLogisticRegressionModel::updateZeroPointOffset()
+    {
+        zeroPointOffset = 0;
+        for (size_t j = 0; j < weights.size(); ++j)
+        {
+            zeroPointOffset += static_cast<int64_t>(weights[j]) * inputZeroPoints[j];
+        }
+    }
+
+    // Getter function implementations
+    MLLIB_INLINE size_t QuantizedLogisticRegressionModel::getNumFeatures() const { return weights.size(); }
+    MLLIB_INLINE const std::vector<int8_t> &QuantizedLogisticRegressionModel::getWeights() const { return weights; }
+    MLLIB_INLINE const std::vector<long double> &QuantizedLogisticRegressionModel::getInputScales() const { return inputScales; }
+    MLLIB_INLINE const std::vector<int32_t> &QuantizedLogisticRegressionModel::getInputZeroPoints() const { return inputZeroPoints; }
+    MLLIB_INLINE long double QuantizedLogisticRegressionModel::getWeightScale() const { return weightScale; }
+    MLLIB_INLINE long double QuantizedLogisticRegressionModel::getBias() const { return bias; }
+
+    template <typename T>
+    std::vector<int8_t> QuantizedLogisticRegressionModel::quantizeInputs(const std::vector<std::vector<T>> &xValues) const
+    {
+        const size_t numFeatures = weights.size();
+        std::vector<int8_t> quantizedRows(xValues.size() * numFeatures);
+
+        for (size_t i = 0; i < xValues.size(); ++i)
+        {
+            assert(xValues[i].size() == numFeatures && "Input feature size mismatch.");
+
+            for (size_t j = 0; j < numFeatures; ++j)
+            {
+                quantizedRows[i * numFeatures + j] = detail::saturateInt8(static_cast<long double>(xValues[i][j]) / inputScales[j] + inputZeroPoints[j]);
+            }
+        }
+
+        return quantizedRows;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template std::vector<int8_t> QuantizedLogisticRegressionModel::quantizeInputs(const std::vector<std::vector<int8_t>> &xValues) const;
+    template std::vector<int8_t> QuantizedLogisticRegressionModel::quantizeInputs(const std::vector<std::vector<int16_t>> &xValues) const;
+    template std::vector<int8_t> QuantizedLogisticRegressionModel::quantizeInputs(const std::vector<std::vector<int32_t>> &xValues) const;
+    template std::vector<int8_t> QuantizedLogisticRegressionModel::quantizeInputs(const std::vector<std::vector<int64_t>> &xValues) const;
+
+    template std::vector<int8_t> QuantizedLogisticRegressionModel::quantizeInputs(const std::vector<std::vector<uint8_t>> &xValues) const;
+    template std::vector<int8_t> QuantizedLogisticRegressionModel::quantizeInputs(const std::vector<std::vector<uint16_t>> &xValues) const;
+    template std::vector<int8_t> QuantizedLogisticRegressionModel::quantizeInputs(const std::vector<std::vector<uint32_t>> &xValues) const;
+    template std::vector<int8_t> QuantizedLogisticRegressionModel::quantizeInputs(const std::vector<std::vector<uint64_t>> &xValues) const;
+
+    template std::vector<int8_t> QuantizedLogisticRegressionModel::quantizeInputs(const std::vector<std::vector<float>> &xValues) const;
+    template std::vector<int8_t> QuantizedLogisticRegressionModel::quantizeInputs(const std::vector<std::vector<double>> &xValues) const;
+    template std::vector<int8_t> QuantizedLogisticRegressionModel::quantizeInputs(const std::vector<std::vector<long double>> &xValues) const;
+#endif
+
+    MLLIB_INLINE long double QuantizedLogisticRegressionModel::logit(const int8_t *quantizedRow) const
+    {
+        const int64_t accumulator = detail::dotProductInt8(weights.data(), quantizedRow, weights.size());
+        return bias + weightScale * static_cast<long double>(accumulator - zeroPointOffset);
+    }
+
+    MLLIB_INLINE std::vector<int> QuantizedLogisticRegressionModel::predictQuantized(const std::vector<int8_t> &quantizedRows, const long double threshold) const
+    {
+        assert(!weights.empty() && "Model weights are not initialized.");
+        assert(quantizedRows.size() % weights.size() == 0 && "Input feature size mismatch.");
+
+        // Compare logits against the threshold's logit instead of evaluating exp per row
+        const long double logitThreshold = std::log(threshold / (1.0L - threshold));
+        const size_t numRows = quantizedRows.size() / weights.size();
+        std::vector<int> predictions(numRows);
+
+        for (size_t i = 0; i < numRows; ++i)
+        {
+            predictions[i] = (logit(&quantizedRows[i * weights.size()]) >= logitThreshold) ? 1 : 0;
+        }
+
+        return predictions;
+    }
+
+    template <typename T>
+    std::vector<int> QuantizedLogisticRegressionModel::predict(const std::vector<std::vector<T>> &xValues, const long double threshold) const
+    {
+        return predictQuantized(quantizeInputs(xValues), threshold);
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template std::vector<int> QuantizedLogisticRegressionModel::predict(const std::vector<std::vector<int8_t>> &xValues, const long double threshold) const;
+    template std::vector<int> QuantizedLogisticRegressionModel::predict(const std::vector<std::vector<int16_t>> &xValues, const long double threshold) const;
+    template std::vector<int> QuantizedLogisticRegressionModel::predict(const std::vector<std::vector<int32_t>> &xValues, const long double threshold) const;
+    template std::vector<int> QuantizedLogisticRegressionModel::predict(const std::vector<std::vector<int64_t>> &xValues, const long double threshold) const;
+
+    template std::vector<int> QuantizedLogisticRegressionModel::predict(const std::vector<std::vector<uint8_t>> &xValues, const long double threshold) const;
+    template std::vector<int> QuantizedLogisticRegressionModel::predict(const std::vector<std::vector<uint16_t>> &xValues, const long double threshold) const;
+    template std::vector<int> QuantizedLogisticRegressionModel::predict(const std::vector<std::vector<uint32_t>> &xValues, const long double threshold) const;
+    template std::vector<int> QuantizedLogisticRegressionModel::predict(const std::vector<std::vector<uint64_t>> &xValues, const long double threshold) const;
+
+    template std::vector<int> QuantizedLogisticRegressionModel::predict(const std::vector<std::vector<float>> &xValues, const long double threshold) const;
+    template std::vector<int> QuantizedLogisticRegressionModel::predict(const std::vector<std::vector<double>> &xValues, const long double threshold) const;
+    template std::vector<int> QuantizedLogisticRegressionModel::predict(const std::vector<std::vector<long double>> &xValues, const long double threshold) const;
+#endif
+
+    MLLIB_INLINE void QuantizedLogisticRegressionModel::saveToFile(const std::string &filename) const
+    {
+        std::ofstream outFile(filename);
+        if (outFile.is_open())
+        {
+            // Scales must round-trip exactly or reloaded inputs quantize differently
+            outFile.precision(std::numeric_limits<long double>::max_digits10);
+            outFile << *this;
+            outFile.close();
+        }
+        else
+        {
+            std::cerr << "Unable to open file for writing." << std::endl;
+        }
+    }
+
+    MLLIB_INLINE void QuantizedLogisticRegressionModel::loadFromFile(const std::string &filename)
+    {
+        std::ifstream inFile(filename);
+        if (inFile.is_open())
+        {
+            inFile >> *this;
+            inFile.close();
+        }
+        else
+        {
+            std::cerr << "Unable to open file for reading." << std::endl;
+        }
+    }
+
+    MLLIB_INLINE void QuantizedLogisticRegressionModel::printInfo() const
+    {
+        std::cout << "Quantized Logistic Regression Model:\n"
+                  << "Weights (int8): ";
+        for (const auto &weight : weights)
+        {
+            std::cout << static_cast<int>(weight) << " ";
+        }
+        std::cout << "\nWeight Scale: " << weightScale << "\n"
+                  << "Bias: " << bias << "\n";
+    }
+
+    template <typename T>
+    QuantizedLogisticRegressionModel QuantizeLogisticRegression(const LogisticRegressionModel &model, const std::vector<std::vector<T>> &calibrationXValues)
+    {
+        const std::vector<long double> &coefficients = model.getCoefficients();
+
+        assert(!coefficients.empty() && "Model coefficients are not initialized.");
+        assert(!calibrationXValues.empty() && "Calibration batch is empty");
+
+        const size_t numFeatures = coefficients.size() - 1;
+        std::vector<long double> inputScales(numFeatures);
+        std::vector<int32_t> inputZeroPoints(numFeatures);
+        std::vector<long double> effectiveWeights(numFeatures);
+        long double maxAbsWeight = 0.0L;
+
+        for (size_t j = 0; j < numFeatures; ++j)
+        {
+            // Asymmetric range per feature, widened to include zero so it is represented exactly
+            long double minValue = 0.0L;
+            long double maxValue = 0.0L;
+            for (const auto &xVector : calibrationXValues)
+            {
+                assert(xVector.size() == numFeatures && "Input feature size mismatch.");
+                minValue = std::min(minValue, static_cast<long double>(xVector[j]));
+                maxValue = std::max(maxValue, static_cast<long double>(xVector[j]));
+            }
+
+            inputScales[j] = (maxValue > minValue) ? (maxValue - minValue) / 255.0L : 1.0L;
+            inputZeroPoints[j] = static_cast<int32_t>(std::max(-128.0L, std::min(127.0L, std::round(-128.0L - minValue / inputScales[j]))));
+
+            effectiveWeights[j] = coefficients[j + 1] * inputScales[j];
+            maxAbsWeight = std::max(maxAbsWeight, std::abs(effectiveWeights[j]));
+        }
+
+        const long double weightScale = (maxAbsWeight > 0) ? maxAbsWeight / 127.0L : 1.0L;
+        std::vector<int8_t> weights(numFeatures);
+        for (size_t j = 0; j < numFeatures; ++j)
+        {
+            weights[j] = detail::saturateInt8(effectiveWeights[j] / weightScale);
+        }
+
+        return QuantizedLogisticRegressionModel(weights, inputScales, inputZeroPoints, weightScale, coefficients[0]);
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template QuantizedLogisticRegressionModel QuantizeLogisticRegression(const LogisticRegressionModel &model, const std::vector<std::vector<int8_t>> &calibrationXValues);
+    template QuantizedLogisticRegressionModel QuantizeLogisticRegression(const LogisticRegressionModel &model, const std::vector<std::vector<int16_t>> &calibrationXValues);
+    template QuantizedLogisticRegressionModel QuantizeLogisticRegression(const LogisticRegressionModel &model, const std::vector<std::vector<int32_t>> &calibrationXValues);
+    template QuantizedLogisticRegressionModel QuantizeLogisticRegression(const LogisticRegressionModel &model, const std::vector<std::vector<int64_t>> &calibrationXValues);
+
+    template QuantizedLogisticRegressionModel QuantizeLogisticRegression(const LogisticRegressionModel &model, const std::vector<std::vector<uint8_t>> &calibrationXValues);
+    template QuantizedLogisticRegressionModel QuantizeLogisticRegression(const LogisticRegressionModel &model, const std::vector<std::vector<uint16_t>> &calibrationXValues);
+    template QuantizedLogisticRegressionModel QuantizeLogisticRegression(const LogisticRegressionModel &model, const std::vector<std::vector<uint32_t>> &calibrationXValues);
+    template QuantizedLogisticRegressionModel QuantizeLogisticRegression(const LogisticRegressionModel &model, const std::vector<std::vector<uint64_t>> &calibrationXValues);
+
+    template QuantizedLogisticRegressionModel QuantizeLogisticRegression(const LogisticRegressionModel &model, const std::vector<std::vector<float>> &calibrationXValues);
+    template QuantizedLogisticRegressionModel QuantizeLogisticRegression(const LogisticRegressionModel &model, const std::vector<std::vector<double>> &calibrationXValues);
+    template QuantizedLogisticRegressionModel QuantizeLogisticRegression(const LogisticRegressionModel &model, const std::vector<std::vector<long double>> &calibrationXValues);
+#endif
+
+    template <typename T>
+    QuantizationReport EvaluateQuantization(const LogisticRegressionModel &model, const QuantizedLogisticRegressionModel &quantizedModel, const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues, const long double threshold)
+    {
+        const std::vector<long double> &coefficients = model.getCoefficients();
+
+        assert(!xValues.empty() && "xValues is empty");
+        assert(xValues.size() == yValues.size() && "Input vectors must have the same size");
+        assert(coefficients.size() == quantizedModel.getNumFeatures() + 1 && "Model sizes do not match");
+
+        const size_t numFeatures = quantizedModel.getNumFeatures();
+        const std::vector<int8_t> quantizedRows = quantizedModel.quantizeInputs(xValues);
+        const long double logitThreshold = std::log(threshold / (1.0L - threshold));
+
+        QuantizationReport report;
+        size_t floatCorrect = 0;
+        size_t quantizedCorrect = 0;
+        size_t agreed = 0;
+        long double sumLogitError = 0.0L;
+
+        for (size_t i = 0; i < xValues.size(); ++i)
+        {
+            long double floatLogit = coefficients[0];
+            for (size_t j = 0; j < numFeatures; ++j)
+            {
+                floatLogit += coefficients[j + 1] * xValues[i][j];
+            }
+            const long double quantizedLogit = quantizedModel.logit(&quantizedRows[i * numFeatures]);
+
+            const int actualValue = static_cast<int>(yValues[i]);
+            const int floatClass = (floatLogit >= logitThreshold) ? 1 : 0;
+            const int quantizedClass = (quantizedLogit >= logitThreshold) ? 1 : 0;
+
+            floatCorrect += (floatClass == actualValue);
+            quantizedCorrect += (quantizedClass == actualValue);
+            agreed += (floatClass == quantizedClass);
+
+            const long double logitError = std::abs(floatLogit - quantizedLogit);
+            report.maxLogitError = std::max(report.maxLogitError, logitError);
+            sumLogitError += logitError;
+        }
+
+        const long double dataSize = static_cast<long double>(xValues.size());
+        report.floatAccuracy = floatCorrect / dataSize * 100.0;
+        report.quantizedAccuracy = quantizedCorrect / dataSize * 100.0;
+        report.accuracyDelta = report.quantizedAccuracy - report.floatAccuracy;
+        report.agreement = agreed / dataSize * 100.0;
+        report.meanLogitError = sumLogitError / dataSize;
+
+        return report;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template QuantizationReport EvaluateQuantization(const LogisticRegressionModel &model, const QuantizedLogisticRegressionModel &quantizedModel, const std::vector<std::vector<int8_t>> &xValues, const std::vector<int8_t> &yValues, const long double threshold);
+    template QuantizationReport EvaluateQuantization(const LogisticRegressionModel &model, const QuantizedLogisticRegressionModel &quantizedModel, const std::vector<std::vector<int16_t>> &xValues, const std::vector<int16_t> &yValues, const long double threshold);
+    template QuantizationReport EvaluateQuantization(const LogisticRegressionModel &model, const QuantizedLogisticRegressionModel &quantizedModel, const std::vector<std::vector<int32_t>> &xValues, const std::vector<int32_t> &yValues, const long double threshold);
+    template QuantizationReport EvaluateQuantization(const LogisticRegressionModel &model, const QuantizedLogisticRegressionModel &quantizedModel, const std::vector<std::vector<int64_t>> &xValues, const std::vector<int64_t> &yValues, const long double threshold);
+
+    template QuantizationReport EvaluateQuantization(const LogisticRegressionModel &model, const QuantizedLogisticRegressionModel &quantizedModel, const std::vector<std::vector<uint8_t>> &xValues, const std::vector<uint8_t> &yValues, const long double threshold);
+    template QuantizationReport EvaluateQuantization(const LogisticRegressionModel &model, const QuantizedLogisticRegressionModel &quantizedModel, const std::vector<std::vector<uint16_t>> &xValues, const std::vector<uint16_t> &yValues, const long double threshold);
+    template QuantizationReport EvaluateQuantization(const LogisticRegressionModel &model, const QuantizedLogisticRegressionModel &quantizedModel, const std::vector<std::vector<uint32_t>> &xValues, const std::vector<uint32_t> &yValues, const long double threshold);
+    template QuantizationReport EvaluateQuantization(const LogisticRegressionModel &model, const QuantizedLogisticRegressionModel &quantizedModel, const std::vector<std::vector<uint64_t>> &xValues, const std::vector<uint64_t> &yValues, const long double threshold);
+
+    template QuantizationReport EvaluateQuantization(const LogisticRegressionModel &model, const QuantizedLogisticRegressionModel &quantizedModel, const std::vector<std::vector<float>> &xValues, const std::vector<float> &yValues, const long double threshold);
+    template QuantizationReport EvaluateQuantization(const LogisticRegressionModel &model, const QuantizedLogisticRegressionModel &quantizedModel, const std::vector<std::vector<double>> &xValues, const std::vector<double> &yValues, const long double threshold);
+    template QuantizationReport EvaluateQuantization(const LogisticRegressionModel &model, const QuantizedLogisticRegressionModel &quantizedModel, const std::vector<std::vector<long double>> &xValues, const std::vector<long double> &yValues, const long double threshold);
+#endif
+
+    template <typename T>
+    CurveEvaluation EvaluateCurves(const std::vector<long double> &probabilities, const std::vector<T> &actualYValues, EvaluationMode mode, size_t numBins, size_t numThreads)
+    {
+        assert(("Probabilities are empty" && !probabilities.empty()));
+        assert(("Input vectors must have the same size" && probabilities.size() == actualYValues.size()));
+
+        const size_t dataSize = probabilities.size();
+        numThreads = detail::resolveThreadCount(numThreads);
+
+        // Per-thread partial results are reduced after the parallel pass
+        std::vector<long double> partialLogLoss(numThreads, 0.0L);
+        std::vector<size_t> partialPositives(numThreads, 0);
+
+        // Swept from the highest threshold down: positive and negative counts per candidate threshold
+        std::vector<long double> candidateThresholds;
+        std::vector<size_t> positiveCounts;
+        std::vector<size_t> negativeCounts;
+
+        const long double epsilon = 1e-15L;
+        auto logLossTerm = [epsilon](long double probability, int actualValue)
+        {
+            probability = std::max(epsilon, std::min(1.0L - epsilon, probability));
+            return (actualValue == 1) ? -std::log(probability) : -std::log(1.0L - probability);
+        };
+
+        switch (mode)
+        {
+        case Exact:
+        {
+            std::vector<size_t> order(dataSize);
+            std::iota(order.begin(), order.end(), 0);
+            auto descending = [&probabilities](size_t a, size_t b)
+            { return probabilities[a] > probabilities[b]; };
+
+            // Sort blocks in parallel, accumulating log-loss in the same pass, then merge blocks pairwise
+            const size_t blockSize = (dataSize + numThreads - 1) / numThreads;
+            detail::parallelFor(dataSize, numThreads, [&](size_t begin, size_t end, size_t threadIndex)
+                                {
+                                    for (size_t i = begin; i < end; ++i)
+                                    {
+                                        const int actualValue = static_cast<int>(actualYValues[i]);
+                                        partialLogLoss[threadIndex] += logLossTerm(probabilities[i], actualValue);
+                                        partialPositives[threadIndex] += (actualValue == 1);
+                                    }
+                                    std::sort(order.begin() + begin, order.begin() + end, descending); });
+
+            for (size_t width = blockSize; width < dataSize; width *= 2)
+            {
+                const size_t numMerges = (dataSize + 2 * width - 1) / (2 * width);
+                detail::parallelFor(numMerges, numThreads, [&](size_t begin, size_t end, size_t)
+                                    {
+                                        for (size_t m = begin; m < end; ++m)
+                                        {
+                                            const size_t first = m * 2 * width;
+                                            const size_t middle = std::min(first + width, dataSize);
+                                            const size_t last = std::min(first + 2 * width, dataSize);
+                                            std::inplace_merge(order.begin() + first, order.begin() + middle, order.begin() + last, descending);
+                                        } });
+            }
+
+            // Every distinct probability is a candidate threshold
+            for (size_t i = 0; i < dataSize; ++i)
+            {
+                const long double probability = probabilities[order[i]];
+                if (candidateThresholds.empty() || probability != candidateThresholds.back())
+                {
+                    candidateThresholds.push_back(probability);
+                    positiveCounts.push_back(0);
+                    negativeCounts.push_back(0);
+                }
+
+                if (static_cast<int>(actualYValues[order[i]]) == 1)
+                    positiveCounts.back()++;
+                else
+                    negativeCounts.back()++;
+            }
+        }
+        break;
+
+        case Histogram:
+        {
+            assert(("Number of bins must be positive" && numBins > 0));
+
+            std::vector<std::vector<size_t>> localPositives(numThreads, std::vector<size_t>(numBins, 0));
+            std::vector<std::vector<size_t>> localNegatives(numThreads, std::vector<size_t>(numBins, 0));
+
+            detail::parallelFor(dataSize, numThreads, [&](size_t begin, size_t end, size_t threadIndex)
+                                {
+                                    for (size_t i = begin; i < end; ++i)
+                                    {
+                                        const long double probability = std::max(0.0L, std::min(1.0L, probabilities[i]));
+                                        const size_t bin = std::min(numBins - 1, static_cast<size_t>(probability * numBins));
+                                        const int actualValue = static_cast<int>(actualYValues[i]);
+
+                                        partialLogLoss[threadIndex] += logLossTerm(probabilities[i], actualValue);
+                                        if (actualValue == 1)
+                                        {
+                                            partialPositives[threadIndex]++;
+                                            localPositives[threadIndex][bin]++;
+                                        }
+                                        else
+                                        {
+                                            localNegatives[threadIndex][bin]++;
+                                        }
+                                    } });
+
+            // Each non-empty bin contributes a threshold at its lower edge
+            for (size_t bin = numBins; bin-- > 0;)
+            {
+                size_t positives = 0;
+                size_t negatives = 0;
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    positives += localPositives[t][bin];
+                    negatives += localNegatives[t][bin];
+                }
+
+                if (positives + negatives == 0)
+                    continue;
+
+                candidateThresholds.push_back(static_cast<long double>(bin) / numBins);
+                positiveCounts.push_back(positives);
+                negativeCounts.push_back(negatives);
+            }
+        }
+        break;
+
+        default:
+            assert(false && "Unsupported evaluation mode");
+        }
+
+        CurveEvaluation evaluation;
+        const size_t totalPositives = std::accumulate(partialPositives.begin(), partialPositives.end(), static_cast<size_t>(0));
+        const size_t totalNegatives = dataSize - totalPositives;
+        evaluation.logLoss = std::accumulate(partialLogLoss.begin(), partialLogLoss.end(), 0.0L) / dataSize;
+
+        // Sweep thresholds from high to low, integrating ROC (trapezoids) and PR (average precision)
+        evaluation.thresholds.reserve(candidateThresholds.size());
+        size_t truePositive = 0;
+        size_t falsePositive = 0;
+        long double previousTpr = 0.0L;
+        long double previousFpr = 0.0L;
+
+        for (size_t k = 0; k < candidateThresholds.size(); ++k)
+        {
+            truePositive += positiveCounts[k];
+            falsePositive += negativeCounts[k];
+
+            ThresholdPoint point;
+            point.threshold = candidateThresholds[k];
+            point.confusionMatrix.truePositive = truePositive;
+            point.confusionMatrix.falsePositive = falsePositive;
+            point.confusionMatrix.falseNegative = totalPositives - truePositive;
+            point.confusionMatrix.trueNegative = totalNegatives - falsePositive;
+            evaluation.thresholds.push_back(point);
+
+            const long double tpr = totalPositives ? static_cast<long double>(truePositive) / totalPositives : 0.0L;
+            const long double fpr = totalNegatives ? static_cast<long double>(falsePositive) / totalNegatives : 0.0L;
+            const long double precision = static_cast<long double>(truePositive) / (truePositive + falsePositive);
+
+            evaluation.rocAuc += (fpr - previousFpr) * (tpr + previousTpr) / 2.0L;
+            evaluation.prAuc += (tpr - previousTpr) * precision;
+
+            previousTpr = tpr;
+            previousFpr = fpr;
+        }
+
+        return evaluation;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template CurveEvaluation EvaluateCurves(const std::vector<long double> &probabilities, const std::vector<int8_t> &actualYValues, EvaluationMode mode, size_t numBins, size_t numThreads);
+    template CurveEvaluation EvaluateCurves(const std::vector<long double> &probabilities, const std::vector<int16_t> &actualYValues, EvaluationMode mode, size_t numBins, size_t numThreads);
+    template CurveEvaluation EvaluateCurves(const std::vector<long double> &probabilities, const std::vector<int32_t> &actualYValues, EvaluationMode mode, size_t numBins, size_t numThreads);
+    template CurveEvaluation EvaluateCurves(const std::vector<long double> &probabilities, const std::vector<int64_t> &actualYValues, EvaluationMode mode, size_t numBins, size_t numThreads);
+
+    template CurveEvaluation EvaluateCurves(const std::vector<long double> &probabilities, const std::vector<uint8_t> &actualYValues, EvaluationMode mode, size_t numBins, size_t numThreads);
+    template CurveEvaluation EvaluateCurves(const std::vector<long double> &probabilities, const std::vector<uint16_t> &actualYValues, EvaluationMode mode, size_t numBins, size_t numThreads);
+    template CurveEvaluation EvaluateCurves(const std::vector<long double> &probabilities, const std::vector<uint32_t> &actualYValues, EvaluationMode mode, size_t numBins, size_t numThreads);
+    template CurveEvaluation EvaluateCurves(const std::vector<long double> &probabilities, const std::vector<uint64_t> &actualYValues, EvaluationMode mode, size_t numBins, size_t numThreads);
+
+    template CurveEvaluation EvaluateCurves(const std::vector<long double> &probabilities, const std::vector<float> &actualYValues, EvaluationMode mode, size_t numBins, size_t numThreads);
+    template CurveEvaluation EvaluateCurves(const std::vector<long double> &probabilities, const std::vector<double> &actualYValues, EvaluationMode mode, size_t numBins, size_t numThreads);
+    template CurveEvaluation EvaluateCurves(const std::vector<long double> &probabilities, const std::vector<long double> &actualYValues, EvaluationMode mode, size_t numBins, size_t numThreads);
+#endif
+
+    MLLIB_INLINE std::vector<LogisticRegressionParams> MakeParameterGrid(const std::vector<long double> &learningRates, const std::vector<int> &iterationCounts, const std::vector<OptimizerType> &optimizers)
+    {
+        std::vector<LogisticRegressionParams> parameterGrid;
+        parameterGrid.reserve(learningRates.size() * iterationCounts.size() * optimizers.size());
+
+        for (const auto &optimizer : optimizers)
+        {
+            for (const auto &learningRate : learningRates)
+            {
+                for (const auto &numIterations : iterationCounts)
+                {
+                    parameterGrid.push_back({learningRate, numIterations, optimizer});
+                }
+            }
+        }
+
+        return parameterGrid;
+    }
+
+    template <typename T>
+    std::vector<CrossValidationResult> CrossValidateLogisticRegression(const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed)
+    {
+        assert(!xValues.empty() && "xValues is empty");
+        assert(xValues.size() == yValues.size() && "Input vectors must have the same size");
+
+        return detail::crossValidateRows(
+            xValues.size(), xValues[0].size(),
+            [&xValues](size_t i) -> const std::vector<T> & { return xValues[i]; },
+            [&yValues](size_t i) { return yValues[i]; },
+            parameterGrid, numFolds, successiveHalving, numThreads, seed);
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const std::vector<std::vector<int8_t>> &xValues, const std::vector<int8_t> &yValues, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const std::vector<std::vector<int16_t>> &xValues, const std::vector<int16_t> &yValues, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const std::vector<std::vector<int32_t>> &xValues, const std::vector<int32_t> &yValues, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const std::vector<std::vector<int64_t>> &xValues, const std::vector<int64_t> &yValues, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const std::vector<std::vector<uint8_t>> &xValues, const std::vector<uint8_t> &yValues, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const std::vector<std::vector<uint16_t>> &xValues, const std::vector<uint16_t> &yValues, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const std::vector<std::vector<uint32_t>> &xValues, const std::vector<uint32_t> &yValues, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const std::vector<std::vector<uint64_t>> &xValues, const std::vector<uint64_t> &yValues, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const std::vector<std::vector<float>> &xValues, const std::vector<float> &yValues, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const std::vector<std::vector<double>> &xValues, const std::vector<double> &yValues, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const std::vector<std::vector<long double>> &xValues, const std::vector<long double> &yValues, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+#endif
+
+    template <typename T>
+    std::vector<CrossValidationResult> CrossValidateLogisticRegression(const DatasetView<T> &data, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed)
+    {
+        assert(!data.empty() && "Dataset view is empty");
+
+        return detail::crossValidateRows(
+            data.size(), data.getNumFeatures(),
+            [&data](size_t i) { return data.row(i); },
+            [&data](size_t i) { return data.label(i); },
+            parameterGrid, numFolds, successiveHalving, numThreads, seed);
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const DatasetView<int8_t> &data, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const DatasetView<int16_t> &data, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const DatasetView<int32_t> &data, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const DatasetView<int64_t> &data, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const DatasetView<uint8_t> &data, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const DatasetView<uint16_t> &data, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const DatasetView<uint32_t> &data, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const DatasetView<uint64_t> &data, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const DatasetView<float> &data, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const DatasetView<double> &data, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+    template std::vector<CrossValidationResult> CrossValidateLogisticRegression(const DatasetView<long double> &data, const std::vector<LogisticRegressionParams> &parameterGrid, size_t numFolds, bool successiveHalving, size_t numThreads, unsigned int seed);
+#endif
+
+    template <typename T>
+    BatchIterator<T>::BatchIterator(const DatasetView<T> &data, const BatchOptions &options)
+        : data(data), options(options), buffers(options.numBuffers), readyBuffers(options.numBuffers + 1), freeBuffers(options.numBuffers), currentBuffer(SIZE_MAX)
+    {
+        assert(("Batch size must be positive" && options.batchSize > 0));
+        assert(("At least two buffers are needed to overlap producer and consumer" && options.numBuffers >= 2));
+
+        const size_t numFeatures = data.getNumFeatures();
+        featureOffsets.assign(numFeatures, 0.0L);
+        featureScales.assign(numFeatures, 1.0L);
+
+        if (options.normalizeFeatures || options.normalizeLabels)
+        {
+            std::vector<T> values(data.size());
+            for (size_t j = 0; j < numFeatures && options.normalizeFeatures; ++j)
+            {
+                for (size_t i = 0; i < data.size(); ++i)
+                {
+                    values[i] = data.row(i)[j];
+                }
+                detail::normalizationParameters(std::span<const T>(values), options.normalizationType, featureOffsets[j], featureScales[j]);
+                if (featureScales[j] == 0.0L)
+                    featureScales[j] = 1.0L;
+            }
+
+            if (options.normalizeLabels)
+            {
+                for (size_t i = 0; i < data.size(); ++i)
+                {
+                    values[i] = data.label(i);
+                }
+                detail::normalizationParameters(std::span<const T>(values), options.normalizationType, labelOffset, labelScale);
+                if (labelScale == 0.0L)
+                    labelScale = 1.0L;
+            }
+        }
+
+        for (size_t b = 0; b < options.numBuffers; ++b)
+        {
+            buffers[b].features.resize(options.batchSize * numFeatures);
+            buffers[b].labels.resize(options.batchSize);
+            buffers[b].numFeatures = numFeatures;
+            freeBuffers.tryPush(b);
+        }
+
+        producer = std::thread(&BatchIterator::produce, this);
+    }
+
+    template <typename T>
+    BatchIterator<T>::~BatchIterator()
+    {
+        stopRequested.store(true, std::memory_order_relaxed);
+        producer.join();
+    }
+
+    template <typename T>
+    void BatchIterator<T>::produce()
+    {
+        const size_t numFeatures = data.getNumFeatures();
+        std::vector<size_t> order(data.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::mt19937 generator(options.seed);
+
+        for (size_t epoch = 0; epoch < options.numEpochs; ++epoch)
+        {
+            if (options.shuffle)
+                std::shuffle(order.begin(), order.end(), generator);
+
+            for (size_t begin = 0; begin < order.size(); begin += options.batchSize)
+            {
+                size_t bufferIndex;
+                if (!freeBuffers.tryPop(bufferIndex))
+                {
+                    producerStalls.fetch_add(1, std::memory_order_relaxed);
+                    do
+                    {
+                        if (stopRequested.load(std::memory_order_relaxed))
+                            return;
+                        std::this_thread::yield();
+                    } while (!freeBuffers.tryPop(bufferIndex));
+                }
+
+                // Gather and normalize the rows of this batch
+                ScopedTimer timer("BatchIterator::produce");
+                Batch &batch = buffers[bufferIndex];
+                batch.numRows = std::min(options.batchSize, order.size() - begin);
+                batch.epoch = epoch;
+                for (size_t r = 0; r < batch.numRows; ++r)
+                {
+                    const std::span<const T> row = data.row(order[begin + r]);
+                    long double *destination = &batch.features[r * numFeatures];
+                    for (size_t j = 0; j < numFeatures; ++j)
+                    {
+                        destination[j] = (static_cast<long double>(row[j]) - featureOffsets[j]) / featureScales[j];
+                    }
+                    batch.labels[r] = (static_cast<long double>(data.label(order[begin + r])) - labelOffset) / labelScale;
+                }
+
+                readyBuffers.tryPush(bufferIndex);
+            }
+        }
+
+        // The ready queue has one slot more than there are buffers, so the end marker always fits
+        readyBuffers.tryPush(SIZE_MAX);
+    }
+
+    template <typename T>
+    const Batch *BatchIterator<T>::next()
+    {
+        if (finished)
+            return nullptr;
+
+        if (currentBuffer != SIZE_MAX)
+            freeBuffers.tryPush(currentBuffer);
+
+        if (!readyBuffers.tryPop(currentBuffer))
+        {
+            ScopedTimer timer("BatchIterator::wait");
+            const auto waitStart = std::chrono::steady_clock::now();
+            while (!readyBuffers.tryPop(currentBuffer))
+            {
+                std::this_thread::yield();
+            }
+            ++stats.consumerStalls;
+            stats.consumerWaitTime += std::chrono::steady_clock::now() - waitStart;
+        }
+
+        if (currentBuffer == SIZE_MAX)
+        {
+            finished = true;
+            return nullptr;
+        }
+
+        ++stats.batches;
+        return &buffers[currentBuffer];
+    }
+
+    template <typename T>
+    BatchIteratorStats BatchIterator<T>::getStats() const
+    {
+        BatchIteratorStats result = stats;
+        result.producerStalls = producerStalls.load(std::memory_order_relaxed);
+        return result;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template class BatchIterator<int8_t>;
+    template class BatchIterator<int16_t>;
+    template class BatchIterator<int32_t>;
+    template class BatchIterator<int64_t>;
+
+    template class BatchIterator<uint8_t>;
+    template class BatchIterator<uint16_t>;
+    template class BatchIterator<uint32_t>;
+    template class BatchIterator<uint64_t>;
+
+    template class BatchIterator<float>;
+    template class BatchIterator<double>;
+    template class BatchIterator<long double>;
+#endif
+
+    template <typename T>
+    void LogisticRegressionModel::partialFit(BatchIterator<T> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback)
+    {
+        if (coefficients.empty())
+        {
+            coefficients.assign(batches.getNumFeatures() + 1, 0.0);
+            normalizationType = batches.getOptions().normalizationType;
+        }
+        assert(("Input feature size mismatch." && coefficients.size() == batches.getNumFeatures() + 1));
+
+        // One progress report per batch
+        detail::TrainingMonitor monitor(callback);
+        while (const Batch *batch = batches.next())
+        {
+            detail::fitLogisticRows(
+                coefficients, optimizerState, batch->numRows,
+                [batch](size_t i) { return &batch->features[i * batch->numFeatures]; },
+                [batch](size_t i) { return batch->labels[i]; },
+                learningRate, 1, optimizer, &monitor);
+        }
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template void LogisticRegressionModel::partialFit(BatchIterator<int8_t> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(BatchIterator<int16_t> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(BatchIterator<int32_t> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(BatchIterator<int64_t> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+
+    template void LogisticRegressionModel::partialFit(BatchIterator<uint8_t> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(BatchIterator<uint16_t> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(BatchIterator<uint32_t> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(BatchIterator<uint64_t> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+
+    template void LogisticRegressionModel::partialFit(BatchIterator<float> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(BatchIterator<double> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+    template void LogisticRegressionModel::partialFit(BatchIterator<long double> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+#endif
+
+    template <typename T>
+    LogisticRegressionModel LogisticRegression(BatchIterator<T> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback)
+    {
+        LogisticRegressionModel model;
+        model.partialFit(batches, learningRate, optimizer, callback);
+        return model;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template LogisticRegressionModel LogisticRegression(BatchIterator<int8_t> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(BatchIterator<int16_t> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(BatchIterator<int32_t> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(BatchIterator<int64_t> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+
+    template LogisticRegressionModel LogisticRegression(BatchIterator<uint8_t> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(BatchIterator<uint16_t> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(BatchIterator<uint32_t> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(BatchIterator<uint64_t> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+
+    template LogisticRegressionModel LogisticRegression(BatchIterator<float> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(BatchIterator<double> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+    template LogisticRegressionModel LogisticRegression(BatchIterator<long double> &batches, const long double learningRate, OptimizerType optimizer, const TrainingCallback &callback);
+#endif
+
+    template <typename T>
+    LinearRegressionModel LinearRegressionGradientDescent(BatchIterator<T> &batches, const long double learningRate, const TrainingCallback &callback)
+    {
+        assert(("Linear regression takes a single feature" && batches.getNumFeatures() == 1));
+
+        long double slope = 0.0L;
+        long double intercept = 0.0L;
+
+        detail::TrainingMonitor monitor(callback);
+        const bool tracking = monitor.active();
+        while (const Batch *batch = batches.next())
+        {
+            long double sumErrors = 0.0L;
+            long double sumXErrors = 0.0L;
+            long double sumSquaredErrors = 0.0L;
+
+            for (size_t i = 0; i < batch->numRows; ++i)
+            {
+                long double error = slope * batch->features[i] + intercept - batch->labels[i];
+                sumErrors += error;
+                sumXErrors += error * batch->features[i];
+                sumSquaredErrors += error * error;
+            }
+
+            if (tracking)
+            {
+                const long double gradientSums[2] = {sumXErrors, sumErrors};
+                monitor.report(sumSquaredErrors, gradientSums, batch->numRows);
+            }
+
+            slope -= learningRate * (1.0L / batch->numRows) * sumXErrors;
+            intercept -= learningRate * (1.0L / batch->numRows) * sumErrors;
+        }
+
+        return LinearRegressionModel(slope, intercept, batches.getOptions().normalizationType);
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template LinearRegressionModel LinearRegressionGradientDescent(BatchIterator<int8_t> &batches, const long double learningRate, const TrainingCallback &callback);
+    template LinearRegressionModel LinearRegressionGradientDescent(BatchIterator<int16_t> &batches, const long double learningRate, const TrainingCallback &callback);
+    template LinearRegressionModel LinearRegressionGradientDescent(BatchIterator<int32_t> &batches, const long double learningRate, const TrainingCallback &callback);
+    template LinearRegressionModel LinearRegressionGradientDescent(BatchIterator<int64_t> &batches, const long double learningRate, const TrainingCallback &callback);
+
+    template LinearRegressionModel LinearRegressionGradientDescent(BatchIterator<uint8_t> &batches, const long double learningRate, const TrainingCallback &callback);
+    template LinearRegressionModel LinearRegressionGradientDescent(BatchIterator<uint16_t> &batches, const long double learningRate, const TrainingCallback &callback);
+    template LinearRegressionModel LinearRegressionGradientDescent(BatchIterator<uint32_t> &batches, const long double learningRate, const TrainingCallback &callback);
+    template LinearRegressionModel LinearRegressionGradientDescent(BatchIterator<uint64_t> &batches, const long double learningRate, const TrainingCallback &callback);
+
+    template LinearRegressionModel LinearRegressionGradientDescent(BatchIterator<float> &batches, const long double learningRate, const TrainingCallback &callback);
+    template LinearRegressionModel LinearRegressionGradientDescent(BatchIterator<double> &batches, const long double learningRate, const TrainingCallback &callback);
+    template LinearRegressionModel LinearRegressionGradientDescent(BatchIterator<long double> &batches, const long double learningRate, const TrainingCallback &callback);
+#endif
+
+    MLLIB_INLINE CompressedDataset::CompressedDataset() {}
+
+    template <typename T>
+    CompressedDataset::CompressedDataset(const DatasetView<T> &data, const CompressionOptions &options)
+        : columns(data.getNumFeatures()), numRows(data.size())
+    {
+        std::vector<float> values(numRows);
+        for (size_t j = 0; j < columns.size(); ++j)
+        {
+            for (size_t i = 0; i < numRows; ++i)
+            {
+                values[i] = static_cast<float>(data.row(i)[j]);
+            }
+            columns[j] = detail::encodeColumn(values, options);
+        }
+
+        for (size_t i = 0; i < numRows; ++i)
+        {
+            values[i] = static_cast<float>(data.label(i));
+        }
+        labelColumn = detail::encodeColumn(values, options);
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template CompressedDataset::CompressedDataset(const DatasetView<int8_t> &data, const CompressionOptions &options);
+    template CompressedDataset::CompressedDataset(const DatasetView<int16_t> &data, const CompressionOptions &options);
+    template CompressedDataset::CompressedDataset(const DatasetView<int32_t> &data, const CompressionOptions &options);
+    template CompressedDataset::CompressedDataset(const DatasetView<int64_t> &data, const CompressionOptions &options);
+
+    template CompressedDataset::CompressedDataset(const DatasetView<uint8_t> &data, const CompressionOptions &options);
+    template CompressedDataset::CompressedDataset(const DatasetView<uint16_t> &data, const CompressionOptions &options);
+    template CompressedDataset::CompressedDataset(const DatasetView<uint32_t> &data, const CompressionOptions &options);
+    template CompressedDataset::CompressedDataset(const DatasetView<uint64_t> &data, const CompressionOptions &options);
+
+    template CompressedDataset::CompressedDataset(const DatasetView<float> &data, const CompressionOptions &options);
+    template CompressedDataset::CompressedDataset(const DatasetView<double> &data, const CompressionOptions &options);
+    template CompressedDataset::CompressedDataset(const DatasetView<long double> &data, const CompressionOptions &options);
+#endif
+
+    MLLIB_INLINE size_t CompressedDataset::getNumRows() const { return numRows; }
+    MLLIB_INLINE size_t CompressedDataset::getNumFeatures() const { return columns.size(); }
+
+    MLLIB_INLINE ColumnEncoding CompressedDataset::getEncoding(size_t feature) const
+    {
+        assert(feature < columns.size() && "Feature index out of range");
+        return columns[feature].encoding;
+    }
+
+    MLLIB_INLINE size_t CompressedDataset::getMemoryUsage() const
+    {
+        size_t bytes = labelColumn.data.size() + labelColumn.dictionary.size() * sizeof(float);
+        for (const auto &column : columns)
+        {
+            bytes += column.data.size() + column.dictionary.size() * sizeof(float);
+        }
+        return bytes;
+    }
+
+    MLLIB_INLINE float CompressedDataset::value(size_t row, size_t feature) const
+    {
+        assert(row < numRows && feature < columns.size() && "Index out of range");
+        return detail::dispatchEncoding(columns[feature].encoding, [&](auto encoding) { return detail::decodeValue<decltype(encoding)::value>(columns[feature], row); });
+    }
+
+    MLLIB_INLINE float CompressedDataset::label(size_t row) const
+    {
+        assert(row < numRows && "Row index out of range");
+        return detail::dispatchEncoding(labelColumn.encoding, [&](auto encoding) { return detail::decodeValue<decltype(encoding)::value>(labelColumn, row); });
+    }
+
+    MLLIB_INLINE void CompressedDataset::computeLogits(std::span<const float> coefficients, size_t begin, size_t end, std::span<float> logits) const
+    {
+        assert(coefficients.size() == columns.size() + 1 && "Input feature size mismatch.");
+        assert(begin <= end && end <= numRows && logits.size() >= end - begin && "Row range out of bounds");
+
+        std::fill(logits.begin(), logits.begin() + (end - begin), coefficients[0]);
+        for (size_t j = 0; j < columns.size(); ++j)
+        {
+            detail::dispatchEncoding(columns[j].encoding, [&](auto encoding)
+                                     { detail::addScaledColumn<decltype(encoding)::value>(columns[j], begin, end, coefficients[j + 1], logits.data()); });
+        }
+    }
+
+    MLLIB_INLINE void CompressedDataset::accumulateGradient(std::span<const float> errors, size_t begin, size_t end, std::span<long double> gradient) const
+    {
+        assert(gradient.size() == columns.size() + 1 && "Input feature size mismatch.");
+        assert(begin <= end && end <= numRows && errors.size() >= end - begin && "Row range out of bounds");
+
+        gradient[0] += std::accumulate(errors.begin(), errors.begin() + (end - begin), 0.0f);
+        for (size_t j = 0; j < columns.size(); ++j)
+        {
+            gradient[j + 1] += detail::dispatchEncoding(columns[j].encoding, [&](auto encoding)
+                                                        { return detail::dotColumn<decltype(encoding)::value>(columns[j], begin, end, errors.data()); });
+        }
+    }
+
+    MLLIB_INLINE void LogisticRegressionModel::partialFit(const CompressedDataset &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback)
+    {
+        assert(data.getNumRows() > 0 && "Dataset is empty");
+
+        if (coefficients.empty())
+        {
+            coefficients.assign(data.getNumFeatures() + 1, 0.0);
+            normalizationType = stat::NormalizationType::Z_Score;
+        }
+        assert(coefficients.size() == data.getNumFeatures() + 1 && "Input feature size mismatch.");
+
+        // Rows are processed in blocks small enough for the logits and errors to stay in L1
+        const size_t blockSize = 256;
+        const size_t numRows = data.getNumRows();
+        std::vector<float> weights(coefficients.size());
+        std::vector<float> logits(blockSize);
+        std::vector<long double> gradient(coefficients.size());
+
+        if (optimizer == Adam)
+            detail::prepareAdamState(optimizerState, coefficients.size());
+        else
+            optimizerState.type = SGD;
+
+        detail::TrainingMonitor monitor(callback);
+        const bool tracking = monitor.active();
+
+        for (int iter = 0; iter < numIterations; ++iter)
+        {
+            ScopedTimer timer("LogisticRegression::iteration");
+            std::transform(coefficients.begin(), coefficients.end(), weights.begin(), [](long double c) { return static_cast<float>(c); });
+            std::fill(gradient.begin(), gradient.end(), 0.0L);
+            long double totalLoss = 0.0L;
+
+            for (size_t begin = 0; begin < numRows; begin += blockSize)
+            {
+                const size_t end = std::min(begin + blockSize, numRows);
+                data.computeLogits(weights, begin, end, logits);
+
+                // Turn the logits into errors in place
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const float prediction = 1.0f / (1.0f + std::exp(-logits[i - begin]));
+                    if (tracking)
+                        totalLoss += detail::logisticLoss(prediction, data.label(i));
+                    logits[i - begin] = prediction - data.label(i);
+                }
+                data.accumulateGradient(std::span<const float>(logits.data(), end - begin), begin, end, gradient);
+            }
+
+            if (tracking)
+                monitor.report(totalLoss, gradient, numRows);
+            Instrumentation::count("LogisticRegression::rows", numRows);
+
+            if (optimizer == Adam)
+            {
+                detail::adamStep(coefficients, optimizerState, gradient, numRows, learningRate);
+            }
+            else
+            {
+                for (size_t j = 0; j < coefficients.size(); ++j)
+                {
+                    coefficients[j] -= learningRate * gradient[j] / numRows;
+                }
+                ++optimizerState.step;
+            }
+        }
+    }
+
+    MLLIB_INLINE LogisticRegressionModel LogisticRegression(const CompressedDataset &data, const long double learningRate, const int numIterations, OptimizerType optimizer, const TrainingCallback &callback)
+    {
+        LogisticRegressionModel model;
+        model.partialFit(data, learningRate, numIterations, optimizer, callback);
+        return model;
+    }
+
+    namespace detail
+    {
+        // Reader stripe of the calling thread, handed out round robin as threads first read
+        MLLIB_INLINE size_t registryReaderStripe()
+        {
+            static std::atomic<size_t> nextStripe{0};
+            thread_local const size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed);
+            return stripe;
+        }
+    } // namespace detail
+
+    MLLIB_INLINE ModelRegistry::ModelRegistry(std::chrono::milliseconds pollInterval) : snapshot(new Snapshot()), pollInterval(pollInterval) {}
+
+    MLLIB_INLINE ModelRegistry::~ModelRegistry()
+    {
+        stop();
+        delete snapshot.load();
+    }
+
+    MLLIB_INLINE bool ModelRegistry::add(const std::string &name, const std::string &filename, Validator validator)
+    {
+        auto entry = std::make_shared<Entry>();
+        entry->name = name;
+        entry->filename = filename;
+        entry->validator = std::move(validator);
+
+        std::lock_guard lock(entry->reloadMutex);
+        ModelPtr model = loadEntry(*entry, false);
+        if (!model)
+            return false;
+
+        std::lock_guard entriesLock(entriesMutex);
+        entries[name] = entry;
+        install(*entry, std::move(model));
+        return true;
+    }
+
+    MLLIB_INLINE void ModelRegistry::remove(const std::string &name)
+    {
+        std::lock_guard lock(entriesMutex);
+        if (entries.erase(name) > 0)
+            publish(name, nullptr);
+    }
+
+    MLLIB_INLINE ModelRegistry::ModelPtr ModelRegistry::get(const std::string &name) const
+    {
+        // Announce the read in the current epoch before loading the snapshot; a writer frees a
+        // snapshot only after both epoch parities have drained
+        std::atomic<uint64_t> &active = readers[detail::registryReaderStripe() % numReaderStripes].active[epoch.load() & 1];
+        active.fetch_add(1);
+        const Snapshot *current = snapshot.load();
+        auto it = current->models.find(name);
+        ModelPtr model = (it == current->models.end()) ? nullptr : it->second;
+        active.fetch_sub(1, std::memory_order_release);
+        return model;
+    }
+
+    MLLIB_INLINE bool ModelRegistry::reload(const std::string &name)
+    {
+        std::shared_ptr<Entry> entry;
+        {
+            std::lock_guard lock(entriesMutex);
+            auto it = entries.find(name);
+            if (it == entries.end())
+                return false;
+            entry = it->second;
+        }
+        return reloadEntry(*entry, false);
+    }
+
+    MLLIB_INLINE ModelRegistryStats ModelRegistry::getStats(const std::string &name) const
+    {
+        std::shared_ptr<Entry> entry;
+        {
+            std::lock_guard lock(entriesMutex);
+            auto it = entries.find(name);
+            if (it == entries.end())
+                return ModelRegistryStats();
+            entry = it->second;
+        }
+        std::lock_guard lock(entry->reloadMutex);
+        return entry->stats;
+    }
+
+    MLLIB_INLINE ModelRegistry::ModelPtr ModelRegistry::loadEntry(Entry &entry, bool onlyIfChanged)
+    {
+        std::error_code error;
+        const auto fileTime = std::filesystem::last_write_time(entry.filename, error).time_since_epoch().count();
+        const auto fileSize = std::filesystem::file_size(entry.filename, error);
+        if (onlyIfChanged && (error || (fileTime == entry.fileTime && fileSize == entry.fileSize)))
+            return nullptr;
+
+        // Remember the attempt so a bad file is retried only once it changes again
+        entry.fileTime = fileTime;
+        entry.fileSize = fileSize;
+
+        // Load and validate off the scoring path; only the snapshot swap is published
+        const auto loadStart = std::chrono::steady_clock::now();
+        auto model = std::make_shared<LogisticRegressionModel>();
+        bool valid;
+        if (detail::isBinaryModelFile(entry.filename))
+        {
+            valid = model->loadBinary(entry.filename);
+        }
+        else
+        {
+            std::ifstream inFile(entry.filename);
+            valid = static_cast<bool>(inFile >> *model);
+            if (!inFile.is_open())
+                std::cerr << "Unable to open file for reading." << std::endl;
+        }
+
+        const auto &coefficients = model->getCoefficients();
+        valid = valid && !coefficients.empty() && std::all_of(coefficients.begin(), coefficients.end(), [](long double c) { return std::isfinite(c); });
+        valid = valid && (!entry.validator || entry.validator(*model));
+        if (!valid)
+        {
+            ++entry.stats.failedReloads;
+            return nullptr;
+        }
+
+        entry.stats.lastLoadTime = std::chrono::steady_clock::now() - loadStart;
+        return model;
+    }
+
+    MLLIB_INLINE bool ModelRegistry::reloadEntry(Entry &entry, bool onlyIfChanged)
+    {
+        std::lock_guard lock(entry.reloadMutex);
+        ModelPtr model = loadEntry(entry, onlyIfChanged);
+        if (!model)
+            return false;
+
+        // The entry may have been removed or replaced while its file was loading
+        std::lock_guard entriesLock(entriesMutex);
+        auto it = entries.find(entry.name);
+        if (it == entries.end() || it->second.get() != &entry)
+            return false;
+        install(entry, std::move(model));
+        return true;
+    }
+
+    MLLIB_INLINE void ModelRegistry::install(Entry &entry, ModelPtr model)
+    {
+        entry.stats.lastSwapTime = publish(entry.name, std::move(model));
+        ++entry.stats.version;
+        if (entry.stats.version > 1)
+            ++entry.stats.reloads;
+    }
+
+    MLLIB_INLINE std::chrono::nanoseconds ModelRegistry::publish(const std::string &name, ModelPtr model)
+    {
+        // Writers hold entriesMutex, so the snapshot only changes here
+        auto next = std::make_unique<Snapshot>(*snapshot.load(std::memory_order_relaxed));
+        if (model)
+            next->models[name] = std::move(model);
+        else
+            next->models.erase(name);
+
+        const auto swapStart = std::chrono::steady_clock::now();
+        const Snapshot *previous = snapshot.exchange(next.release());
+        const auto swapEnd = std::chrono::steady_clock::now();
+
+        waitForReaders();
+        delete previous;
+        return swapEnd - swapStart;
+    }
+
+    MLLIB_INLINE void ModelRegistry::waitForReaders()
+    {
+        // Flip the epoch and wait for the readers of the old parity to leave, twice, so a reader that
+        // read the epoch before an earlier flip and the snapshot before the swap is also waited for
+        for (int flip = 0; flip < 2; ++flip)
+        {
+            const uint64_t parity = epoch.fetch_add(1) & 1;
+            for (;;)
+            {
+                uint64_t active = 0;
+                for (const ReaderStripe &stripe : readers)
+                    active += stripe.active[parity].load();
+                if (active == 0)
+                    break;
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    MLLIB_INLINE void ModelRegistry::watch()
+    {
+        std::unique_lock lock(watcherMutex);
+        while (!watcherCondition.wait_for(lock, pollInterval, [this] { return stopRequested; }))
+        {
+            lock.unlock();
+
+            // Copy the entries so add/remove are never held up by a slow load
+            std::vector<std::shared_ptr<Entry>> current;
+            {
+                std::lock_guard entriesLock(entriesMutex);
+                for (const auto &[name, entry] : entries)
+                    current.push_back(entry);
+            }
+            for (const auto &entry : current)
+                reloadEntry(*entry, true);
+
+            lock.lock();
+        }
+    }
+
+    MLLIB_INLINE void ModelRegistry::start()
+    {
+        std::lock_guard lock(watcherMutex);
+        if (watcher.joinable())
+            return;
+        stopRequested = false;
+        watcher = std::thread(&ModelRegistry::watch, this);
+    }
+
+    MLLIB_INLINE void ModelRegistry::stop()
+    {
+        {
+            std::lock_guard lock(watcherMutex);
+            if (!watcher.joinable())
+                return;
+            stopRequested = true;
+        }
+        watcherCondition.notify_all();
+        watcher.join();
+    }
+
+    struct ScoringServer::Connection
+    {
+        int socket = -1;
+        std::mutex writeMutex;
+        std::thread reader;
+
+        // Responses for requests still in flight hold the connection, so the descriptor is only closed
+        // (and can only be reused) once the last of them is written
+        ~Connection()
+        {
+            if (socket >= 0)
+                ::close(socket);
+        }
+    };
+
+    MLLIB_INLINE ScoringServer::ScoringServer(const ModelRegistry &registry, const ScoringServerOptions &options) : registry(registry), options(options) {}
+
+    MLLIB_INLINE ScoringServer::~ScoringServer() { stop(); }
+
+    MLLIB_INLINE bool ScoringServer::start()
+    {
+        assert(options.maxBatchSize > 0 && options.numWorkers > 0 && "Invalid scoring server options");
+
+        if (running)
+            return false;
+
+        sockaddr_un address;
+        if (!detail::makeSocketAddress(options.socketPath, address))
+        {
+            std::cerr << "Socket path is too long." << std::endl;
+            return false;
+        }
+
+        listenSocket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        ::unlink(options.socketPath.c_str());
+        if (listenSocket < 0 || ::bind(listenSocket, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 || ::listen(listenSocket, SOMAXCONN) != 0)
+        {
+            std::cerr << "Unable to open socket." << std::endl;
+            if (listenSocket >= 0)
+                ::close(listenSocket);
+            listenSocket = -1;
+            return false;
+        }
+
+        running = true;
+        acceptor = std::thread(&ScoringServer::acceptConnections, this);
+        batcher = std::thread(&ScoringServer::formBatches, this);
+        for (size_t w = 0; w < options.numWorkers; ++w)
+        {
+            workers.emplace_back(&ScoringServer::scoreBatches, this);
+        }
+        return true;
+    }
+
+    MLLIB_INLINE void ScoringServer::stop()
+    {
+        if (!running.exchange(false))
+            return;
+
+        // Shutting the sockets down wakes the threads blocked in accept and recv
+        ::shutdown(listenSocket, SHUT_RDWR);
+        acceptor.join();
+        ::close(listenSocket);
+        listenSocket = -1;
+
+        // Take the open connections, so their readers no longer reap themselves, and join them unlocked
+        std::vector<std::shared_ptr<Connection>> openConnections;
+        {
+            std::lock_guard lock(connectionsMutex);
+            openConnections.swap(connections);
+        }
+        for (const auto &connection : openConnections)
+        {
+            ::shutdown(connection->socket, SHUT_RDWR);
+            connection->reader.join();
+        }
+
+        {
+            std::lock_guard lock(pendingMutex);
+        }
+        pendingCondition.notify_all();
+        batcher.join();
+
+        {
+            std::lock_guard lock(batchesMutex);
+        }
+        batchesCondition.notify_all();
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        workers.clear();
+
+        pending.clear();
+        readyBatches.clear();
+        ::unlink(options.socketPath.c_str());
+    }
+
+    MLLIB_INLINE ScoringServerStats ScoringServer::getStats() const
+    {
+        return {numConnections.load(), numRequests.load(), numBatches.load()};
+    }
+
+    MLLIB_INLINE void ScoringServer::acceptConnections()
+    {
+        while (running)
+        {
+            const int socket = ::accept(listenSocket, nullptr, nullptr);
+            if (socket < 0)
+            {
+                if (errno == EINTR || errno == ECONNABORTED)
+                    continue;
+                return;
+            }
+
+            auto connection = std::make_shared<Connection>();
+            connection->socket = socket;
+
+            std::lock_guard lock(connectionsMutex);
+            if (!running)
+                return; // Dropping the connection closes it
+
+            connection->reader = std::thread(&ScoringServer::readRequests, this, connection);
+            connections.push_back(std::move(connection));
+            ++numConnections;
+        }
+    }
+
+    MLLIB_INLINE void ScoringServer::readRequests(std::shared_ptr<Connection> connection)
+    {
+        ScoringRequestHeader header;
+        while (detail::readFully(connection->socket, &header, sizeof(header)))
+        {
+            if (header.magic != ScoringRequestHeader::magicNumber || header.numFeatures > options.maxFeatures)
+                break;
+
+            PendingRequest request;
+            request.connection = connection;
+            request.requestId = header.requestId;
+            request.features.resize(header.numFeatures);
+            if (!detail::readFully(connection->socket, request.features.data(), header.numFeatures * sizeof(float)))
+                break;
+            request.arrival = std::chrono::steady_clock::now();
+
+            {
+                std::lock_guard lock(pendingMutex);
+                pending.push_back(std::move(request));
+            }
+            pendingCondition.notify_one();
+        }
+
+        ::shutdown(connection->socket, SHUT_RDWR);
+
+        // Reap the connection as soon as its client goes. If stop() has already taken the list, it joins
+        // this thread instead.
+        std::lock_guard lock(connectionsMutex);
+        auto it = std::find(connections.begin(), connections.end(), connection);
+        if (it != connections.end())
+        {
+            connection->reader.detach();
+            connections.erase(it);
+        }
+    }
+
+    MLLIB_INLINE void ScoringServer::formBatches()
+    {
+        std::unique_lock lock(pendingMutex);
+        while (true)
+        {
+            pendingCondition.wait(lock, [this] { return !running || !pending.empty(); });
+            if (!running)
+                return;
+
+            // Hold the batch open until it is full or its oldest request reaches the delay limit
+            const auto deadline = pending.front().arrival + options.maxDelay;
+            pendingCondition.wait_until(lock, deadline, [this] { return !running || pending.size() >= options.maxBatchSize; });
+            if (!running)
+                return;
+
+            const size_t batchSize = std::min(pending.size(), options.maxBatchSize);
+            std::vector<PendingRequest> batch(std::make_move_iterator(pending.begin()), std::make_move_iterator(pending.begin() + batchSize));
+            pending.erase(pending.begin(), pending.begin() + batchSize);
+            lock.unlock();
+
+            {
+                std::lock_guard batchesLock(batchesMutex);
+                readyBatches.push_back(std::move(batch));
+            }
+            batchesCondition.notify_one();
+
+            lock.lock();
+        }
+    }
+
+    MLLIB_INLINE void ScoringServer::scoreBatches()
+    {
+        std::vector<float> rows;
+        std::vector<long double> probabilities;
+        std::vector<ScoringResponse> responses;
+        std::vector<size_t> order;
+
+        while (true)
+        {
+            std::vector<PendingRequest> batch;
+            {
+                std::unique_lock lock(batchesMutex);
+                batchesCondition.wait(lock, [this] { return !running || !readyBatches.empty(); });
+                if (readyBatches.empty())
+                    return;
+                batch = std::move(readyBatches.front());
+                readyBatches.erase(readyBatches.begin());
+            }
+
+            // Gather the rows of every well-formed request and score them in one call
+            ScopedTimer timer("ScoringServer::scoreBatch");
+            ModelRegistry::ModelPtr model = registry.get(options.modelName);
+            if (model && model->getCoefficients().empty())
+                model = nullptr; // No intercept, so nothing to score with
+            const size_t numFeatures = model ? model->getCoefficients().size() - 1 : 0;
+
+            // Counting the matching requests rather than dividing by numFeatures also scores intercept-only models
+            rows.clear();
+            size_t numMatching = 0;
+            for (const auto &request : batch)
+            {
+                if (model && request.features.size() == numFeatures)
+                {
+                    rows.insert(rows.end(), request.features.begin(), request.features.end());
+                    ++numMatching;
+                }
+            }
+            probabilities.resize(numMatching);
+            if (!probabilities.empty())
+                model->predictProbabilities(std::span<const float>(rows), std::span<long double>(probabilities));
+
+            responses.resize(batch.size());
+            for (size_t r = 0, scored = 0; r < batch.size(); ++r)
+            {
+                responses[r].requestId = batch[r].requestId;
+                if (!model)
+                {
+                    responses[r].status = ScoringNoModel;
+                    responses[r].probability = 0.0;
+                }
+                else if (batch[r].features.size() != numFeatures)
+                {
+                    responses[r].status = ScoringFeatureMismatch;
+                    responses[r].probability = 0.0;
+                }
+                else
+                {
+                    responses[r].status = ScoringOk;
+                    responses[r].probability = static_cast<double>(probabilities[scored++]);
+                }
+            }
+
+            // One write per connection in the batch
+            order.resize(batch.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&batch](size_t a, size_t b)
+                             { return batch[a].connection.get() < batch[b].connection.get(); });
+
+            std::vector<ScoringResponse> connectionResponses;
+            for (size_t begin = 0; begin < order.size();)
+            {
+                Connection &connection = *batch[order[begin]].connection;
+                connectionResponses.clear();
+                size_t end = begin;
+                for (; end < order.size() && batch[order[end]].connection.get() == &connection; ++end)
+                {
+                    connectionResponses.push_back(responses[order[end]]);
+                }
+
+                std::lock_guard lock(connection.writeMutex);
+                detail::writeFully(connection.socket, connectionResponses.data(), connectionResponses.size() * sizeof(ScoringResponse));
+                begin = end;
+            }
+
+            numRequests += batch.size();
+            ++numBatches;
+        }
+    }
+
+    MLLIB_INLINE ScoringClient::ScoringClient() {}
+
+    MLLIB_INLINE ScoringClient::~ScoringClient() { close(); }
+
+    MLLIB_INLINE bool ScoringClient::connect(const std::string &socketPath)
+    {
+        close();
+
+        sockaddr_un address;
+        if (!detail::makeSocketAddress(socketPath, address))
+            return false;
+
+        socketDescriptor = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (socketDescriptor < 0 || ::connect(socketDescriptor, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0)
+        {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    MLLIB_INLINE void ScoringClient::close()
+    {
+        if (socketDescriptor >= 0)
+            ::close(socketDescriptor);
+        socketDescriptor = -1;
+    }
+
+    MLLIB_INLINE bool ScoringClient::isConnected() const { return socketDescriptor >= 0; }
+
+    MLLIB_INLINE bool ScoringClient::send(uint32_t requestId, std::span<const float> features)
+    {
+        ScoringRequestHeader header;
+        header.requestId = requestId;
+        header.numFeatures = static_cast<uint32_t>(features.size());
+
+        // One write per request, so pipelined requests from one client never interleave
+        std::vector<char> message(sizeof(header) + features.size_bytes());
+        std::memcpy(message.data(), &header, sizeof(header));
+        std::memcpy(message.data() + sizeof(header), features.data(), features.size_bytes());
+        return detail::writeFully(socketDescriptor, message.data(), message.size());
+    }
+
+    MLLIB_INLINE bool ScoringClient::receive(ScoringResponse &response)
+    {
+        return detail::readFully(socketDescriptor, &response, sizeof(response));
+    }
+
+    MLLIB_INLINE bool ScoringClient::score(std::span<const float> features, ScoringResponse &response)
+    {
+        static std::atomic<uint32_t> nextRequestId{0};
+        const uint32_t requestId = nextRequestId++;
+        return send(requestId, features) && receive(response) && response.requestId == requestId;
+    }
+
+    MLLIB_INLINE KMeansModel::KMeansModel() {}
+
+    MLLIB_INLINE KMeansModel::KMeansModel(const std::vector<long double> &centroids, size_t numFeatures)
+    {
+        setCentroids(centroids, numFeatures);
+    }
+
+    MLLIB_INLINE size_t KMeansModel::getNumClusters() const { return clusterCounts.size(); }
+    MLLIB_INLINE size_t KMeansModel::getNumFeatures() const { return numFeatures; }
+    MLLIB_INLINE const std::vector<long double> &KMeansModel::getCentroids() const { return centroids; }
+    MLLIB_INLINE const std::vector<long double> &KMeansModel::getClusterCounts() const { return clusterCounts; }
+    MLLIB_INLINE long double KMeansModel::getInertia() const { return inertia; }
+    MLLIB_INLINE size_t KMeansModel::getIterations() const { return iterations; }
+
+    MLLIB_INLINE std::span<const long double> KMeansModel::getCentroid(size_t cluster) const
+    {
+        assert(cluster < getNumClusters());
+        return std::span<const long double>(centroids.data() + cluster * numFeatures, numFeatures);
+    }
+
+    MLLIB_INLINE void KMeansModel::setCentroids(const std::vector<long double> &newCentroids, size_t newNumFeatures)
+    {
+        assert(newNumFeatures > 0 && newCentroids.size() % newNumFeatures == 0);
+        centroids = newCentroids;
+        numFeatures = newNumFeatures;
+        clusterCounts.assign(centroids.size() / numFeatures, 0.0L);
+        inertia = 0.0L;
+        iterations = 0;
+    }
+
+    MLLIB_INLINE void KMeansModel::setClusterCounts(const std::vector<long double> &newClusterCounts)
+    {
+        assert(newClusterCounts.size() == getNumClusters());
+        clusterCounts = newClusterCounts;
+    }
+
+    MLLIB_INLINE void KMeansModel::setInertia(long double newInertia) { inertia = newInertia; }
+    MLLIB_INLINE void KMeansModel::setIterations(size_t newIterations) { iterations = newIterations; }
+
+
+    namespace detail
+    {
+        // Double precision working copy of a model's centroids
+        MLLIB_INLINE CentroidTable makeCentroidTable(const std::vector<long double> &centroids, size_t numClusters, size_t numFeatures)
+        {
+            CentroidTable table(numClusters, numFeatures);
+            std::transform(centroids.begin(), centroids.end(), table.centroids.begin(), [](long double value)
+                           { return static_cast<double>(value); });
+            table.update();
+            return table;
+        }
+    }
+
+    template <typename T>
+    void KMeansModel::partialFit(const DatasetView<T> &data, const KMeansOptions &options)
+    {
+        assert(!data.empty() && (centroids.empty() || data.getNumFeatures() == numFeatures));
+        const size_t numThreads = detail::resolveThreadCount(options.numThreads);
+
+        if (centroids.empty())
+        {
+            assert(options.numClusters > 0 && data.size() >= options.numClusters);
+            std::mt19937 generator(options.seed);
+            const detail::CentroidTable seeds = detail::seedKMeansPlusPlus(data, options.numClusters, numThreads, generator);
+            setCentroids(std::vector<long double>(seeds.centroids.begin(), seeds.centroids.end()), data.getNumFeatures());
+        }
+
+        detail::CentroidTable table = detail::makeCentroidTable(centroids, getNumClusters(), numFeatures);
+        double batchInertia = 0.0;
+        detail::miniBatchStep(data, table, clusterCounts, numThreads, batchInertia);
+
+        centroids.assign(table.centroids.begin(), table.centroids.end());
+        inertia = batchInertia;
+        ++iterations;
+    }
+
+    template <typename T>
+    size_t KMeansModel::predict(std::span<const T> xRow) const
+    {
+        assert(xRow.size() == numFeatures && !centroids.empty());
+        size_t best = 0;
+        long double bestDistance = std::numeric_limits<long double>::infinity();
+        for (size_t c = 0; c < getNumClusters(); ++c)
+        {
+            long double distance = 0.0L;
+            for (size_t j = 0; j < numFeatures; ++j)
+            {
+                const long double difference = static_cast<long double>(xRow[j]) - centroids[c * numFeatures + j];
+                distance += difference * difference;
+            }
+            if (distance < bestDistance)
+            {
+                bestDistance = distance;
+                best = c;
+            }
+        }
+        return best;
+    }
+
+    template <typename T>
+    std::vector<size_t> KMeansModel::predict(const std::vector<std::vector<T>> &xValues, size_t numThreads) const
+    {
+        std::vector<T> rowMajor;
+        rowMajor.reserve(xValues.size() * numFeatures);
+        for (const auto &row : xValues)
+        {
+            assert(row.size() == numFeatures);
+            rowMajor.insert(rowMajor.end(), row.begin(), row.end());
+        }
+        return predict(DatasetView<T>(rowMajor.data(), nullptr, xValues.size(), numFeatures), numThreads);
+    }
+
+    template <typename T>
+    std::vector<size_t> KMeansModel::predict(const DatasetView<T> &data, size_t numThreads) const
+    {
+        assert(data.getNumFeatures() == numFeatures && !centroids.empty());
+        const detail::CentroidTable table = detail::makeCentroidTable(centroids, getNumClusters(), numFeatures);
+        std::vector<size_t> clusters(data.size());
+        detail::parallelFor(data.size(), detail::resolveThreadCount(numThreads), [&](size_t begin, size_t end, size_t)
+                            { detail::forEachRowDistances(data, begin, end, table, [&](size_t position, const double *distances)
+                                                          { clusters[position] = std::min_element(distances, distances + table.numClusters) - distances; }); });
+        return clusters;
+    }
+
+    template <typename T>
+    long double KMeansModel::evaluate(const DatasetView<T> &data, size_t numThreads) const
+    {
+        assert(data.getNumFeatures() == numFeatures && !centroids.empty());
+        const detail::CentroidTable table = detail::makeCentroidTable(centroids, getNumClusters(), numFeatures);
+        numThreads = std::max<size_t>(1, std::min(detail::resolveThreadCount(numThreads), data.size()));
+
+        // The expanded distances pick the cluster; the sum uses exact distances, which keep their precision far from the origin
+        std::vector<double> threadInertia(numThreads, 0.0);
+        detail::parallelFor(data.size(), numThreads, [&](size_t begin, size_t end, size_t threadIndex)
+                            { detail::forEachRowDistances(data, begin, end, table, [&](size_t position, const double *distances)
+                                                          {
+                                                              const size_t cluster = std::min_element(distances, distances + table.numClusters) - distances;
+                                                              threadInertia[threadIndex] += detail::squaredDistance(data.row(position), table.centroid(cluster)); }); });
+        return std::accumulate(threadInertia.begin(), threadInertia.end(), 0.0L);
+    }
+
+    MLLIB_INLINE void KMeansModel::saveToFile(const std::string &filename) const
+    {
+        std::ofstream outFile(filename);
+        if (outFile.is_open())
+        {
+            outFile.precision(std::numeric_limits<long double>::max_digits10);
+            outFile << *this;
+            outFile.close();
+        }
+        else
+        {
+            std::cerr << "Unable to open file for writing." << std::endl;
+        }
+    }
+
+    MLLIB_INLINE void KMeansModel::loadFromFile(const std::string &filename)
+    {
+        if (detail::isBinaryModelFile(filename))
+        {
+            loadBinary(filename);
+            return;
+        }
+
+        std::ifstream inFile(filename);
+        if (inFile.is_open())
+        {
+            if (!(inFile >> *this))
+                std::cerr << "Invalid model file: truncated or malformed text model" << std::endl;
+            inFile.close();
+        }
+        else
+        {
+            std::cerr << "Unable to open file for reading." << std::endl;
+        }
+    }
+
+    MLLIB_INLINE bool KMeansModel::saveBinary(const std::string &filename) const
+    {
+        detail::PayloadWriter payload;
+        payload.write(centroids);
+        payload.write(static_cast<uint64_t>(numFeatures));
+        payload.write(clusterCounts);
+        payload.write(inertia);
+        payload.write(static_cast<uint64_t>(iterations));
+
+        // The header's normalization type is not used by k-means models
+        return detail::writeModelFile(filename, detail::KMeansModelFile, stat::NormalizationType(), centroids.size(), payload.buffer);
+    }
+
+    MLLIB_INLINE bool KMeansModel::loadBinary(const std::string &filename)
+    {
+        MappedFile file;
+        const detail::ModelFileHeader *header = detail::readModelFile(file, filename, detail::KMeansModelFile);
+        if (header == nullptr)
+            return false;
+
+        // Decode into a temporary so a malformed payload leaves this model untouched
+        KMeansModel model;
+        detail::PayloadReader payload(file.data() + sizeof(detail::ModelFileHeader), header->payloadSize);
+        uint64_t newNumFeatures = 0, newIterations = 0;
+
+        bool valid = payload.read(model.centroids, header->numCoefficients) && payload.read(newNumFeatures) &&
+                     newNumFeatures > 0 && header->numCoefficients % newNumFeatures == 0 &&
+                     payload.read(model.clusterCounts, header->numCoefficients / newNumFeatures) &&
+                     payload.read(model.inertia) && payload.read(newIterations) && payload.atEnd();
+        if (!valid)
+        {
+            std::cerr << "Invalid model file: malformed payload" << std::endl;
+            return false;
+        }
+
+        model.numFeatures = newNumFeatures;
+        model.iterations = newIterations;
+        *this = std::move(model);
+        return true;
+    }
+
+    MLLIB_INLINE void KMeansModel::printInfo() const
+    {
+        std::cout << "K-Means Model:\n"
+                  << "Clusters: " << getNumClusters() << ", Features: " << numFeatures << "\n";
+        for (size_t c = 0; c < getNumClusters(); ++c)
+        {
+            std::cout << "Centroid " << c << " (" << clusterCounts[c] << " rows): ";
+            for (const auto &value : getCentroid(c))
+            {
+                std::cout << value << " ";
+            }
+            std::cout << "\n";
+        }
+        std::cout << "Inertia: " << inertia << ", Iterations: " << iterations << "\n";
+    }
+
+    template <typename T>
+    KMeansModel KMeans(const DatasetView<T> &data, const KMeansOptions &options, const TrainingCallback &callback)
+    {
+        assert(options.numClusters > 0 && data.size() >= options.numClusters);
+        const size_t numRows = data.size();
+        const size_t numFeatures = data.getNumFeatures();
+        const size_t numClusters = options.numClusters;
+        const size_t numThreads = std::min(detail::resolveThreadCount(options.numThreads), numRows);
+        detail::TrainingMonitor monitor(callback);
+        std::mt19937 generator(options.seed);
+
+        detail::CentroidTable table = detail::seedKMeansPlusPlus(data, numClusters, numThreads, generator);
+        const double tolerance = static_cast<double>(options.tolerance) * detail::meanFeatureVariance(data);
+
+        // Hamerly bounds the distance of each row to its own centroid from above and to the nearest other
+        // centroid from below; Elkan bounds the distance to every centroid from below
+        const bool hamerly = (options.algorithm == Hamerly);
+        const bool elkan = (options.algorithm == Elkan);
+        std::vector<size_t> assignments(numRows, 0);
+        std::vector<double> upper((hamerly || elkan) ? numRows : 0);
+        std::vector<double> lower(hamerly ? numRows : (elkan ? numRows * numClusters : 0));
+        std::vector<double> movement(numClusters, 0.0);
+        std::vector<double> gaps;                          // Distances between centroids
+        std::vector<double> halfNearest(numClusters, 0.0); // Half the distance of each centroid to its nearest other centroid
+
+        std::vector<size_t> clusterSizes(numClusters, 0);
+        size_t iteration = 0;
+        while (iteration < options.maxIterations)
+        {
+            ScopedTimer timer("KMeans::iteration");
+            const bool fullPass = (iteration == 0 || options.algorithm == Lloyd);
+
+            // Largest and second largest centroid movement, the lower bound of Hamerly shrinks by the largest
+            // movement of any centroid other than the row's own
+            size_t farthestMover = 0;
+            double largestMove = 0.0, secondLargestMove = 0.0;
+            if (!fullPass)
+            {
+                for (size_t c = 0; c < numClusters; ++c)
+                {
+                    if (movement[c] > largestMove)
+                    {
+                        secondLargestMove = largestMove;
+                        largestMove = movement[c];
+                        farthestMover = c;
+                    }
+                    else
+                    {
+                        secondLargestMove = std::max(secondLargestMove, movement[c]);
+                    }
+                }
+
+                gaps = detail::centroidDistances(table);
+                for (size_t c = 0; c < numClusters; ++c)
+                {
+                    double nearest = std::numeric_limits<double>::infinity();
+                    for (size_t b = 0; b < numClusters; ++b)
+                    {
+                        if (b != c)
+                            nearest = std::min(nearest, gaps[c * numClusters + b]);
+                    }
+                    halfNearest[c] = 0.5 * nearest;
+                }
+            }
+
+            std::vector<detail::ClusterSums> threadSums(numThreads, detail::ClusterSums(numClusters, numFeatures));
+            detail::parallelFor(numRows, numThreads, [&](size_t begin, size_t end, size_t threadIndex)
+                                {
+                                    detail::ClusterSums &local = threadSums[threadIndex];
+                                    uint64_t numDistances = 0;
+
+                                    if (fullPass)
+                                    {
+                                        detail::forEachRowDistances(data, begin, end, table, [&](size_t i, const double *distances)
+                                                                    {
+                                                                        const size_t best = std::min_element(distances, distances + numClusters) - distances;
+                                                                        if (iteration > 0 && best != assignments[i])
+                                                                            ++local.changed;
+                                                                        assignments[i] = best;
+                                                                        local.inertia += distances[best];
+
+                                                                        if (hamerly || elkan)
+                                                                            upper[i] = std::sqrt(distances[best]);
+                                                                        if (hamerly)
+                                                                        {
+                                                                            double second = std::numeric_limits<double>::infinity();
+                                                                            for (size_t c = 0; c < numClusters; ++c)
+                                                                            {
+                                                                                if (c != best)
+                                                                                    second = std::min(second, distances[c]);
+                                                                            }
+                                                                            lower[i] = std::sqrt(second);
+                                                                        }
+                                                                        if (elkan)
+                                                                        {
+                                                                            for (size_t c = 0; c < numClusters; ++c)
+                                                                            {
+                                                                                lower[i * numClusters + c] = std::sqrt(distances[c]);
+                                                                            }
+                                                                        }
+                                                                        local.add(data.row(i), best);
+                                                                    });
+                                    }
+                                    else
+                                    {
+                                        for (size_t i = begin; i < end; ++i)
+                                        {
+                                            const std::span<const T> row = data.row(i);
+                                            size_t cluster = assignments[i];
+                                            upper[i] += movement[cluster];
+
+                                            if (hamerly)
+                                            {
+                                                lower[i] -= (cluster == farthestMover) ? secondLargestMove : largestMove;
+                                                const double bound = std::max(halfNearest[cluster], lower[i]);
+                                                if (upper[i] > bound)
+                                                {
+                                                    upper[i] = std::sqrt(detail::squaredDistance(row, table.centroid(cluster)));
+                                                    ++numDistances;
+                                                    if (upper[i] > bound)
+                                                    {
+                                                        // The bounds could not rule out another centroid: find the nearest two
+                                                        double best = std::numeric_limits<double>::infinity(), second = best;
+                                                        for (size_t c = 0; c < numClusters; ++c)
+                                                        {
+                                                            const double distance = (c == assignments[i]) ? upper[i] * upper[i] : detail::squaredDistance(row, table.centroid(c));
+                                                            if (distance < best)
+                                                            {
+                                                                second = best;
+                                                                best = distance;
+                                                                cluster = c;
+                                                            }
+                                                            else
+                                                            {
+                                                                second = std::min(second, distance);
+                                                            }
+                                                        }
+                                                        numDistances += numClusters - 1;
+                                                        upper[i] = std::sqrt(best);
+                                                        lower[i] = std::sqrt(second);
+                                                    }
+                                                }
+                                            }
+                                            else
+                                            {
+                                                double *rowLower = lower.data() + i * numClusters;
+                                                for (size_t c = 0; c < numClusters; ++c)
+                                                {
+                                                    rowLower[c] = std::max(0.0, rowLower[c] - movement[c]);
+                                                }
+
+                                                if (upper[i] > halfNearest[cluster])
+                                                {
+                                                    bool tight = false;
+                                                    for (size_t c = 0; c < numClusters; ++c)
+                                                    {
+                                                        if (c == cluster || upper[i] <= rowLower[c] || upper[i] <= 0.5 * gaps[cluster * numClusters + c])
+                                                            continue;
+
+                                                        if (!tight)
+                                                        {
+                                                            upper[i] = std::sqrt(detail::squaredDistance(row, table.centroid(cluster)));
+                                                            rowLower[cluster] = upper[i];
+                                                            ++numDistances;
+                                                            tight = true;
+                                                            if (upper[i] <= rowLower[c] || upper[i] <= 0.5 * gaps[cluster * numClusters + c])
+                                                                continue;
+                                                        }
+
+                                                        const double distance = std::sqrt(detail::squaredDistance(row, table.centroid(c)));
+                                                        rowLower[c] = distance;
+                                                        ++numDistances;
+                                                        if (distance < upper[i])
+                                                        {
+                                                            cluster = c;
+                                                            upper[i] = distance;
+                                                        }
+                                                    }
+                                                }
+                                            }
+
+                                            if (cluster != assignments[i])
+                                            {
+                                                ++local.changed;
+                                                assignments[i] = cluster;
+                                            }
+
+                                            // The bounds skip the exact loss, so it is only summed when someone is watching
+                                            if (monitor.active())
+                                                local.inertia += detail::squaredDistance(row, table.centroid(cluster));
+                                            local.add(row, cluster);
+                                        }
+                                        Instrumentation::count("KMeans::distances", numDistances);
+                                    } });
+
+            const detail::ClusterSums &total = detail::reduceClusterSums(threadSums);
+            movement = detail::moveCentroids(table, total);
+            clusterSizes = total.counts;
+            ++iteration;
+
+            double squaredMovement = 0.0;
+            for (const double move : movement)
+            {
+                squaredMovement += move * move;
+            }
+
+            if (monitor.active())
+                monitor.reportMean(total.inertia / numRows, std::sqrt(squaredMovement), numRows);
+
+            if (squaredMovement <= tolerance)
+                break;
+        }
+
+        KMeansModel model(std::vector<long double>(table.centroids.begin(), table.centroids.end()), numFeatures);
+        model.setClusterCounts(std::vector<long double>(clusterSizes.begin(), clusterSizes.end()));
+        model.setIterations(iteration);
+        model.setInertia(model.evaluate(data, numThreads));
+        return model;
+    }
+
+    template <typename T>
+    KMeansModel KMeans(const std::vector<std::vector<T>> &xValues, const KMeansOptions &options, const TrainingCallback &callback)
+    {
+        assert(!xValues.empty());
+        const size_t numFeatures = xValues[0].size();
+        std::vector<T> rowMajor;
+        rowMajor.reserve(xValues.size() * numFeatures);
+        for (const auto &row : xValues)
+        {
+            assert(row.size() == numFeatures);
+            rowMajor.insert(rowMajor.end(), row.begin(), row.end());
+        }
+        return KMeans(DatasetView<T>(rowMajor.data(), nullptr, xValues.size(), numFeatures), options, callback);
+    }
+
+    template <typename T>
+    KMeansModel MiniBatchKMeans(const DatasetView<T> &data, const KMeansOptions &options, const TrainingCallback &callback)
+    {
+        assert(options.numClusters > 0 && data.size() >= options.numClusters && options.batchSize > 0);
+        const size_t numThreads = detail::resolveThreadCount(options.numThreads);
+        detail::TrainingMonitor monitor(callback);
+        std::mt19937 generator(options.seed);
+
+        // Seed on a sample of three batches; seeding on every row would cost more than the training itself
+        const DatasetView<T> sample = data.shuffled(options.seed).rows(0, std::min(data.size(), std::max(options.numClusters, 3 * options.batchSize)));
+        detail::CentroidTable table = detail::seedKMeansPlusPlus(sample, options.numClusters, numThreads, generator);
+        const double tolerance = static_cast<double>(options.tolerance) * detail::meanFeatureVariance(sample);
+
+        std::vector<long double> clusterCounts(options.numClusters, 0.0L);
+        DatasetView<T> epoch;
+        size_t position = data.size();
+        size_t numEpochs = 0;
+        size_t iteration = 0;
+        while (iteration < options.maxIterations)
+        {
+            ScopedTimer timer("MiniBatchKMeans::batch");
+            if (position >= data.size())
+            {
+                epoch = data.shuffled(options.seed + static_cast<unsigned int>(++numEpochs));
+                position = 0;
+            }
+            const DatasetView<T> batch = epoch.rows(position, std::min(data.size(), position + options.batchSize));
+            position += batch.size();
+
+            double batchInertia = 0.0;
+            const double squaredMovement = detail::miniBatchStep(batch, table, clusterCounts, numThreads, batchInertia);
+            ++iteration;
+
+            if (monitor.active())
+                monitor.reportMean(batchInertia / batch.size(), std::sqrt(squaredMovement), batch.size());
+
+            if (squaredMovement <= tolerance)
+                break;
+        }
+
+        KMeansModel model(std::vector<long double>(table.centroids.begin(), table.centroids.end()), data.getNumFeatures());
+        model.setClusterCounts(clusterCounts);
+        model.setIterations(iteration);
+        model.setInertia(model.evaluate(data, numThreads));
+        return model;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template void KMeansModel::partialFit(const DatasetView<int8_t> &data, const KMeansOptions &options);
+    template void KMeansModel::partialFit(const DatasetView<int16_t> &data, const KMeansOptions &options);
+    template void KMeansModel::partialFit(const DatasetView<int32_t> &data, const KMeansOptions &options);
+    template void KMeansModel::partialFit(const DatasetView<int64_t> &data, const KMeansOptions &options);
+
+    template void KMeansModel::partialFit(const DatasetView<uint8_t> &data, const KMeansOptions &options);
+    template void KMeansModel::partialFit(const DatasetView<uint16_t> &data, const KMeansOptions &options);
+    template void KMeansModel::partialFit(const DatasetView<uint32_t> &data, const KMeansOptions &options);
+    template void KMeansModel::partialFit(const DatasetView<uint64_t> &data, const KMeansOptions &options);
+
+    template void KMeansModel::partialFit(const DatasetView<float> &data, const KMeansOptions &options);
+    template void KMeansModel::partialFit(const DatasetView<double> &data, const KMeansOptions &options);
+    template void KMeansModel::partialFit(const DatasetView<long double> &data, const KMeansOptions &options);
+
+    template size_t KMeansModel::predict(std::span<const int8_t> xRow) const;
+    template size_t KMeansModel::predict(std::span<const int16_t> xRow) const;
+    template size_t KMeansModel::predict(std::span<const int32_t> xRow) const;
+    template size_t KMeansModel::predict(std::span<const int64_t> xRow) const;
+
+    template size_t KMeansModel::predict(std::span<const uint8_t> xRow) const;
+    template size_t KMeansModel::predict(std::span<const uint16_t> xRow) const;
+    template size_t KMeansModel::predict(std::span<const uint32_t> xRow) const;
+    template size_t KMeansModel::predict(std::span<const uint64_t> xRow) const;
+
+    template size_t KMeansModel::predict(std::span<const float> xRow) const;
+    template size_t KMeansModel::predict(std::span<const double> xRow) const;
+    template size_t KMeansModel::predict(std::span<const long double> xRow) const;
+
+    template std::vector<size_t> KMeansModel::predict(const std::vector<std::vector<int8_t>> &xValues, size_t numThreads) const;
+    template std::vector<size_t> KMeansModel::predict(const std::vector<std::vector<int16_t>> &xValues, size_t numThreads) const;
+    template std::vector<size_t> KMeansModel::predict(const std::vector<std::vector<int32_t>> &xValues, size_t numThreads) const;
+    template std::vector<size_t> KMeansModel::predict(const std::vector<std::vector<int64_t>> &xValues, size_t numThreads) const;
+
+    template std::vector<size_t> KMeansModel::predict(const std::vector<std::vector<uint8_t>> &xValues, size_t numThreads) const;
+    template std::vector<size_t> KMeansModel::predict(const std::vector<std::vector<uint16_t>> &xValues, size_t numThreads) const;
+    template std::vector<size_t> KMeansModel::predict(const std::vector<std::vector<uint32_t>> &xValues, size_t numThreads) const;
+    template std::vector<size_t> KMeansModel::predict(const std::vector<std::vector<uint64_t>> &xValues, size_t numThreads) const;
+
+    template std::vector<size_t> KMeansModel::predict(const std::vector<std::vector<float>> &xValues, size_t numThreads) const;
+    template std::vector<size_t> KMeansModel::predict(const std::vector<std::vector<double>> &xValues, size_t numThreads) const;
+    template std::vector<size_t> KMeansModel::predict(const std::vector<std::vector<long double>> &xValues, size_t numThreads) const;
+
+    template std::vector<size_t> KMeansModel::predict(const DatasetView<int8_t> &data, size_t numThreads) const;
+    template std::vector<size_t> KMeansModel::predict(const DatasetView<int16_t> &data, size_t numThreads) const;
+    template std::vector<size_t> KMeansModel::predict(const DatasetView<int32_t> &data, size_t numThreads) const;
+    template std::vector<size_t> KMeansModel::predict(const DatasetView<int64_t> &data, size_t numThreads) const;
+
+    template std::vector<size_t> KMeansModel::predict(const DatasetView<uint8_t> &data, size_t numThreads) const;
+    template std::vector<size_t> KMeansModel::predict(const DatasetView<uint16_t> &data, size_t numThreads) const;
+    template std::vector<size_t> KMeansModel::predict(const DatasetView<uint32_t> &data, size_t numThreads) const;
+    template std::vector<size_t> KMeansModel::predict(const DatasetView<uint64_t> &data, size_t numThreads) const;
+
+    template std::vector<size_t> KMeansModel::predict(const DatasetView<float> &data, size_t numThreads) const;
+    template std::vector<size_t> KMeansModel::predict(const DatasetView<double> &data, size_t numThreads) const;
+    template std::vector<size_t> KMeansModel::predict(const DatasetView<long double> &data, size_t numThreads) const;
+
+    template long double KMeansModel::evaluate(const DatasetView<int8_t> &data, size_t numThreads) const;
+    template long double KMeansModel::evaluate(const DatasetView<int16_t> &data, size_t numThreads) const;
+    template long double KMeansModel::evaluate(const DatasetView<int32_t> &data, size_t numThreads) const;
+    template long double KMeansModel::evaluate(const DatasetView<int64_t> &data, size_t numThreads) const;
+
+    template long double KMeansModel::evaluate(const DatasetView<uint8_t> &data, size_t numThreads) const;
+    template long double KMeansModel::evaluate(const DatasetView<uint16_t> &data, size_t numThreads) const;
+    template long double KMeansModel::evaluate(const DatasetView<uint32_t> &data, size_t numThreads) const;
+    template long double KMeansModel::evaluate(const DatasetView<uint64_t> &data, size_t numThreads) const;
+
+    template long double KMeansModel::evaluate(const DatasetView<float> &data, size_t numThreads) const;
+    template long double KMeansModel::evaluate(const DatasetView<double> &data, size_t numThreads) const;
+    template long double KMeansModel::evaluate(const DatasetView<long double> &data, size_t numThreads) const;
+
+    template KMeansModel KMeans(const DatasetView<int8_t> &data, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel KMeans(const DatasetView<int16_t> &data, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel KMeans(const DatasetView<int32_t> &data, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel KMeans(const DatasetView<int64_t> &data, const KMeansOptions &options, const TrainingCallback &callback);
+
+    template KMeansModel KMeans(const DatasetView<uint8_t> &data, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel KMeans(const DatasetView<uint16_t> &data, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel KMeans(const DatasetView<uint32_t> &data, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel KMeans(const DatasetView<uint64_t> &data, const KMeansOptions &options, const TrainingCallback &callback);
+
+    template KMeansModel KMeans(const DatasetView<float> &data, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel KMeans(const DatasetView<double> &data, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel KMeans(const DatasetView<long double> &data, const KMeansOptions &options, const TrainingCallback &callback);
+
+    template KMeansModel KMeans(const std::vector<std::vector<int8_t>> &xValues, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel KMeans(const std::vector<std::vector<int16_t>> &xValues, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel KMeans(const std::vector<std::vector<int32_t>> &xValues, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel KMeans(const std::vector<std::vector<int64_t>> &xValues, const KMeansOptions &options, const TrainingCallback &callback);
+
+    template KMeansModel KMeans(const std::vector<std::vector<uint8_t>> &xValues, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel KMeans(const std::vector<std::vector<uint16_t>> &xValues, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel KMeans(const std::vector<std::vector<uint32_t>> &xValues, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel KMeans(const std::vector<std::vector<uint64_t>> &xValues, const KMeansOptions &options, const TrainingCallback &callback);
+
+    template KMeansModel KMeans(const std::vector<std::vector<float>> &xValues, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel KMeans(const std::vector<std::vector<double>> &xValues, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel KMeans(const std::vector<std::vector<long double>> &xValues, const KMeansOptions &options, const TrainingCallback &callback);
+
+    template KMeansModel MiniBatchKMeans(const DatasetView<int8_t> &data, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel MiniBatchKMeans(const DatasetView<int16_t> &data, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel MiniBatchKMeans(const DatasetView<int32_t> &data, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel MiniBatchKMeans(const DatasetView<int64_t> &data, const KMeansOptions &options, const TrainingCallback &callback);
+
+    template KMeansModel MiniBatchKMeans(const DatasetView<uint8_t> &data, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel MiniBatchKMeans(const DatasetView<uint16_t> &data, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel MiniBatchKMeans(const DatasetView<uint32_t> &data, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel MiniBatchKMeans(const DatasetView<uint64_t> &data, const KMeansOptions &options, const TrainingCallback &callback);
+
+    template KMeansModel MiniBatchKMeans(const DatasetView<float> &data, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel MiniBatchKMeans(const DatasetView<double> &data, const KMeansOptions &options, const TrainingCallback &callback);
+    template KMeansModel MiniBatchKMeans(const DatasetView<long double> &data, const KMeansOptions &options, const TrainingCallback &callback);
+#endif
+
+    MLLIB_INLINE NeighborIndex::NeighborIndex() {}
+
+    template <typename T>
+    NeighborIndex::NeighborIndex(const DatasetView<T> &data, const NeighborIndexOptions &options)
+        : options(options), numFeatures(data.getNumFeatures())
+    {
+        assert(options.leafSize > 0 && numFeatures > 0);
+
+        std::vector<double> source(data.size() * numFeatures);
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            const std::span<const T> row = data.row(i);
+            std::copy(row.begin(), row.end(), source.begin() + i * numFeatures);
+        }
+
+        std::vector<size_t> order(data.size());
+        std::iota(order.begin(), order.end(), size_t(0));
+        if (!data.empty())
+            buildNode(source, order, 0, data.size());
+
+        // Store the points in tree order so each leaf bucket is contiguous
+        points.resize(source.size());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            std::copy_n(source.begin() + order[i] * numFeatures, numFeatures, points.begin() + i * numFeatures);
+        }
+        positions = std::move(order);
+    }
+
+    MLLIB_INLINE size_t NeighborIndex::buildNode(const std::vector<double> &source, std::vector<size_t> &order, size_t begin, size_t end)
+    {
+        const size_t node = nodes.size();
+        nodes.push_back(Node{begin, end, 0, 0.0});
+
+        // Range of every feature over the points of the node, which is the bounding box of the KD tree
+        std::vector<double> lower(numFeatures, std::numeric_limits<double>::infinity());
+        std::vector<double> upper(numFeatures, -std::numeric_limits<double>::infinity());
+        for (size_t i = begin; i < end; ++i)
+        {
+            const double *point = source.data() + order[i] * numFeatures;
+            for (size_t j = 0; j < numFeatures; ++j)
+            {
+                lower[j] = std::min(lower[j], point[j]);
+                upper[j] = std::max(upper[j], point[j]);
+            }
+        }
+
+        if (options.type == KDTree)
+        {
+            bounds.insert(bounds.end(), lower.begin(), lower.end());
+            bounds.insert(bounds.end(), upper.begin(), upper.end());
+        }
+        else
+        {
+            // The sphere is centred on the mean of the points and reaches the farthest of them
+            std::vector<double> centre(numFeatures, 0.0);
+            for (size_t i = begin; i < end; ++i)
+            {
+                const double *point = source.data() + order[i] * numFeatures;
+                for (size_t j = 0; j < numFeatures; ++j)
+                {
+                    centre[j] += point[j];
+                }
+            }
+            for (double &value : centre)
+            {
+                value /= static_cast<double>(end - begin);
+            }
+
+            nodes[node].radius = detail::dispatchMetric(options.metric, [&]<stat::NormType Metric>()
+                                                        {
+                                                            double reduced = 0.0;
+                                                            for (size_t i = begin; i < end; ++i)
+                                                            {
+                                                                reduced = std::max(reduced, detail::reducedDistance<Metric>(source.data() + order[i] * numFeatures, centre.data(), numFeatures));
+                                                            }
+                                                            return detail::fromReduced<Metric>(reduced); });
+            bounds.insert(bounds.end(), centre.begin(), centre.end());
+        }
+
+        // Split at the median of the feature with the largest spread, unless the node is small enough or all its points coincide
+        size_t splitFeature = 0;
+        for (size_t j = 1; j < numFeatures; ++j)
+        {
+            if (upper[j] - lower[j] > upper[splitFeature] - lower[splitFeature])
+                splitFeature = j;
+        }
+        if (end - begin <= options.leafSize || upper[splitFeature] == lower[splitFeature])
+            return node;
+
+        const size_t middle = begin + (end - begin) / 2;
+        std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end, [&](size_t a, size_t b)
+                         { return source[a * numFeatures + splitFeature] < source[b * numFeatures + splitFeature]; });
+
+        buildNode(source, order, begin, middle);
+        const size_t right = buildNode(source, order, middle, end);
+        nodes[node].right = right;
+        return node;
+    }
+
+    template <stat::NormType Metric>
+    double NeighborIndex::nodeBound(const double *query, size_t node) const
+    {
+        if (options.type == KDTree)
+        {
+            const double *lower = bounds.data() + node * 2 * numFeatures;
+            const double *upper = lower + numFeatures;
+            double reduced = 0.0;
+            for (size_t j = 0; j < numFeatures; ++j)
+            {
+                reduced = detail::accumulateReduced<Metric>(reduced, std::max({lower[j] - query[j], query[j] - upper[j], 0.0}));
+            }
+            return reduced;
+        }
+
+        const double distance = detail::fromReduced<Metric>(detail::reducedDistance<Metric>(query, bounds.data() + node * numFeatures, numFeatures));
+        return detail::toReduced<Metric>(std::max(0.0, distance - nodes[node].radius));
+    }
+
+    namespace detail
+    {
+        // Orders a heap of neighbours with the farthest on top
+        MLLIB_INLINE bool nearerNeighbor(const Neighbor &a, const Neighbor &b)
+        {
+            return a.distance < b.distance;
+        }
+    }
+
+    template <stat::NormType Metric>
+    void NeighborIndex::searchNearest(const double *query, size_t node, size_t k, std::vector<Neighbor> &heap, uint64_t &numDistances) const
+    {
+        const Node &current = nodes[node];
+        if (current.right == 0)
+        {
+            for (size_t i = current.begin; i < current.end; ++i)
+            {
+                const double reduced = detail::reducedDistance<Metric>(query, points.data() + i * numFeatures, numFeatures);
+                if (heap.size() < k)
+                {
+                    heap.push_back(Neighbor{i, reduced});
+                    std::push_heap(heap.begin(), heap.end(), detail::nearerNeighbor);
+                }
+                else if (reduced < heap.front().distance)
+                {
+                    std::pop_heap(heap.begin(), heap.end(), detail::nearerNeighbor);
+                    heap.back() = Neighbor{i, reduced};
+                    std::push_heap(heap.begin(), heap.end(), detail::nearerNeighbor);
+                }
+            }
+            numDistances += current.end - current.begin;
+            return;
+        }
+
+        // Descend into the nearer child first, so the farther one is more likely to be pruned
+        size_t first = node + 1, second = current.right;
+        double firstBound = nodeBound<Metric>(query, first), secondBound = nodeBound<Metric>(query, second);
+        if (secondBound < firstBound)
+        {
+            std::swap(first, second);
+            std::swap(firstBound, secondBound);
+        }
+
+        if (heap.size() < k || firstBound < heap.front().distance)
+            searchNearest<Metric>(query, first, k, heap, numDistances);
+        if (heap.size() < k || secondBound < heap.front().distance)
+            searchNearest<Metric>(query, second, k, heap, numDistances);
+    }
+
+    template <stat::NormType Metric>
+    void NeighborIndex::searchRadius(const double *query, size_t node, double reducedRadius, std::vector<Neighbor> &result, uint64_t &numDistances) const
+    {
+        const Node &current = nodes[node];
+        if (current.right == 0)
+        {
+            for (size_t i = current.begin; i < current.end; ++i)
+            {
+                const double reduced = detail::reducedDistance<Metric>(query, points.data() + i * numFeatures, numFeatures);
+                if (reduced <= reducedRadius)
+                    result.push_back(Neighbor{i, reduced});
+            }
+            numDistances += current.end - current.begin;
+            return;
+        }
+
+        if (nodeBound<Metric>(query, node + 1) <= reducedRadius)
+            searchRadius<Metric>(query, node + 1, reducedRadius, result, numDistances);
+        if (nodeBound<Metric>(query, current.right) <= reducedRadius)
+            searchRadius<Metric>(query, current.right, reducedRadius, result, numDistances);
+    }
+
+    MLLIB_INLINE std::vector<Neighbor> NeighborIndex::nearest(const double *query, size_t k) const
+    {
+        std::vector<Neighbor> neighbors;
+        if (nodes.empty() || k == 0)
+            return neighbors;
+
+        neighbors.reserve(std::min(k, size()));
+        uint64_t numDistances = 0;
+        detail::dispatchMetric(options.metric, [&]<stat::NormType Metric>()
+                               {
+                                   searchNearest<Metric>(query, 0, k, neighbors, numDistances);
+                                   std::sort_heap(neighbors.begin(), neighbors.end(), detail::nearerNeighbor);
+                                   for (Neighbor &neighbor : neighbors)
+                                   {
+                                       neighbor.index = positions[neighbor.index];
+                                       neighbor.distance = detail::fromReduced<Metric>(static_cast<double>(neighbor.distance));
+                                   } });
+        Instrumentation::count("NeighborIndex::distances", numDistances);
+        return neighbors;
+    }
+
+    MLLIB_INLINE std::vector<Neighbor> NeighborIndex::withinRadius(const double *query, long double radius) const
+    {
+        std::vector<Neighbor> neighbors;
+        if (nodes.empty() || radius < 0.0L)
+            return neighbors;
+
+        uint64_t numDistances = 0;
+        detail::dispatchMetric(options.metric, [&]<stat::NormType Metric>()
+                               {
+                                   searchRadius<Metric>(query, 0, detail::toReduced<Metric>(static_cast<double>(radius)), neighbors, numDistances);
+                                   std::sort(neighbors.begin(), neighbors.end(), detail::nearerNeighbor);
+                                   for (Neighbor &neighbor : neighbors)
+                                   {
+                                       neighbor.index = positions[neighbor.index];
+                                       neighbor.distance = detail::fromReduced<Metric>(static_cast<double>(neighbor.distance));
+                                   } });
+        Instrumentation::count("NeighborIndex::distances", numDistances);
+        return neighbors;
+    }
+
+    template <typename T>
+    std::vector<Neighbor> NeighborIndex::query(std::span<const T> point, size_t k) const
+    {
+        assert(point.size() == numFeatures);
+        const std::vector<double> converted(point.begin(), point.end());
+        return nearest(converted.data(), k);
+    }
+
+    template <typename T>
+    std::vector<Neighbor> NeighborIndex::queryRadius(std::span<const T> point, long double radius) const
+    {
+        assert(point.size() == numFeatures);
+        const std::vector<double> converted(point.begin(), point.end());
+        return withinRadius(converted.data(), radius);
+    }
+
+    template <typename T>
+    std::vector<std::vector<Neighbor>> NeighborIndex::query(const DatasetView<T> &queries, size_t k, size_t numThreads) const
+    {
+        assert(queries.getNumFeatures() == numFeatures);
+        std::vector<std::vector<Neighbor>> results(queries.size());
+        detail::parallelFor(queries.size(), detail::resolveThreadCount(numThreads), [&](size_t begin, size_t end, size_t)
+                            {
+                                std::vector<double> converted(numFeatures);
+                                for (size_t i = begin; i < end; ++i)
+                                {
+                                    const std::span<const T> row = queries.row(i);
+                                    std::copy(row.begin(), row.end(), converted.begin());
+                                    results[i] = nearest(converted.data(), k);
+                                } });
+        return results;
+    }
+
+    template <typename T>
+    std::vector<std::vector<Neighbor>> NeighborIndex::queryRadius(const DatasetView<T> &queries, long double radius, size_t numThreads) const
+    {
+        assert(queries.getNumFeatures() == numFeatures);
+        std::vector<std::vector<Neighbor>> results(queries.size());
+        detail::parallelFor(queries.size(), detail::resolveThreadCount(numThreads), [&](size_t begin, size_t end, size_t)
+                            {
+                                std::vector<double> converted(numFeatures);
+                                for (size_t i = begin; i < end; ++i)
+                                {
+                                    const std::span<const T> row = queries.row(i);
+                                    std::copy(row.begin(), row.end(), converted.begin());
+                                    results[i] = withinRadius(converted.data(), radius);
+                                } });
+        return results;
+    }
+
+    MLLIB_INLINE KNNClassifier::KNNClassifier() {}
+
+    template <typename T>
+    KNNClassifier::KNNClassifier(const DatasetView<T> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options)
+        : index(data, options), labels(data.size()), numNeighbors(numNeighbors), distanceWeighted(distanceWeighted)
+    {
+        assert(numNeighbors > 0);
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            labels[i] = static_cast<int>(std::lround(static_cast<long double>(data.label(i))));
+        }
+    }
+
+    MLLIB_INLINE int KNNClassifier::vote(const std::vector<Neighbor> &neighbors) const
+    {
+        assert(!neighbors.empty());
+
+        // With inverse distance weights, neighbours at distance zero outvote all others
+        const bool exactMatch = distanceWeighted && neighbors.front().distance == 0.0L;
+
+        // Classes are listed in the order of their nearest neighbour, so the first maximum wins ties
+        std::vector<std::pair<int, long double>> votes;
+        for (const Neighbor &neighbor : neighbors)
+        {
+            if (exactMatch && neighbor.distance > 0.0L)
+                break;
+
+            const long double weight = (distanceWeighted && !exactMatch) ? 1.0L / neighbor.distance : 1.0L;
+            const int label = labels[neighbor.index];
+            auto existing = std::find_if(votes.begin(), votes.end(), [label](const auto &entry)
+                                         { return entry.first == label; });
+            if (existing == votes.end())
+                votes.emplace_back(label, weight);
+            else
+                existing->second += weight;
+        }
+
+        return std::max_element(votes.begin(), votes.end(), [](const auto &a, const auto &b)
+                                { return a.second < b.second; })
+            ->first;
+    }
+
+    template <typename T>
+    int KNNClassifier::predict(std::span<const T> xRow) const
+    {
+        return vote(index.query(xRow, numNeighbors));
+    }
+
+    template <typename T>
+    std::vector<int> KNNClassifier::predict(const DatasetView<T> &data, size_t numThreads) const
+    {
+        const std::vector<std::vector<Neighbor>> neighbors = index.query(data, numNeighbors, numThreads);
+        std::vector<int> predictions(neighbors.size());
+        for (size_t i = 0; i < neighbors.size(); ++i)
+        {
+            predictions[i] = vote(neighbors[i]);
+        }
+        return predictions;
+    }
+
+    MLLIB_INLINE KNNRegressor::KNNRegressor() {}
+
+    template <typename T>
+    KNNRegressor::KNNRegressor(const DatasetView<T> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options)
+        : index(data, options), targets(data.size()), numNeighbors(numNeighbors), distanceWeighted(distanceWeighted)
+    {
+        assert(numNeighbors > 0);
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            targets[i] = static_cast<long double>(data.label(i));
+        }
+    }
+
+    MLLIB_INLINE long double KNNRegressor::average(const std::vector<Neighbor> &neighbors) const
+    {
+        assert(!neighbors.empty());
+
+        // With inverse distance weights, neighbours at distance zero are averaged on their own
+        const bool exactMatch = distanceWeighted && neighbors.front().distance == 0.0L;
+
+        long double weightedSum = 0.0L, totalWeight = 0.0L;
+        for (const Neighbor &neighbor : neighbors)
+        {
+            if (exactMatch && neighbor.distance > 0.0L)
+                break;
+
+            const long double weight = (distanceWeighted && !exactMatch) ? 1.0L / neighbor.distance : 1.0L;
+            weightedSum += weight * targets[neighbor.index];
+            totalWeight += weight;
+        }
+        return weightedSum / totalWeight;
+    }
+
+    template <typename T>
+    long double KNNRegressor::predict(std::span<const T> xRow) const
+    {
+        return average(index.query(xRow, numNeighbors));
+    }
+
+    template <typename T>
+    std::vector<long double> KNNRegressor::predict(const DatasetView<T> &data, size_t numThreads) const
+    {
+        const std::vector<std::vector<Neighbor>> neighbors = index.query(data, numNeighbors, numThreads);
+        std::vector<long double> predictions(neighbors.size());
+        for (size_t i = 0; i < neighbors.size(); ++i)
+        {
+            predictions[i] = average(neighbors[i]);
+        }
+        return predictions;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template NeighborIndex::NeighborIndex(const DatasetView<int8_t> &data, const NeighborIndexOptions &options);
+    template NeighborIndex::NeighborIndex(const DatasetView<int16_t> &data, const NeighborIndexOptions &options);
+    template NeighborIndex::NeighborIndex(const DatasetView<int32_t> &data, const NeighborIndexOptions &options);
+    template NeighborIndex::NeighborIndex(const DatasetView<int64_t> &data, const NeighborIndexOptions &options);
+
+    template NeighborIndex::NeighborIndex(const DatasetView<uint8_t> &data, const NeighborIndexOptions &options);
+    template NeighborIndex::NeighborIndex(const DatasetView<uint16_t> &data, const NeighborIndexOptions &options);
+    template NeighborIndex::NeighborIndex(const DatasetView<uint32_t> &data, const NeighborIndexOptions &options);
+    template NeighborIndex::NeighborIndex(const DatasetView<uint64_t> &data, const NeighborIndexOptions &options);
+
+    template NeighborIndex::NeighborIndex(const DatasetView<float> &data, const NeighborIndexOptions &options);
+    template NeighborIndex::NeighborIndex(const DatasetView<double> &data, const NeighborIndexOptions &options);
+    template NeighborIndex::NeighborIndex(const DatasetView<long double> &data, const NeighborIndexOptions &options);
+
+    template std::vector<Neighbor> NeighborIndex::query(std::span<const int8_t> point, size_t k) const;
+    template std::vector<Neighbor> NeighborIndex::query(std::span<const int16_t> point, size_t k) const;
+    template std::vector<Neighbor> NeighborIndex::query(std::span<const int32_t> point, size_t k) const;
+    template std::vector<Neighbor> NeighborIndex::query(std::span<const int64_t> point, size_t k) const;
+
+    template std::vector<Neighbor> NeighborIndex::query(std::span<const uint8_t> point, size_t k) const;
+    template std::vector<Neighbor> NeighborIndex::query(std::span<const uint16_t> point, size_t k) const;
+    template std::vector<Neighbor> NeighborIndex::query(std::span<const uint32_t> point, size_t k) const;
+    template std::vector<Neighbor> NeighborIndex::query(std::span<const uint64_t> point, size_t k) const;
+
+    template std::vector<Neighbor> NeighborIndex::query(std::span<const float> point, size_t k) const;
+    template std::vector<Neighbor> NeighborIndex::query(std::span<const double> point, size_t k) const;
+    template std::vector<Neighbor> NeighborIndex::query(std::span<const long double> point, size_t k) const;
+
+    template std::vector<Neighbor> NeighborIndex::queryRadius(std::span<const int8_t> point, long double radius) const;
+    template std::vector<Neighbor> NeighborIndex::queryRadius(std::span<const int16_t> point, long double radius) const;
+    template std::vector<Neighbor> NeighborIndex::queryRadius(std::span<const int32_t> point, long double radius) const;
+    template std::vector<Neighbor> NeighborIndex::queryRadius(std::span<const int64_t> point, long double radius) const;
+
+    template std::vector<Neighbor> NeighborIndex::queryRadius(std::span<const uint8_t> point, long double radius) const;
+    template std::vector<Neighbor> NeighborIndex::queryRadius(std::span<const uint16_t> point, long double radius) const;
+    template std::vector<Neighbor> NeighborIndex::queryRadius(std::span<const uint32_t> point, long double radius) const;
+    template std::vector<Neighbor> NeighborIndex::queryRadius(std::span<const uint64_t> point, long double radius) const;
+
+    template std::vector<Neighbor> NeighborIndex::queryRadius(std::span<const float> point, long double radius) const;
+    template std::vector<Neighbor> NeighborIndex::queryRadius(std::span<const double> point, long double radius) const;
+    template std::vector<Neighbor> NeighborIndex::queryRadius(std::span<const long double> point, long double radius) const;
+
+    template std::vector<std::vector<Neighbor>> NeighborIndex::query(const DatasetView<int8_t> &queries, size_t k, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> NeighborIndex::query(const DatasetView<int16_t> &queries, size_t k, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> NeighborIndex::query(const DatasetView<int32_t> &queries, size_t k, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> NeighborIndex::query(const DatasetView<int64_t> &queries, size_t k, size_t numThreads) const;
+
+    template std::vector<std::vector<Neighbor>> NeighborIndex::query(const DatasetView<uint8_t> &queries, size_t k, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> NeighborIndex::query(const DatasetView<uint16_t> &queries, size_t k, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> NeighborIndex::query(const DatasetView<uint32_t> &queries, size_t k, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> NeighborIndex::query(const DatasetView<uint64_t> &queries, size_t k, size_t numThreads) const;
+
+    template std::vector<std::vector<Neighbor>> NeighborIndex::query(const DatasetView<float> &queries, size_t k, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> NeighborIndex::query(const DatasetView<double> &queries, size_t k, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> NeighborIndex::query(const DatasetView<long double> &queries, size_t k, size_t numThreads) const;
+
+    template std::vector<std::vector<Neighbor>> NeighborIndex::queryRadius(const DatasetView<int8_t> &queries, long double radius, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> NeighborIndex::queryRadius(const DatasetView<int16_t> &queries, long double radius, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> NeighborIndex::queryRadius(const DatasetView<int32_t> &queries, long double radius, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> NeighborIndex::queryRadius(const DatasetView<int64_t> &queries, long double radius, size_t numThreads) const;
+
+    template std::vector<std::vector<Neighbor>> NeighborIndex::queryRadius(const DatasetView<uint8_t> &queries, long double radius, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> NeighborIndex::queryRadius(const DatasetView<uint16_t> &queries, long double radius, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> NeighborIndex::queryRadius(const DatasetView<uint32_t> &queries, long double radius, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> NeighborIndex::queryRadius(const DatasetView<uint64_t> &queries, long double radius, size_t numThreads) const;
+
+    template std::vector<std::vector<Neighbor>> NeighborIndex::queryRadius(const DatasetView<float> &queries, long double radius, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> NeighborIndex::queryRadius(const DatasetView<double> &queries, long double radius, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> NeighborIndex::queryRadius(const DatasetView<long double> &queries, long double radius, size_t numThreads) const;
+
+    template KNNClassifier::KNNClassifier(const DatasetView<int8_t> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+    template KNNClassifier::KNNClassifier(const DatasetView<int16_t> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+    template KNNClassifier::KNNClassifier(const DatasetView<int32_t> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+    template KNNClassifier::KNNClassifier(const DatasetView<int64_t> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+
+    template KNNClassifier::KNNClassifier(const DatasetView<uint8_t> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+    template KNNClassifier::KNNClassifier(const DatasetView<uint16_t> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+    template KNNClassifier::KNNClassifier(const DatasetView<uint32_t> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+    template KNNClassifier::KNNClassifier(const DatasetView<uint64_t> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+
+    template KNNClassifier::KNNClassifier(const DatasetView<float> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+    template KNNClassifier::KNNClassifier(const DatasetView<double> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+    template KNNClassifier::KNNClassifier(const DatasetView<long double> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+
+    template int KNNClassifier::predict(std::span<const int8_t> xRow) const;
+    template int KNNClassifier::predict(std::span<const int16_t> xRow) const;
+    template int KNNClassifier::predict(std::span<const int32_t> xRow) const;
+    template int KNNClassifier::predict(std::span<const int64_t> xRow) const;
+
+    template int KNNClassifier::predict(std::span<const uint8_t> xRow) const;
+    template int KNNClassifier::predict(std::span<const uint16_t> xRow) const;
+    template int KNNClassifier::predict(std::span<const uint32_t> xRow) const;
+    template int KNNClassifier::predict(std::span<const uint64_t> xRow) const;
+
+    template int KNNClassifier::predict(std::span<const float> xRow) const;
+    template int KNNClassifier::predict(std::span<const double> xRow) const;
+    template int KNNClassifier::predict(std::span<const long double> xRow) const;
+
+    template std::vector<int> KNNClassifier::predict(const DatasetView<int8_t> &data, size_t numThreads) const;
+    template std::vector<int> KNNClassifier::predict(const DatasetView<int16_t> &data, size_t numThreads) const;
+    template std::vector<int> KNNClassifier::predict(const DatasetView<int32_t> &data, size_t numThreads) const;
+    template std::vector<int> KNNClassifier::predict(const DatasetView<int64_t> &data, size_t numThreads) const;
+
+    template std::vector<int> KNNClassifier::predict(const DatasetView<uint8_t> &data, size_t numThreads) const;
+    template std::vector<int> KNNClassifier::predict(const DatasetView<uint16_t> &data, size_t numThreads) const;
+    template std::vector<int> KNNClassifier::predict(const DatasetView<uint32_t> &data, size_t numThreads) const;
+    template std::vector<int> KNNClassifier::predict(const DatasetView<uint64_t> &data, size_t numThreads) const;
+
+    template std::vector<int> KNNClassifier::predict(const DatasetView<float> &data, size_t numThreads) const;
+    template std::vector<int> KNNClassifier::predict(const DatasetView<double> &data, size_t numThreads) const;
+    template std::vector<int> KNNClassifier::predict(const DatasetView<long double> &data, size_t numThreads) const;
+
+    template KNNRegressor::KNNRegressor(const DatasetView<int8_t> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+    template KNNRegressor::KNNRegressor(const DatasetView<int16_t> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+    template KNNRegressor::KNNRegressor(const DatasetView<int32_t> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+    template KNNRegressor::KNNRegressor(const DatasetView<int64_t> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+
+    template KNNRegressor::KNNRegressor(const DatasetView<uint8_t> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+    template KNNRegressor::KNNRegressor(const DatasetView<uint16_t> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+    template KNNRegressor::KNNRegressor(const DatasetView<uint32_t> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+    template KNNRegressor::KNNRegressor(const DatasetView<uint64_t> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+
+    template KNNRegressor::KNNRegressor(const DatasetView<float> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+    template KNNRegressor::KNNRegressor(const DatasetView<double> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+    template KNNRegressor::KNNRegressor(const DatasetView<long double> &data, size_t numNeighbors, bool distanceWeighted, const NeighborIndexOptions &options);
+
+    template long double KNNRegressor::predict(std::span<const int8_t> xRow) const;
+    template long double KNNRegressor::predict(std::span<const int16_t> xRow) const;
+    template long double KNNRegressor::predict(std::span<const int32_t> xRow) const;
+    template long double KNNRegressor::predict(std::span<const int64_t> xRow) const;
+
+    template long double KNNRegressor::predict(std::span<const uint8_t> xRow) const;
+    template long double KNNRegressor::predict(std::span<const uint16_t> xRow) const;
+    template long double KNNRegressor::predict(std::span<const uint32_t> xRow) const;
+    template long double KNNRegressor::predict(std::span<const uint64_t> xRow) const;
+
+    template long double KNNRegressor::predict(std::span<const float> xRow) const;
+    template long double KNNRegressor::predict(std::span<const double> xRow) const;
+    template long double KNNRegressor::predict(std::span<const long double> xRow) const;
+
+    template std::vector<long double> KNNRegressor::predict(const DatasetView<int8_t> &data, size_t numThreads) const;
+    template std::vector<long double> KNNRegressor::predict(const DatasetView<int16_t> &data, size_t numThreads) const;
+    template std::vector<long double> KNNRegressor::predict(const DatasetView<int32_t> &data, size_t numThreads) const;
+    template std::vector<long double> KNNRegressor::predict(const DatasetView<int64_t> &data, size_t numThreads) const;
+
+    template std::vector<long double> KNNRegressor::predict(const DatasetView<uint8_t> &data, size_t numThreads) const;
+    template std::vector<long double> KNNRegressor::predict(const DatasetView<uint16_t> &data, size_t numThreads) const;
+    template std::vector<long double> KNNRegressor::predict(const DatasetView<uint32_t> &data, size_t numThreads) const;
+    template std::vector<long double> KNNRegressor::predict(const DatasetView<uint64_t> &data, size_t numThreads) const;
+
+    template std::vector<long double> KNNRegressor::predict(const DatasetView<float> &data, size_t numThreads) const;
+    template std::vector<long double> KNNRegressor::predict(const DatasetView<double> &data, size_t numThreads) const;
+    template std::vector<long double> KNNRegressor::predict(const DatasetView<long double> &data, size_t numThreads) const;
+#endif
+
+    MLLIB_INLINE void HNSWIndex::VisitedSet::reset(size_t numNodes)
+    {
+        if (marks.size() < numNodes)
+            marks.resize(numNodes, 0);
+        if (++epoch == 0)
+        {
+            std::fill(marks.begin(), marks.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    MLLIB_INLINE bool HNSWIndex::VisitedSet::insert(uint32_t node)
+    {
+        if (marks[node] == epoch)
+            return false;
+        marks[node] = epoch;
+        return true;
+    }
+
+    MLLIB_INLINE HNSWIndex::HNSWIndex() : HNSWIndex(0) {}
+
+    MLLIB_INLINE HNSWIndex::HNSWIndex(size_t numFeatures, const HNSWOptions &options)
+        : options(options), numFeatures(numFeatures), levelGenerator(options.seed), upperOffsets(1, 0),
+          nodeLocks(new std::mutex[numLockStripes]), entryLock(std::make_unique<std::mutex>())
+    {
+        assert(options.M >= 2 && options.efConstruction > 0);
+        bindStorage();
+    }
+
+    template <typename T>
+    HNSWIndex::HNSWIndex(const DatasetView<T> &data, const HNSWOptions &options)
+        : HNSWIndex(data.getNumFeatures(), options)
+    {
+        assert(numFeatures > 0);
+        addBatch(data);
+    }
+
+    MLLIB_INLINE void HNSWIndex::bindStorage()
+    {
+        vectorData = vectors.data();
+        baseLinkData = baseLinks.data();
+        levelData = levels.data();
+        upperOffsetData = upperOffsets.data();
+        upperLinkData = upperLinks.data();
+    }
+
+    // Copy the arrays of a mapped index into memory so nodes can be inserted
+    MLLIB_INLINE void HNSWIndex::detach()
+    {
+        if (!file.isOpen())
+            return;
+
+        vectors.assign(vectorData, vectorData + numNodes * numFeatures);
+        baseLinks.assign(baseLinkData, baseLinkData + numNodes * (1 + 2 * options.M));
+        levels.assign(levelData, levelData + numNodes);
+        upperOffsets.assign(upperOffsetData, upperOffsetData + numNodes + 1);
+        upperLinks.assign(upperLinkData, upperLinkData + upperOffsets.back());
+        file.close();
+        bindStorage();
+    }
+
+    // Grow the storage by count nodes with empty link lists and random levels. Returns the first new id.
+    MLLIB_INLINE size_t HNSWIndex::reserve(size_t count)
+    {
+        detach();
+        assert(numNodes + count <= std::numeric_limits<uint32_t>::max());
+
+        const size_t first = numNodes;
+        numNodes += count;
+        vectors.resize(numNodes * numFeatures);
+        baseLinks.resize(numNodes * (1 + 2 * options.M), 0);
+
+        // P(level >= l) = M^-l, so each layer holds about 1/M of the nodes of the layer below
+        const double levelScale = 1.0 / std::log(static_cast<double>(options.M));
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        for (size_t i = first; i < numNodes; ++i)
+        {
+            const double level = std::floor(-std::log(1.0 - uniform(levelGenerator)) * levelScale);
+            levels.push_back(static_cast<uint8_t>(std::min(level, 255.0)));
+            upperOffsets.push_back(upperOffsets.back() + levels.back() * (1 + options.M));
+        }
+        upperLinks.resize(upperOffsets.back(), 0);
+
+        bindStorage();
+        return first;
+    }
+
+    // Convert a vector to float, normalized to unit length for the cosine distance
+    template <typename T>
+    void HNSWIndex::storeVector(std::span<const T> point, float *destination) const
+    {
+        assert(point.size() == numFeatures);
+        std::transform(point.begin(), point.end(), destination, [](const T &value)
+                       { return static_cast<float>(value); });
+
+        if (options.metric == CosineDistance)
+        {
+            const float norm = std::sqrt(detail::dotProductFloat(destination, destination, numFeatures));
+            if (norm > 0.0f)
+            {
+                std::transform(destination, destination + numFeatures, destination, [norm](float value)
+                               { return value / norm; });
+            }
+        }
+    }
+
+    // Squared distance for L2, which orders nodes like the distance itself, and 1 - a.b for unit vectors
+    MLLIB_INLINE float HNSWIndex::distance(const float *a, const float *b) const
+    {
+        if (options.metric == CosineDistance)
+            return 1.0f - detail::dotProductFloat(a, b, numFeatures);
+        if (options.metric == ManhattanDistance)
+            return detail::manhattanDistanceFloat(a, b, numFeatures);
+        return detail::squaredDistanceFloat(a, b, numFeatures);
+    }
+
+    MLLIB_INLINE const uint32_t *HNSWIndex::linksAt(uint32_t node, size_t level) const
+    {
+        if (level == 0)
+            return baseLinkData + node * (1 + 2 * options.M);
+        return upperLinkData + upperOffsetData[node] + (level - 1) * (1 + options.M);
+    }
+
+    MLLIB_INLINE uint32_t *HNSWIndex::mutableLinksAt(uint32_t node, size_t level)
+    {
+        if (level == 0)
+            return baseLinks.data() + node * (1 + 2 * options.M);
+        return upperLinks.data() + upperOffsets[node] + (level - 1) * (1 + options.M);
+    }
+
+    // The links of a node on one layer. While inserting, they are copied under the node's lock because
+    // other threads may be rewriting them.
+    template <bool Locked>
+    std::span<const uint32_t> HNSWIndex::readLinks(uint32_t node, size_t level, std::vector<uint32_t> &buffer) const
+    {
+        const uint32_t *links = linksAt(node, level);
+        if constexpr (Locked)
+        {
+            std::lock_guard<std::mutex> lock(nodeLock(node));
+            buffer.assign(links + 1, links + 1 + links[0]);
+            return buffer;
+        }
+        else
+        {
+            return std::span<const uint32_t>(links + 1, links[0]);
+        }
+    }
+
+    // Walk from entry to the node closest to the query on layers topLevel down to bottomLevel + 1
+    template <bool Locked>
+    uint32_t HNSWIndex::greedyClosest(const float *query, uint32_t entry, int topLevel, int bottomLevel, uint64_t &numDistances) const
+    {
+        float entryDistance = distance(query, vectorAt(entry));
+        ++numDistances;
+
+        std::vector<uint32_t> buffer;
+        for (int level = topLevel; level > bottomLevel; --level)
+        {
+            bool moved = true;
+            while (moved)
+            {
+                moved = false;
+                for (const uint32_t neighbor : readLinks<Locked>(entry, level, buffer))
+                {
+                    const float neighborDistance = distance(query, vectorAt(neighbor));
+                    ++numDistances;
+                    if (neighborDistance < entryDistance)
+                    {
+                        entryDistance = neighborDistance;
+                        entry = neighbor;
+                        moved = true;
+                    }
+                }
+            }
+        }
+        return entry;
+    }
+
+    // Best-first search of one layer from entry, keeping the ef nearest nodes found. Returns them nearest first.
+    template <bool Locked>
+    std::vector<HNSWIndex::Candidate> HNSWIndex::searchLayer(const float *query, uint32_t entry, size_t ef, size_t level, VisitedSet &visited, uint64_t &numDistances) const
+    {
+        std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> frontier; // Nearest on top
+        std::priority_queue<Candidate> nearest;                                                   // Farthest on top
+
+        visited.reset(numNodes);
+        visited.insert(entry);
+        const float entryDistance = distance(query, vectorAt(entry));
+        ++numDistances;
+        frontier.emplace(entryDistance, entry);
+        nearest.emplace(entryDistance, entry);
+
+        std::vector<uint32_t> buffer;
+        while (!frontier.empty())
+        {
+            const Candidate current = frontier.top();
+            if (current.first > nearest.top().first && nearest.size() >= ef)
+                break;
+            frontier.pop();
+
+            const std::span<const uint32_t> links = readLinks<Locked>(current.second, level, buffer);
+            for (size_t i = 0; i < links.size(); ++i)
+            {
+#if defined(__GNUC__)
+                if (i + 1 < links.size())
+                    __builtin_prefetch(vectorAt(links[i + 1]));
+#endif
+                if (!visited.insert(links[i]))
+                    continue;
+
+                const float neighborDistance = distance(query, vectorAt(links[i]));
+                ++numDistances;
+                if (nearest.size() < ef || neighborDistance < nearest.top().first)
+                {
+                    frontier.emplace(neighborDistance, links[i]);
+                    nearest.emplace(neighborDistance, links[i]);
+                    if (nearest.size() > ef)
+                        nearest.pop();
+                }
+            }
+        }
+
+        std::vector<Candidate> result(nearest.size());
+        for (size_t i = result.size(); i-- > 0;)
+        {
+            result[i] = nearest.top();
+            nearest.pop();
+        }
+        return result;
+    }
+
+    // Keep at most maxCount of the candidates, nearest first, skipping any candidate that is closer to an
+    // already kept one than to the new node. This spreads the links in different directions, which keeps
+    // clustered data connected.
+    MLLIB_INLINE void HNSWIndex::selectNeighbors(std::vector<Candidate> &candidates, size_t maxCount, uint64_t &numDistances) const
+    {
+        if (candidates.size() <= maxCount)
+            return;
+
+        std::vector<Candidate> selected;
+        selected.reserve(maxCount);
+        for (const Candidate &candidate : candidates)
+        {
+            if (selected.size() == maxCount)
+                break;
+
+            bool diverse = true;
+            for (const Candidate &kept : selected)
+            {
+                ++numDistances;
+                if (distance(vectorAt(candidate.second), vectorAt(kept.second)) < candidate.first)
+                {
+                    diverse = false;
+                    break;
+                }
+            }
+            if (diverse)
+                selected.push_back(candidate);
+        }
+        candidates.swap(selected);
+    }
+
+    // Add a link from node to newNode, pruning the links of node with selectNeighbors once they are full
+    MLLIB_INLINE void HNSWIndex::linkBack(uint32_t node, uint32_t newNode, float newDistance, size_t level, uint64_t &numDistances)
+    {
+        std::lock_guard<std::mutex> lock(nodeLock(node));
+        uint32_t *links = mutableLinksAt(node, level);
+        const size_t capacity = maxLinks(level);
+        if (links[0] < capacity)
+        {
+            links[1 + links[0]++] = newNode;
+            return;
+        }
+
+        std::vector<Candidate> candidates;
+        candidates.reserve(capacity + 1);
+        candidates.emplace_back(newDistance, newNode);
+        for (size_t i = 1; i <= capacity; ++i)
+        {
+            candidates.emplace_back(distance(vectorAt(node), vectorAt(links[i])), links[i]);
+        }
+        numDistances += capacity;
+        std::sort(candidates.begin(), candidates.end());
+        selectNeighbors(candidates, capacity, numDistances);
+
+        links[0] = static_cast<uint32_t>(candidates.size());
+        for (size_t i = 0; i < candidates.size(); ++i)
+        {
+            links[1 + i] = candidates[i].second;
+        }
+    }
+
+    // Link a reserved node whose vector is stored into the graph; safe to call from several threads at once
+    MLLIB_INLINE void HNSWIndex::insert(uint32_t node, VisitedSet &visited)
+    {
+        const float *point = vectorAt(node);
+        const int level = levelData[node];
+
+        std::unique_lock<std::mutex> entryGuard(*entryLock);
+        const int topLevel = maxLevel;
+        if (topLevel < 0)
+        {
+            entryPoint = node;
+            maxLevel = level;
+            return;
+        }
+
+        // A node above the top layer becomes the new entry point, so it holds the lock until it is linked
+        uint32_t entry = entryPoint;
+        if (level <= topLevel)
+            entryGuard.unlock();
+
+        uint64_t numDistances = 0;
+        entry = greedyClosest<true>(point, entry, topLevel, level, numDistances);
+        for (int layer = std::min(level, topLevel); layer >= 0; --layer)
+        {
+            std::vector<Candidate> candidates = searchLayer<true>(point, entry, options.efConstruction, layer, visited, numDistances);
+            entry = candidates.front().second;
+            selectNeighbors(candidates, options.M, numDistances);
+
+            {
+                std::lock_guard<std::mutex> lock(nodeLock(node));
+                uint32_t *links = mutableLinksAt(node, layer);
+                links[0] = static_cast<uint32_t>(candidates.size());
+                for (size_t i = 0; i < candidates.size(); ++i)
+                {
+                    links[1 + i] = candidates[i].second;
+                }
+            }
+
+            for (const Candidate &candidate : candidates)
+            {
+                linkBack(candidate.second, node, candidate.first, layer, numDistances);
+            }
+        }
+
+        if (level > topLevel)
+        {
+            entryPoint = node;
+            maxLevel = level;
+        }
+        Instrumentation::count("HNSWIndex::distances", numDistances);
+    }
+
+    MLLIB_INLINE std::vector<Neighbor> HNSWIndex::search(const float *query, size_t k, size_t ef, VisitedSet &visited) const
+    {
+        if (numNodes == 0 || k == 0)
+            return std::vector<Neighbor>();
+
+        uint64_t numDistances = 0;
+        const uint32_t entry = greedyClosest<false>(query, entryPoint, maxLevel, 0, numDistances);
+        std::vector<Candidate> candidates = searchLayer<false>(query, entry, std::max(ef, k), 0, visited, numDistances);
+        Instrumentation::count("HNSWIndex::distances", numDistances);
+        return toNeighbors(candidates, k);
+    }
+
+    // The first k of candidates sorted nearest first, with the internal distances converted to the metric
+    MLLIB_INLINE std::vector<Neighbor> HNSWIndex::toNeighbors(std::vector<Candidate> &candidates, size_t k) const
+    {
+        std::vector<Neighbor> neighbors(std::min(k, candidates.size()));
+        for (size_t i = 0; i < neighbors.size(); ++i)
+        {
+            const float reduced = std::max(0.0f, candidates[i].first);
+            neighbors[i].index = candidates[i].second;
+            neighbors[i].distance = (options.metric == L2Distance) ? std::sqrt(static_cast<long double>(reduced)) : reduced;
+        }
+        return neighbors;
+    }
+
+    MLLIB_INLINE void HNSWIndex::setEfSearch(size_t efSearch) { options.efSearch = efSearch; }
+
+    template <typename T>
+    size_t HNSWIndex::add(std::span<const T> point)
+    {
+        const size_t node = reserve(1);
+        storeVector(point, vectors.data() + node * numFeatures);
+        insert(static_cast<uint32_t>(node), addVisited);
+        return node;
+    }
+
+    template <typename T>
+    void HNSWIndex::addBatch(const DatasetView<T> &data)
+    {
+        assert(data.getNumFeatures() == numFeatures);
+        if (data.empty())
+            return;
+
+        const size_t first = reserve(data.size());
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            storeVector(data.row(i), vectors.data() + (first + i) * numFeatures);
+        }
+
+        // Rows are handed out one at a time so the threads grow the graph in roughly insertion order
+        const size_t numThreads = detail::resolveThreadCount(options.numThreads);
+        std::atomic<size_t> nextRow{0};
+        detail::parallelFor(numThreads, numThreads, [&](size_t, size_t, size_t)
+                            {
+                                VisitedSet visited;
+                                for (size_t i = nextRow++; i < data.size(); i = nextRow++)
+                                {
+                                    insert(static_cast<uint32_t>(first + i), visited);
+                                } });
+    }
+
+    template <typename T>
+    std::vector<Neighbor> HNSWIndex::query(std::span<const T> point, size_t k, size_t efSearch) const
+    {
+        thread_local VisitedSet visited;
+        std::vector<float> converted(numFeatures);
+        storeVector(point, converted.data());
+        return search(converted.data(), k, (efSearch > 0) ? efSearch : options.efSearch, visited);
+    }
+
+    template <typename T>
+    std::vector<std::vector<Neighbor>> HNSWIndex::query(const DatasetView<T> &queries, size_t k, size_t efSearch, size_t numThreads) const
+    {
+        assert(queries.getNumFeatures() == numFeatures);
+        std::vector<std::vector<Neighbor>> results(queries.size());
+        detail::parallelFor(queries.size(), detail::resolveThreadCount(numThreads), [&](size_t begin, size_t end, size_t)
+                            {
+                                std::vector<float> converted(numFeatures);
+                                VisitedSet visited;
+                                for (size_t i = begin; i < end; ++i)
+                                {
+                                    storeVector(queries.row(i), converted.data());
+                                    results[i] = search(converted.data(), k, (efSearch > 0) ? efSearch : options.efSearch, visited);
+                                } });
+        return results;
+    }
+
+    template <typename T>
+    std::vector<Neighbor> HNSWIndex::exactQuery(std::span<const T> point, size_t k) const
+    {
+        std::vector<float> converted(numFeatures);
+        storeVector(point, converted.data());
+
+        std::vector<Candidate> candidates(numNodes);
+        for (size_t node = 0; node < numNodes; ++node)
+        {
+            candidates[node] = Candidate(distance(converted.data(), vectorAt(static_cast<uint32_t>(node))), static_cast<uint32_t>(node));
+        }
+        k = std::min(k, candidates.size());
+        std::partial_sort(candidates.begin(), candidates.begin() + k, candidates.end());
+        return toNeighbors(candidates, k);
+    }
+
+    template <typename T>
+    std::vector<std::vector<Neighbor>> HNSWIndex::exactQuery(const DatasetView<T> &queries, size_t k, size_t numThreads) const
+    {
+        assert(queries.getNumFeatures() == numFeatures);
+        std::vector<std::vector<Neighbor>> results(queries.size());
+        detail::parallelFor(queries.size(), detail::resolveThreadCount(numThreads), [&](size_t begin, size_t end, size_t)
+                            {
+                                for (size_t i = begin; i < end; ++i)
+                                {
+                                    results[i] = exactQuery(queries.row(i), k);
+                                } });
+        return results;
+    }
+
+    MLLIB_INLINE bool HNSWIndex::save(const std::string &filename) const
+    {
+        std::ofstream outFile(filename, std::ios::binary);
+        if (!outFile.is_open())
+        {
+            std::cerr << "Unable to open file for writing." << std::endl;
+            return false;
+        }
+
+        detail::HNSWFileHeader header = {};
+        std::memcpy(header.magic, "MLHN", 4);
+        header.version = detail::hnswFileVersion;
+        header.metric = options.metric;
+        header.maxLevel = maxLevel;
+        header.entryPoint = entryPoint;
+        header.M = static_cast<uint32_t>(options.M);
+        header.efConstruction = static_cast<uint32_t>(options.efConstruction);
+        header.efSearch = static_cast<uint32_t>(options.efSearch);
+        header.numNodes = numNodes;
+        header.numFeatures = numFeatures;
+        header.numUpperLinks = upperOffsetData[numNodes];
+        outFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        const std::array<uint64_t, 6> offsets = detail::hnswSectionOffsets(header);
+        const char *sections[5] = {reinterpret_cast<const char *>(vectorData), reinterpret_cast<const char *>(baseLinkData),
+                                   reinterpret_cast<const char *>(levelData), reinterpret_cast<const char *>(upperOffsetData),
+                                   reinterpret_cast<const char *>(upperLinkData)};
+        const size_t sectionSizes[5] = {numNodes * numFeatures * sizeof(float), numNodes * (1 + 2 * options.M) * sizeof(uint32_t),
+                                        numNodes, (numNodes + 1) * sizeof(uint64_t), header.numUpperLinks * sizeof(uint32_t)};
+        const char padding[64] = {};
+        for (size_t s = 0; s < 5; ++s)
+        {
+            outFile.write(sections[s], static_cast<std::streamsize>(sectionSizes[s]));
+            outFile.write(padding, static_cast<std::streamsize>(offsets[s + 1] - offsets[s] - sectionSizes[s]));
+        }
+        return outFile.good();
+    }
+
+    MLLIB_INLINE bool HNSWIndex::open(const std::string &filename)
+    {
+        MappedFile mapped;
+        if (!mapped.open(filename))
+        {
+            std::cerr << "Unable to open file for reading." << std::endl;
+            return false;
+        }
+
+        auto invalid = [](const char *reason)
+        {
+            std::cerr << "Invalid HNSW index file: " << reason << std::endl;
+            return false;
+        };
+
+        if (mapped.size() < sizeof(detail::HNSWFileHeader))
+            return invalid("file is truncated");
+
+        const auto *header = reinterpret_cast<const detail::HNSWFileHeader *>(mapped.data());
+        if (std::memcmp(header->magic, "MLHN", 4) != 0)
+            return invalid("bad magic number");
+        if (header->version != detail::hnswFileVersion)
+            return invalid("unsupported format version");
+        if (header->metric > ManhattanDistance || header->M < 2 || header->numFeatures == 0)
+            return invalid("bad index options");
+        // Bound the sizes by the file size first so the section offsets cannot overflow
+        const uint64_t bytesPerNode = mapped.size() / std::max<uint64_t>(1, header->numNodes);
+        if (header->numNodes > std::numeric_limits<uint32_t>::max() || header->numUpperLinks > mapped.size() / sizeof(uint32_t))
+            return invalid("file is truncated");
+        if (header->numNodes > 0 && (header->numFeatures > bytesPerNode / sizeof(float) || header->M > bytesPerNode / (2 * sizeof(uint32_t))))
+            return invalid("file is truncated");
+
+        const std::array<uint64_t, 6> offsets = detail::hnswSectionOffsets(*header);
+        if (offsets[5] != mapped.size())
+            return invalid("file is truncated");
+
+        const auto *fileUpperOffsets = reinterpret_cast<const uint64_t *>(mapped.data() + offsets[3]);
+        if (fileUpperOffsets[header->numNodes] != header->numUpperLinks)
+            return invalid("inconsistent link table");
+        if ((header->numNodes == 0) ? (header->maxLevel != -1) : (header->maxLevel < 0 || header->entryPoint >= header->numNodes))
+            return invalid("bad entry point");
+
+        // Searches follow links without bounds checks, so every level, offset, link count and link target
+        // is checked once here. This reads the link sections but not the vectors.
+        const auto *fileBaseLinks = reinterpret_cast<const uint32_t *>(mapped.data() + offsets[1]);
+        const auto *fileLevels = reinterpret_cast<const uint8_t *>(mapped.data() + offsets[2]);
+        const auto *fileUpperLinks = reinterpret_cast<const uint32_t *>(mapped.data() + offsets[4]);
+        auto validLinks = [&](const uint32_t *links, uint64_t maxCount)
+        {
+            if (links[0] > maxCount)
+                return false;
+            for (uint32_t l = 1; l <= links[0]; ++l)
+            {
+                if (links[l] >= header->numNodes)
+                    return false;
+            }
+            return true;
+        };
+        if (header->numNodes > 0 && (fileUpperOffsets[0] != 0 || fileLevels[header->entryPoint] != header->maxLevel))
+            return invalid("inconsistent link table");
+        for (uint64_t node = 0; node < header->numNodes; ++node)
+        {
+            const uint64_t level = fileLevels[node];
+            if (level > static_cast<uint64_t>(header->maxLevel))
+                return invalid("node level above the top layer");
+            if (fileUpperOffsets[node + 1] < fileUpperOffsets[node] || fileUpperOffsets[node + 1] - fileUpperOffsets[node] != level * (1 + header->M))
+                return invalid("inconsistent link table");
+            if (!validLinks(fileBaseLinks + node * (1 + 2 * static_cast<uint64_t>(header->M)), 2 * static_cast<uint64_t>(header->M)))
+                return invalid("bad layer 0 links");
+            for (uint64_t l = 0; l < level; ++l)
+            {
+                if (!validLinks(fileUpperLinks + fileUpperOffsets[node] + l * (1 + header->M), header->M))
+                    return invalid("bad upper layer links");
+            }
+        }
+
+        options.metric = static_cast<VectorMetric>(header->metric);
+        options.M = header->M;
+        options.efConstruction = header->efConstruction;
+        options.efSearch = header->efSearch;
+        numFeatures = header->numFeatures;
+        numNodes = header->numNodes;
+        maxLevel = header->maxLevel;
+        entryPoint = header->entryPoint;
+        levelGenerator.seed(options.seed + static_cast<unsigned int>(numNodes));
+
+        std::vector<float>().swap(vectors);
+        std::vector<uint32_t>().swap(baseLinks);
+        std::vector<uint8_t>().swap(levels);
+        std::vector<uint64_t>().swap(upperOffsets);
+        std::vector<uint32_t>().swap(upperLinks);
+
+        file = std::move(mapped);
+        vectorData = reinterpret_cast<const float *>(file.data() + offsets[0]);
+        baseLinkData = reinterpret_cast<const uint32_t *>(file.data() + offsets[1]);
+        levelData = reinterpret_cast<const uint8_t *>(file.data() + offsets[2]);
+        upperOffsetData = reinterpret_cast<const uint64_t *>(file.data() + offsets[3]);
+        upperLinkData = reinterpret_cast<const uint32_t *>(file.data() + offsets[4]);
+        return true;
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template HNSWIndex::HNSWIndex(const DatasetView<int8_t> &data, const HNSWOptions &options);
+    template HNSWIndex::HNSWIndex(const DatasetView<int16_t> &data, const HNSWOptions &options);
+    template HNSWIndex::HNSWIndex(const DatasetView<int32_t> &data, const HNSWOptions &options);
+    template HNSWIndex::HNSWIndex(const DatasetView<int64_t> &data, const HNSWOptions &options);
+
+    template HNSWIndex::HNSWIndex(const DatasetView<uint8_t> &data, const HNSWOptions &options);
+    template HNSWIndex::HNSWIndex(const DatasetView<uint16_t> &data, const HNSWOptions &options);
+    template HNSWIndex::HNSWIndex(const DatasetView<uint32_t> &data, const HNSWOptions &options);
+    template HNSWIndex::HNSWIndex(const DatasetView<uint64_t> &data, const HNSWOptions &options);
+
+    template HNSWIndex::HNSWIndex(const DatasetView<float> &data, const HNSWOptions &options);
+    template HNSWIndex::HNSWIndex(const DatasetView<double> &data, const HNSWOptions &options);
+    template HNSWIndex::HNSWIndex(const DatasetView<long double> &data, const HNSWOptions &options);
+
+    template size_t HNSWIndex::add(std::span<const int8_t> point);
+    template size_t HNSWIndex::add(std::span<const int16_t> point);
+    template size_t HNSWIndex::add(std::span<const int32_t> point);
+    template size_t HNSWIndex::add(std::span<const int64_t> point);
+
+    template size_t HNSWIndex::add(std::span<const uint8_t> point);
+    template size_t HNSWIndex::add(std::span<const uint16_t> point);
+    template size_t HNSWIndex::add(std::span<const uint32_t> point);
+    template size_t HNSWIndex::add(std::span<const uint64_t> point);
+
+    template size_t HNSWIndex::add(std::span<const float> point);
+    template size_t HNSWIndex::add(std::span<const double> point);
+    template size_t HNSWIndex::add(std::span<const long double> point);
+
+    template void HNSWIndex::addBatch(const DatasetView<int8_t> &data);
+    template void HNSWIndex::addBatch(const DatasetView<int16_t> &data);
+    template void HNSWIndex::addBatch(const DatasetView<int32_t> &data);
+    template void HNSWIndex::addBatch(const DatasetView<int64_t> &data);
+
+    template void HNSWIndex::addBatch(const DatasetView<uint8_t> &data);
+    template void HNSWIndex::addBatch(const DatasetView<uint16_t> &data);
+    template void HNSWIndex::addBatch(const DatasetView<uint32_t> &data);
+    template void HNSWIndex::addBatch(const DatasetView<uint64_t> &data);
+
+    template void HNSWIndex::addBatch(const DatasetView<float> &data);
+    template void HNSWIndex::addBatch(const DatasetView<double> &data);
+    template void HNSWIndex::addBatch(const DatasetView<long double> &data);
+
+    template std::vector<Neighbor> HNSWIndex::query(std::span<const int8_t> point, size_t k, size_t efSearch) const;
+    template std::vector<Neighbor> HNSWIndex::query(std::span<const int16_t> point, size_t k, size_t efSearch) const;
+    template std::vector<Neighbor> HNSWIndex::query(std::span<const int32_t> point, size_t k, size_t efSearch) const;
+    template std::vector<Neighbor> HNSWIndex::query(std::span<const int64_t> point, size_t k, size_t efSearch) const;
+
+    template std::vector<Neighbor> HNSWIndex::query(std::span<const uint8_t> point, size_t k, size_t efSearch) const;
+    template std::vector<Neighbor> HNSWIndex::query(std::span<const uint16_t> point, size_t k, size_t efSearch) const;
+    template std::vector<Neighbor> HNSWIndex::query(std::span<const uint32_t> point, size_t k, size_t efSearch) const;
+    template std::vector<Neighbor> HNSWIndex::query(std::span<const uint64_t> point, size_t k, size_t efSearch) const;
+
+    template std::vector<Neighbor> HNSWIndex::query(std::span<const float> point, size_t k, size_t efSearch) const;
+    template std::vector<Neighbor> HNSWIndex::query(std::span<const double> point, size_t k, size_t efSearch) const;
+    template std::vector<Neighbor> HNSWIndex::query(std::span<const long double> point, size_t k, size_t efSearch) const;
+
+    template std::vector<std::vector<Neighbor>> HNSWIndex::query(const DatasetView<int8_t> &queries, size_t k, size_t efSearch, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> HNSWIndex::query(const DatasetView<int16_t> &queries, size_t k, size_t efSearch, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> HNSWIndex::query(const DatasetView<int32_t> &queries, size_t k, size_t efSearch, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> HNSWIndex::query(const DatasetView<int64_t> &queries, size_t k, size_t efSearch, size_t numThreads) const;
+
+    template std::vector<std::vector<Neighbor>> HNSWIndex::query(const DatasetView<uint8_t> &queries, size_t k, size_t efSearch, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> HNSWIndex::query(const DatasetView<uint16_t> &queries, size_t k, size_t efSearch, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> HNSWIndex::query(const DatasetView<uint32_t> &queries, size_t k, size_t efSearch, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> HNSWIndex::query(const DatasetView<uint64_t> &queries, size_t k, size_t efSearch, size_t numThreads) const;
+
+    template std::vector<std::vector<Neighbor>> HNSWIndex::query(const DatasetView<float> &queries, size_t k, size_t efSearch, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> HNSWIndex::query(const DatasetView<double> &queries, size_t k, size_t efSearch, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> HNSWIndex::query(const DatasetView<long double> &queries, size_t k, size_t efSearch, size_t numThreads) const;
+
+    template std::vector<Neighbor> HNSWIndex::exactQuery(std::span<const int8_t> point, size_t k) const;
+    template std::vector<Neighbor> HNSWIndex::exactQuery(std::span<const int16_t> point, size_t k) const;
+    template std::vector<Neighbor> HNSWIndex::exactQuery(std::span<const int32_t> point, size_t k) const;
+    template std::vector<Neighbor> HNSWIndex::exactQuery(std::span<const int64_t> point, size_t k) const;
+
+    template std::vector<Neighbor> HNSWIndex::exactQuery(std::span<const uint8_t> point, size_t k) const;
+    template std::vector<Neighbor> HNSWIndex::exactQuery(std::span<const uint16_t> point, size_t k) const;
+    template std::vector<Neighbor> HNSWIndex::exactQuery(std::span<const uint32_t> point, size_t k) const;
+    template std::vector<Neighbor> HNSWIndex::exactQuery(std::span<const uint64_t> point, size_t k) const;
+
+    template std::vector<Neighbor> HNSWIndex::exactQuery(std::span<const float> point, size_t k) const;
+    template std::vector<Neighbor> HNSWIndex::exactQuery(std::span<const double> point, size_t k) const;
+    template std::vector<Neighbor> HNSWIndex::exactQuery(std::span<const long double> point, size_t k) const;
+
+    template std::vector<std::vector<Neighbor>> HNSWIndex::exactQuery(const DatasetView<int8_t> &queries, size_t k, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> HNSWIndex::exactQuery(const DatasetView<int16_t> &queries, size_t k, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> HNSWIndex::exactQuery(const DatasetView<int32_t> &queries, size_t k, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> HNSWIndex::exactQuery(const DatasetView<int64_t> &queries, size_t k, size_t numThreads) const;
+
+    template std::vector<std::vector<Neighbor>> HNSWIndex::exactQuery(const DatasetView<uint8_t> &queries, size_t k, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> HNSWIndex::exactQuery(const DatasetView<uint16_t> &queries, size_t k, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> HNSWIndex::exactQuery(const DatasetView<uint32_t> &queries, size_t k, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> HNSWIndex::exactQuery(const DatasetView<uint64_t> &queries, size_t k, size_t numThreads) const;
+
+    template std::vector<std::vector<Neighbor>> HNSWIndex::exactQuery(const DatasetView<float> &queries, size_t k, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> HNSWIndex::exactQuery(const DatasetView<double> &queries, size_t k, size_t numThreads) const;
+    template std::vector<std::vector<Neighbor>> HNSWIndex::exactQuery(const DatasetView<long double> &queries, size_t k, size_t numThreads) const;
+#endif
+
+    namespace detail
+    {
+#if defined(MLLIB_AVX2_KERNELS)
+        // One 4 x 8 tile of gemmAccumulate over depth values of p, with a, b and c at the tile's origin
+        MLLIB_INLINE MLLIB_TARGET_AVX2 void gemmTileAvx2(const double *a, size_t rowStride, size_t colStride, const double *b, size_t ldb, double *c, size_t ldc, size_t depth)
+        {
+            // Named accumulators rather than an array, so they stay in registers without loop unrolling
+            __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd(), c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+            __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd(), c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+            const double *aColumn = a, *bRow = b;
+            for (size_t p = 0; p < depth; ++p, aColumn += colStride, bRow += ldb)
+            {
+                const __m256d b0 = _mm256_loadu_pd(bRow);
+                const __m256d b1 = _mm256_loadu_pd(bRow + 4);
+                __m256d value = _mm256_broadcast_sd(aColumn);
+                c00 = _mm256_fmadd_pd(value, b0, c00);
+                c01 = _mm256_fmadd_pd(value, b1, c01);
+                value = _mm256_broadcast_sd(aColumn + rowStride);
+                c10 = _mm256_fmadd_pd(value, b0, c10);
+                c11 = _mm256_fmadd_pd(value, b1, c11);
+                value = _mm256_broadcast_sd(aColumn + 2 * rowStride);
+                c20 = _mm256_fmadd_pd(value, b0, c20);
+                c21 = _mm256_fmadd_pd(value, b1, c21);
+                value = _mm256_broadcast_sd(aColumn + 3 * rowStride);
+                c30 = _mm256_fmadd_pd(value, b0, c30);
+                c31 = _mm256_fmadd_pd(value, b1, c31);
+            }
+            const __m256d sums[4][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}};
+            for (size_t r = 0; r < 4; ++r)
+            {
+                double *out = c + r * ldc;
+                _mm256_storeu_pd(out, _mm256_add_pd(_mm256_loadu_pd(out), sums[r][0]));
+                _mm256_storeu_pd(out + 4, _mm256_add_pd(_mm256_loadu_pd(out + 4), sums[r][1]));
+            }
+        }
+#endif
+
+        // c[i * ldc + j] += sum_p A(i, p) * b[p * ldb + j] for i < m, j < n, p < k, where A(i, p) = a[i * rowStride + p * colStride],
+        // so A may be a row-major matrix or the transpose of one. The loop over p is split into panels of B that
+        // stay in cache, and C is updated in 4 x 8 tiles whose 32 sums are kept in registers.
+        MLLIB_INLINE void gemmAccumulate(const double *a, size_t rowStride, size_t colStride, const double *b, size_t ldb, double *c, size_t ldc, size_t m, size_t n, size_t k)
+        {
+            const size_t panelDepth = 256;
+            const size_t fullRows = m - m % 4, fullColumns = n - n % 8;
+#if defined(MLLIB_AVX2_KERNELS)
+            const bool avx2 = cpuHasAvx2();
+#endif
+
+            for (size_t p0 = 0; p0 < k; p0 += panelDepth)
+            {
+                const size_t p1 = std::min(k, p0 + panelDepth);
+                for (size_t j0 = 0; j0 < fullColumns; j0 += 8)
+                {
+                    for (size_t i0 = 0; i0 < fullRows; i0 += 4)
+                    {
+#if defined(MLLIB_AVX2_KERNELS)
+                        if (avx2)
+                        {
+                            gemmTileAvx2(a + i0 * rowStride + p0 * colStride, rowStride, colStride, b + p0 * ldb + j0, ldb, c + i0 * ldc + j0, ldc, p1 - p0);
+                            continue;
+                        }
+#endif
+                        double sums[4][8] = {};
+                        for (size_t p = p0; p < p1; ++p)
+                        {
+                            const double *bRow = b + p * ldb + j0;
+                            for (size_t r = 0; r < 4; ++r)
+                            {
+                                const double value = a[(i0 + r) * rowStride + p * colStride];
+                                for (size_t j = 0; j < 8; ++j)
+                                {
+                                    sums[r][j] += value * bRow[j];
+                                }
+                            }
+                        }
+                        for (size_t r = 0; r < 4; ++r)
+                        {
+                            for (size_t j = 0; j < 8; ++j)
+                            {
+                                c[(i0 + r) * ldc + j0 + j] += sums[r][j];
+                            }
+                        }
+                    }
+                }
+
+                // Rows and columns left over by the tiles, in strips of up to 8 columns whose sums stay local
+                // rather than updating C in memory for every p
+                for (size_t i = 0; i < m; ++i)
+                {
+                    for (size_t j0 = (i < fullRows) ? fullColumns : 0; j0 < n; j0 += 8)
+                    {
+                        const size_t width = std::min<size_t>(8, n - j0);
+                        double sums[8] = {};
+                        for (size_t p = p0; p < p1; ++p)
+                        {
+                            const double value = a[i * rowStride + p * colStride];
+                            const double *bRow = b + p * ldb + j0;
+                            for (size_t j = 0; j < width; ++j)
+                            {
+                                sums[j] += value * bRow[j];
+                            }
+                        }
+                        for (size_t j = 0; j < width; ++j)
+                        {
+                            c[i * ldc + j0 + j] += sums[j];
+                        }
+                    }
+                }
+            }
+        }
+
+        // Replace the columns of a rows x cols row-major matrix (rows >= cols) by an orthonormal basis of their
+        // span: Householder QR, then Q formed by applying the reflectors to the first cols columns of the identity.
+        // Reflectors are applied a row at a time so every update streams over contiguous memory.
+        MLLIB_INLINE void orthonormalizeColumns(std::vector<double> &matrix, size_t rows, size_t cols)
+        {
+            assert(rows >= cols && matrix.size() == rows * cols);
+            std::vector<double> tau(cols, 0.0), dots(cols);
+
+            // Apply the reflector of column j, I - tau v v^T with v[j] = 1 and v[i > j] stored in factors, to columns [first, cols) of target
+            auto reflect = [&](const std::vector<double> &factors, size_t j, std::vector<double> &target, size_t first)
+            {
+                std::fill(dots.begin() + first, dots.end(), 0.0);
+                for (size_t i = j; i < rows; ++i)
+                {
+                    const double v = (i == j) ? 1.0 : factors[i * cols + j];
+                    for (size_t col = first; col < cols; ++col)
+                        dots[col] += v * target[i * cols + col];
+                }
+                for (size_t i = j; i < rows; ++i)
+                {
+                    const double v = tau[j] * ((i == j) ? 1.0 : factors[i * cols + j]);
+                    for (size_t col = first; col < cols; ++col)
+                        target[i * cols + col] -= v * dots[col];
+                }
+            };
+
+            for (size_t j = 0; j < cols; ++j)
+            {
+                double norm = 0.0;
+                for (size_t i = j; i < rows; ++i)
+                    norm += matrix[i * cols + j] * matrix[i * cols + j];
+                norm = std::sqrt(norm);
+                if (norm == 0.0)
+                    continue;
+
+                const double head = matrix[j * cols + j];
+                const double beta = (head >= 0.0) ? -norm : norm;
+                tau[j] = (beta - head) / beta;
+                for (size_t i = j + 1; i < rows; ++i)
+                    matrix[i * cols + j] /= head - beta;
+                matrix[j * cols + j] = beta;
+                reflect(matrix, j, matrix, j + 1);
+            }
+
+            std::vector<double> basis(rows * cols, 0.0);
+            for (size_t j = 0; j < cols; ++j)
+                basis[j * cols + j] = 1.0;
+            for (size_t j = cols; j-- > 0;)
+            {
+                if (tau[j] != 0.0)
+                    reflect(matrix, j, basis, j);
+            }
+            matrix.swap(basis);
+        }
+
+        // Eigen decomposition of a symmetric size x size matrix by cyclic Jacobi rotations. Returns the
+        // eigenvalues in descending order and the matching eigenvectors as the columns of eigenvectors.
+        MLLIB_INLINE std::vector<double> symmetricEigen(std::vector<double> matrix, size_t size, std::vector<double> &eigenvectors)
+        {
+            std::vector<double> rotations(size * size, 0.0);
+            for (size_t i = 0; i < size; ++i)
+                rotations[i * size + i] = 1.0;
+
+            double scale = 0.0;
+            for (const double value : matrix)
+                scale += value * value;
+
+            for (int sweep = 0; sweep < 100; ++sweep)
+            {
+                double offDiagonal = 0.0;
+                for (size_t p = 0; p < size; ++p)
+                    for (size_t q = p + 1; q < size; ++q)
+                        offDiagonal += matrix[p * size + q] * matrix[p * size + q];
+                if (offDiagonal <= 1e-30 * scale)
+                    break;
+
+                for (size_t p = 0; p < size; ++p)
+                {
+                    for (size_t q = p + 1; q < size; ++q)
+                    {
+                        const double apq = matrix[p * size + q];
+                        if (apq == 0.0)
+                            continue;
+
+                        // Rotation by the angle that zeroes matrix[p][q]
+                        const double theta = (matrix[q * size + q] - matrix[p * size + p]) / (2.0 * apq);
+                        const double t = std::copysign(1.0, theta) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                        const double cosine = 1.0 / std::sqrt(t * t + 1.0), sine = t * cosine;
+
+                        for (size_t i = 0; i < size; ++i)
+                        {
+                            const double aip = matrix[i * size + p], aiq = matrix[i * size + q];
+                            matrix[i * size + p] = cosine * aip - sine * aiq;
+                            matrix[i * size + q] = sine * aip + cosine * aiq;
+                        }
+                        for (size_t i = 0; i < size; ++i)
+                        {
+                            const double api = matrix[p * size + i], aqi = matrix[q * size + i];
+                            matrix[p * size + i] = cosine * api - sine * aqi;
+                            matrix[q * size + i] = sine * api + cosine * aqi;
+                        }
+                        for (size_t i = 0; i < size; ++i)
+                        {
+                            const double vip = rotations[i * size + p], viq = rotations[i * size + q];
+                            rotations[i * size + p] = cosine * vip - sine * viq;
+                            rotations[i * size + q] = sine * vip + cosine * viq;
+                        }
+                    }
+                }
+            }
+
+            std::vector<size_t> order(size);
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&](size_t x, size_t y)
+                      { return matrix[x * size + x] > matrix[y * size + y]; });
+
+            std::vector<double> eigenvalues(size);
+            eigenvectors.assign(size * size, 0.0);
+            for (size_t c = 0; c < size; ++c)
+            {
+                eigenvalues[c] = matrix[order[c] * size + order[c]];
+                for (size_t i = 0; i < size; ++i)
+                    eigenvectors[i * size + c] = rotations[i * size + order[c]];
+            }
+            return eigenvalues;
+        }
+
+        // Call visit(rows, blockBegin, numRows, threadIndex) for blocks of up to 64 consecutive rows of a view on
+        // numThreads threads, with the rows converted to double and centered by mean (if not empty)
+        template <typename T, typename Visit>
+        void forEachCenteredBlock(const DatasetView<T> &data, const std::vector<double> &mean, size_t numThreads, Visit visit)
+        {
+            const size_t blockRows = 64, numFeatures = data.getNumFeatures();
+            parallelFor(data.size(), numThreads, [&](size_t begin, size_t end, size_t threadIndex)
+                        {
+                            std::vector<double> rows(blockRows * numFeatures);
+                            for (size_t blockBegin = begin; blockBegin < end; blockBegin += blockRows)
+                            {
+                                const size_t numRows = std::min(blockRows, end - blockBegin);
+                                for (size_t r = 0; r < numRows; ++r)
+                                {
+                                    const std::span<const T> row = data.row(blockBegin + r);
+                                    double *out = rows.data() + r * numFeatures;
+                                    for (size_t j = 0; j < numFeatures; ++j)
+                                        out[j] = static_cast<double>(row[j]) - (mean.empty() ? 0.0 : mean[j]);
+                                }
+                                visit(rows.data(), blockBegin, numRows, threadIndex);
+                            } });
+        }
+
+        // Randomized PCA over the rows that forEachView passes, one view at a time and as often as it is called,
+        // to its argument. See PCA in the header for the algorithm.
+        template <typename Source>
+        PCAModel randomizedPCA(Source forEachView, size_t numFeatures, const PCAOptions &options)
+        {
+            const size_t numThreads = resolveThreadCount(options.numThreads);
+            const size_t numComponents = options.numComponents;
+            assert(numComponents > 0 && numComponents <= numFeatures);
+
+            // Subspace width, rounded up to whole 8-column GEMM tiles where the features allow
+            const size_t width = std::min(numFeatures, (numComponents + options.oversampling + 7) / 8 * 8);
+
+            size_t numRows = 0;
+            std::vector<double> mean;
+            if (options.center)
+            {
+                ScopedTimer timer("PCA::pass");
+                std::vector<std::vector<double>> sums(numThreads, std::vector<double>(numFeatures, 0.0));
+                forEachView([&](const auto &view)
+                            {
+                                parallelFor(view.size(), numThreads, [&](size_t begin, size_t end, size_t threadIndex)
+                                            {
+                                                for (size_t i = begin; i < end; ++i)
+                                                {
+                                                    const auto row = view.row(i);
+                                                    for (size_t j = 0; j < numFeatures; ++j)
+                                                        sums[threadIndex][j] += static_cast<double>(row[j]);
+                                                } });
+                                numRows += view.size(); });
+
+                mean.assign(numFeatures, 0.0);
+                for (const auto &threadSums : sums)
+                    for (size_t j = 0; j < numFeatures; ++j)
+                        mean[j] += threadSums[j];
+                for (double &value : mean)
+                    value /= std::max<size_t>(1, numRows);
+            }
+
+            std::mt19937 generator(options.seed);
+            std::normal_distribution<double> normal(0.0, 1.0);
+            std::vector<double> basis(numFeatures * width);
+            for (double &value : basis)
+                value = normal(generator);
+            orthonormalizeColumns(basis, numFeatures, width);
+
+            // basis <- orth(X^T X basis), with the projections of each block of rows computed as one product and
+            // folded back into per-thread accumulators as another
+            long double totalVariance = 0.0L;
+            std::vector<std::vector<double>> products(numThreads);
+            std::vector<long double> squaredNorms(numThreads);
+            for (size_t pass = 0; pass <= options.powerIterations; ++pass)
+            {
+                ScopedTimer timer("PCA::pass");
+                for (auto &product : products)
+                    product.assign(numFeatures * width, 0.0);
+                std::fill(squaredNorms.begin(), squaredNorms.end(), 0.0L);
+                size_t passRows = 0;
+
+                forEachView([&](const auto &view)
+                            {
+                                std::vector<std::vector<double>> projections(numThreads, std::vector<double>(64 * width));
+                                forEachCenteredBlock(view, mean, numThreads, [&](const double *rows, size_t, size_t blockRows, size_t threadIndex)
+                                                     {
+                                                         std::vector<double> &projection = projections[threadIndex];
+                                                         std::fill(projection.begin(), projection.end(), 0.0);
+                                                         gemmAccumulate(rows, numFeatures, 1, basis.data(), width, projection.data(), width, blockRows, width, numFeatures);
+                                                         gemmAccumulate(rows, 1, numFeatures, projection.data(), width, products[threadIndex].data(), width, numFeatures, width, blockRows);
+                                                         if (pass == 0)
+                                                             squaredNorms[threadIndex] += std::inner_product(rows, rows + blockRows * numFeatures, rows, 0.0L);
+                                                     });
+                                passRows += view.size(); });
+
+                for (size_t t = 1; t < numThreads; ++t)
+                    std::transform(products[0].begin(), products[0].end(), products[t].begin(), products[0].begin(), std::plus<double>());
+                basis.swap(products[0]);
+                orthonormalizeColumns(basis, numFeatures, width);
+
+                if (pass == 0)
+                {
+                    numRows = passRows;
+                    totalVariance = std::accumulate(squaredNorms.begin(), squaredNorms.end(), 0.0L);
+                }
+            }
+
+            // Rayleigh-Ritz: the covariance projected onto the subspace, (X basis)^T (X basis), is only width x width
+            std::vector<std::vector<double>> projected(numThreads, std::vector<double>(width * width, 0.0));
+            {
+                ScopedTimer timer("PCA::pass");
+                forEachView([&](const auto &view)
+                            {
+                                std::vector<std::vector<double>> projections(numThreads, std::vector<double>(64 * width));
+                                forEachCenteredBlock(view, mean, numThreads, [&](const double *rows, size_t, size_t blockRows, size_t threadIndex)
+                                                     {
+                                                         std::vector<double> &projection = projections[threadIndex];
+                                                         std::fill(projection.begin(), projection.end(), 0.0);
+                                                         gemmAccumulate(rows, numFeatures, 1, basis.data(), width, projection.data(), width, blockRows, width, numFeatures);
+                                                         gemmAccumulate(projection.data(), 1, width, projection.data(), width, projected[threadIndex].data(), width, width, width, blockRows);
+                                                     }); });
+            }
+            for (size_t t = 1; t < numThreads; ++t)
+                std::transform(projected[0].begin(), projected[0].end(), projected[t].begin(), projected[0].begin(), std::plus<double>());
+
+            std::vector<double> rotation;
+            const std::vector<double> eigenvalues = symmetricEigen(projected[0], width, rotation);
+
+            // Components are basis * rotation, each flipped so its largest entry is positive for reproducible signs
+            const long double degreesOfFreedom = std::max<long double>(1.0L, static_cast<long double>(numRows) - 1.0L);
+            std::vector<long double> components(numComponents * numFeatures), explainedVariance(numComponents), singularValues(numComponents);
+            for (size_t c = 0; c < numComponents; ++c)
+            {
+                long double *component = components.data() + c * numFeatures;
+                for (size_t j = 0; j < numFeatures; ++j)
+                {
+                    long double value = 0.0L;
+                    for (size_t w = 0; w < width; ++w)
+                        value += basis[j * width + w] * rotation[w * width + c];
+                    component[j] = value;
+                }
+                const long double *largest = std::max_element(component, component + numFeatures, [](long double x, long double y)
+                                                              { return std::abs(x) < std::abs(y); });
+                if (*largest < 0.0L)
+                    std::transform(component, component + numFeatures, component, std::negate<long double>());
+
+                const long double eigenvalue = std::max(0.0, eigenvalues[c]);
+                singularValues[c] = std::sqrt(eigenvalue);
+                explainedVariance[c] = eigenvalue / degreesOfFreedom;
+            }
+
+            PCAModel model(components, numFeatures);
+            if (options.center)
+                model.setMean(std::vector<long double>(mean.begin(), mean.end()));
+            model.setExplainedVariance(explainedVariance, totalVariance / degreesOfFreedom);
+            model.setSingularValues(singularValues);
+            return model;
+        }
+    }
+
+    MLLIB_INLINE PCAModel::PCAModel() {}
+
+    MLLIB_INLINE PCAModel::PCAModel(const std::vector<long double> &components, size_t numFeatures)
+    {
+        setComponents(components, numFeatures);
+    }
+
+    MLLIB_INLINE size_t PCAModel::getNumComponents() const { return explainedVariance.size(); }
+    MLLIB_INLINE size_t PCAModel::getNumFeatures() const { return numFeatures; }
+    MLLIB_INLINE const std::vector<long double> &PCAModel::getMean() const { return mean; }
+    MLLIB_INLINE const std::vector<long double> &PCAModel::getComponents() const { return components; }
+    MLLIB_INLINE const std::vector<long double> &PCAModel::getExplainedVariance() const { return explainedVariance; }
+    MLLIB_INLINE const std::vector<long double> &PCAModel::getSingularValues() const { return singularValues; }
+    MLLIB_INLINE long double PCAModel::getTotalVariance() const { return totalVariance; }
+
+    MLLIB_INLINE std::span<const long double> PCAModel::getComponent(size_t component) const
+    {
+        assert(component < getNumComponents());
+        return std::span<const long double>(components.data() + component * numFeatures, numFeatures);
+    }
+
+    MLLIB_INLINE std::vector<long double> PCAModel::getExplainedVarianceRatio() const
+    {
+        std::vector<long double> ratios(explainedVariance.size(), 0.0L);
+        if (totalVariance > 0.0L)
+        {
+            for (size_t c = 0; c < ratios.size(); ++c)
+                ratios[c] = explainedVariance[c] / totalVariance;
+        }
+        return ratios;
+    }
+
+    MLLIB_INLINE void PCAModel::setComponents(const std::vector<long double> &newComponents, size_t newNumFeatures)
+    {
+        assert(newNumFeatures > 0 && newComponents.size() % newNumFeatures == 0);
+        components = newComponents;
+        numFeatures = newNumFeatures;
+        mean.assign(numFeatures, 0.0L);
+        explainedVariance.assign(components.size() / numFeatures, 0.0L);
+        singularValues.assign(components.size() / numFeatures, 0.0L);
+        totalVariance = 0.0L;
+    }
+
+    MLLIB_INLINE void PCAModel::setMean(const std::vector<long double> &newMean)
+    {
+        assert(newMean.size() == numFeatures);
+        mean = newMean;
+    }
+
+    MLLIB_INLINE void PCAModel::setExplainedVariance(const std::vector<long double> &newExplainedVariance, long double newTotalVariance)
+    {
+        assert(newExplainedVariance.size() == getNumComponents());
+        explainedVariance = newExplainedVariance;
+        totalVariance = newTotalVariance;
+    }
+
+    MLLIB_INLINE void PCAModel::setSingularValues(const std::vector<long double> &newSingularValues)
+    {
+        assert(newSingularValues.size() == getNumComponents());
+        singularValues = newSingularValues;
+    }
+
+    template <typename T>
+    std::vector<long double> PCAModel::transform(std::span<const T> xRow) const
+    {
+        assert(xRow.size() == numFeatures);
+        std::vector<long double> coordinates(getNumComponents(), 0.0L);
+        for (size_t c = 0; c < coordinates.size(); ++c)
+        {
+            const long double *component = components.data() + c * numFeatures;
+            for (size_t j = 0; j < numFeatures; ++j)
+                coordinates[c] += (static_cast<long double>(xRow[j]) - mean[j]) * component[j];
+        }
+        return coordinates;
+    }
+
+    template <typename T>
+    Dataset<double> PCAModel::transform(const DatasetView<T> &data, size_t numThreads) const
+    {
+        assert(data.getNumFeatures() == numFeatures);
+        const size_t numComponents = getNumComponents();
+
+        // Components transposed to numFeatures x numComponents, so each block of rows is one product
+        std::vector<double> basis(numFeatures * numComponents);
+        for (size_t c = 0; c < numComponents; ++c)
+            for (size_t j = 0; j < numFeatures; ++j)
+                basis[j * numComponents + c] = static_cast<double>(components[c * numFeatures + j]);
+
+        const std::vector<double> centers(mean.begin(), mean.end());
+        std::vector<double> coordinates(data.size() * numComponents, 0.0), labels(data.size(), 0.0);
+        detail::forEachCenteredBlock(data, centers, detail::resolveThreadCount(numThreads), [&](const double *rows, size_t blockBegin, size_t blockRows, size_t)
+                                     {
+                                         detail::gemmAccumulate(rows, numFeatures, 1, basis.data(), numComponents, coordinates.data() + blockBegin * numComponents, numComponents, blockRows, numComponents, numFeatures);
+                                         if (data.hasLabels())
+                                         {
+                                             for (size_t r = 0; r < blockRows; ++r)
+                                                 labels[blockBegin + r] = static_cast<double>(data.label(blockBegin + r));
+                                         } });
+
+        return Dataset<double>(std::move(coordinates), std::move(labels), numComponents);
+    }
+
+    MLLIB_INLINE std::vector<long double> PCAModel::inverseTransform(std::span<const long double> coordinates) const
+    {
+        assert(coordinates.size() == getNumComponents());
+        std::vector<long double> row(mean);
+        for (size_t c = 0; c < coordinates.size(); ++c)
+        {
+            const long double *component = components.data() + c * numFeatures;
+            for (size_t j = 0; j < numFeatures; ++j)
+                row[j] += coordinates[c] * component[j];
+        }
+        return row;
+    }
+
+    MLLIB_INLINE void PCAModel::saveToFile(const std::string &filename) const
+    {
+        std::ofstream outFile(filename);
+        if (outFile.is_open())
+        {
+            outFile.precision(std::numeric_limits<long double>::max_digits10);
+            outFile << *this;
+            outFile.close();
+        }
+        else
+        {
+            std::cerr << "Unable to open file for writing." << std::endl;
+        }
+    }
+
+    MLLIB_INLINE void PCAModel::loadFromFile(const std::string &filename)
+    {
+        if (detail::isBinaryModelFile(filename))
+        {
+            loadBinary(filename);
+            return;
+        }
+
+        std::ifstream inFile(filename);
+        if (inFile.is_open())
+        {
+            if (!(inFile >> *this))
+                std::cerr << "Invalid model file: truncated or malformed text model" << std::endl;
+            inFile.close();
+        }
+        else
+        {
+            std::cerr << "Unable to open file for reading." << std::endl;
+        }
+    }
+
+    MLLIB_INLINE bool PCAModel::saveBinary(const std::string &filename) const
+    {
+        detail::PayloadWriter payload;
+        payload.write(components);
+        payload.write(static_cast<uint64_t>(numFeatures));
+        payload.write(mean);
+        payload.write(explainedVariance);
+        payload.write(singularValues);
+        payload.write(totalVariance);
+
+        // The header's normalization type is not used by PCA models
+        return detail::writeModelFile(filename, detail::PCAModelFile, stat::NormalizationType(), components.size(), payload.buffer);
+    }
+
+    MLLIB_INLINE bool PCAModel::loadBinary(const std::string &filename)
+    {
+        MappedFile file;
+        const detail::ModelFileHeader *header = detail::readModelFile(file, filename, detail::PCAModelFile);
+        if (header == nullptr)
+            return false;
+
+        // Decode into a temporary so a malformed payload leaves this model untouched
+        PCAModel model;
+        detail::PayloadReader payload(file.data() + sizeof(detail::ModelFileHeader), header->payloadSize);
+        uint64_t newNumFeatures = 0;
+
+        bool valid = payload.read(model.components, header->numCoefficients) && payload.read(newNumFeatures) &&
+                     newNumFeatures > 0 && header->numCoefficients % newNumFeatures == 0 &&
+                     payload.read(model.mean, newNumFeatures) &&
+                     payload.read(model.explainedVariance, header->numCoefficients / newNumFeatures) &&
+                     payload.read(model.singularValues, header->numCoefficients / newNumFeatures) &&
+                     payload.read(model.totalVariance) && payload.atEnd();
+        if (!valid)
+        {
+            std::cerr << "Invalid model file: malformed payload" << std::endl;
+            return false;
+        }
+
+        model.numFeatures = newNumFeatures;
+        *this = std::move(model);
+        return true;
+    }
+
+    MLLIB_INLINE void PCAModel::printInfo() const
+    {
+        std::cout << "PCA Model:\n"
+                  << "Components: " << getNumComponents() << ", Features: " << numFeatures << "\n";
+        const std::vector<long double> ratios = getExplainedVarianceRatio();
+        for (size_t c = 0; c < getNumComponents(); ++c)
+        {
+            std::cout << "Component " << c << ": explained variance " << explainedVariance[c] << " (" << 100.0L * ratios[c] << "%), singular value " << singularValues[c] << "\n";
+        }
+        std::cout << "Total variance: " << totalVariance << "\n";
+    }
+
+    template <typename T>
+    PCAModel PCA(const DatasetView<T> &data, const PCAOptions &options)
+    {
+        assert(!data.empty());
+        return detail::randomizedPCA([&data](auto visit)
+                                     { visit(data); }, data.getNumFeatures(), options);
+    }
+
+    template <typename T>
+    PCAModel PCA(const std::vector<std::vector<T>> &xValues, const PCAOptions &options)
+    {
+        assert(!xValues.empty());
+        const size_t numFeatures = xValues[0].size();
+        std::vector<T> rowMajor;
+        rowMajor.reserve(xValues.size() * numFeatures);
+        for (const auto &row : xValues)
+        {
+            assert(row.size() == numFeatures);
+            rowMajor.insert(rowMajor.end(), row.begin(), row.end());
+        }
+        return PCA(DatasetView<T>(rowMajor.data(), nullptr, xValues.size(), numFeatures), options);
+    }
+
+    MLLIB_INLINE PCAModel PCA(ChunkedDataReader &reader, const PCAOptions &options)
+    {
+        assert(reader.isOpen() && "Data source is not open");
+        const size_t numFeatures = reader.getNumFeatures();
+
+        // Each pass re-reads the file; one chunk is processed while the next is read by a prefetch thread
+        auto forEachChunk = [&](auto visit)
+        {
+            reader.reset();
+            DataChunk buffers[2];
+            int current = 0;
+
+            std::future<size_t> pending = std::async(std::launch::async, [&reader, &buffers]()
+                                                     { return reader.readChunk(buffers[0]); });
+            while (pending.get() > 0)
+            {
+                const DataChunk &chunk = buffers[current];
+                const int next = 1 - current;
+                pending = std::async(std::launch::async, [&reader, &buffers, next]()
+                                     { return reader.readChunk(buffers[next]); });
+
+                visit(DatasetView<long double>(chunk.features.data(), chunk.labels.data(), chunk.numRows, numFeatures));
+                current = next;
+            }
+        };
+        return detail::randomizedPCA(forEachChunk, numFeatures, options);
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template std::vector<long double> PCAModel::transform(std::span<const int8_t> xRow) const;
+    template std::vector<long double> PCAModel::transform(std::span<const int16_t> xRow) const;
+    template std::vector<long double> PCAModel::transform(std::span<const int32_t> xRow) const;
+    template std::vector<long double> PCAModel::transform(std::span<const int64_t> xRow) const;
+
+    template std::vector<long double> PCAModel::transform(std::span<const uint8_t> xRow) const;
+    template std::vector<long double> PCAModel::transform(std::span<const uint16_t> xRow) const;
+    template std::vector<long double> PCAModel::transform(std::span<const uint32_t> xRow) const;
+    template std::vector<long double> PCAModel::transform(std::span<const uint64_t> xRow) const;
+
+    template std::vector<long double> PCAModel::transform(std::span<const float> xRow) const;
+    template std::vector<long double> PCAModel::transform(std::span<const double> xRow) const;
+    template std::vector<long double> PCAModel::transform(std::span<const long double> xRow) const;
+
+    template Dataset<double> PCAModel::transform(const DatasetView<int8_t> &data, size_t numThreads) const;
+    template Dataset<double> PCAModel::transform(const DatasetView<int16_t> &data, size_t numThreads) const;
+    template Dataset<double> PCAModel::transform(const DatasetView<int32_t> &data, size_t numThreads) const;
+    template Dataset<double> PCAModel::transform(const DatasetView<int64_t> &data, size_t numThreads) const;
+
+    template Dataset<double> PCAModel::transform(const DatasetView<uint8_t> &data, size_t numThreads) const;
+    template Dataset<double> PCAModel::transform(const DatasetView<uint16_t> &data, size_t numThreads) const;
+    template Dataset<double> PCAModel::transform(const DatasetView<uint32_t> &data, size_t numThreads) const;
+    template Dataset<double> PCAModel::transform(const DatasetView<uint64_t> &data, size_t numThreads) const;
+
+    template Dataset<double> PCAModel::transform(const DatasetView<float> &data, size_t numThreads) const;
+    template Dataset<double> PCAModel::transform(const DatasetView<double> &data, size_t numThreads) const;
+    template Dataset<double> PCAModel::transform(const DatasetView<long double> &data, size_t numThreads) const;
+
+    template PCAModel PCA(const DatasetView<int8_t> &data, const PCAOptions &options);
+    template PCAModel PCA(const DatasetView<int16_t> &data, const PCAOptions &options);
+    template PCAModel PCA(const DatasetView<int32_t> &data, const PCAOptions &options);
+    template PCAModel PCA(const DatasetView<int64_t> &data, const PCAOptions &options);
+
+    template PCAModel PCA(const DatasetView<uint8_t> &data, const PCAOptions &options);
+    template PCAModel PCA(const DatasetView<uint16_t> &data, const PCAOptions &options);
+    template PCAModel PCA(const DatasetView<uint32_t> &data, const PCAOptions &options);
+    template PCAModel PCA(const DatasetView<uint64_t> &data, const PCAOptions &options);
+
+    template PCAModel PCA(const DatasetView<float> &data, const PCAOptions &options);
+    template PCAModel PCA(const DatasetView<double> &data, const PCAOptions &options);
+    template PCAModel PCA(const DatasetView<long double> &data, const PCAOptions &options);
+
+    template PCAModel PCA(const std::vector<std::vector<int8_t>> &xValues, const PCAOptions &options);
+    template PCAModel PCA(const std::vector<std::vector<int16_t>> &xValues, const PCAOptions &options);
+    template PCAModel PCA(const std::vector<std::vector<int32_t>> &xValues, const PCAOptions &options);
+    template PCAModel PCA(const std::vector<std::vector<int64_t>> &xValues, const PCAOptions &options);
+
+    template PCAModel PCA(const std::vector<std::vector<uint8_t>> &xValues, const PCAOptions &options);
+    template PCAModel PCA(const std::vector<std::vector<uint16_t>> &xValues, const PCAOptions &options);
+    template PCAModel PCA(const std::vector<std::vector<uint32_t>> &xValues, const PCAOptions &options);
+    template PCAModel PCA(const std::vector<std::vector<uint64_t>> &xValues, const PCAOptions &options);
+
+    template PCAModel PCA(const std::vector<std::vector<float>> &xValues, const PCAOptions &options);
+    template PCAModel PCA(const std::vector<std::vector<double>> &xValues, const PCAOptions &options);
+    template PCAModel PCA(const std::vector<std::vector<long double>> &xValues, const PCAOptions &options);
+#endif
+
+
+    namespace detail
+    {
+        // Gradient and hessian sums of the rows that fall into one histogram bin
+        struct GradientBin
+        {
+            double gradient = 0.0;
+            double hessian = 0.0;
+            uint64_t count = 0;
+        };
+
+        // Features bucketed into at most 256 bins, one byte per value in row-major order. A value falls into
+        // the first bin whose upper bound is >= the value; the last bin of each feature has no bound.
+        struct BinnedFeatures
+        {
+            std::vector<uint8_t> bins;
+            size_t numFeatures = 0;
+            std::vector<std::vector<double>> bounds;
+            std::vector<size_t> binOffsets; // First histogram slot of each feature; the last entry is the total
+        };
+
+        // Upper bounds of at most maxBins bins over sorted values: one bin per distinct value when there are
+        // few of them, otherwise bins of about equal row counts. Bounds lie halfway between adjacent values.
+        MLLIB_INLINE std::vector<double> quantileBinBounds(const std::vector<double> &sorted, size_t maxBins)
+        {
+            std::vector<double> distinct;
+            std::vector<size_t> counts;
+            for (const double value : sorted)
+            {
+                if (distinct.empty() || value != distinct.back())
+                {
+                    distinct.push_back(value);
+                    counts.push_back(0);
+                }
+                ++counts.back();
+            }
+
+            auto boundBetween = [](double low, double high)
+            {
+                const double middle = std::midpoint(low, high);
+                return (middle < high) ? middle : low;
+            };
+
+            std::vector<double> bounds;
+            const double rowsPerBin = static_cast<double>(sorted.size()) / maxBins;
+            size_t accumulated = 0;
+            for (size_t i = 0; i + 1 < distinct.size() && bounds.size() + 1 < maxBins; ++i)
+            {
+                accumulated += counts[i];
+                if (distinct.size() <= maxBins || accumulated >= (bounds.size() + 1) * rowsPerBin)
+                    bounds.push_back(boundBetween(distinct[i], distinct[i + 1]));
+            }
+            return bounds;
+        }
+
+        // Number of bounds below value, i.e. std::lower_bound, halving the range with conditional moves instead of branches
+        MLLIB_INLINE size_t binIndex(const std::vector<double> &bounds, double value)
+        {
+            if (bounds.empty())
+                return 0;
+            const double *base = bounds.data();
+            size_t length = bounds.size();
+            while (length > 1)
+            {
+                const size_t half = length / 2;
+                base += (base[half] < value) ? half : 0;
+                length -= half;
+            }
+            return (base - bounds.data()) + (*base < value);
+        }
+
+        // Bin bounds from a sample of at most 200,000 rows, then the bins of every row, on numThreads threads
+        template <typename T>
+        BinnedFeatures binFeatures(const DatasetView<T> &data, size_t maxBins, size_t numThreads)
+        {
+            const size_t numRows = data.size(), numFeatures = data.getNumFeatures();
+            const size_t sampleStep = (numRows + 199999) / 200000;
+
+            BinnedFeatures binned;
+            binned.numFeatures = numFeatures;
+            binned.bounds.resize(numFeatures);
+            parallelForDynamic(numFeatures, numThreads, [&](size_t j)
+                               {
+                                   std::vector<double> values;
+                                   values.reserve(numRows / sampleStep + 1);
+                                   for (size_t i = 0; i < numRows; i += sampleStep)
+                                       values.push_back(static_cast<double>(data.row(i)[j]));
+                                   std::sort(values.begin(), values.end());
+                                   binned.bounds[j] = quantileBinBounds(values, maxBins); });
+
+            binned.binOffsets.assign(numFeatures + 1, 0);
+            for (size_t j = 0; j < numFeatures; ++j)
+                binned.binOffsets[j + 1] = binned.binOffsets[j] + binned.bounds[j].size() + 1;
+
+            binned.bins.resize(numRows * numFeatures);
+            parallelFor(numRows, numThreads, [&](size_t begin, size_t end, size_t)
+                        {
+                            for (size_t i = begin; i < end; ++i)
+                            {
+                                const std::span<const T> row = data.row(i);
+                                uint8_t *rowBins = binned.bins.data() + i * numFeatures;
+                                for (size_t j = 0; j < numFeatures; ++j)
+                                {
+                                    rowBins[j] = static_cast<uint8_t>(binIndex(binned.bounds[j], static_cast<double>(row[j])));
+                                }
+                            } });
+            return binned;
+        }
+
+        // Histogram of the rows rows[0, count) into histogram. Threads sum blocks of rows into their own
+        // histograms, which are added up afterwards; small nodes use fewer threads so the extra histograms
+        // stay cheap to clear and add.
+        MLLIB_INLINE void buildHistogram(const BinnedFeatures &binned, const uint32_t *rows, size_t count, const std::vector<double> &gradients, const std::vector<double> &hessians,
+                                         std::vector<GradientBin> &histogram, std::vector<std::vector<GradientBin>> &threadHistograms, size_t numThreads)
+        {
+            const size_t numFeatures = binned.numFeatures, numBins = binned.binOffsets.back();
+            const size_t *offsets = binned.binOffsets.data();
+            numThreads = std::max<size_t>(1, std::min(numThreads, count / 4096));
+            Instrumentation::count("GradientBoosting::histogramRows", count);
+
+            histogram.assign(numBins, GradientBin());
+            parallelFor(count, numThreads, [&](size_t begin, size_t end, size_t threadIndex)
+                        {
+                            std::vector<GradientBin> &local = (threadIndex == 0) ? histogram : threadHistograms[threadIndex - 1];
+                            if (threadIndex > 0)
+                                local.assign(numBins, GradientBin());
+                            GradientBin *bins = local.data();
+                            for (size_t i = begin; i < end; ++i)
+                            {
+                                const uint32_t row = rows[i];
+                                const uint8_t *rowBins = binned.bins.data() + static_cast<size_t>(row) * numFeatures;
+                                const double g = gradients[row], h = hessians[row];
+                                for (size_t j = 0; j < numFeatures; ++j)
+                                {
+                                    GradientBin &bin = bins[offsets[j] + rowBins[j]];
+                                    bin.gradient += g;
+                                    bin.hessian += h;
+                                    ++bin.count;
+                                }
+                            } });
+
+            if (numThreads > 1)
+            {
+                parallelFor(numBins, numThreads, [&](size_t begin, size_t end, size_t)
+                            {
+                                for (size_t t = 0; t + 1 < numThreads; ++t)
+                                {
+                                    for (size_t b = begin; b < end; ++b)
+                                    {
+                                        histogram[b].gradient += threadHistograms[t][b].gradient;
+                                        histogram[b].hessian += threadHistograms[t][b].hessian;
+                                        histogram[b].count += threadHistograms[t][b].count;
+                                    }
+                                } });
+            }
+        }
+
+        // Best split of a leaf: rows whose bin of feature is <= bin go left
+        struct SplitCandidate
+        {
+            double gain = 0.0; // Loss reduction, 0 if the leaf cannot be split
+            uint32_t feature = 0;
+            uint32_t bin = 0;
+            GradientBin left;
+        };
+
+        MLLIB_INLINE SplitCandidate findBestSplit(const BinnedFeatures &binned, const std::vector<GradientBin> &histogram, const GradientBin &total, const GBDTOptions &options)
+        {
+            const double lambda = static_cast<double>(options.l2Regularization);
+            const double minHessian = 1e-3;
+            auto score = [lambda](double gradient, double hessian)
+            { return gradient * gradient / (hessian + lambda); };
+            const double parentScore = score(total.gradient, total.hessian);
+
+            SplitCandidate best;
+            for (size_t j = 0; j < binned.numFeatures; ++j)
+            {
+                GradientBin left;
+                for (size_t b = binned.binOffsets[j]; b + 1 < binned.binOffsets[j + 1]; ++b)
+                {
+                    left.gradient += histogram[b].gradient;
+                    left.hessian += histogram[b].hessian;
+                    left.count += histogram[b].count;
+                    if (left.count < options.minSamplesLeaf || left.hessian < minHessian)
+                        continue;
+
+                    const uint64_t rightCount = total.count - left.count;
+                    const double rightHessian = total.hessian - left.hessian;
+                    if (rightCount < options.minSamplesLeaf || rightHessian < minHessian)
+                        break;
+
+                    const double gain = 0.5 * (score(left.gradient, left.hessian) + score(total.gradient - left.gradient, rightHessian) - parentScore);
+                    if (gain > best.gain)
+                    {
+                        best.gain = gain;
+                        best.feature = static_cast<uint32_t>(j);
+                        best.bin = static_cast<uint32_t>(b - binned.binOffsets[j]);
+                        best.left = left;
+                    }
+                }
+            }
+            return best;
+        }
+
+        // True if the size nodes at nodes form one tree whose child indices are relative to base and point
+        // forward, so every walk from the root ends at a leaf
+        MLLIB_INLINE bool isValidTree(const GBDTNode *nodes, size_t size, size_t base, size_t numFeatures)
+        {
+            if (size == 0)
+                return false;
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (nodes[i].left == 0)
+                    continue;
+                if (nodes[i].left < base || nodes[i].left - base <= i || nodes[i].left - base + 1 >= size || nodes[i].feature >= numFeatures)
+                    return false;
+            }
+            return true;
+        }
+
+        MLLIB_INLINE double sigmoid(double score)
+        {
+            return 1.0 / (1.0 + std::exp(-score));
+        }
+    }
+
+    MLLIB_INLINE GBDTModel::GBDTModel() {}
+
+    MLLIB_INLINE GBDTModel::GBDTModel(BoostingLoss loss, long double baseScore, size_t numFeatures)
+        : loss(loss), baseScore(baseScore), numFeatures(numFeatures), featureImportance(numFeatures, 0.0L) {}
+
+    MLLIB_INLINE BoostingLoss GBDTModel::getLoss() const { return loss; }
+    MLLIB_INLINE long double GBDTModel::getBaseScore() const { return baseScore; }
+    MLLIB_INLINE size_t GBDTModel::getNumFeatures() const { return numFeatures; }
+    MLLIB_INLINE size_t GBDTModel::getNumTrees() const { return treeOffsets.size(); }
+    MLLIB_INLINE const std::vector<GBDTNode> &GBDTModel::getNodes() const { return nodes; }
+    MLLIB_INLINE const std::vector<uint32_t> &GBDTModel::getTreeOffsets() const { return treeOffsets; }
+    MLLIB_INLINE const std::vector<long double> &GBDTModel::getFeatureImportance() const { return featureImportance; }
+
+    MLLIB_INLINE bool GBDTModel::addTree(const std::vector<GBDTNode> &treeNodes)
+    {
+        if (!detail::isValidTree(treeNodes.data(), treeNodes.size(), 0, numFeatures) || nodes.size() + treeNodes.size() > std::numeric_limits<uint32_t>::max())
+            return false;
+
+        const uint32_t offset = static_cast<uint32_t>(nodes.size());
+        treeOffsets.push_back(offset);
+        for (GBDTNode node : treeNodes)
+        {
+            if (node.left != 0)
+                node.left += offset;
+            nodes.push_back(node);
+        }
+        return true;
+    }
+
+    MLLIB_INLINE void GBDTModel::setFeatureImportance(const std::vector<long double> &newFeatureImportance)
+    {
+        assert(newFeatureImportance.size() == numFeatures);
+        featureImportance = newFeatureImportance;
+    }
+
+    template <typename T>
+    double GBDTModel::rawScore(const T *xRow) const
+    {
+        double score = static_cast<double>(baseScore);
+        for (const uint32_t offset : treeOffsets)
+        {
+            const GBDTNode *node = nodes.data() + offset;
+            while (node->left != 0)
+            {
+                node = nodes.data() + node->left + (static_cast<double>(xRow[node->feature]) > node->value);
+            }
+            score += node->value;
+        }
+        return score;
+    }
+
+    template <typename T>
+    long double GBDTModel::predictRaw(std::span<const T> xRow) const
+    {
+        assert(xRow.size() == numFeatures);
+        return rawScore(xRow.data());
+    }
+
+    template <typename T>
+    long double GBDTModel::predict(std::span<const T> xRow) const
+    {
+        assert(xRow.size() == numFeatures);
+        const double score = rawScore(xRow.data());
+        return (loss == LogLoss) ? detail::sigmoid(score) : score;
+    }
+
+    template <typename T>
+    std::vector<long double> GBDTModel::predict(const DatasetView<T> &data, size_t numThreads) const
+    {
+        assert(data.getNumFeatures() == numFeatures);
+        const size_t blockSize = 256;
+        const size_t numBlocks = (data.size() + blockSize - 1) / blockSize;
+
+        // Depth of every tree; children follow their parent, so one backward sweep finds them
+        std::vector<uint32_t> depths(treeOffsets.size()), height(nodes.size(), 0);
+        for (size_t t = 0; t < treeOffsets.size(); ++t)
+        {
+            const size_t end = (t + 1 < treeOffsets.size()) ? treeOffsets[t + 1] : nodes.size();
+            for (size_t i = end; i-- > treeOffsets[t];)
+            {
+                if (nodes[i].left != 0)
+                    height[i] = 1 + std::max(height[nodes[i].left], height[nodes[i].left + 1]);
+            }
+            depths[t] = height[treeOffsets[t]];
+        }
+
+        // Copy of the nodes in which every leaf points to itself and never sends a row right
+        std::vector<GBDTNode> walk(nodes);
+        for (size_t i = 0; i < walk.size(); ++i)
+        {
+            if (walk[i].left == 0)
+                walk[i] = GBDTNode{0, static_cast<uint32_t>(i), std::numeric_limits<double>::infinity()};
+        }
+
+        std::vector<long double> predictions(data.size());
+        detail::parallelFor(numBlocks, detail::resolveThreadCount(numThreads), [&](size_t beginBlock, size_t endBlock, size_t)
+                            {
+                                const T *rows[blockSize];
+                                double scores[blockSize];
+                                for (size_t block = beginBlock; block < endBlock; ++block)
+                                {
+                                    const size_t first = block * blockSize;
+                                    const size_t count = std::min(blockSize, data.size() - first);
+                                    for (size_t r = 0; r < count; ++r)
+                                    {
+                                        rows[r] = data.row(first + r).data();
+                                        scores[r] = static_cast<double>(baseScore);
+                                    }
+
+                                    // Eight rows descend each tree in lockstep for depth steps, a row at a leaf staying put, so the
+                                    // walks overlap in the pipeline and the loop branches only on the depth
+                                    for (size_t t = 0; t < treeOffsets.size(); ++t)
+                                    {
+                                        const uint32_t root = treeOffsets[t];
+                                        size_t r = 0;
+                                        for (; r + 8 <= count; r += 8)
+                                        {
+                                            uint32_t index[8];
+                                            for (size_t k = 0; k < 8; ++k)
+                                                index[k] = root;
+                                            for (uint32_t step = 0; step < depths[t]; ++step)
+                                            {
+                                                for (size_t k = 0; k < 8; ++k)
+                                                {
+                                                    const GBDTNode &node = walk[index[k]];
+                                                    index[k] = node.left + (static_cast<double>(rows[r + k][node.feature]) > node.value);
+                                                }
+                                            }
+                                            for (size_t k = 0; k < 8; ++k)
+                                                scores[r + k] += nodes[index[k]].value;
+                                        }
+                                        for (; r < count; ++r)
+                                        {
+                                            const GBDTNode *node = nodes.data() + root;
+                                            while (node->left != 0)
+                                            {
+                                                node = nodes.data() + node->left + (static_cast<double>(rows[r][node->feature]) > node->value);
+                                            }
+                                            scores[r] += node->value;
+                                        }
+                                    }
+
+                                    for (size_t r = 0; r < count; ++r)
+                                        predictions[first + r] = (loss == LogLoss) ? detail::sigmoid(scores[r]) : scores[r];
+                                } });
+        return predictions;
+    }
+
+    template <typename T>
+    std::vector<int> GBDTModel::predictClasses(const DatasetView<T> &data, const long double threshold, size_t numThreads) const
+    {
+        const std::vector<long double> probabilities = predict(data, numThreads);
+        std::vector<int> classes(probabilities.size());
+        for (size_t i = 0; i < probabilities.size(); ++i)
+            classes[i] = (probabilities[i] >= threshold) ? 1 : 0;
+        return classes;
+    }
+
+    MLLIB_INLINE void GBDTModel::saveToFile(const std::string &filename) const
+    {
+        std::ofstream outFile(filename);
+        if (outFile.is_open())
+        {
+            outFile.precision(std::numeric_limits<long double>::max_digits10);
+            outFile << *this;
+            outFile.close();
+        }
+        else
+        {
+            std::cerr << "Unable to open file for writing." << std::endl;
+        }
+    }
+
+    MLLIB_INLINE void GBDTModel::loadFromFile(const std::string &filename)
+    {
+        if (detail::isBinaryModelFile(filename))
+        {
+            loadBinary(filename);
+            return;
+        }
+
+        std::ifstream inFile(filename);
+        if (inFile.is_open())
+        {
+            if (!(inFile >> *this))
+                std::cerr << "Invalid model file: truncated or malformed text model" << std::endl;
+            inFile.close();
+        }
+        else
+        {
+            std::cerr << "Unable to open file for reading." << std::endl;
+        }
+    }
+
+    MLLIB_INLINE bool GBDTModel::saveBinary(const std::string &filename) const
+    {
+        detail::PayloadWriter payload;
+        payload.write(featureImportance);
+        payload.write(static_cast<uint32_t>(loss));
+        payload.write(baseScore);
+        payload.write(static_cast<uint64_t>(treeOffsets.size()));
+        payload.write(static_cast<uint64_t>(nodes.size()));
+        for (const uint32_t offset : treeOffsets)
+            payload.write(offset);
+        for (const GBDTNode &node : nodes)
+            payload.write(node);
+
+        // The header's normalization type is not used by tree models; the coefficients are the feature importances
+        return detail::writeModelFile(filename, detail::GBDTModelFile, stat::NormalizationType(), featureImportance.size(), payload.buffer);
+    }
+
+    MLLIB_INLINE bool GBDTModel::loadBinary(const std::string &filename)
+    {
+        MappedFile file;
+        const detail::ModelFileHeader *header = detail::readModelFile(file, filename, detail::GBDTModelFile);
+        if (header == nullptr)
+            return false;
+
+        // Decode into a temporary so a malformed payload leaves this model untouched
+        GBDTModel model;
+        detail::PayloadReader payload(file.data() + sizeof(detail::ModelFileHeader), header->payloadSize);
+        uint32_t lossInt = 0;
+        uint64_t numTrees = 0, numNodes = 0;
+
+        bool valid = payload.read(model.featureImportance, header->numCoefficients) && payload.read(lossInt) && lossInt <= LogLoss &&
+                     payload.read(model.baseScore) && payload.read(numTrees) && payload.read(numNodes) &&
+                     numTrees <= numNodes && numNodes <= std::numeric_limits<uint32_t>::max();
+        for (uint64_t t = 0; valid && t < numTrees; ++t)
+        {
+            uint32_t offset = 0;
+            valid = payload.read(offset);
+            model.treeOffsets.push_back(offset);
+        }
+        for (uint64_t n = 0; valid && n < numNodes; ++n)
+        {
+            GBDTNode node;
+            valid = payload.read(node);
+            model.nodes.push_back(node);
+        }
+        model.numFeatures = header->numCoefficients;
+        valid = valid && payload.atEnd() && model.isValid();
+        if (!valid)
+        {
+            std::cerr << "Invalid model file: malformed payload" << std::endl;
+            return false;
+        }
+
+        model.loss = static_cast<BoostingLoss>(lossInt);
+        *this = std::move(model);
+        return true;
+    }
+
+    MLLIB_INLINE bool GBDTModel::isValid() const
+    {
+        if (featureImportance.size() != numFeatures || treeOffsets.empty() != nodes.empty() || nodes.size() > std::numeric_limits<uint32_t>::max())
+            return false;
+
+        // The trees tile the node array in order: the first starts at 0 and each ends where the next begins
+        for (size_t t = 0; t < treeOffsets.size(); ++t)
+        {
+            const size_t begin = treeOffsets[t];
+            const size_t end = (t + 1 < treeOffsets.size()) ? treeOffsets[t + 1] : nodes.size();
+            if ((t == 0 && begin != 0) || begin >= end || end > nodes.size() || !detail::isValidTree(nodes.data() + begin, end - begin, begin, numFeatures))
+                return false;
+        }
+        return true;
+    }
+
+    MLLIB_INLINE void GBDTModel::printInfo() const
+    {
+        size_t numLeaves = 0;
+        for (const GBDTNode &node : nodes)
+        {
+            numLeaves += (node.left == 0);
+        }
+
+        std::cout << "Gradient Boosted Trees Model:\n"
+                  << "Loss: " << ((loss == LogLoss) ? "log loss" : "squared error") << ", Features: " << numFeatures << "\n"
+                  << "Trees: " << getNumTrees() << ", Leaves: " << numLeaves << ", Base score: " << baseScore << "\n";
+
+        std::vector<size_t> order(numFeatures);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                  { return featureImportance[a] > featureImportance[b]; });
+        std::cout << "Most important features:";
+        for (size_t i = 0; i < std::min<size_t>(numFeatures, 5); ++i)
+        {
+            std::cout << " " << order[i] << " (" << featureImportance[order[i]] << ")";
+        }
+        std::cout << "\n";
+    }
+
+    template <typename T>
+    GBDTModel GradientBoosting(const DatasetView<T> &data, const GBDTOptions &options, const TrainingCallback &callback)
+    {
+        assert(!data.empty() && data.hasLabels() && data.getNumFeatures() > 0);
+        assert(options.maxBins >= 2 && options.maxBins <= 256 && options.maxLeaves >= 2);
+        assert(data.size() < std::numeric_limits<uint32_t>::max());
+        const size_t numRows = data.size(), numFeatures = data.getNumFeatures();
+        const size_t numThreads = detail::resolveThreadCount(options.numThreads);
+        const double learningRate = static_cast<double>(options.learningRate);
+        const double lambda = static_cast<double>(options.l2Regularization);
+        detail::TrainingMonitor monitor(callback);
+
+        const detail::BinnedFeatures binned = detail::binFeatures(data, options.maxBins, numThreads);
+        std::vector<double> labels(numRows);
+        double labelSum = 0.0;
+        for (size_t i = 0; i < numRows; ++i)
+        {
+            labels[i] = static_cast<double>(data.label(i));
+            labelSum += labels[i];
+        }
+
+        // Start from the constant that minimizes the loss
+        double baseScore = labelSum / numRows;
+        if (options.loss == LogLoss)
+        {
+            const double positiveRate = std::clamp(baseScore, 1e-6, 1.0 - 1e-6);
+            baseScore = std::log(positiveRate / (1.0 - positiveRate));
+        }
+        GBDTModel model(options.loss, baseScore, numFeatures);
+        std::vector<long double> importance(numFeatures, 0.0L);
+
+        std::vector<double> scores(numRows, baseScore), gradients(numRows), hessians(numRows);
+        std::vector<uint32_t> rowOrder(numRows), scratch(numRows);
+        std::vector<std::vector<detail::GradientBin>> threadHistograms(numThreads - 1), histogramPool;
+
+        // A leaf of the growing tree: its rows are rowOrder[begin, end)
+        struct GrowingLeaf
+        {
+            size_t begin, end, depth;
+            uint32_t node;
+            detail::GradientBin total;
+            std::vector<detail::GradientBin> histogram; // Empty once the leaf cannot be split further
+            detail::SplitCandidate split;
+        };
+
+        auto takeHistogram = [&]()
+        {
+            std::vector<detail::GradientBin> histogram;
+            if (!histogramPool.empty())
             {
-                newConfusionMatrix.truePositive++;
+                histogram = std::move(histogramPool.back());
+                histogramPool.pop_back();
             }
-            else if (predictedClass == 0 && actualValue == 0)
+            return histogram;
+        };
+
+        auto canSplit = [&](const GrowingLeaf &leaf)
+        {
+            return (options.maxDepth == 0 || leaf.depth < options.maxDepth) && leaf.end - leaf.begin >= 2 * std::max<size_t>(1, options.minSamplesLeaf);
+        };
+
+        // Find the best split of a leaf whose histogram is built, then release the histogram if no split is possible
+        auto prepare = [&](GrowingLeaf &leaf)
+        {
+            leaf.split = canSplit(leaf) ? detail::findBestSplit(binned, leaf.histogram, leaf.total, options) : detail::SplitCandidate();
+            if (leaf.split.gain <= static_cast<double>(options.minSplitGain))
             {
-                newConfusionMatrix.trueNegative++;
+                leaf.split.gain = 0.0;
+                histogramPool.push_back(std::move(leaf.histogram));
+                leaf.histogram.clear();
             }
-            else if (predictedClass == 1 && actualValue == 0)
+        };
+
+        for (size_t tree = 0; tree < options.numTrees; ++tree)
+        {
+            ScopedTimer timer("GradientBoosting::tree");
+
+            detail::parallelFor(numRows, numThreads, [&](size_t begin, size_t end, size_t)
+                                {
+                                    for (size_t i = begin; i < end; ++i)
+                                    {
+                                        if (options.loss == LogLoss)
+                                        {
+                                            const double p = detail::sigmoid(scores[i]);
+                                            gradients[i] = p - labels[i];
+                                            hessians[i] = std::max(p * (1.0 - p), 1e-16);
+                                        }
+                                        else
+                                        {
+                                            gradients[i] = scores[i] - labels[i];
+                                            hessians[i] = 1.0;
+                                        }
+                                    } });
+
+            std::iota(rowOrder.begin(), rowOrder.end(), 0);
+            std::vector<GBDTNode> treeNodes(1);
+            std::vector<GrowingLeaf> leaves(1);
+            GrowingLeaf &root = leaves[0];
+            root.begin = 0;
+            root.end = numRows;
+            root.depth = 0;
+            root.node = 0;
+            root.histogram = takeHistogram();
+            detail::buildHistogram(binned, rowOrder.data(), numRows, gradients, hessians, root.histogram, threadHistograms, numThreads);
+            for (size_t b = 0; b < binned.binOffsets[1]; ++b)
             {
-                newConfusionMatrix.falsePositive++;
+                root.total.gradient += root.histogram[b].gradient;
+                root.total.hessian += root.histogram[b].hessian;
+                root.total.count += root.histogram[b].count;
             }
-            else if (predictedClass == 0 && actualValue == 1)
+            prepare(root);
+
+            // Leaf-wise growth: always split the leaf whose best split reduces the loss most
+            while (leaves.size() < options.maxLeaves)
             {
-                newConfusionMatrix.falseNegative++;
+                size_t best = leaves.size();
+                for (size_t l = 0; l < leaves.size(); ++l)
+                {
+                    if (leaves[l].split.gain > 0.0 && (best == leaves.size() || leaves[l].split.gain > leaves[best].split.gain))
+                        best = l;
+                }
+                if (best == leaves.size())
+                    break;
+
+                GrowingLeaf parent = std::move(leaves[best]);
+                const detail::SplitCandidate split = parent.split;
+                importance[split.feature] += split.gain;
+
+                // Stable partition, so the rows of each leaf stay in ascending order for the histogram passes
+                size_t numLeft = 0, numRight = 0;
+                for (size_t i = parent.begin; i < parent.end; ++i)
+                {
+                    const uint32_t row = rowOrder[i];
+                    if (binned.bins[static_cast<size_t>(row) * numFeatures + split.feature] <= split.bin)
+                        rowOrder[parent.begin + numLeft++] = row;
+                    else
+                        scratch[numRight++] = row;
+                }
+                std::copy(scratch.begin(), scratch.begin() + numRight, rowOrder.begin() + parent.begin + numLeft);
+
+                const uint32_t leftNode = static_cast<uint32_t>(treeNodes.size());
+                treeNodes[parent.node].feature = split.feature;
+                treeNodes[parent.node].left = leftNode;
+                treeNodes[parent.node].value = binned.bounds[split.feature][split.bin];
+                treeNodes.resize(treeNodes.size() + 2);
+
+                GrowingLeaf left, right;
+                left.begin = parent.begin;
+                left.end = right.begin = parent.begin + numLeft;
+                right.end = parent.end;
+                left.depth = right.depth = parent.depth + 1;
+                left.node = leftNode;
+                right.node = leftNode + 1;
+                left.total = split.left;
+                right.total.gradient = parent.total.gradient - split.left.gradient;
+                right.total.hessian = parent.total.hessian - split.left.hessian;
+                right.total.count = parent.total.count - split.left.count;
+
+                // Build the histogram of the smaller child and subtract it from the parent's for the larger one
+                if (canSplit(left) || canSplit(right))
+                {
+                    GrowingLeaf &smaller = (numLeft <= numRight) ? left : right;
+                    GrowingLeaf &larger = (numLeft <= numRight) ? right : left;
+                    smaller.histogram = takeHistogram();
+                    detail::buildHistogram(binned, rowOrder.data() + smaller.begin, smaller.end - smaller.begin, gradients, hessians, smaller.histogram, threadHistograms, numThreads);
+
+                    larger.histogram = std::move(parent.histogram);
+                    for (size_t b = 0; b < larger.histogram.size(); ++b)
+                    {
+                        larger.histogram[b].gradient -= smaller.histogram[b].gradient;
+                        larger.histogram[b].hessian -= smaller.histogram[b].hessian;
+                        larger.histogram[b].count -= smaller.histogram[b].count;
+                    }
+                    prepare(left);
+                    prepare(right);
+                }
+                else
+                {
+                    histogramPool.push_back(std::move(parent.histogram));
+                }
+
+                leaves[best] = std::move(left);
+                leaves.push_back(std::move(right));
+            }
+
+            // Leaf values are Newton steps, shrunk by the learning rate; each leaf updates the scores of its rows
+            for (GrowingLeaf &leaf : leaves)
+            {
+                const double value = -learningRate * leaf.total.gradient / (leaf.total.hessian + lambda);
+                treeNodes[leaf.node].value = value;
+                for (size_t i = leaf.begin; i < leaf.end; ++i)
+                    scores[rowOrder[i]] += value;
+                if (!leaf.histogram.empty())
+                    histogramPool.push_back(std::move(leaf.histogram));
+            }
+            model.addTree(treeNodes);
+
+            if (monitor.active())
+            {
+                long double totalLoss = 0.0L, squaredGradient = 0.0L;
+                for (size_t i = 0; i < numRows; ++i)
+                {
+                    if (options.loss == LogLoss)
+                        totalLoss += detail::logisticLoss(detail::sigmoid(scores[i]), labels[i]);
+                    else
+                        totalLoss += (scores[i] - labels[i]) * (scores[i] - labels[i]);
+                    squaredGradient += gradients[i] * gradients[i];
+                }
+                monitor.reportMean(totalLoss / numRows, std::sqrt(squaredGradient) / numRows, numRows);
             }
         }
 
-        setConfusionMatrix(newConfusionMatrix);
+        model.setFeatureImportance(importance);
+        return model;
+    }
 
-        long double accuracy = static_cast<long double>(newConfusionMatrix.truePositive + newConfusionMatrix.trueNegative) / dataSize * 100.0;
-        long double recall = static_cast<long double>(newConfusionMatrix.truePositive) / (newConfusionMatrix.truePositive + newConfusionMatrix.falseNegative) * 100.0;
-        long double precision = static_cast<long double>(newConfusionMatrix.truePositive) / (newConfusionMatrix.truePositive + newConfusionMatrix.falsePositive) * 100.0;
-        long double f1Score = 2 * precision * recall / (precision + recall);
+    template <typename T>
+    GBDTModel GradientBoosting(const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues, const GBDTOptions &options, const TrainingCallback &callback)
+    {
+        const Dataset<T> dataset(xValues, yValues);
+        return GradientBoosting(dataset.view(), options, callback);
+    }
 
-        // Set the evaluation metrics
-        setEvaluationMetrics({accuracy, recall, precision, f1Score});
+    template <typename T>
+    ClassificationMetrics EvaluateClassification(const GBDTModel &model, const DatasetView<T> &data, const long double threshold)
+    {
+        const std::vector<int> predictedClasses = model.predictClasses(data, threshold);
+        std::vector<T> actualYValues(data.size());
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            actualYValues[i] = data.label(i);
+        }
+        return EvaluateClassification(std::span<const T>(actualYValues), std::span<const int>(predictedClasses));
+    }
+
+#if !defined(MLLIB_HEADER_ONLY)
+    template long double GBDTModel::predictRaw(std::span<const int8_t> xRow) const;
+    template long double GBDTModel::predictRaw(std::span<const int16_t> xRow) const;
+    template long double GBDTModel::predictRaw(std::span<const int32_t> xRow) const;
+    template long double GBDTModel::predictRaw(std::span<const int64_t> xRow) const;
+
+    template long double GBDTModel::predictRaw(std::span<const uint8_t> xRow) const;
+    template long double GBDTModel::predictRaw(std::span<const uint16_t> xRow) const;
+    template long double GBDTModel::predictRaw(std::span<const uint32_t> xRow) const;
+    template long double GBDTModel::predictRaw(std::span<const uint64_t> xRow) const;
+
+    template long double GBDTModel::predictRaw(std::span<const float> xRow) const;
+    template long double GBDTModel::predictRaw(std::span<const double> xRow) const;
+    template long double GBDTModel::predictRaw(std::span<const long double> xRow) const;
+
+    template long double GBDTModel::predict(std::span<const int8_t> xRow) const;
+    template long double GBDTModel::predict(std::span<const int16_t> xRow) const;
+    template long double GBDTModel::predict(std::span<const int32_t> xRow) const;
+    template long double GBDTModel::predict(std::span<const int64_t> xRow) const;
+
+    template long double GBDTModel::predict(std::span<const uint8_t> xRow) const;
+    template long double GBDTModel::predict(std::span<const uint16_t> xRow) const;
+    template long double GBDTModel::predict(std::span<const uint32_t> xRow) const;
+    template long double GBDTModel::predict(std::span<const uint64_t> xRow) const;
+
+    template long double GBDTModel::predict(std::span<const float> xRow) const;
+    template long double GBDTModel::predict(std::span<const double> xRow) const;
+    template long double GBDTModel::predict(std::span<const long double> xRow) const;
+
+    template std::vector<long double> GBDTModel::predict(const DatasetView<int8_t> &data, size_t numThreads) const;
+    template std::vector<long double> GBDTModel::predict(const DatasetView<int16_t> &data, size_t numThreads) const;
+    template std::vector<long double> GBDTModel::predict(const DatasetView<int32_t> &data, size_t numThreads) const;
+    template std::vector<long double> GBDTModel::predict(const DatasetView<int64_t> &data, size_t numThreads) const;
+
+    template std::vector<long double> GBDTModel::predict(const DatasetView<uint8_t> &data, size_t numThreads) const;
+    template std::vector<long double> GBDTModel::predict(const DatasetView<uint16_t> &data, size_t numThreads) const;
+    template std::vector<long double> GBDTModel::predict(const DatasetView<uint32_t> &data, size_t numThreads) const;
+    template std::vector<long double> GBDTModel::predict(const DatasetView<uint64_t> &data, size_t numThreads) const;
+
+    template std::vector<long double> GBDTModel::predict(const DatasetView<float> &data, size_t numThreads) const;
+    template std::vector<long double> GBDTModel::predict(const DatasetView<double> &data, size_t numThreads) const;
+    template std::vector<long double> GBDTModel::predict(const DatasetView<long double> &data, size_t numThreads) const;
+
+    template std::vector<int> GBDTModel::predictClasses(const DatasetView<int8_t> &data, const long double threshold, size_t numThreads) const;
+    template std::vector<int> GBDTModel::predictClasses(const DatasetView<int16_t> &data, const long double threshold, size_t numThreads) const;
+    template std::vector<int> GBDTModel::predictClasses(const DatasetView<int32_t> &data, const long double threshold, size_t numThreads) const;
+    template std::vector<int> GBDTModel::predictClasses(const DatasetView<int64_t> &data, const long double threshold, size_t numThreads) const;
+
+    template std::vector<int> GBDTModel::predictClasses(const DatasetView<uint8_t> &data, const long double threshold, size_t numThreads) const;
+    template std::vector<int> GBDTModel::predictClasses(const DatasetView<uint16_t> &data, const long double threshold, size_t numThreads) const;
+    template std::vector<int> GBDTModel::predictClasses(const DatasetView<uint32_t> &data, const long double threshold, size_t numThreads) const;
+    template std::vector<int> GBDTModel::predictClasses(const DatasetView<uint64_t> &data, const long double threshold, size_t numThreads) const;
+
+    template std::vector<int> GBDTModel::predictClasses(const DatasetView<float> &data, const long double threshold, size_t numThreads) const;
+    template std::vector<int> GBDTModel::predictClasses(const DatasetView<double> &data, const long double threshold, size_t numThreads) const;
+    template std::vector<int> GBDTModel::predictClasses(const DatasetView<long double> &data, const long double threshold, size_t numThreads) const;
+
+    template GBDTModel GradientBoosting(const DatasetView<int8_t> &data, const GBDTOptions &options, const TrainingCallback &callback);
+    template GBDTModel GradientBoosting(const DatasetView<int16_t> &data, const GBDTOptions &options, const TrainingCallback &callback);
+    template GBDTModel GradientBoosting(const DatasetView<int32_t> &data, const GBDTOptions &options, const TrainingCallback &callback);
+    template GBDTModel GradientBoosting(const DatasetView<int64_t> &data, const GBDTOptions &options, const TrainingCallback &callback);
+
+    template GBDTModel GradientBoosting(const DatasetView<uint8_t> &data, const GBDTOptions &options, const TrainingCallback &callback);
+    template GBDTModel GradientBoosting(const DatasetView<uint16_t> &data, const GBDTOptions &options, const TrainingCallback &callback);
+    template GBDTModel GradientBoosting(const DatasetView<uint32_t> &data, const GBDTOptions &options, const TrainingCallback &callback);
+    template GBDTModel GradientBoosting(const DatasetView<uint64_t> &data, const GBDTOptions &options, const TrainingCallback &callback);
+
+    template GBDTModel GradientBoosting(const DatasetView<float> &data, const GBDTOptions &options, const TrainingCallback &callback);
+    template GBDTModel GradientBoosting(const DatasetView<double> &data, const GBDTOptions &options, const TrainingCallback &callback);
+    template GBDTModel GradientBoosting(const DatasetView<long double> &data, const GBDTOptions &options, const TrainingCallback &callback);
+
+    template GBDTModel GradientBoosting(const std::vector<std::vector<int8_t>> &xValues, const std::vector<int8_t> &yValues, const GBDTOptions &options, const TrainingCallback &callback);
+    template GBDTModel GradientBoosting(const std::vector<std::vector<int16_t>> &xValues, const std::vector<int16_t> &yValues, const GBDTOptions &options, const TrainingCallback &callback);
+    template GBDTModel GradientBoosting(const std::vector<std::vector<int32_t>> &xValues, const std::vector<int32_t> &yValues, const GBDTOptions &options, const TrainingCallback &callback);
+    template GBDTModel GradientBoosting(const std::vector<std::vector<int64_t>> &xValues, const std::vector<int64_t> &yValues, const GBDTOptions &options, const TrainingCallback &callback);
+
+    template GBDTModel GradientBoosting(const std::vector<std::vector<uint8_t>> &xValues, const std::vector<uint8_t> &yValues, const GBDTOptions &options, const TrainingCallback &callback);
+    template GBDTModel GradientBoosting(const std::vector<std::vector<uint16_t>> &xValues, const std::vector<uint16_t> &yValues, const GBDTOptions &options, const TrainingCallback &callback);
+    template GBDTModel GradientBoosting(const std::vector<std::vector<uint32_t>> &xValues, const std::vector<uint32_t> &yValues, const GBDTOptions &options, const TrainingCallback &callback);
+    template GBDTModel GradientBoosting(const std::vector<std::vector<uint64_t>> &xValues, const std::vector<uint64_t> &yValues, const GBDTOptions &options, const TrainingCallback &callback);
+
+    template GBDTModel GradientBoosting(const std::vector<std::vector<float>> &xValues, const std::vector<float> &yValues, const GBDTOptions &options, const TrainingCallback &callback);
+    template GBDTModel GradientBoosting(const std::vector<std::vector<double>> &xValues, const std::vector<double> &yValues, const GBDTOptions &options, const TrainingCallback &callback);
+    template GBDTModel GradientBoosting(const std::vector<std::vector<long double>> &xValues, const std::vector<long double> &yValues, const GBDTOptions &options, const TrainingCallback &callback);
+
+    template ClassificationMetrics EvaluateClassification(const GBDTModel &model, const DatasetView<int8_t> &data, const long double threshold);
+    template ClassificationMetrics EvaluateClassification(const GBDTModel &model, const DatasetView<int16_t> &data, const long double threshold);
+    template ClassificationMetrics EvaluateClassification(const GBDTModel &model, const DatasetView<int32_t> &data, const long double threshold);
+    template ClassificationMetrics EvaluateClassification(const GBDTModel &model, const DatasetView<int64_t> &data, const long double threshold);
+
+    template ClassificationMetrics EvaluateClassification(const GBDTModel &model, const DatasetView<uint8_t> &data, const long double threshold);
+    template ClassificationMetrics EvaluateClassification(const GBDTModel &model, const DatasetView<uint16_t> &data, const long double threshold);
+    template ClassificationMetrics EvaluateClassification(const GBDTModel &model, const DatasetView<uint32_t> &data, const long double threshold);
+    template ClassificationMetrics EvaluateClassification(const GBDTModel &model, const DatasetView<uint64_t> &data, const long double threshold);
+
+    template ClassificationMetrics EvaluateClassification(const GBDTModel &model, const DatasetView<float> &data, const long double threshold);
+    template ClassificationMetrics EvaluateClassification(const GBDTModel &model, const DatasetView<double> &data, const long double threshold);
+    template ClassificationMetrics EvaluateClassification(const GBDTModel &model, const DatasetView<long double> &data, const long double threshold);
+#endif
+
+
+    MLLIB_INLINE NaiveBayesModel::NaiveBayesModel() {}
+
+    MLLIB_INLINE NaiveBayesModel::NaiveBayesModel(const NaiveBayesOptions &options) : options(options) {}
+
+    MLLIB_INLINE NaiveBayesType NaiveBayesModel::getType() const { return options.type; }
+    MLLIB_INLINE const NaiveBayesOptions &NaiveBayesModel::getOptions() const { return options; }
+    MLLIB_INLINE size_t NaiveBayesModel::getNumFeatures() const { return numFeatures; }
+    MLLIB_INLINE size_t NaiveBayesModel::getNumClasses() const { return classes.size(); }
+    MLLIB_INLINE const std::vector<int> &NaiveBayesModel::getClasses() const { return classes; }
+    MLLIB_INLINE const std::vector<long double> &NaiveBayesModel::getClassCounts() const { return classCounts; }
+    MLLIB_INLINE const std::vector<long double> &NaiveBayesModel::getFeatureSums() const { return featureSums; }
+    MLLIB_INLINE const std::vector<long double> &NaiveBayesModel::getSquaredDeviations() const { return squaredDeviations; }
+
+    MLLIB_INLINE void NaiveBayesModel::updateParameters()
+    {
+        const size_t numClasses = classes.size();
+        const bool gaussian = (options.type == GaussianNaiveBayes);
+        const size_t numScoring = gaussian ? 2 * numFeatures : numFeatures;
+        weights.assign(numScoring * numClasses, 0.0);
+        biases.assign(numClasses, 0.0);
+        shift.assign(gaussian ? numFeatures : 0, 0.0);
+        if (numClasses == 0)
+            return;
+
+        // Log priors
+        const long double totalCount = std::accumulate(classCounts.begin(), classCounts.end(), 0.0L);
+        for (size_t c = 0; c < numClasses; ++c)
+            biases[c] = static_cast<double>(std::log(classCounts[c] / totalCount));
+
+        // A zero smoothing would give log(0) weights, and 0 * -infinity for absent features
+        const long double alpha = std::max(options.alpha, 1e-10L);
+        switch (options.type)
+        {
+        case MultinomialNaiveBayes:
+            for (size_t c = 0; c < numClasses; ++c)
+            {
+                const long double *sums = featureSums.data() + c * numFeatures;
+                const long double total = std::accumulate(sums, sums + numFeatures, 0.0L) + alpha * numFeatures;
+                for (size_t j = 0; j < numFeatures; ++j)
+                    weights[j * numClasses + c] = static_cast<double>(std::log((sums[j] + alpha) / total));
+            }
+            break;
+
+        case BernoulliNaiveBayes:
+            // log P(x | c) = sum over features of log P(absent) + x * (log P(present) - log P(absent))
+            for (size_t c = 0; c < numClasses; ++c)
+            {
+                for (size_t j = 0; j < numFeatures; ++j)
+                {
+                    const double p = static_cast<double>((featureSums[c * numFeatures + j] + alpha) / (classCounts[c] + 2.0L * alpha));
+                    const double absent = prob::logBinomialProbability(1, 0, p);
+                    weights[j * numClasses + c] = prob::logBinomialProbability(1, 1, p) - absent;
+                    biases[c] += absent;
+                }
+            }
+            break;
+
+        case GaussianNaiveBayes:
+        {
+            // Values are shifted by the overall feature means, so the quadratic expansion
+            // -(x - mean)^2 / (2 variance) = x mean / variance - x^2 / (2 variance) - mean^2 / (2 variance) does not cancel
+            std::vector<long double> variances(numFeatures, 0.0L);
+            for (size_t j = 0; j < numFeatures; ++j)
+            {
+                long double sum = 0.0L;
+                for (size_t c = 0; c < numClasses; ++c)
+                    sum += featureSums[c * numFeatures + j];
+                shift[j] = static_cast<double>(sum / totalCount);
+
+                long double squares = 0.0L;
+                for (size_t c = 0; c < numClasses; ++c)
+                {
+                    const long double deviation = featureSums[c * numFeatures + j] / classCounts[c] - shift[j];
+                    squares += squaredDeviations[c * numFeatures + j] + classCounts[c] * deviation * deviation;
+                }
+                variances[j] = squares / totalCount;
+            }
+            long double epsilon = options.varianceSmoothing * *std::max_element(variances.begin(), variances.end());
+            if (epsilon <= 0.0L)
+                epsilon = 1e-9L;
 
-        size_t correctPredictions = newConfusionMatrix.truePositive + newConfusionMatrix.trueNegative;
-        return static_cast<long double>(correctPredictions) / dataSize * 100.0;
+            for (size_t c = 0; c < numClasses; ++c)
+            {
+                for (size_t j = 0; j < numFeatures; ++j)
+                {
+                    const double mean = static_cast<double>(featureSums[c * numFeatures + j] / classCounts[c] - shift[j]);
+                    const double variance = static_cast<double>(squaredDeviations[c * numFeatures + j] / classCounts[c] + epsilon);
+                    weights[j * numClasses + c] = mean / variance;
+                    weights[(numFeatures + j) * numClasses + c] = -0.5 / variance;
+                    biases[c] += prob::normalLogDensity(0.0, mean, variance);
+                }
+            }
+            break;
+        }
+        }
     }
 
-    template long double mlLib::LogisticRegressionModel::evaluate<int8_t>(const std::vector<int8_t> &actualYValues, const std::vector<int> &predictedClasses);
-    template long double mlLib::LogisticRegressionModel::evaluate<int16_t>(const std::vector<int16_t> &actualYValues, const std::vector<int> &predictedClasses);
-    template long double mlLib::LogisticRegressionModel::evaluate<int32_t>(const std::vector<int32_t> &actualYValues, const std::vector<int> &predictedClasses);
-    template long double mlLib::LogisticRegressionModel::evaluate<int64_t>(const std::vector<int64_t> &actualYValues, const std::vector<int> &predictedClasses);
+    template <typename T>
+    void NaiveBayesModel::scoringFeatures(std::span<const T> xRow, double *out) const
+    {
+        for (size_t j = 0; j < numFeatures; ++j)
+        {
+            const double value = static_cast<double>(xRow[j]);
+            if (options.type == MultinomialNaiveBayes)
+            {
+                out[j] = value;
+            }
+            else if (options.type == BernoulliNaiveBayes)
+            {
+                out[j] = (value > static_cast<double>(options.binarizeThreshold)) ? 1.0 : 0.0;
+            }
+            else
+            {
+                out[j] = value - shift[j];
+                out[numFeatures + j] = out[j] * out[j];
+            }
+        }
+    }
 
-    template long double mlLib::LogisticRegressionModel::evaluate<uint8_t>(const std::vector<uint8_t> &actualYValues, const std::vector<int> &predictedClasses);
-    template long double mlLib::LogisticRegressionModel::evaluate<uint16_t>(const std::vector<uint16_t> &actualYValues, const std::vector<int> &predictedClasses);
-    template long double mlLib::LogisticRegressionModel::evaluate<uint32_t>(const std::vector<uint32_t> &actualYValues, const std::vector<int> &predictedClasses);
-    template long double mlLib::LogisticRegressionModel::evaluate<uint64_t>(const std::vector<uint64_t> &actualYValues, const std::vector<int> &predictedClasses);
+    // Log posteriors of the rows of a view, block by block: the scoring features of 64 rows times the
+    // weights, plus the biases, then normalized by log-sum-exp. Calls visit(position, logPosteriors).
+    template <typename T, typename Visit>
+    void NaiveBayesModel::scoreRows(const DatasetView<T> &data, size_t numThreads, Visit visit) const
+    {
+        assert(data.getNumFeatures() == numFeatures && !classes.empty());
+        const size_t numClasses = classes.size();
+        const size_t numScoring = weights.size() / numClasses;
+        const size_t blockSize = 64;
+        const size_t numBlocks = (data.size() + blockSize - 1) / blockSize;
+
+        detail::parallelFor(numBlocks, detail::resolveThreadCount(numThreads), [&](size_t beginBlock, size_t endBlock, size_t)
+                            {
+                                std::vector<double> features(blockSize * numScoring), logJoint(blockSize * numClasses);
+                                for (size_t block = beginBlock; block < endBlock; ++block)
+                                {
+                                    const size_t first = block * blockSize;
+                                    const size_t count = std::min(blockSize, data.size() - first);
+                                    for (size_t r = 0; r < count; ++r)
+                                    {
+                                        scoringFeatures(data.row(first + r), features.data() + r * numScoring);
+                                        std::copy(biases.begin(), biases.end(), logJoint.begin() + r * numClasses);
+                                    }
+
+                                    detail::gemmAccumulate(features.data(), numScoring, 1, weights.data(), numClasses, logJoint.data(), numClasses, count, numClasses, numScoring);
+
+                                    for (size_t r = 0; r < count; ++r)
+                                    {
+                                        double *row = logJoint.data() + r * numClasses;
+                                        const double evidence = prob::logSumExp(std::span<const double>(row, numClasses));
+                                        for (size_t c = 0; c < numClasses; ++c)
+                                            row[c] -= evidence;
+                                        visit(first + r, static_cast<const double *>(row));
+                                    }
+                                } });
+    }
 
-    template long double mlLib::LogisticRegressionModel::evaluate<float>(const std::vector<float> &actualYValues, const std::vector<int> &predictedClasses);
-    template long double mlLib::LogisticRegressionModel::evaluate<double>(const std::vector<double> &actualYValues, const std::vector<int> &predictedClasses);
-    template long double mlLib::LogisticRegressionModel::evaluate<long double>(const std::vector<long double> &actualYValues, const std::vector<int> &predictedClasses);
+    template <typename T>
+    void NaiveBayesModel::partialFit(const DatasetView<T> &data)
+    {
+        assert(data.hasLabels() && !data.empty());
+        if (numFeatures == 0)
+            numFeatures = data.getNumFeatures();
+        assert(data.getNumFeatures() == numFeatures);
+
+        // Classes of this batch
+        std::vector<int> labels(data.size());
+        for (size_t i = 0; i < data.size(); ++i)
+            labels[i] = static_cast<int>(std::lround(static_cast<long double>(data.label(i))));
+        std::vector<int> batchClasses(labels);
+        std::sort(batchClasses.begin(), batchClasses.end());
+        batchClasses.erase(std::unique(batchClasses.begin(), batchClasses.end()), batchClasses.end());
+        const size_t numClasses = batchClasses.size();
+
+        // One pass per thread over its rows. Gaussian sums are of the values minus the first row, which keeps
+        // the sums of squares from cancelling when the values are far from zero.
+        const bool gaussian = (options.type == GaussianNaiveBayes);
+        const bool bernoulli = (options.type == BernoulliNaiveBayes);
+        std::vector<double> origin(numFeatures, 0.0);
+        if (gaussian)
+        {
+            for (size_t j = 0; j < numFeatures; ++j)
+                origin[j] = static_cast<double>(data.row(0)[j]);
+        }
+
+        struct ClassSums
+        {
+            std::vector<size_t> counts;
+            std::vector<double> sums, squares;
+        };
+        const size_t numThreads = std::min(detail::resolveThreadCount(options.numThreads), data.size());
+        std::vector<ClassSums> threadSums(numThreads);
+        detail::parallelFor(data.size(), numThreads, [&](size_t begin, size_t end, size_t threadIndex)
+                            {
+                                ClassSums &local = threadSums[threadIndex];
+                                local.counts.assign(numClasses, 0);
+                                local.sums.assign(numClasses * numFeatures, 0.0);
+                                local.squares.assign(gaussian ? numClasses * numFeatures : 0, 0.0);
+                                for (size_t i = begin; i < end; ++i)
+                                {
+                                    const size_t c = std::lower_bound(batchClasses.begin(), batchClasses.end(), labels[i]) - batchClasses.begin();
+                                    const std::span<const T> row = data.row(i);
+                                    double *sums = local.sums.data() + c * numFeatures;
+                                    ++local.counts[c];
+                                    if (gaussian)
+                                    {
+                                        double *squares = local.squares.data() + c * numFeatures;
+                                        for (size_t j = 0; j < numFeatures; ++j)
+                                        {
+                                            const double value = static_cast<double>(row[j]) - origin[j];
+                                            sums[j] += value;
+                                            squares[j] += value * value;
+                                        }
+                                    }
+                                    else if (bernoulli)
+                                    {
+                                        for (size_t j = 0; j < numFeatures; ++j)
+                                            sums[j] += (static_cast<double>(row[j]) > static_cast<double>(options.binarizeThreshold)) ? 1.0 : 0.0;
+                                    }
+                                    else
+                                    {
+                                        for (size_t j = 0; j < numFeatures; ++j)
+                                            sums[j] += static_cast<double>(row[j]);
+                                    }
+                                } });
+
+        // Statistics of the batch, merged into this model
+        NaiveBayesModel batch(options);
+        batch.numFeatures = numFeatures;
+        batch.classes = batchClasses;
+        batch.classCounts.assign(numClasses, 0.0L);
+        batch.featureSums.assign(numClasses * numFeatures, 0.0L);
+        batch.squaredDeviations.assign(gaussian ? numClasses * numFeatures : 0, 0.0L);
+        for (const ClassSums &local : threadSums)
+        {
+            for (size_t c = 0; c < numClasses; ++c)
+                batch.classCounts[c] += local.counts[c];
+            for (size_t k = 0; k < local.sums.size(); ++k)
+                batch.featureSums[k] += local.sums[k];
+            for (size_t k = 0; k < local.squares.size(); ++k)
+                batch.squaredDeviations[k] += local.squares[k];
+        }
+        if (gaussian)
+        {
+            for (size_t c = 0; c < numClasses; ++c)
+            {
+                for (size_t j = 0; j < numFeatures; ++j)
+                {
+                    long double &sum = batch.featureSums[c * numFeatures + j];
+                    long double &squares = batch.squaredDeviations[c * numFeatures + j];
+                    squares = std::max(0.0L, squares - sum * sum / batch.classCounts[c]);
+                    sum += batch.classCounts[c] * origin[j];
+                }
+            }
+        }
+
+        merge(batch);
+    }
+
+    MLLIB_INLINE void NaiveBayesModel::merge(const NaiveBayesModel &other)
+    {
+        if (other.classes.empty())
+            return;
+        if (classes.empty())
+            numFeatures = other.numFeatures;
+        assert(other.options.type == options.type && other.numFeatures == numFeatures);
+
+        std::vector<int> mergedClasses;
+        std::set_union(classes.begin(), classes.end(), other.classes.begin(), other.classes.end(), std::back_inserter(mergedClasses));
+        const bool gaussian = (options.type == GaussianNaiveBayes);
+        std::vector<long double> counts(mergedClasses.size(), 0.0L), sums(mergedClasses.size() * numFeatures, 0.0L);
+        std::vector<long double> deviations(gaussian ? sums.size() : 0, 0.0L);
+
+        // Counts and sums add up; squared deviations are combined with the update of Chan, Golub and LeVeque
+        auto add = [&](const NaiveBayesModel &source)
+        {
+            for (size_t sourceClass = 0; sourceClass < source.classes.size(); ++sourceClass)
+            {
+                const size_t c = std::lower_bound(mergedClasses.begin(), mergedClasses.end(), source.classes[sourceClass]) - mergedClasses.begin();
+                const long double countA = counts[c], countB = source.classCounts[sourceClass];
+                for (size_t j = 0; j < numFeatures; ++j)
+                {
+                    const long double sumB = source.featureSums[sourceClass * numFeatures + j];
+                    if (gaussian)
+                    {
+                        long double &squares = deviations[c * numFeatures + j];
+                        squares += source.squaredDeviations[sourceClass * numFeatures + j];
+                        if (countA > 0.0L)
+                        {
+                            const long double delta = sumB / countB - sums[c * numFeatures + j] / countA;
+                            squares += delta * delta * countA * countB / (countA + countB);
+                        }
+                    }
+                    sums[c * numFeatures + j] += sumB;
+                }
+                counts[c] += countB;
+            }
+        };
+        add(*this);
+        add(other);
+
+        classes = std::move(mergedClasses);
+        classCounts = std::move(counts);
+        featureSums = std::move(sums);
+        squaredDeviations = std::move(deviations);
+        updateParameters();
+    }
+
+    template <typename T>
+    std::vector<long double> NaiveBayesModel::predictLogProbabilities(std::span<const T> xRow) const
+    {
+        assert(xRow.size() == numFeatures && !classes.empty());
+        const size_t numClasses = classes.size();
+        const size_t numScoring = weights.size() / numClasses;
+        std::vector<double> features(numScoring), logJoint(biases);
+        scoringFeatures(xRow, features.data());
+        for (size_t k = 0; k < numScoring; ++k)
+        {
+            for (size_t c = 0; c < numClasses; ++c)
+                logJoint[c] += features[k] * weights[k * numClasses + c];
+        }
+
+        const double evidence = prob::logSumExp(logJoint);
+        std::vector<long double> logPosteriors(numClasses);
+        for (size_t c = 0; c < numClasses; ++c)
+            logPosteriors[c] = logJoint[c] - evidence;
+        return logPosteriors;
+    }
+
+    template <typename T>
+    int NaiveBayesModel::predict(std::span<const T> xRow) const
+    {
+        const std::vector<long double> logPosteriors = predictLogProbabilities(xRow);
+        return classes[std::max_element(logPosteriors.begin(), logPosteriors.end()) - logPosteriors.begin()];
+    }
+
+    template <typename T>
+    std::vector<long double> NaiveBayesModel::predictProbabilities(const DatasetView<T> &data, size_t numThreads) const
+    {
+        const size_t numClasses = classes.size();
+        std::vector<long double> probabilities(data.size() * numClasses);
+        scoreRows(data, numThreads, [&](size_t i, const double *logPosteriors)
+                  {
+                      for (size_t c = 0; c < numClasses; ++c)
+                          probabilities[i * numClasses + c] = std::exp(logPosteriors[c]);
+                  });
+        return probabilities;
+    }
+
+    template <typename T>
+    std::vector<int> NaiveBayesModel::predict(const DatasetView<T> &data, size_t numThreads) const
+    {
+        std::vector<int> predictions(data.size());
+        scoreRows(data, numThreads, [&](size_t i, const double *logPosteriors)
+                  { predictions[i] = classes[std::max_element(logPosteriors, logPosteriors + classes.size()) - logPosteriors]; });
+        return predictions;
+    }
 
-    void LogisticRegressionModel::saveToFile(const std::string &filename) const
+    MLLIB_INLINE void NaiveBayesModel::saveToFile(const std::string &filename) const
     {
         std::ofstream outFile(filename);
         if (outFile.is_open())
         {
+            outFile.precision(std::numeric_limits<long double>::max_digits10);
             outFile << *this;
             outFile.close();
         }
@@ -951,13 +9987,19 @@ namespace mlLib
         }
     }
 
-    // Definition of the member function loadFromFile
-    void LogisticRegressionModel::loadFromFile(const std::string &filename)
+    MLLIB_INLINE void NaiveBayesModel::loadFromFile(const std::string &filename)
     {
+        if (detail::isBinaryModelFile(filename))
+        {
+            loadBinary(filename);
+            return;
+        }
+
         std::ifstream inFile(filename);
         if (inFile.is_open())
         {
-            inFile >> *this;
+            if (!(inFile >> *this))
+                std::cerr << "Invalid model file: truncated or malformed text model" << std::endl;
             inFile.close();
         }
         else
@@ -966,79 +10008,549 @@ namespace mlLib
         }
     }
 
-    void LogisticRegressionModel::printInfo() const
+    MLLIB_INLINE bool NaiveBayesModel::saveBinary(const std::string &filename) const
     {
-        std::cout << "Logistic Regression Model:\n"
-                  << "Coefficients: ";
-        for (const auto &coeff : coefficients)
+        detail::PayloadWriter payload;
+        payload.write(featureSums);
+        payload.write(static_cast<uint32_t>(options.type));
+        payload.write(options.alpha);
+        payload.write(options.varianceSmoothing);
+        payload.write(options.binarizeThreshold);
+        payload.write(static_cast<uint64_t>(numFeatures));
+        payload.write(static_cast<uint64_t>(classes.size()));
+        for (const int label : classes)
+            payload.write(static_cast<int32_t>(label));
+        payload.write(classCounts);
+        payload.write(squaredDeviations);
+
+        // The header's normalization type is not used by naive Bayes models
+        return detail::writeModelFile(filename, detail::NaiveBayesModelFile, stat::NormalizationType(), featureSums.size(), payload.buffer);
+    }
+
+    MLLIB_INLINE bool NaiveBayesModel::loadBinary(const std::string &filename)
+    {
+        MappedFile file;
+        const detail::ModelFileHeader *header = detail::readModelFile(file, filename, detail::NaiveBayesModelFile);
+        if (header == nullptr)
+            return false;
+
+        // Decode into a temporary so a malformed payload leaves this model untouched
+        NaiveBayesModel model;
+        detail::PayloadReader payload(file.data() + sizeof(detail::ModelFileHeader), header->payloadSize);
+        uint32_t typeInt = 0;
+        uint64_t newNumFeatures = 0, numClasses = 0;
+
+        bool valid = payload.read(model.featureSums, header->numCoefficients) && payload.read(typeInt) && typeInt <= BernoulliNaiveBayes &&
+                     payload.read(model.options.alpha) && payload.read(model.options.varianceSmoothing) && payload.read(model.options.binarizeThreshold) &&
+                     payload.read(newNumFeatures) && payload.read(numClasses) && numClasses * newNumFeatures == header->numCoefficients &&
+                     numClasses <= header->payloadSize / sizeof(int32_t);
+        for (uint64_t c = 0; valid && c < numClasses; ++c)
         {
-            std::cout << coeff << " ";
+            int32_t label = 0;
+            valid = payload.read(label);
+            model.classes.push_back(label);
+        }
+        valid = valid && payload.read(model.classCounts, numClasses) &&
+                payload.read(model.squaredDeviations, (typeInt == GaussianNaiveBayes) ? header->numCoefficients : 0) && payload.atEnd();
+        if (valid)
+        {
+            model.options.type = static_cast<NaiveBayesType>(typeInt);
+            model.numFeatures = newNumFeatures;
+            valid = model.isValid();
+        }
+        if (!valid)
+        {
+            std::cerr << "Invalid model file: malformed payload" << std::endl;
+            return false;
+        }
+
+        model.options.numThreads = options.numThreads;
+        model.updateParameters();
+        *this = std::move(model);
+        return true;
+    }
+
+    MLLIB_INLINE bool NaiveBayesModel::isValid() const
+    {
+        const size_t numClasses = classes.size();
+        const size_t numDeviations = (options.type == GaussianNaiveBayes) ? featureSums.size() : 0;
+        if (classCounts.size() != numClasses || squaredDeviations.size() != numDeviations)
+            return false;
+        // An untrained model has neither classes nor features; a trained one has both
+        if ((numClasses == 0) != (numFeatures == 0) || (numClasses > 0 && (featureSums.size() % numClasses != 0 || featureSums.size() / numClasses != numFeatures)))
+            return false;
+        if (numClasses == 0 && !featureSums.empty())
+            return false;
+
+        // Every class was seen, so its log prior and means are finite, and labels are sorted for the class lookup
+        for (size_t c = 0; c < numClasses; ++c)
+        {
+            if (!(classCounts[c] > 0.0L) || !std::isfinite(classCounts[c]) || (c > 0 && classes[c] <= classes[c - 1]))
+                return false;
+        }
+        return true;
+    }
+
+    MLLIB_INLINE void NaiveBayesModel::printInfo() const
+    {
+        const char *names[] = {"Gaussian", "Multinomial", "Bernoulli"};
+        const long double totalCount = std::accumulate(classCounts.begin(), classCounts.end(), 0.0L);
+        std::cout << names[options.type] << " Naive Bayes Model:\n"
+                  << "Features: " << numFeatures << ", Classes: " << classes.size() << ", Rows: " << totalCount << "\n";
+        for (size_t c = 0; c < classes.size(); ++c)
+        {
+            std::cout << "Class " << classes[c] << ": " << classCounts[c] << " rows, prior " << classCounts[c] / totalCount << "\n";
         }
-        std::cout << "\nNormalization Type: " << normalizationType << "\n"
-                  << "Confusion Matrix: TP=" << confusionMatrix.truePositive
-                  << ", TN=" << confusionMatrix.trueNegative
-                  << ", FP=" << confusionMatrix.falsePositive
-                  << ", FN=" << confusionMatrix.falseNegative << "\n"
-                  << "Evaluation Metrics: Accuracy=" << evaluationMetrics.accuracy
-                  << ", Recall=" << evaluationMetrics.recall
-                  << ", Precision=" << evaluationMetrics.precision
-                  << ", F1 Score=" << evaluationMetrics.f1Score << "\n";
     }
 
     template <typename T>
-    LogisticRegressionModel LogisticRegression(const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues, const long double learningRate, const int numIterations)
+    NaiveBayesModel NaiveBayes(const DatasetView<T> &data, const NaiveBayesOptions &options)
     {
-        assert(!xValues.empty() && "xValues is empty");
-        assert(!yValues.empty() && "yValues is empty");
-        assert(xValues.size() == yValues.size() && "Input vectors must have the same size");
+        NaiveBayesModel model(options);
+        model.partialFit(data);
+        return model;
+    }
 
-        size_t numFeatures = xValues[0].size();
-        std::vector<long double> coefficients(numFeatures + 1, 0.0);
+    template <typename T>
+    NaiveBayesModel NaiveBayes(const std::vector<std::vector<T>> &xValues, const std::vector<T> &yValues, const NaiveBayesOptions &options)
+    {
+        const Dataset<T> dataset(xValues, yValues);
+        return NaiveBayes(dataset.view(), options);
+    }
 
-        for (int iter = 0; iter < numIterations; ++iter)
+    template <typename T>
+    ClassificationMetrics EvaluateClassification(const NaiveBayesModel &model, const DatasetView<T> &data)
+    {
+        const std::vector<int> predictedClasses = model.predict(data);
+        std::vector<T> actualYValues(data.size());
+        for (size_t i = 0; i < data.size(); ++i)
         {
-            std::vector<long double> errors(yValues.size(), 0.0);
-            long double interceptGradient = 0.0;
+            actualYValues[i] = data.label(i);
+        }
+        return EvaluateClassification(std::span<const T>(actualYValues), std::span<const int>(predictedClasses));
+    }
 
-            for (size_t i = 0; i < xValues.size(); ++i)
+#if !defined(MLLIB_HEADER_ONLY)
+    template void NaiveBayesModel::partialFit(const DatasetView<int8_t> &data);
+    template void NaiveBayesModel::partialFit(const DatasetView<int16_t> &data);
+    template void NaiveBayesModel::partialFit(const DatasetView<int32_t> &data);
+    template void NaiveBayesModel::partialFit(const DatasetView<int64_t> &data);
+
+    template void NaiveBayesModel::partialFit(const DatasetView<uint8_t> &data);
+    template void NaiveBayesModel::partialFit(const DatasetView<uint16_t> &data);
+    template void NaiveBayesModel::partialFit(const DatasetView<uint32_t> &data);
+    template void NaiveBayesModel::partialFit(const DatasetView<uint64_t> &data);
+
+    template void NaiveBayesModel::partialFit(const DatasetView<float> &data);
+    template void NaiveBayesModel::partialFit(const DatasetView<double> &data);
+    template void NaiveBayesModel::partialFit(const DatasetView<long double> &data);
+
+    template std::vector<long double> NaiveBayesModel::predictLogProbabilities(std::span<const int8_t> xRow) const;
+    template std::vector<long double> NaiveBayesModel::predictLogProbabilities(std::span<const int16_t> xRow) const;
+    template std::vector<long double> NaiveBayesModel::predictLogProbabilities(std::span<const int32_t> xRow) const;
+    template std::vector<long double> NaiveBayesModel::predictLogProbabilities(std::span<const int64_t> xRow) const;
+
+    template std::vector<long double> NaiveBayesModel::predictLogProbabilities(std::span<const uint8_t> xRow) const;
+    template std::vector<long double> NaiveBayesModel::predictLogProbabilities(std::span<const uint16_t> xRow) const;
+    template std::vector<long double> NaiveBayesModel::predictLogProbabilities(std::span<const uint32_t> xRow) const;
+    template std::vector<long double> NaiveBayesModel::predictLogProbabilities(std::span<const uint64_t> xRow) const;
+
+    template std::vector<long double> NaiveBayesModel::predictLogProbabilities(std::span<const float> xRow) const;
+    template std::vector<long double> NaiveBayesModel::predictLogProbabilities(std::span<const double> xRow) const;
+    template std::vector<long double> NaiveBayesModel::predictLogProbabilities(std::span<const long double> xRow) const;
+
+    template int NaiveBayesModel::predict(std::span<const int8_t> xRow) const;
+    template int NaiveBayesModel::predict(std::span<const int16_t> xRow) const;
+    template int NaiveBayesModel::predict(std::span<const int32_t> xRow) const;
+    template int NaiveBayesModel::predict(std::span<const int64_t> xRow) const;
+
+    template int NaiveBayesModel::predict(std::span<const uint8_t> xRow) const;
+    template int NaiveBayesModel::predict(std::span<const uint16_t> xRow) const;
+    template int NaiveBayesModel::predict(std::span<const uint32_t> xRow) const;
+    template int NaiveBayesModel::predict(std::span<const uint64_t> xRow) const;
+
+    template int NaiveBayesModel::predict(std::span<const float> xRow) const;
+    template int NaiveBayesModel::predict(std::span<const double> xRow) const;
+    template int NaiveBayesModel::predict(std::span<const long double> xRow) const;
+
+    template std::vector<long double> NaiveBayesModel::predictProbabilities(const DatasetView<int8_t> &data, size_t numThreads) const;
+    template std::vector<long double> NaiveBayesModel::predictProbabilities(const DatasetView<int16_t> &data, size_t numThreads) const;
+    template std::vector<long double> NaiveBayesModel::predictProbabilities(const DatasetView<int32_t> &data, size_t numThreads) const;
+    template std::vector<long double> NaiveBayesModel::predictProbabilities(const DatasetView<int64_t> &data, size_t numThreads) const;
+
+    template std::vector<long double> NaiveBayesModel::predictProbabilities(const DatasetView<uint8_t> &data, size_t numThreads) const;
+    template std::vector<long double> NaiveBayesModel::predictProbabilities(const DatasetView<uint16_t> &data, size_t numThreads) const;
+    template std::vector<long double> NaiveBayesModel::predictProbabilities(const DatasetView<uint32_t> &data, size_t numThreads) const;
+    template std::vector<long double> NaiveBayesModel::predictProbabilities(const DatasetView<uint64_t> &data, size_t numThreads) const;
+
+    template std::vector<long double> NaiveBayesModel::predictProbabilities(const DatasetView<float> &data, size_t numThreads) const;
+    template std::vector<long double> NaiveBayesModel::predictProbabilities(const DatasetView<double> &data, size_t numThreads) const;
+    template std::vector<long double> NaiveBayesModel::predictProbabilities(const DatasetView<long double> &data, size_t numThreads) const;
+
+    template std::vector<int> NaiveBayesModel::predict(const DatasetView<int8_t> &data, size_t numThreads) const;
+    template std::vector<int> NaiveBayesModel::predict(const DatasetView<int16_t> &data, size_t numThreads) const;
+    template std::vector<int> NaiveBayesModel::predict(const DatasetView<int32_t> &data, size_t numThreads) const;
+    template std::vector<int> NaiveBayesModel::predict(const DatasetView<int64_t> &data, size_t numThreads) const;
+
+    template std::vector<int> NaiveBayesModel::predict(const DatasetView<uint8_t> &data, size_t numThreads) const;
+    template std::vector<int> NaiveBayesModel::predict(const DatasetView<uint16_t> &data, size_t numThreads) const;
+    template std::vector<int> NaiveBayesModel::predict(const DatasetView<uint32_t> &data, size_t numThreads) const;
+    template std::vector<int> NaiveBayesModel::predict(const DatasetView<uint64_t> &data, size_t numThreads) const;
+
+    template std::vector<int> NaiveBayesModel::predict(const DatasetView<float> &data, size_t numThreads) const;
+    template std::vector<int> NaiveBayesModel::predict(const DatasetView<double> &data, size_t numThreads) const;
+    template std::vector<int> NaiveBayesModel::predict(const DatasetView<long double> &data, size_t numThreads) const;
+
+    template NaiveBayesModel NaiveBayes(const DatasetView<int8_t> &data, const NaiveBayesOptions &options);
+    template NaiveBayesModel NaiveBayes(const DatasetView<int16_t> &data, const NaiveBayesOptions &options);
+    template NaiveBayesModel NaiveBayes(const DatasetView<int32_t> &data, const NaiveBayesOptions &options);
+    template NaiveBayesModel NaiveBayes(const DatasetView<int64_t> &data, const NaiveBayesOptions &options);
+
+    template NaiveBayesModel NaiveBayes(const DatasetView<uint8_t> &data, const NaiveBayesOptions &options);
+    template NaiveBayesModel NaiveBayes(const DatasetView<uint16_t> &data, const NaiveBayesOptions &options);
+    template NaiveBayesModel NaiveBayes(const DatasetView<uint32_t> &data, const NaiveBayesOptions &options);
+    template NaiveBayesModel NaiveBayes(const DatasetView<uint64_t> &data, const NaiveBayesOptions &options);
+
+    template NaiveBayesModel NaiveBayes(const DatasetView<float> &data, const NaiveBayesOptions &options);
+    template NaiveBayesModel NaiveBayes(const DatasetView<double> &data, const NaiveBayesOptions &options);
+    template NaiveBayesModel NaiveBayes(const DatasetView<long double> &data, const NaiveBayesOptions &options);
+
+    template NaiveBayesModel NaiveBayes(const std::vector<std::vector<int8_t>> &xValues, const std::vector<int8_t> &yValues, const NaiveBayesOptions &options);
+    template NaiveBayesModel NaiveBayes(const std::vector<std::vector<int16_t>> &xValues, const std::vector<int16_t> &yValues, const NaiveBayesOptions &options);
+    template NaiveBayesModel NaiveBayes(const std::vector<std::vector<int32_t>> &xValues, const std::vector<int32_t> &yValues, const NaiveBayesOptions &options);
+    template NaiveBayesModel NaiveBayes(const std::vector<std::vector<int64_t>> &xValues, const std::vector<int64_t> &yValues, const NaiveBayesOptions &options);
+
+    template NaiveBayesModel NaiveBayes(const std::vector<std::vector<uint8_t>> &xValues, const std::vector<uint8_t> &yValues, const NaiveBayesOptions &options);
+    template NaiveBayesModel NaiveBayes(const std::vector<std::vector<uint16_t>> &xValues, const std::vector<uint16_t> &yValues, const NaiveBayesOptions &options);
+    template NaiveBayesModel NaiveBayes(const std::vector<std::vector<uint32_t>> &xValues, const std::vector<uint32_t> &yValues, const NaiveBayesOptions &options);
+    template NaiveBayesModel NaiveBayes(const std::vector<std::vector<uint64_t>> &xValues, const std::vector<uint64_t> &yValues, const NaiveBayesOptions &options);
+
+    template NaiveBayesModel NaiveBayes(const std::vector<std::vector<float>> &xValues, const std::vector<float> &yValues, const NaiveBayesOptions &options);
+    template NaiveBayesModel NaiveBayes(const std::vector<std::vector<double>> &xValues, const std::vector<double> &yValues, const NaiveBayesOptions &options);
+    template NaiveBayesModel NaiveBayes(const std::vector<std::vector<long double>> &xValues, const std::vector<long double> &yValues, const NaiveBayesOptions &options);
+
+    template ClassificationMetrics EvaluateClassification(const NaiveBayesModel &model, const DatasetView<int8_t> &data);
+    template ClassificationMetrics EvaluateClassification(const NaiveBayesModel &model, const DatasetView<int16_t> &data);
+    template ClassificationMetrics EvaluateClassification(const NaiveBayesModel &model, const DatasetView<int32_t> &data);
+    template ClassificationMetrics EvaluateClassification(const NaiveBayesModel &model, const DatasetView<int64_t> &data);
+
+    template ClassificationMetrics EvaluateClassification(const NaiveBayesModel &model, const DatasetView<uint8_t> &data);
+    template ClassificationMetrics EvaluateClassification(const NaiveBayesModel &model, const DatasetView<uint16_t> &data);
+    template ClassificationMetrics EvaluateClassification(const NaiveBayesModel &model, const DatasetView<uint32_t> &data);
+    template ClassificationMetrics EvaluateClassification(const NaiveBayesModel &model, const DatasetView<uint64_t> &data);
+
+    template ClassificationMetrics EvaluateClassification(const NaiveBayesModel &model, const DatasetView<float> &data);
+    template ClassificationMetrics EvaluateClassification(const NaiveBayesModel &model, const DatasetView<double> &data);
+    template ClassificationMetrics EvaluateClassification(const NaiveBayesModel &model, const DatasetView<long double> &data);
+#endif
+
+
+    namespace detail
+    {
+#if defined(MLLIB_AVX2_KERNELS)
+        // One 4 x 8 tile of manhattanAccumulate over depth values of p, with a, b and c at the tile's origin
+        MLLIB_INLINE MLLIB_TARGET_AVX2 void manhattanTileAvx2(const double *a, size_t lda, const double *b, size_t ldb, double *c, size_t ldc, size_t depth)
+        {
+            const __m256d signMask = _mm256_set1_pd(-0.0);
+            __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd(), c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+            __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd(), c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+            const double *aColumn = a, *bRow = b;
+            for (size_t p = 0; p < depth; ++p, ++aColumn, bRow += ldb)
             {
-                long double logit = coefficients[0];
-                for (size_t j = 0; j < numFeatures; ++j)
+                const __m256d b0 = _mm256_loadu_pd(bRow);
+                const __m256d b1 = _mm256_loadu_pd(bRow + 4);
+                __m256d value = _mm256_broadcast_sd(aColumn);
+                c00 = _mm256_add_pd(c00, _mm256_andnot_pd(signMask, _mm256_sub_pd(value, b0)));
+                c01 = _mm256_add_pd(c01, _mm256_andnot_pd(signMask, _mm256_sub_pd(value, b1)));
+                value = _mm256_broadcast_sd(aColumn + lda);
+                c10 = _mm256_add_pd(c10, _mm256_andnot_pd(signMask, _mm256_sub_pd(value, b0)));
+                c11 = _mm256_add_pd(c11, _mm256_andnot_pd(signMask, _mm256_sub_pd(value, b1)));
+                value = _mm256_broadcast_sd(aColumn + 2 * lda);
+                c20 = _mm256_add_pd(c20, _mm256_andnot_pd(signMask, _mm256_sub_pd(value, b0)));
+                c21 = _mm256_add_pd(c21, _mm256_andnot_pd(signMask, _mm256_sub_pd(value, b1)));
+                value = _mm256_broadcast_sd(aColumn + 3 * lda);
+                c30 = _mm256_add_pd(c30, _mm256_andnot_pd(signMask, _mm256_sub_pd(value, b0)));
+                c31 = _mm256_add_pd(c31, _mm256_andnot_pd(signMask, _mm256_sub_pd(value, b1)));
+            }
+            const __m256d sums[4][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}};
+            for (size_t r = 0; r < 4; ++r)
+            {
+                double *out = c + r * ldc;
+                _mm256_storeu_pd(out, _mm256_add_pd(_mm256_loadu_pd(out), sums[r][0]));
+                _mm256_storeu_pd(out + 4, _mm256_add_pd(_mm256_loadu_pd(out + 4), sums[r][1]));
+            }
+        }
+#endif
+
+        // c[i * ldc + j] += sum_p |a[i * lda + p] - b[p * ldb + j]| for i < m, j < n, p < k: the Manhattan
+        // counterpart of gemmAccumulate, with the same panels of B and 4 x 8 tiles of C held in registers
+        MLLIB_INLINE void manhattanAccumulate(const double *a, size_t lda, const double *b, size_t ldb, double *c, size_t ldc, size_t m, size_t n, size_t k)
+        {
+            const size_t panelDepth = 256;
+            const size_t fullRows = m - m % 4, fullColumns = n - n % 8;
+#if defined(MLLIB_AVX2_KERNELS)
+            const bool avx2 = cpuHasAvx2();
+#endif
+
+            for (size_t p0 = 0; p0 < k; p0 += panelDepth)
+            {
+                const size_t p1 = std::min(k, p0 + panelDepth);
+                for (size_t j0 = 0; j0 < fullColumns; j0 += 8)
                 {
-                    logit += coefficients[j + 1] * xValues[i][j];
+                    for (size_t i0 = 0; i0 < fullRows; i0 += 4)
+                    {
+#if defined(MLLIB_AVX2_KERNELS)
+                        if (avx2)
+                        {
+                            manhattanTileAvx2(a + i0 * lda + p0, lda, b + p0 * ldb + j0, ldb, c + i0 * ldc + j0, ldc, p1 - p0);
+                            continue;
+                        }
+#endif
+                        double sums[4][8] = {};
+                        for (size_t p = p0; p < p1; ++p)
+                        {
+                            const double *bRow = b + p * ldb + j0;
+                            for (size_t r = 0; r < 4; ++r)
+                            {
+                                const double value = a[(i0 + r) * lda + p];
+                                for (size_t j = 0; j < 8; ++j)
+                                {
+                                    sums[r][j] += std::fabs(value - bRow[j]);
+                                }
+                            }
+                        }
+                        for (size_t r = 0; r < 4; ++r)
+                        {
+                            for (size_t j = 0; j < 8; ++j)
+                            {
+                                c[(i0 + r) * ldc + j0 + j] += sums[r][j];
+                            }
+                        }
+                    }
                 }
 
-                const long double prediction = 1.0 / (1.0 + std::exp(-logit));
-                errors[i] = prediction - yValues[i];
-
-                interceptGradient += errors[i];
-                for (size_t j = 0; j < numFeatures; ++j)
+                // Rows and columns left over by the tiles
+                for (size_t i = 0; i < m; ++i)
                 {
-                    coefficients[j + 1] -= learningRate * errors[i] * xValues[i][j];
+                    for (size_t j0 = (i < fullRows) ? fullColumns : 0; j0 < n; j0 += 8)
+                    {
+                        const size_t width = std::min<size_t>(8, n - j0);
+                        double sums[8] = {};
+                        for (size_t p = p0; p < p1; ++p)
+                        {
+                            const double value = a[i * lda + p];
+                            const double *bRow = b + p * ldb + j0;
+                            for (size_t j = 0; j < width; ++j)
+                            {
+                                sums[j] += std::fabs(value - bRow[j]);
+                            }
+                        }
+                        for (size_t j = 0; j < width; ++j)
+                        {
+                            c[i * ldc + j0 + j] += sums[j];
+                        }
+                    }
                 }
             }
-
-            interceptGradient /= yValues.size();
-            coefficients[0] -= learningRate * interceptGradient;
         }
+    } // namespace detail
 
-        return LogisticRegressionModel(coefficients);
+    template <typename T>
+    void PairwiseDistanceTiles(const DatasetView<T> &x, const DatasetView<T> &y, VectorMetric metric, const DistanceTileCallback &callback, size_t numThreads)
+    {
+        assert(x.getNumFeatures() == y.getNumFeatures() && callback);
+        const size_t numFeatures = x.getNumFeatures();
+        if (x.empty() || y.empty())
+            return;
+        numThreads = detail::resolveThreadCount(numThreads);
+
+        // Bands of up to 256 rows, so each pass over the packed y serves many rows, but at least one band per thread
+        const size_t bandRows = std::clamp<size_t>((x.size() + 4 * numThreads - 1) / (4 * numThreads) * 4, 4, 256), tileColumns = 32;
+        const size_t numBands = (x.size() + bandRows - 1) / bandRows;
+        const size_t numTiles = (y.size() + tileColumns - 1) / tileColumns;
+
+        // y is converted once into column blocks of numFeatures x tileColumns values, so each tile multiplies
+        // a band of x rows by one contiguous block. Norms are squared for Euclidean and plain for cosine.
+        std::vector<double> packed(y.size() * numFeatures), yNorms(y.size(), 0.0);
+        detail::parallelForDynamic(numTiles, std::min(numThreads, numTiles), [&](size_t tile)
+                                   {
+                                       const size_t columnBegin = tile * tileColumns, width = std::min(tileColumns, y.size() - columnBegin);
+                                       double *block = packed.data() + columnBegin * numFeatures;
+                                       for (size_t j = 0; j < width; ++j)
+                                       {
+                                           const std::span<const T> row = y.row(columnBegin + j);
+                                           double norm = 0.0;
+                                           for (size_t p = 0; p < numFeatures; ++p)
+                                           {
+                                               const double value = static_cast<double>(row[p]);
+                                               block[p * width + j] = value;
+                                               norm += value * value;
+                                           }
+                                           yNorms[columnBegin + j] = (metric == CosineDistance) ? std::sqrt(norm) : norm;
+                                       } });
+
+        detail::parallelForDynamic(numBands, std::min(numThreads, numBands), [&](size_t band)
+                                   {
+                                       const size_t rowBegin = band * bandRows, rows = std::min(bandRows, x.size() - rowBegin);
+                                       std::vector<double> block(rows * numFeatures), xNorms(rows, 0.0), distances(rows * tileColumns);
+                                       for (size_t i = 0; i < rows; ++i)
+                                       {
+                                           const std::span<const T> row = x.row(rowBegin + i);
+                                           for (size_t p = 0; p < numFeatures; ++p)
+                                           {
+                                               block[i * numFeatures + p] = static_cast<double>(row[p]);
+                                               xNorms[i] += block[i * numFeatures + p] * block[i * numFeatures + p];
+                                           }
+                                           if (metric == CosineDistance)
+                                               xNorms[i] = std::sqrt(xNorms[i]);
+                                       }
+
+                                       for (size_t tile = 0; tile < numTiles; ++tile)
+                                       {
+                                           const size_t columnBegin = tile * tileColumns, width = std::min(tileColumns, y.size() - columnBegin);
+                                           const double *yBlock = packed.data() + columnBegin * numFeatures;
+                                           std::fill(distances.begin(), distances.begin() + rows * width, 0.0);
+                                           if (metric == ManhattanDistance)
+                                           {
+                                               detail::manhattanAccumulate(block.data(), numFeatures, yBlock, width, distances.data(), width, rows, width, numFeatures);
+                                           }
+                                           else
+                                           {
+                                               detail::gemmAccumulate(block.data(), numFeatures, 1, yBlock, width, distances.data(), width, rows, width, numFeatures);
+                                               for (size_t i = 0; i < rows; ++i)
+                                               {
+                                                   double *out = distances.data() + i * width;
+                                                   for (size_t j = 0; j < width; ++j)
+                                                   {
+                                                       const double yNorm = yNorms[columnBegin + j];
+                                                       if (metric == CosineDistance)
+                                                           out[j] = (xNorms[i] > 0.0 && yNorm > 0.0) ? std::clamp(1.0 - out[j] / (xNorms[i] * yNorm), 0.0, 2.0) : 1.0;
+                                                       else
+                                                           out[j] = std::sqrt(std::max(0.0, xNorms[i] + yNorm - 2.0 * out[j]));
+                                                   }
+                                               }
+                                           }
+
+                                           DistanceTile result;
+                                           result.rowBegin = rowBegin;
+                                           result.rowEnd = rowBegin + rows;
+                                           result.columnBegin = columnBegin;
+                                           result.columnEnd = columnBegin + width;
+                                           result.distances = distances.data();
+                                           callback(result);
+                                       }
+                                       Instrumentation::count("PairwiseDistances::distances", rows * y.size());
+                                   });
     }
 
-    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<int8_t>> &xValues, const std::vector<int8_t> &yValues, const long double learningRate, const int numIterations);
-    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<int16_t>> &xValues, const std::vector<int16_t> &yValues, const long double learningRate, const int numIterations);
-    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<int32_t>> &xValues, const std::vector<int32_t> &yValues, const long double learningRate, const int numIterations);
-    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<int64_t>> &xValues, const std::vector<int64_t> &yValues, const long double learningRate, const int numIterations);
+    template <typename T>
+    std::vector<double> PairwiseDistances(const DatasetView<T> &x, const DatasetView<T> &y, VectorMetric metric, size_t numThreads)
+    {
+        std::vector<double> matrix(x.size() * y.size());
+        PairwiseDistanceTiles(x, y, metric, [&](const DistanceTile &tile)
+                              {
+                                  const size_t width = tile.columnEnd - tile.columnBegin;
+                                  for (size_t i = tile.rowBegin; i < tile.rowEnd; ++i)
+                                  {
+                                      std::copy(tile.distances + (i - tile.rowBegin) * width, tile.distances + (i - tile.rowBegin + 1) * width,
+                                                matrix.begin() + i * y.size() + tile.columnBegin);
+                                  } },
+                              numThreads);
+        return matrix;
+    }
 
-    // Explicit instantiations for Logistic Regression with uint types
-    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<uint8_t>> &xValues, const std::vector<uint8_t> &yValues, const long double learningRate, const int numIterations);
-    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<uint16_t>> &xValues, const std::vector<uint16_t> &yValues, const long double learningRate, const int numIterations);
-    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<uint32_t>> &xValues, const std::vector<uint32_t> &yValues, const long double learningRate, const int numIterations);
-    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<uint64_t>> &xValues, const std::vector<uint64_t> &yValues, const long double learningRate, const int numIterations);
+    template <typename T>
+    std::vector<std::vector<Neighbor>> PairwiseNearest(const DatasetView<T> &x, const DatasetView<T> &y, size_t k, VectorMetric metric, size_t numThreads)
+    {
+        k = std::min(k, y.size());
+
+        // A max-heap of the k nearest (distance, row of y) so far for every row of x; a band's rows are only
+        // touched by the thread that computes the band
+        std::vector<std::vector<std::pair<double, size_t>>> nearest(x.size());
+        PairwiseDistanceTiles(x, y, metric, [&](const DistanceTile &tile)
+                              {
+                                  const size_t width = tile.columnEnd - tile.columnBegin;
+                                  for (size_t i = tile.rowBegin; i < tile.rowEnd; ++i)
+                                  {
+                                      std::vector<std::pair<double, size_t>> &heap = nearest[i];
+                                      const double *distances = tile.distances + (i - tile.rowBegin) * width;
+                                      for (size_t j = 0; j < width; ++j)
+                                      {
+                                          // Most candidates are farther than the current k-th nearest
+                                          if (heap.size() == k && (k == 0 || distances[j] > heap.front().first))
+                                              continue;
+                                          const std::pair<double, size_t> candidate(distances[j], tile.columnBegin + j);
+                                          if (heap.size() < k)
+                                          {
+                                              heap.push_back(candidate);
+                                              std::push_heap(heap.begin(), heap.end());
+                                          }
+                                          else if (candidate < heap.front())
+                                          {
+                                              std::pop_heap(heap.begin(), heap.end());
+                                              heap.back() = candidate;
+                                              std::push_heap(heap.begin(), heap.end());
+                                          }
+                                      }
+                                  } },
+                              numThreads);
+
+        std::vector<std::vector<Neighbor>> results(x.size());
+        for (size_t i = 0; i < x.size(); ++i)
+        {
+            std::sort_heap(nearest[i].begin(), nearest[i].end());
+            results[i].resize(nearest[i].size());
+            for (size_t n = 0; n < nearest[i].size(); ++n)
+            {
+                results[i][n].index = nearest[i][n].second;
+                results[i][n].distance = nearest[i][n].first;
+            }
+        }
+        return results;
+    }
 
-    // Explicit instantiations for Logistic Regression with float types
-    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<float>> &xValues, const std::vector<float> &yValues, const long double learningRate, const int numIterations);
-    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<double>> &xValues, const std::vector<double> &yValues, const long double learningRate, const int numIterations);
-    template LogisticRegressionModel LogisticRegression(const std::vector<std::vector<long double>> &xValues, const std::vector<long double> &yValues, const long double learningRate, const int numIterations);
+#if !defined(MLLIB_HEADER_ONLY)
+    template void PairwiseDistanceTiles(const DatasetView<int8_t> &x, const DatasetView<int8_t> &y, VectorMetric metric, const DistanceTileCallback &callback, size_t numThreads);
+    template void PairwiseDistanceTiles(const DatasetView<int16_t> &x, const DatasetView<int16_t> &y, VectorMetric metric, const DistanceTileCallback &callback, size_t numThreads);
+    template void PairwiseDistanceTiles(const DatasetView<int32_t> &x, const DatasetView<int32_t> &y, VectorMetric metric, const DistanceTileCallback &callback, size_t numThreads);
+    template void PairwiseDistanceTiles(const DatasetView<int64_t> &x, const DatasetView<int64_t> &y, VectorMetric metric, const DistanceTileCallback &callback, size_t numThreads);
+
+    template void PairwiseDistanceTiles(const DatasetView<uint8_t> &x, const DatasetView<uint8_t> &y, VectorMetric metric, const DistanceTileCallback &callback, size_t numThreads);
+    template void PairwiseDistanceTiles(const DatasetView<uint16_t> &x, const DatasetView<uint16_t> &y, VectorMetric metric, const DistanceTileCallback &callback, size_t numThreads);
+    template void PairwiseDistanceTiles(const DatasetView<uint32_t> &x, const DatasetView<uint32_t> &y, VectorMetric metric, const DistanceTileCallback &callback, size_t numThreads);
+    template void PairwiseDistanceTiles(const DatasetView<uint64_t> &x, const DatasetView<uint64_t> &y, VectorMetric metric, const DistanceTileCallback &callback, size_t numThreads);
+
+    template void PairwiseDistanceTiles(const DatasetView<float> &x, const DatasetView<float> &y, VectorMetric metric, const DistanceTileCallback &callback, size_t numThreads);
+    template void PairwiseDistanceTiles(const DatasetView<double> &x, const DatasetView<double> &y, VectorMetric metric, const DistanceTileCallback &callback, size_t numThreads);
+    template void PairwiseDistanceTiles(const DatasetView<long double> &x, const DatasetView<long double> &y, VectorMetric metric, const DistanceTileCallback &callback, size_t numThreads);
+
+    template std::vector<double> PairwiseDistances(const DatasetView<int8_t> &x, const DatasetView<int8_t> &y, VectorMetric metric, size_t numThreads);
+    template std::vector<double> PairwiseDistances(const DatasetView<int16_t> &x, const DatasetView<int16_t> &y, VectorMetric metric, size_t numThreads);
+    template std::vector<double> PairwiseDistances(const DatasetView<int32_t> &x, const DatasetView<int32_t> &y, VectorMetric metric, size_t numThreads);
+    template std::vector<double> PairwiseDistances(const DatasetView<int64_t> &x, const DatasetView<int64_t> &y, VectorMetric metric, size_t numThreads);
+
+    template std::vector<double> PairwiseDistances(const DatasetView<uint8_t> &x, const DatasetView<uint8_t> &y, VectorMetric metric, size_t numThreads);
+    template std::vector<double> PairwiseDistances(const DatasetView<uint16_t> &x, const DatasetView<uint16_t> &y, VectorMetric metric, size_t numThreads);
+    template std::vector<double> PairwiseDistances(const DatasetView<uint32_t> &x, const DatasetView<uint32_t> &y, VectorMetric metric, size_t numThreads);
+    template std::vector<double> PairwiseDistances(const DatasetView<uint64_t> &x, const DatasetView<uint64_t> &y, VectorMetric metric, size_t numThreads);
+
+    template std::vector<double> PairwiseDistances(const DatasetView<float> &x, const DatasetView<float> &y, VectorMetric metric, size_t numThreads);
+    template std::vector<double> PairwiseDistances(const DatasetView<double> &x, const DatasetView<double> &y, VectorMetric metric, size_t numThreads);
+    template std::vector<double> PairwiseDistances(const DatasetView<long double> &x, const DatasetView<long double> &y, VectorMetric metric, size_t numThreads);
+
+    template std::vector<std::vector<Neighbor>> PairwiseNearest(const DatasetView<int8_t> &x, const DatasetView<int8_t> &y, size_t k, VectorMetric metric, size_t numThreads);
+    template std::vector<std::vector<Neighbor>> PairwiseNearest(const DatasetView<int16_t> &x, const DatasetView<int16_t> &y, size_t k, VectorMetric metric, size_t numThreads);
+    template std::vector<std::vector<Neighbor>> PairwiseNearest(const DatasetView<int32_t> &x, const DatasetView<int32_t> &y, size_t k, VectorMetric metric, size_t numThreads);
+    template std::vector<std::vector<Neighbor>> PairwiseNearest(const DatasetView<int64_t> &x, const DatasetView<int64_t> &y, size_t k, VectorMetric metric, size_t numThreads);
+
+    template std::vector<std::vector<Neighbor>> PairwiseNearest(const DatasetView<uint8_t> &x, const DatasetView<uint8_t> &y, size_t k, VectorMetric metric, size_t numThreads);
+    template std::vector<std::vector<Neighbor>> PairwiseNearest(const DatasetView<uint16_t> &x, const DatasetView<uint16_t> &y, size_t k, VectorMetric metric, size_t numThreads);
+    template std::vector<std::vector<Neighbor>> PairwiseNearest(const DatasetView<uint32_t> &x, const DatasetView<uint32_t> &y, size_t k, VectorMetric metric, size_t numThreads);
+    template std::vector<std::vector<Neighbor>> PairwiseNearest(const DatasetView<uint64_t> &x, const DatasetView<uint64_t> &y, size_t k, VectorMetric metric, size_t numThreads);
+
+    template std::vector<std::vector<Neighbor>> PairwiseNearest(const DatasetView<float> &x, const DatasetView<float> &y, size_t k, VectorMetric metric, size_t numThreads);
+    template std::vector<std::vector<Neighbor>> PairwiseNearest(const DatasetView<double> &x, const DatasetView<double> &y, size_t k, VectorMetric metric, size_t numThreads);
+    template std::vector<std::vector<Neighbor>> PairwiseNearest(const DatasetView<long double> &x, const DatasetView<long double> &y, size_t k, VectorMetric metric, size_t numThreads);
+#endif
 
 } // namespace mlLib